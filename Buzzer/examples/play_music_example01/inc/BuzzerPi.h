@@ -3,6 +3,7 @@
 
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
+#include "hardware/dma.h"
 
 /******************************
  * Documentação do Arquivo
@@ -22,6 +23,10 @@
  * 3. Reprodução de tons únicos com controle de frequência e duração.
  * 4. Reprodução de melodias a partir de arrays de frequências e durações.
  * 5. Reprodução de beeps repetidos.
+ * 6. Instâncias `BuzzerPi_t` que guardam slice, canal e parâmetros do PWM de cada buzzer.
+ * 7. Partida sincronizada de vários buzzers em slices diferentes (`pwm_set_mask_enabled`).
+ * 8. Modo estéreo/duplo tom (ex: DTMF) com atualização atômica dos dois canais.
+ * 9. Varreduras de frequência (sirenes, subidas, "laser") executadas por DMA, sem uso da CPU.
  */
 
 /******************************
@@ -36,7 +41,95 @@
 /**
  * @brief Pino GPIO padrão para o buzzer.
  */
+#ifndef BUZZER_PIN
 #define BUZZER_PIN 21
+#endif
+
+/**
+ * @brief Pino GPIO do segundo buzzer da BitDogLab (slice PWM diferente do `BUZZER_PIN`).
+ */
+#ifndef BUZZER_PIN_2
+#define BUZZER_PIN_2 10
+#endif
+
+/**
+ * @brief Número máximo de passos de uma tabela de varredura.
+ *
+ * Cada passo ocupa 8 bytes (TOP + CC).
+ */
+#ifndef BUZZER_SWEEP_MAX_STEPS
+#define BUZZER_SWEEP_MAX_STEPS 256
+#endif
+
+/**
+ * @brief Taxa padrão de atualização da varredura (passos por segundo).
+ */
+#ifndef BUZZER_SWEEP_STEP_HZ
+#define BUZZER_SWEEP_STEP_HZ 500
+#endif
+
+/**
+ * @brief Slice PWM usado como temporizador de cadência da varredura.
+ *
+ * O slice não precisa de pino: apenas o seu sinal de wrap (DREQ) é usado para cadenciar o DMA.
+ * Na BitDogLab o slice 7 (GP14/GP15) fica livre, pois esses pinos são usados pelo I2C do display.
+ */
+#ifndef BUZZER_SWEEP_PACER_SLICE
+#define BUZZER_SWEEP_PACER_SLICE 7
+#endif
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estrutura que representa um buzzer ligado a um canal PWM.
+ *
+ * O slice, o canal e a frequência de contagem do PWM são calculados uma única vez em
+ * `BuzzerPi_init`, de forma que tocar uma nota custa apenas uma divisão inteira.
+ */
+typedef struct {
+    uint pin;            // Pino GPIO onde o buzzer está conectado
+    uint slice;          // Slice PWM associado ao pino
+    uint channel;        // Canal do slice (PWM_CHAN_A ou PWM_CHAN_B)
+    float clkdiv;        // Divisor de clock aplicado ao slice
+    uint32_t counter_hz; // Frequência do contador do PWM (clk_sys / clkdiv)
+    uint16_t wrap;       // Último valor de wrap (TOP) programado
+    uint16_t level;      // Último nível (duty cycle) programado
+} BuzzerPi_t;
+
+/**
+ * @brief Formato da rampa de frequência de uma varredura.
+ */
+typedef enum {
+    BUZZER_SWEEP_LINEAR,     // Frequência varia linearmente com o tempo
+    BUZZER_SWEEP_EXPONENTIAL // Frequência varia em razão constante (passos iguais em semitons)
+} BuzzerSweepCurve;
+
+/**
+ * @brief Varredura de frequência pré-calculada e executada por DMA.
+ *
+ * As tabelas `top` e `cc` contêm os valores escritos nos registradores TOP e CC do slice do
+ * buzzer a cada passo. Dois canais DMA, cadenciados pelo wrap do slice `pacer_slice`, copiam
+ * um par por passo; os registradores são duplamente bufferizados pelo hardware, então TOP e CC
+ * mudam juntos no próximo wrap do buzzer. No modo contínuo, dois canais adicionais reiniciam os
+ * canais de dados ao fim da tabela.
+ */
+typedef struct {
+    uint32_t top[BUZZER_SWEEP_MAX_STEPS + 1]; // Valores de wrap (o último passo extra é o silêncio final)
+    uint32_t cc[BUZZER_SWEEP_MAX_STEPS + 1];  // Valores do registrador CC (nível no canal do buzzer)
+    uint steps;                               // Número de passos da rampa
+    uint32_t step_us;                         // Duração de cada passo em microssegundos
+    bool valid;                               // Tabelas montadas com sucesso por `BuzzerPi_sweep_build`
+    BuzzerPi_t *buzzer;                       // Buzzer controlado pela varredura
+    uint pacer_slice;                         // Slice PWM usado como temporizador
+    int dma_top;                              // Canal DMA que escreve TOP
+    int dma_cc;                               // Canal DMA que escreve CC
+    int dma_top_reload;                       // Canal que reinicia `dma_top` (modo contínuo)
+    int dma_cc_reload;                        // Canal que reinicia `dma_cc` (modo contínuo)
+    const uint32_t *top_start;                // Endereço inicial lido pelos canais de reinício
+    const uint32_t *cc_start;
+} BuzzerSweep_t;
 
 /******************************
  * Funções
@@ -102,4 +195,171 @@ void play_melody(uint pin, int *melody, int *durations, float clkdiv, int length
  */
 void beep(uint pin, int freq, int duration, int repetition);
 
+/**
+ * @brief Inicializa uma instância de buzzer.
+ *
+ * Configura o pino como saída PWM, aplica o divisor de clock ao slice e guarda os parâmetros
+ * do slice na instância. O slice permanece desabilitado até `BuzzerPi_start`.
+ *
+ * @param buzzer Ponteiro para a instância a ser inicializada.
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param clkdiv Divisor de clock usado para o PWM (ex: `CLK_DIV_DEFAULT`).
+ */
+void BuzzerPi_init(BuzzerPi_t *buzzer, uint pin, float clkdiv);
+
+/**
+ * @brief Programa a frequência do buzzer sem alterar o estado de habilitação do slice.
+ *
+ * O duty cycle é fixado em 50%. Uma frequência 0 programa nível 0 (silêncio).
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param freq Frequência do tom em Hz.
+ */
+void BuzzerPi_set_tone(BuzzerPi_t *buzzer, uint32_t freq);
+
+/**
+ * @brief Habilita o slice PWM do buzzer.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ */
+void BuzzerPi_start(BuzzerPi_t *buzzer);
+
+/**
+ * @brief Silencia o buzzer (nível 0) e desabilita o slice PWM.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ */
+void BuzzerPi_stop(BuzzerPi_t *buzzer);
+
+/**
+ * @brief Toca um tom no buzzer com a frequência e duração especificadas.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param freq Frequência do tom em Hz (0 = pausa).
+ * @param duration_ms Duração do tom em milissegundos.
+ */
+void BuzzerPi_play_tone(BuzzerPi_t *buzzer, uint32_t freq, uint duration_ms);
+
+/**
+ * @brief Toca uma melodia a partir de arrays de frequências e durações.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param melody Array de frequências que compõem a melodia (0 = pausa).
+ * @param durations Array de durações correspondentes a cada frequência.
+ * @param length Número de notas na melodia.
+ */
+void BuzzerPi_play_melody(BuzzerPi_t *buzzer, const int *melody, const int *durations, int length);
+
+/**
+ * @brief Retorna a máscara de habilitação (bits de slice) de um grupo de buzzers.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ * @return Máscara com o bit de cada slice usado pelo grupo.
+ */
+uint32_t BuzzerPi_group_mask(BuzzerPi_t *const *buzzers, uint count);
+
+/**
+ * @brief Habilita simultaneamente os slices de um grupo de buzzers.
+ *
+ * Os contadores dos slices são zerados e todos são habilitados com uma única escrita
+ * (`pwm_set_mask_enabled`), de forma que os sinais partem alinhados em fase.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ */
+void BuzzerPi_start_group(BuzzerPi_t *const *buzzers, uint count);
+
+/**
+ * @brief Silencia e desabilita simultaneamente os slices de um grupo de buzzers.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ */
+void BuzzerPi_stop_group(BuzzerPi_t *const *buzzers, uint count);
+
+/**
+ * @brief Programa dois buzzers com frequências independentes de forma atômica.
+ *
+ * Os dois slices são parados, reprogramados e religados na mesma escrita do registrador
+ * de habilitação, com as interrupções desabilitadas. Os buzzers devem estar em slices
+ * diferentes, pois os dois canais de um mesmo slice compartilham o wrap.
+ *
+ * @param left Buzzer do canal esquerdo (ou tom baixo).
+ * @param right Buzzer do canal direito (ou tom alto).
+ * @param freq_left Frequência do canal esquerdo em Hz (0 = silêncio).
+ * @param freq_right Frequência do canal direito em Hz (0 = silêncio).
+ * @return false se os dois buzzers compartilharem o mesmo slice.
+ */
+bool BuzzerPi_set_stereo(BuzzerPi_t *left, BuzzerPi_t *right, uint32_t freq_left, uint32_t freq_right);
+
+/**
+ * @brief Toca um par de tons simultâneos durante o tempo especificado.
+ *
+ * @param left Buzzer do canal esquerdo (ou tom baixo).
+ * @param right Buzzer do canal direito (ou tom alto).
+ * @param freq_left Frequência do canal esquerdo em Hz.
+ * @param freq_right Frequência do canal direito em Hz.
+ * @param duration_ms Duração em milissegundos.
+ */
+void BuzzerPi_play_stereo(BuzzerPi_t *left, BuzzerPi_t *right, uint32_t freq_left, uint32_t freq_right, uint duration_ms);
+
+/**
+ * @brief Gera o sinal DTMF correspondente a uma tecla do teclado telefônico.
+ *
+ * O tom de linha (697-941 Hz) é tocado em `low` e o tom de coluna (1209-1633 Hz) em `high`.
+ *
+ * @param low Buzzer que gera o tom de linha.
+ * @param high Buzzer que gera o tom de coluna.
+ * @param key Tecla ('0'-'9', 'A'-'D', '*' ou '#').
+ * @param duration_ms Duração do tom em milissegundos.
+ * @return false se a tecla for inválida ou os buzzers compartilharem o mesmo slice.
+ */
+bool BuzzerPi_play_dtmf(BuzzerPi_t *low, BuzzerPi_t *high, char key, uint duration_ms);
+
+/**
+ * @brief Pré-calcula uma varredura de frequência para um buzzer.
+ *
+ * O número de passos é `duration_ms * BUZZER_SWEEP_STEP_HZ / 1000`, limitado a
+ * `BUZZER_SWEEP_MAX_STEPS`. Todo o cálculo (inclusive a curva exponencial) é feito aqui,
+ * uma única vez; durante a reprodução a CPU não participa.
+ *
+ * @param sweep Ponteiro para a varredura a ser preenchida.
+ * @param buzzer Buzzer inicializado com `BuzzerPi_init`.
+ * @param f_start Frequência inicial em Hz.
+ * @param f_end Frequência final em Hz.
+ * @param duration_ms Duração da rampa em milissegundos.
+ * @param curve Formato da rampa (linear ou exponencial).
+ * @return false se os parâmetros forem inválidos (frequência 0 ou duração curta demais) ou se o
+ *         buzzer estiver no slice `BUZZER_SWEEP_PACER_SLICE`, reservado ao temporizador.
+ */
+bool BuzzerPi_sweep_build(BuzzerSweep_t *sweep, BuzzerPi_t *buzzer, uint32_t f_start, uint32_t f_end, uint duration_ms, BuzzerSweepCurve curve);
+
+/**
+ * @brief Inicia a reprodução de uma varredura por DMA.
+ *
+ * A função retorna imediatamente. No modo único, o buzzer é silenciado ao fim da rampa;
+ * no modo contínuo (`loop`), a rampa se repete até `BuzzerPi_sweep_stop`.
+ *
+ * @param sweep Varredura preenchida por `BuzzerPi_sweep_build`.
+ * @param loop true para repetir a rampa indefinidamente (sirene).
+ * @return false se a varredura não foi montada com sucesso ou se não houver canais DMA livres.
+ */
+bool BuzzerPi_sweep_start(BuzzerSweep_t *sweep, bool loop);
+
+/**
+ * @brief Indica se a varredura ainda está em reprodução.
+ *
+ * @param sweep Varredura em execução.
+ * @return true enquanto os canais DMA estiverem ativos.
+ */
+bool BuzzerPi_sweep_busy(const BuzzerSweep_t *sweep);
+
+/**
+ * @brief Interrompe a varredura, silencia o buzzer e libera os canais DMA.
+ *
+ * @param sweep Varredura em execução (ou já encerrada).
+ */
+void BuzzerPi_sweep_stop(BuzzerSweep_t *sweep);
+
 #endif // BUZZER_PI_H
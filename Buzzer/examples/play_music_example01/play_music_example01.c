@@ -19,9 +19,21 @@
  * Funcionalidades:
  * 1. Inicializa o PWM para controle do buzzer.
  * 2. Reproduz as melodias "Pirates of the Caribbean", "Marcha Imperial" e "Für Elise".
- * 3. Repete a sequência de melodias indefinidamente.
+ * 3. Toca um número de telefone em DTMF usando os dois buzzers da placa (modo estéreo).
+ * 4. Executa efeitos de varredura por DMA: um "laser" descendente e uma sirene contínua.
+ * 5. Repete a sequência de melodias indefinidamente.
  */
 
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Tabelas das varreduras (estáticas, pois cada uma ocupa alguns kilobytes).
+ */
+static BuzzerSweep_t laser_sweep;
+static BuzzerSweep_t siren_sweep;
+
 /******************************
  * Função Principal
  ******************************/
@@ -37,21 +49,50 @@
 int main() {
     stdio_init_all(); // Inicializa a comunicação serial (para debug, se necessário)
 
-    initialize_pwm(BUZZER_PIN); // Inicializa o PWM no pino do buzzer
+    // Inicializa os dois buzzers da placa (cada um em um slice PWM próprio)
+    BuzzerPi_t buzzer_a, buzzer_b;
+    BuzzerPi_init(&buzzer_a, BUZZER_PIN, CLK_DIV_DEFAULT);
+    BuzzerPi_init(&buzzer_b, BUZZER_PIN_2, CLK_DIV_DEFAULT);
+
+    // Pré-calcula os efeitos uma única vez
+    BuzzerPi_sweep_build(&laser_sweep, &buzzer_a, 2000, 200, 300, BUZZER_SWEEP_EXPONENTIAL);
+    BuzzerPi_sweep_build(&siren_sweep, &buzzer_a, 600, 1200, 500, BUZZER_SWEEP_LINEAR);
 
     // Loop principal do programa
     while (true) {
         // Toca a melodia "Pirates of the Caribbean"
-        play_melody(BUZZER_PIN, PiratesCaribeanMelody, PiratesCaribeanDurations, 125.0f, sizeof(PiratesCaribeanMelody) / sizeof(PiratesCaribeanMelody[0]));
+        BuzzerPi_play_melody(&buzzer_a, PiratesCaribeanMelody, PiratesCaribeanDurations, sizeof(PiratesCaribeanMelody) / sizeof(PiratesCaribeanMelody[0]));
         sleep_ms(1000); // Intervalo de 1 segundo
 
         // Toca a melodia "Marcha Imperial"
-        play_melody(BUZZER_PIN, MarchImperialMelody, MarchImperialDurations, 125.0f, sizeof(MarchImperialMelody) / sizeof(MarchImperialMelody[0]));
+        BuzzerPi_play_melody(&buzzer_a, MarchImperialMelody, MarchImperialDurations, sizeof(MarchImperialMelody) / sizeof(MarchImperialMelody[0]));
         sleep_ms(1000); // Intervalo de 1 segundo
 
         // Toca a melodia "Für Elise"
-        play_melody(BUZZER_PIN, ForEliseMelody, ForEliseDurations, 125.0f, sizeof(ForEliseMelody) / sizeof(ForEliseMelody[0]));
+        BuzzerPi_play_melody(&buzzer_a, ForEliseMelody, ForEliseDurations, sizeof(ForEliseMelody) / sizeof(ForEliseMelody[0]));
+        sleep_ms(1000); // Intervalo de 1 segundo
+
+        // Disca um número em DTMF (tom de linha no buzzer A, tom de coluna no buzzer B)
+        const char *number = "5551234";
+        for (const char *key = number; *key != '\0'; key++) {
+            BuzzerPi_play_dtmf(&buzzer_a, &buzzer_b, *key, 120);
+            sleep_ms(80); // Pausa entre dígitos
+        }
         sleep_ms(1000); // Intervalo de 1 segundo
+
+        // Efeito "laser": a CPU fica livre enquanto o DMA percorre a rampa
+        BuzzerPi_sweep_start(&laser_sweep, false);
+        while (BuzzerPi_sweep_busy(&laser_sweep)) {
+            tight_loop_contents();
+        }
+        BuzzerPi_sweep_stop(&laser_sweep);
+        sleep_ms(500);
+
+        // Sirene contínua por 3 segundos
+        BuzzerPi_sweep_start(&siren_sweep, true);
+        sleep_ms(3000);
+        BuzzerPi_sweep_stop(&siren_sweep);
+        sleep_ms(1000);
     }
 
     return 0; // Nunca alcançado, pois o programa está em um loop infinito
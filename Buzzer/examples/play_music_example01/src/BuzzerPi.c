@@ -1,6 +1,8 @@
 #include "inc/BuzzerPi.h"
 #include "hardware/clocks.h"
+#include "hardware/sync.h"
 #include <stdio.h>
+#include <math.h>
 
 /******************************
  * Documentação do Arquivo
@@ -20,6 +22,8 @@
  * 3. Reprodução de tons únicos com controle de frequência e duração.
  * 4. Reprodução de melodias a partir de arrays de frequências e durações.
  * 5. Reprodução de beeps repetidos.
+ * 6. Instâncias `BuzzerPi_t` com slice e canal próprios, partida sincronizada e modo estéreo/DTMF.
+ * 7. Varreduras de frequência pré-calculadas e escritas nos registradores TOP/CC por DMA.
  */
 
 /******************************
@@ -139,3 +143,511 @@ void beep(uint pin, int freq, int duration, int repetition) {
         sleep_ms(500); // Intervalo entre os beeps
     }
 }
+
+/******************************
+ * Instâncias BuzzerPi_t
+ ******************************/
+
+/**
+ * @brief Frequências de linha do teclado DTMF (Hz).
+ */
+static const uint16_t dtmf_row_freq[4] = {697, 770, 852, 941};
+
+/**
+ * @brief Frequências de coluna do teclado DTMF (Hz).
+ */
+static const uint16_t dtmf_col_freq[4] = {1209, 1336, 1477, 1633};
+
+/**
+ * @brief Disposição das teclas DTMF (linha x coluna).
+ */
+static const char dtmf_keys[4][4] = {
+    {'1', '2', '3', 'A'},
+    {'4', '5', '6', 'B'},
+    {'7', '8', '9', 'C'},
+    {'*', '0', '#', 'D'},
+};
+
+/**
+ * @brief Calcula wrap e nível (50% de duty cycle) de uma frequência e guarda na instância.
+ *
+ * Usa a frequência de contagem pré-calculada, evitando consultar o clock e operar com
+ * ponto flutuante a cada nota.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param freq Frequência desejada em Hz (0 = silêncio).
+ */
+static void buzzer_compute(BuzzerPi_t *buzzer, uint32_t freq) {
+    if (freq == 0) {
+        buzzer->level = 0; // Silêncio: mantém o wrap atual e zera o nível
+        return;
+    }
+    uint32_t wrap = buzzer->counter_hz / freq;
+    wrap = (wrap > 0) ? wrap - 1 : 0;
+    buzzer->wrap = (wrap > 65535) ? 65535 : wrap; // Limita ao máximo suportado pelo contador
+    buzzer->level = buzzer->wrap / 2;
+}
+
+/**
+ * @brief Escreve o wrap e o nível guardados na instância nos registradores do slice.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ */
+static void buzzer_apply(const BuzzerPi_t *buzzer) {
+    pwm_set_wrap(buzzer->slice, buzzer->wrap);
+    pwm_set_chan_level(buzzer->slice, buzzer->channel, buzzer->level);
+}
+
+/**
+ * @brief Inicializa uma instância de buzzer.
+ *
+ * @param buzzer Ponteiro para a instância a ser inicializada.
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param clkdiv Divisor de clock usado para o PWM.
+ */
+void BuzzerPi_init(BuzzerPi_t *buzzer, uint pin, float clkdiv) {
+    buzzer->pin = pin;
+    buzzer->slice = pwm_gpio_to_slice_num(pin);   // Slice e canal calculados uma única vez
+    buzzer->channel = pwm_gpio_to_channel(pin);
+    buzzer->clkdiv = clkdiv;
+    buzzer->counter_hz = (uint32_t)(clock_get_hz(clk_sys) / clkdiv);
+    buzzer->wrap = 65535;
+    buzzer->level = 0;
+
+    gpio_set_function(pin, GPIO_FUNC_PWM); // Configura o pino como saída PWM
+    pwm_set_enabled(buzzer->slice, false);
+    pwm_set_clkdiv(buzzer->slice, clkdiv);
+    buzzer_apply(buzzer);
+}
+
+/**
+ * @brief Programa a frequência do buzzer sem alterar o estado de habilitação do slice.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param freq Frequência do tom em Hz.
+ */
+void BuzzerPi_set_tone(BuzzerPi_t *buzzer, uint32_t freq) {
+    buzzer_compute(buzzer, freq);
+    buzzer_apply(buzzer);
+}
+
+/**
+ * @brief Habilita o slice PWM do buzzer.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ */
+void BuzzerPi_start(BuzzerPi_t *buzzer) {
+    pwm_set_enabled(buzzer->slice, true);
+}
+
+/**
+ * @brief Silencia o buzzer (nível 0) e desabilita o slice PWM.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ */
+void BuzzerPi_stop(BuzzerPi_t *buzzer) {
+    buzzer->level = 0;
+    pwm_set_chan_level(buzzer->slice, buzzer->channel, 0);
+    pwm_set_enabled(buzzer->slice, false);
+}
+
+/**
+ * @brief Toca um tom no buzzer com a frequência e duração especificadas.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param freq Frequência do tom em Hz (0 = pausa).
+ * @param duration_ms Duração do tom em milissegundos.
+ */
+void BuzzerPi_play_tone(BuzzerPi_t *buzzer, uint32_t freq, uint duration_ms) {
+    BuzzerPi_set_tone(buzzer, freq);
+    BuzzerPi_start(buzzer);
+    sleep_ms(duration_ms); // Mantém o tom ativo pelo tempo especificado
+    BuzzerPi_stop(buzzer);
+}
+
+/**
+ * @brief Toca uma melodia a partir de arrays de frequências e durações.
+ *
+ * @param buzzer Ponteiro para a instância do buzzer.
+ * @param melody Array de frequências que compõem a melodia (0 = pausa).
+ * @param durations Array de durações correspondentes a cada frequência.
+ * @param length Número de notas na melodia.
+ */
+void BuzzerPi_play_melody(BuzzerPi_t *buzzer, const int *melody, const int *durations, int length) {
+    for (int i = 0; i < length; i++) {
+        if (melody[i] != 0) {
+            BuzzerPi_play_tone(buzzer, melody[i], durations[i]); // Toca a nota
+        } else {
+            sleep_ms(durations[i]); // Pausa (nota silenciosa)
+        }
+    }
+}
+
+/**
+ * @brief Retorna a máscara de habilitação (bits de slice) de um grupo de buzzers.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ * @return Máscara com o bit de cada slice usado pelo grupo.
+ */
+uint32_t BuzzerPi_group_mask(BuzzerPi_t *const *buzzers, uint count) {
+    uint32_t mask = 0;
+    for (uint i = 0; i < count; i++) {
+        mask |= 1u << buzzers[i]->slice;
+    }
+    return mask;
+}
+
+/**
+ * @brief Habilita simultaneamente os slices de um grupo de buzzers.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ */
+void BuzzerPi_start_group(BuzzerPi_t *const *buzzers, uint count) {
+    uint32_t mask = BuzzerPi_group_mask(buzzers, count);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t enabled = pwm_hw->en & ~mask;
+    pwm_set_mask_enabled(enabled); // Para os slices do grupo antes de alinhar os contadores
+    for (uint i = 0; i < count; i++) {
+        pwm_set_counter(buzzers[i]->slice, 0);
+    }
+    pwm_set_mask_enabled(enabled | mask); // Uma única escrita liga todos os slices juntos
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Silencia e desabilita simultaneamente os slices de um grupo de buzzers.
+ *
+ * @param buzzers Array de ponteiros para as instâncias.
+ * @param count Número de instâncias no array.
+ */
+void BuzzerPi_stop_group(BuzzerPi_t *const *buzzers, uint count) {
+    uint32_t mask = BuzzerPi_group_mask(buzzers, count);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    pwm_set_mask_enabled(pwm_hw->en & ~mask);
+    restore_interrupts(irq_state);
+
+    for (uint i = 0; i < count; i++) {
+        buzzers[i]->level = 0;
+        pwm_set_chan_level(buzzers[i]->slice, buzzers[i]->channel, 0);
+    }
+}
+
+/**
+ * @brief Programa dois buzzers com frequências independentes de forma atômica.
+ *
+ * Com o slice parado, o hardware carrega TOP e CC imediatamente (sem esperar o próximo wrap),
+ * por isso os dois canais passam a tocar o novo par de tons a partir do mesmo instante.
+ *
+ * @param left Buzzer do canal esquerdo (ou tom baixo).
+ * @param right Buzzer do canal direito (ou tom alto).
+ * @param freq_left Frequência do canal esquerdo em Hz (0 = silêncio).
+ * @param freq_right Frequência do canal direito em Hz (0 = silêncio).
+ * @return false se os dois buzzers compartilharem o mesmo slice.
+ */
+bool BuzzerPi_set_stereo(BuzzerPi_t *left, BuzzerPi_t *right, uint32_t freq_left, uint32_t freq_right) {
+    if (left->slice == right->slice) {
+        return false; // Os canais de um mesmo slice compartilham o wrap
+    }
+
+    // Cálculos feitos antes da seção crítica
+    buzzer_compute(left, freq_left);
+    buzzer_compute(right, freq_right);
+    uint32_t mask = (1u << left->slice) | (1u << right->slice);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    uint32_t enabled = pwm_hw->en & ~mask;
+    pwm_set_mask_enabled(enabled);
+    buzzer_apply(left);
+    buzzer_apply(right);
+    pwm_set_counter(left->slice, 0);
+    pwm_set_counter(right->slice, 0);
+    pwm_set_mask_enabled(enabled | mask);
+    restore_interrupts(irq_state);
+
+    return true;
+}
+
+/**
+ * @brief Toca um par de tons simultâneos durante o tempo especificado.
+ *
+ * @param left Buzzer do canal esquerdo (ou tom baixo).
+ * @param right Buzzer do canal direito (ou tom alto).
+ * @param freq_left Frequência do canal esquerdo em Hz.
+ * @param freq_right Frequência do canal direito em Hz.
+ * @param duration_ms Duração em milissegundos.
+ */
+void BuzzerPi_play_stereo(BuzzerPi_t *left, BuzzerPi_t *right, uint32_t freq_left, uint32_t freq_right, uint duration_ms) {
+    if (!BuzzerPi_set_stereo(left, right, freq_left, freq_right)) {
+        return;
+    }
+    sleep_ms(duration_ms);
+
+    BuzzerPi_t *const pair[2] = {left, right};
+    BuzzerPi_stop_group(pair, 2);
+}
+
+/**
+ * @brief Gera o sinal DTMF correspondente a uma tecla do teclado telefônico.
+ *
+ * @param low Buzzer que gera o tom de linha.
+ * @param high Buzzer que gera o tom de coluna.
+ * @param key Tecla ('0'-'9', 'A'-'D', '*' ou '#').
+ * @param duration_ms Duração do tom em milissegundos.
+ * @return false se a tecla for inválida ou os buzzers compartilharem o mesmo slice.
+ */
+bool BuzzerPi_play_dtmf(BuzzerPi_t *low, BuzzerPi_t *high, char key, uint duration_ms) {
+    if (low->slice == high->slice) {
+        return false;
+    }
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            if (dtmf_keys[row][col] == key) {
+                BuzzerPi_play_stereo(low, high, dtmf_row_freq[row], dtmf_col_freq[col], duration_ms);
+                return true;
+            }
+        }
+    }
+    return false; // Tecla inválida
+}
+
+/******************************
+ * Varreduras de frequência (DMA)
+ ******************************/
+
+/**
+ * @brief Monta a configuração de um canal de dados da varredura.
+ *
+ * @param channel Canal DMA a ser configurado.
+ * @param dreq Sinal de cadência (wrap do slice temporizador).
+ * @param chain_to Canal disparado ao fim da transferência (o próprio canal = sem encadeamento).
+ * @return Configuração do canal.
+ */
+static dma_channel_config sweep_data_config(uint channel, uint dreq, uint chain_to) {
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);   // Percorre a tabela
+    channel_config_set_write_increment(&c, false); // Sempre o mesmo registrador
+    channel_config_set_dreq(&c, dreq);
+    channel_config_set_chain_to(&c, chain_to);
+    return c;
+}
+
+/**
+ * @brief Configura um canal que reinicia um canal de dados no início da tabela.
+ *
+ * Escreve o endereço inicial no alias `READ_ADDR_TRIG` do canal de dados, o que recarrega o
+ * contador de transferências e dispara o canal novamente.
+ *
+ * @param reload Canal de reinício.
+ * @param data Canal de dados a ser reiniciado.
+ * @param start Variável que contém o endereço inicial da tabela.
+ */
+static void sweep_configure_reload(uint reload, uint data, const uint32_t *const *start) {
+    dma_channel_config c = dma_channel_get_default_config(reload);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure(reload, &c, &dma_hw->ch[data].al3_read_addr_trig, start, 1, false);
+}
+
+/**
+ * @brief Libera os canais DMA reservados pela varredura.
+ *
+ * @param sweep Varredura.
+ */
+static void sweep_release_channels(BuzzerSweep_t *sweep) {
+    int *channels[4] = {&sweep->dma_top, &sweep->dma_cc, &sweep->dma_top_reload, &sweep->dma_cc_reload};
+    for (int i = 0; i < 4; i++) {
+        if (*channels[i] >= 0) {
+            dma_channel_abort(*channels[i]);
+            dma_channel_unclaim(*channels[i]);
+            *channels[i] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Pré-calcula uma varredura de frequência para um buzzer.
+ *
+ * @param sweep Ponteiro para a varredura a ser preenchida.
+ * @param buzzer Buzzer inicializado com `BuzzerPi_init`.
+ * @param f_start Frequência inicial em Hz.
+ * @param f_end Frequência final em Hz.
+ * @param duration_ms Duração da rampa em milissegundos.
+ * @param curve Formato da rampa (linear ou exponencial).
+ * @return false se os parâmetros forem inválidos ou o buzzer estiver no slice do temporizador.
+ */
+bool BuzzerPi_sweep_build(BuzzerSweep_t *sweep, BuzzerPi_t *buzzer, uint32_t f_start, uint32_t f_end, uint duration_ms, BuzzerSweepCurve curve) {
+    sweep->dma_top = sweep->dma_cc = -1;
+    sweep->dma_top_reload = sweep->dma_cc_reload = -1;
+    sweep->buzzer = buzzer;
+    sweep->pacer_slice = BUZZER_SWEEP_PACER_SLICE;
+    sweep->top_start = sweep->top;
+    sweep->cc_start = sweep->cc;
+    sweep->valid = false;
+
+    if (f_start == 0 || f_end == 0) {
+        return false;
+    }
+    if (buzzer->slice == BUZZER_SWEEP_PACER_SLICE) {
+        return false; // O slice do buzzer seria reprogramado como temporizador
+    }
+
+    uint steps = (uint)((uint64_t)duration_ms * BUZZER_SWEEP_STEP_HZ / 1000);
+    if (steps > BUZZER_SWEEP_MAX_STEPS) {
+        steps = BUZZER_SWEEP_MAX_STEPS;
+    }
+    if (steps < 2) {
+        return false; // Rampa curta demais para ser interpolada
+    }
+    uint32_t step_us = (uint32_t)((uint64_t)duration_ms * 1000 / steps);
+    if (step_us == 0 || step_us > 65536) {
+        return false; // O temporizador conta em 1 MHz com wrap de 16 bits
+    }
+    sweep->steps = steps;
+    sweep->step_us = step_us;
+
+    // Preserva o nível do outro canal do slice, pois CC guarda os dois canais
+    uint shift = (buzzer->channel == PWM_CHAN_B) ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB;
+    uint32_t other = pwm_hw->slice[buzzer->slice].cc & ~(0xffffu << shift);
+
+    float ratio = powf((float)f_end / (float)f_start, 1.0f / (float)(steps - 1));
+    float f_exp = (float)f_start;
+
+    for (uint i = 0; i < steps; i++) {
+        uint32_t freq;
+        if (curve == BUZZER_SWEEP_EXPONENTIAL) {
+            freq = (uint32_t)(f_exp + 0.5f);
+            f_exp *= ratio;
+        } else {
+            int64_t delta = (int64_t)f_end - (int64_t)f_start;
+            freq = (uint32_t)((int64_t)f_start + delta * (int64_t)i / (int64_t)(steps - 1));
+        }
+        if (freq == 0) {
+            freq = 1;
+        }
+
+        uint32_t wrap = buzzer->counter_hz / freq;
+        wrap = (wrap > 0) ? wrap - 1 : 0;
+        if (wrap > 65535) {
+            wrap = 65535;
+        }
+        sweep->top[i] = wrap;
+        sweep->cc[i] = other | ((wrap / 2) << shift); // 50% de duty cycle
+    }
+
+    // Passo extra: silêncio ao fim da rampa no modo único
+    sweep->top[steps] = sweep->top[steps - 1];
+    sweep->cc[steps] = other;
+    sweep->valid = true;
+    return true;
+}
+
+/**
+ * @brief Inicia a reprodução de uma varredura por DMA.
+ *
+ * @param sweep Varredura preenchida por `BuzzerPi_sweep_build`.
+ * @param loop true para repetir a rampa indefinidamente (sirene).
+ * @return false se a varredura não foi montada com sucesso ou se não houver canais DMA livres.
+ */
+bool BuzzerPi_sweep_start(BuzzerSweep_t *sweep, bool loop) {
+    BuzzerPi_sweep_stop(sweep);
+    if (!sweep->valid) {
+        return false; // `steps` e `step_us` não valem após uma montagem recusada
+    }
+
+    sweep->dma_top = dma_claim_unused_channel(false);
+    sweep->dma_cc = dma_claim_unused_channel(false);
+    if (loop) {
+        sweep->dma_top_reload = dma_claim_unused_channel(false);
+        sweep->dma_cc_reload = dma_claim_unused_channel(false);
+    }
+    if (sweep->dma_top < 0 || sweep->dma_cc < 0 ||
+        (loop && (sweep->dma_top_reload < 0 || sweep->dma_cc_reload < 0))) {
+        sweep_release_channels(sweep);
+        return false;
+    }
+
+    BuzzerPi_t *buzzer = sweep->buzzer;
+    pwm_slice_hw_t *slice_hw = &pwm_hw->slice[buzzer->slice];
+
+    // Temporizador de cadência: contador em 1 MHz, um wrap por passo
+    uint pacer = sweep->pacer_slice;
+    pwm_set_enabled(pacer, false);
+    pwm_set_clkdiv(pacer, (float)clock_get_hz(clk_sys) / 1000000.0f);
+    pwm_set_wrap(pacer, sweep->step_us - 1);
+    pwm_set_counter(pacer, 0);
+    uint dreq = pwm_get_dreq(pacer);
+
+    // O passo 0 é escrito à mão abaixo; os canais de dados começam no passo 1, e no modo contínuo
+    // as voltas seguintes (recarregadas de `top_start`/`cc_start`) percorrem a tabela inteira
+    uint lap = loop ? sweep->steps : sweep->steps + 1;
+    uint top_chain = loop ? (uint)sweep->dma_top_reload : (uint)sweep->dma_top;
+    uint cc_chain = loop ? (uint)sweep->dma_cc_reload : (uint)sweep->dma_cc;
+
+    dma_channel_config c = sweep_data_config(sweep->dma_top, dreq, top_chain);
+    dma_channel_configure(sweep->dma_top, &c, &slice_hw->top, sweep->top + 1, lap - 1, false);
+    c = sweep_data_config(sweep->dma_cc, dreq, cc_chain);
+    dma_channel_configure(sweep->dma_cc, &c, &slice_hw->cc, sweep->cc + 1, lap - 1, false);
+
+    if (loop) {
+        sweep_configure_reload(sweep->dma_top_reload, sweep->dma_top, &sweep->top_start);
+        sweep_configure_reload(sweep->dma_cc_reload, sweep->dma_cc, &sweep->cc_start);
+    }
+
+    // O primeiro passo é aplicado já, sem esperar o primeiro wrap do temporizador
+    slice_hw->top = sweep->top[0];
+    slice_hw->cc = sweep->cc[0];
+    pwm_set_enabled(buzzer->slice, true);
+
+    dma_start_channel_mask((1u << sweep->dma_top) | (1u << sweep->dma_cc));
+    if (loop) {
+        // Com os canais já disparados, TRANS_COUNT só muda o valor recarregado nas próximas voltas
+        dma_channel_set_trans_count(sweep->dma_top, lap, false);
+        dma_channel_set_trans_count(sweep->dma_cc, lap, false);
+    }
+    pwm_set_enabled(pacer, true);
+    return true;
+}
+
+/**
+ * @brief Indica se a varredura ainda está em reprodução.
+ *
+ * @param sweep Varredura em execução.
+ * @return true enquanto os canais DMA estiverem ativos.
+ */
+bool BuzzerPi_sweep_busy(const BuzzerSweep_t *sweep) {
+    if (sweep->dma_top < 0) {
+        return false;
+    }
+    return dma_channel_is_busy(sweep->dma_top) || dma_channel_is_busy(sweep->dma_cc) ||
+           (sweep->dma_top_reload >= 0); // No modo contínuo a varredura só termina com stop
+}
+
+/**
+ * @brief Interrompe a varredura, silencia o buzzer e libera os canais DMA.
+ *
+ * @param sweep Varredura em execução (ou já encerrada).
+ */
+void BuzzerPi_sweep_stop(BuzzerSweep_t *sweep) {
+    if (sweep->dma_top < 0) {
+        return;
+    }
+
+    // Sem cadência os canais de dados não avançam e, portanto, não disparam o reinício
+    pwm_set_enabled(sweep->pacer_slice, false);
+
+    // Desfaz o encadeamento antes de abortar, para que nenhum canal seja redisparado
+    uint dreq = pwm_get_dreq(sweep->pacer_slice);
+    dma_channel_config c = sweep_data_config(sweep->dma_top, dreq, sweep->dma_top);
+    dma_channel_set_config(sweep->dma_top, &c, false);
+    c = sweep_data_config(sweep->dma_cc, dreq, sweep->dma_cc);
+    dma_channel_set_config(sweep->dma_cc, &c, false);
+
+    sweep_release_channels(sweep);
+    BuzzerPi_stop(sweep->buzzer);
+}
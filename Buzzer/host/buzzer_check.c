@@ -0,0 +1,240 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "inc/BuzzerPi.h"
+#include "inc/melody.h"
+
+/******************************
+ * Documentação do Programa
+ ******************************/
+
+/**
+ * @file buzzer_check.c
+ * @brief Confere a lista de notas gravada por `buzzer_render` contra a partitura do cenário.
+ *
+ * Lê o JSON de um cenário de melodia (`pirates`, `imperial`, `elise` ou `mario`), do `beep` ou de
+ * uma varredura (`laser` ou `siren`) e monta as notas esperadas a partir dos vetores de `melody.h`
+ * (ou dos parâmetros dos cenários em `buzzer_render.c`; cada passo de varredura é uma nota de
+ * `step_us`, com a frequência da curva): pausas viram intervalos e notas iguais em sequência se
+ * juntam, pois o PWM volta no mesmo instante em que foi desligado e não há silêncio entre elas.
+ * Cada nota gravada deve ter o pino do buzzer, a altura (dentro de MAX_PITCH_ERROR, que absorve o
+ * arredondamento do wrap), o início relativo à primeira nota e a duração (dentro de
+ * MAX_TIME_ERROR_US) e duty cycle de 50%. Retorna 1 se alguma nota divergir ou faltar.
+ *
+ * Uso: buzzer_check <notas.json>
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define MAX_NOTES 1024
+
+// Maior erro aceito de altura (fração da frequência; um semitom é ~6%)
+#define MAX_PITCH_ERROR 0.005
+
+// Maior erro aceito de início e duração, em microssegundos
+#define MAX_TIME_ERROR_US 1.0
+
+// Parâmetros de `scenario_beep` em buzzer_render.c
+#define BEEP_FREQ_HZ 1000
+#define BEEP_DURATION_MS 100
+#define BEEP_REPETITIONS 3
+#define BEEP_GAP_MS 500 // Intervalo fixo de `beep`
+
+// Parâmetros de `scenario_laser` (rampa única) e `scenario_siren` (rampa contínua)
+#define LASER_F_START_HZ 2000
+#define LASER_F_END_HZ 200
+#define LASER_DURATION_MS 300
+#define SIREN_F_START_HZ 600
+#define SIREN_F_END_HZ 1200
+#define SIREN_DURATION_MS 500
+#define SIREN_PLAY_MS 3000 // Tempo até `BuzzerPi_sweep_stop`
+
+/**
+ * @brief Número de notas de uma melodia declarada em `melody.h`.
+ */
+#define count_of_melody(melody) ((int)(sizeof(melody) / sizeof((melody)[0])))
+
+/**
+ * @brief Um trecho audível: da lista `notes` do JSON ou da partitura.
+ */
+typedef struct {
+    unsigned pin;
+    double start_us;
+    double duration_us;
+    double freq_hz;
+    double duty;
+} note_t;
+
+static note_t expected[MAX_NOTES], recorded[MAX_NOTES];
+
+/******************************
+ * Notas Esperadas
+ ******************************/
+
+/**
+ * @brief Acrescenta uma nota, juntando-a à anterior se tiver a mesma altura e começar onde ela termina.
+ */
+static void expect_note(int *count, double start_us, double duration_us, double freq_hz) {
+    note_t *last = *count ? &expected[*count - 1] : NULL;
+    if (last && last->freq_hz == freq_hz && last->start_us + last->duration_us == start_us) {
+        last->duration_us += duration_us;
+        return;
+    }
+    if (*count < MAX_NOTES) {
+        expected[(*count)++] = (note_t){BUZZER_PIN, start_us, duration_us, freq_hz, 0.5};
+    }
+}
+
+static int expect_melody(const int *melody, const int *durations, int length) {
+    int count = 0;
+    double t = 0.0;
+    for (int i = 0; i < length; i++) {
+        if (melody[i] != 0) {
+            expect_note(&count, t, durations[i] * 1000.0, melody[i]);
+        }
+        t += durations[i] * 1000.0;
+    }
+    return count;
+}
+
+static int expect_beep(void) {
+    int count = 0;
+    for (int i = 0; i < BEEP_REPETITIONS; i++) {
+        expect_note(&count, i * (BEEP_DURATION_MS + BEEP_GAP_MS) * 1000.0, BEEP_DURATION_MS * 1000.0, BEEP_FREQ_HZ);
+    }
+    return count;
+}
+
+/**
+ * @brief Passos de uma varredura tocada por `play_ms` (uma rampa inteira se `loop` for false).
+ *
+ * O número de passos e a duração de cada um seguem `BuzzerPi_sweep_build`; a frequência é a da
+ * curva ideal, e MAX_PITCH_ERROR absorve o arredondamento da biblioteca.
+ */
+static int expect_sweep(double f_start, double f_end, uint duration_ms, bool exponential, bool loop, uint play_ms) {
+    uint steps = (uint)((uint64_t)duration_ms * BUZZER_SWEEP_STEP_HZ / 1000);
+    if (steps > BUZZER_SWEEP_MAX_STEPS) {
+        steps = BUZZER_SWEEP_MAX_STEPS;
+    }
+    double step_us = (double)((uint64_t)duration_ms * 1000 / steps);
+    uint total = loop ? (uint)(play_ms * 1000.0 / step_us) : steps;
+    int count = 0;
+    for (uint i = 0; i < total; i++) {
+        double k = (double)(i % steps) / (steps - 1);
+        double freq = exponential ? f_start * pow(f_end / f_start, k) : f_start + (f_end - f_start) * k;
+        expect_note(&count, i * step_us, step_us, freq);
+    }
+    return count;
+}
+
+/**
+ * @brief Monta as notas esperadas de um cenário; devolve -1 se o cenário não tiver partitura.
+ */
+static int expect_scenario(const char *scenario) {
+    if (strcmp(scenario, "pirates") == 0) {
+        return expect_melody(PiratesCaribeanMelody, PiratesCaribeanDurations, count_of_melody(PiratesCaribeanMelody));
+    }
+    if (strcmp(scenario, "imperial") == 0) {
+        return expect_melody(MarchImperialMelody, MarchImperialDurations, count_of_melody(MarchImperialMelody));
+    }
+    if (strcmp(scenario, "elise") == 0) {
+        return expect_melody(ForEliseMelody, ForEliseDurations, count_of_melody(ForEliseMelody));
+    }
+    if (strcmp(scenario, "mario") == 0) {
+        return expect_melody(Mariomelody, MarionoteDurations, count_of_melody(Mariomelody));
+    }
+    if (strcmp(scenario, "beep") == 0) {
+        return expect_beep();
+    }
+    if (strcmp(scenario, "laser") == 0) {
+        return expect_sweep(LASER_F_START_HZ, LASER_F_END_HZ, LASER_DURATION_MS, true, false, 0);
+    }
+    if (strcmp(scenario, "siren") == 0) {
+        return expect_sweep(SIREN_F_START_HZ, SIREN_F_END_HZ, SIREN_DURATION_MS, false, true, SIREN_PLAY_MS);
+    }
+    return -1;
+}
+
+/******************************
+ * Leitura do JSON
+ ******************************/
+
+/**
+ * @brief Lê o nome do cenário e a lista `notes` (uma nota por linha, como `buzzer_render` grava).
+ * @return Número de notas, ou -1 se o arquivo não puder ser lido.
+ */
+static int read_notes(const char *path, char *scenario, size_t scenario_size) {
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        perror(path);
+        return -1;
+    }
+    char line[512];
+    int count = 0;
+    bool in_notes = false;
+    scenario[0] = '\0';
+    while (fgets(line, sizeof(line), f)) {
+        char name[64];
+        if (sscanf(line, " \"scenario\": \"%63[^\"]\"", name) == 1) {
+            snprintf(scenario, scenario_size, "%s", name);
+        } else if (strstr(line, "\"notes\": [")) {
+            in_notes = true;
+        } else if (in_notes && count < MAX_NOTES) {
+            note_t *n = &recorded[count];
+            if (sscanf(line, " {\"pin\": %u, \"start_us\": %lf, \"duration_us\": %lf, \"freq_hz\": %lf, \"duty\": %lf}",
+                       &n->pin, &n->start_us, &n->duration_us, &n->freq_hz, &n->duty) == 5) {
+                count++;
+            }
+        }
+    }
+    fclose(f);
+    return count;
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(int argc, char **argv) {
+    if (argc != 2) {
+        fprintf(stderr, "Uso: buzzer_check <notas.json>\n");
+        return 2;
+    }
+    char scenario[64];
+    int got = read_notes(argv[1], scenario, sizeof(scenario));
+    if (got < 0) {
+        return 1;
+    }
+    int want = expect_scenario(scenario);
+    if (want < 0) {
+        fprintf(stderr, "%s: cenário \"%s\" sem partitura para conferir\n", argv[1], scenario);
+        return 2;
+    }
+
+    // Os tempos são comparados a partir do início da primeira nota
+    double offset = (got && want) ? recorded[0].start_us - expected[0].start_us : 0.0;
+    int failures = 0;
+    for (int i = 0; i < got && i < want; i++) {
+        const note_t *r = &recorded[i], *e = &expected[i];
+        bool ok = r->pin == e->pin && fabs(r->freq_hz - e->freq_hz) <= e->freq_hz * MAX_PITCH_ERROR &&
+                  fabs(r->start_us - offset - e->start_us) <= MAX_TIME_ERROR_US &&
+                  fabs(r->duration_us - e->duration_us) <= MAX_TIME_ERROR_US && fabs(r->duty - e->duty) < 0.01;
+        if (!ok) {
+            printf("ERRO: nota %d: esperado pino %u, %.0f Hz em %.0f us por %.0f us; gravado pino %u, %.2f Hz em "
+                   "%.3f us por %.3f us (duty %.3f)\n",
+                   i, e->pin, e->freq_hz, e->start_us, e->duration_us, r->pin, r->freq_hz, r->start_us - offset,
+                   r->duration_us, r->duty);
+            failures++;
+        }
+    }
+    if (got != want) {
+        printf("ERRO: %d notas gravadas, %d esperadas\n", got, want);
+        failures++;
+    }
+
+    printf("%s: %d notas conferidas, %s\n", scenario, got < want ? got : want, failures ? "com divergências" : "ok");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,386 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "fake_pico.h"
+#include "hardware/clocks.h"
+#include "inc/BuzzerPi.h"
+#include "inc/melody.h"
+
+/******************************
+ * Documentação do Programa
+ ******************************/
+
+/**
+ * @file buzzer_render.c
+ * @brief Renderizador da BuzzerPi para Linux (WAV + log de eventos em JSON)
+ *
+ * Executa um cenário da biblioteca `BuzzerPi` sobre a camada falsa de PWM (`fake/fake_pico.c`),
+ * em tempo virtual, e exporta:
+ * 1. Um arquivo WAV com um canal por pino configurado como PWM, sintetizado a partir dos valores
+ *    de wrap, divisor de clock, nível e habilitação de cada slice.
+ * 2. Um arquivo JSON com a linha do tempo de eventos de registrador e a lista de notas
+ *    (início, duração, frequência e duty cycle de cada trecho audível).
+ *
+ * O JSON permite verificar, em qualquer máquina Linux, a altura, a duração e o intervalo entre
+ * as notas de `play_melody`, `beep` e das demais funções.
+ *
+ * Uso: buzzer_render <cenario> <saida.wav> <saida.json> [taxa_de_amostragem]
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define DEFAULT_SAMPLE_RATE 44100
+#define MAX_SAMPLE_RATE 384000
+#define MAX_PINS 8
+#define AMPLITUDE 12000.0
+
+/**
+ * @brief Número de notas de uma melodia declarada em `melody.h`.
+ */
+#define count_of_melody(melody) ((int)(sizeof(melody) / sizeof((melody)[0])))
+
+/******************************
+ * Cenários
+ ******************************/
+
+static BuzzerSweep_t sweep; // Estática: a tabela ocupa alguns kilobytes
+
+static void scenario_melody(int *melody, int *durations, int length) {
+    initialize_pwm(BUZZER_PIN);
+    play_melody(BUZZER_PIN, melody, durations, CLK_DIV_DEFAULT, length);
+}
+
+static void scenario_pirates(void) {
+    scenario_melody(PiratesCaribeanMelody, PiratesCaribeanDurations, count_of_melody(PiratesCaribeanMelody));
+}
+
+static void scenario_imperial(void) {
+    scenario_melody(MarchImperialMelody, MarchImperialDurations, count_of_melody(MarchImperialMelody));
+}
+
+static void scenario_elise(void) {
+    scenario_melody(ForEliseMelody, ForEliseDurations, count_of_melody(ForEliseMelody));
+}
+
+static void scenario_mario(void) {
+    scenario_melody(Mariomelody, MarionoteDurations, count_of_melody(Mariomelody));
+}
+
+static void scenario_beep(void) {
+    initialize_pwm(BUZZER_PIN);
+    beep(BUZZER_PIN, 1000, 100, 3);
+}
+
+static void scenario_dtmf(void) {
+    BuzzerPi_t low, high;
+    BuzzerPi_init(&low, BUZZER_PIN, CLK_DIV_DEFAULT);
+    BuzzerPi_init(&high, BUZZER_PIN_2, CLK_DIV_DEFAULT);
+    for (const char *key = "5551234"; *key != '\0'; key++) {
+        BuzzerPi_play_dtmf(&low, &high, *key, 120);
+        sleep_ms(80);
+    }
+}
+
+static void scenario_laser(void) {
+    BuzzerPi_t buzzer;
+    BuzzerPi_init(&buzzer, BUZZER_PIN, CLK_DIV_DEFAULT);
+    BuzzerPi_sweep_build(&sweep, &buzzer, 2000, 200, 300, BUZZER_SWEEP_EXPONENTIAL);
+    BuzzerPi_sweep_start(&sweep, false);
+    while (BuzzerPi_sweep_busy(&sweep)) {
+        tight_loop_contents();
+    }
+    BuzzerPi_sweep_stop(&sweep);
+}
+
+static void scenario_siren(void) {
+    BuzzerPi_t buzzer;
+    BuzzerPi_init(&buzzer, BUZZER_PIN, CLK_DIV_DEFAULT);
+    BuzzerPi_sweep_build(&sweep, &buzzer, 600, 1200, 500, BUZZER_SWEEP_LINEAR);
+    BuzzerPi_sweep_start(&sweep, true);
+    sleep_ms(3000);
+    BuzzerPi_sweep_stop(&sweep);
+}
+
+typedef struct {
+    const char *name;
+    void (*run)(void);
+} scenario_t;
+
+static const scenario_t scenarios[] = {
+    {"pirates", scenario_pirates},
+    {"imperial", scenario_imperial},
+    {"elise", scenario_elise},
+    {"mario", scenario_mario},
+    {"beep", scenario_beep},
+    {"dtmf", scenario_dtmf},
+    {"laser", scenario_laser},
+    {"siren", scenario_siren},
+};
+
+/******************************
+ * Estado dos slices durante a renderização
+ ******************************/
+
+typedef struct {
+    uint32_t top;
+    uint32_t div;
+    uint32_t level[2];
+    bool enabled;
+} slice_state_t;
+
+static slice_state_t slices[NUM_PWM_SLICES];
+static uint pins[MAX_PINS];
+static uint pin_count;
+
+static void state_reset(void) {
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        slices[s] = (slice_state_t){0xffff, 16, {0, 0}, false};
+    }
+}
+
+static void state_apply(const fake_event_t *e) {
+    slice_state_t *s = &slices[e->slice];
+    switch (e->kind) {
+        case FAKE_EVT_WRAP:    s->top = e->value; break;
+        case FAKE_EVT_CLKDIV:  s->div = e->value ? e->value : 16; break;
+        case FAKE_EVT_LEVEL_A: s->level[0] = e->value; break;
+        case FAKE_EVT_LEVEL_B: s->level[1] = e->value; break;
+        case FAKE_EVT_ENABLE:  s->enabled = e->value; break;
+        default: break;
+    }
+}
+
+/**
+ * @brief Frequência e duty cycle atuais de um pino (frequência 0 = silêncio).
+ */
+static void pin_output(uint pin, double *freq, double *duty) {
+    const slice_state_t *s = &slices[(pin >> 1) & 7];
+    uint32_t level = s->level[pin & 1];
+    double period = (double)(s->top + 1);
+    if (!s->enabled || level == 0 || level > s->top) {
+        *freq = 0.0; // Parado, nível 0 ou saída constante em nível alto: sem som
+        *duty = 0.0;
+        return;
+    }
+    *freq = (double)FAKE_SYS_CLOCK_HZ * 16.0 / ((double)s->div * period);
+    *duty = (double)level / period;
+}
+
+static void collect_pins(const fake_event_t *events, size_t count) {
+    pin_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (events[i].kind != FAKE_EVT_PIN_PWM) {
+            continue;
+        }
+        bool known = false;
+        for (uint p = 0; p < pin_count; p++) {
+            known |= pins[p] == events[i].value;
+        }
+        if (!known && pin_count < MAX_PINS) {
+            pins[pin_count++] = events[i].value;
+        }
+    }
+}
+
+/******************************
+ * Saída WAV
+ ******************************/
+
+static void write_u32(FILE *f, uint32_t v) {
+    uint8_t b[4] = {v & 0xff, (v >> 8) & 0xff, (v >> 16) & 0xff, (v >> 24) & 0xff};
+    fwrite(b, 1, 4, f);
+}
+
+static void write_u16(FILE *f, uint16_t v) {
+    uint8_t b[2] = {v & 0xff, (v >> 8) & 0xff};
+    fwrite(b, 1, 2, f);
+}
+
+static bool write_wav(const char *path, const fake_event_t *events, size_t count, uint64_t end_ns, uint32_t rate) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        return false;
+    }
+    uint channels = pin_count ? pin_count : 1;
+    uint64_t samples = end_ns * rate / 1000000000ull;
+    uint32_t data_bytes = (uint32_t)(samples * channels * 2);
+
+    fwrite("RIFF", 1, 4, f);
+    write_u32(f, 36 + data_bytes);
+    fwrite("WAVEfmt ", 1, 8, f);
+    write_u32(f, 16);
+    write_u16(f, 1); // PCM
+    write_u16(f, channels);
+    write_u32(f, rate);
+    write_u32(f, rate * channels * 2);
+    write_u16(f, channels * 2);
+    write_u16(f, 16);
+    fwrite("data", 1, 4, f);
+    write_u32(f, data_bytes);
+
+    double phase[NUM_PWM_SLICES] = {0};
+    size_t next = 0;
+    state_reset();
+    for (uint64_t n = 0; n < samples; n++) {
+        uint64_t t = n * 1000000000ull / rate;
+        while (next < count && events[next].t_ns <= t) {
+            state_apply(&events[next++]);
+        }
+        // Os dois canais de um slice compartilham o contador: a fase avança uma vez por slice
+        double step[NUM_PWM_SLICES] = {0};
+        for (uint c = 0; c < channels; c++) {
+            double freq = 0.0, duty = 0.0;
+            int16_t sample = 0;
+            if (pin_count) {
+                uint s = (pins[c] >> 1) & 7;
+                pin_output(pins[c], &freq, &duty);
+                if (freq > 0.0) {
+                    double high = (phase[s] - floor(phase[s])) < duty ? 1.0 : 0.0;
+                    sample = (int16_t)(AMPLITUDE * (high - duty)); // Remove o nível DC, como o transdutor
+                    step[s] = freq / rate;
+                }
+            }
+            write_u16(f, (uint16_t)sample);
+        }
+        for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+            phase[s] += step[s];
+        }
+    }
+    fclose(f);
+    return true;
+}
+
+/******************************
+ * Saída JSON
+ ******************************/
+
+static const char *event_name(uint8_t kind) {
+    switch (kind) {
+        case FAKE_EVT_WRAP:    return "wrap";
+        case FAKE_EVT_CLKDIV:  return "clkdiv";
+        case FAKE_EVT_LEVEL_A: return "level_a";
+        case FAKE_EVT_LEVEL_B: return "level_b";
+        case FAKE_EVT_ENABLE:  return "enable";
+        case FAKE_EVT_PIN_PWM: return "pin_pwm";
+        default:               return "?";
+    }
+}
+
+static bool write_json(const char *path, const char *scenario, const fake_event_t *events, size_t count, uint64_t end_ns, uint32_t rate) {
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        return false;
+    }
+    fprintf(f, "{\n  \"scenario\": \"%s\",\n  \"sys_clock_hz\": %u,\n  \"sample_rate\": %u,\n", scenario, FAKE_SYS_CLOCK_HZ, rate);
+    fprintf(f, "  \"duration_us\": %.3f,\n  \"pins\": [", end_ns / 1000.0);
+    for (uint p = 0; p < pin_count; p++) {
+        fprintf(f, "%s%u", p ? ", " : "", pins[p]);
+    }
+    fprintf(f, "],\n  \"events\": [\n");
+    for (size_t i = 0; i < count; i++) {
+        fprintf(f, "    {\"t_us\": %.3f, \"slice\": %u, \"type\": \"%s\", \"value\": %u}%s\n",
+                events[i].t_ns / 1000.0, events[i].slice, event_name(events[i].kind), events[i].value,
+                i + 1 < count ? "," : "");
+    }
+    fprintf(f, "  ],\n  \"notes\": [\n");
+
+    // Trechos audíveis de cada pino: fecham quando frequência, duty ou habilitação mudam
+    double open_freq[MAX_PINS] = {0}, open_duty[MAX_PINS] = {0};
+    uint64_t open_start[MAX_PINS] = {0};
+    bool first = true;
+    state_reset();
+    for (size_t i = 0; i <= count; i++) {
+        uint64_t t = (i < count) ? events[i].t_ns : end_ns;
+        if (i < count && i + 1 < count && events[i + 1].t_ns == t) {
+            state_apply(&events[i]);
+            continue; // Agrupa eventos simultâneos
+        }
+        if (i < count) {
+            state_apply(&events[i]);
+        }
+        for (uint p = 0; p < pin_count; p++) {
+            double freq, duty;
+            pin_output(pins[p], &freq, &duty);
+            if (i == count) {
+                freq = 0.0; // Fecha tudo no fim da gravação
+            }
+            if (freq == open_freq[p] && duty == open_duty[p]) {
+                continue;
+            }
+            if (open_freq[p] > 0.0 && t > open_start[p]) {
+                fprintf(f, "%s    {\"pin\": %u, \"start_us\": %.3f, \"duration_us\": %.3f, \"freq_hz\": %.2f, \"duty\": %.3f}",
+                        first ? "" : ",\n", pins[p], open_start[p] / 1000.0, (t - open_start[p]) / 1000.0,
+                        open_freq[p], open_duty[p]);
+                first = false;
+            }
+            open_freq[p] = freq;
+            open_duty[p] = duty;
+            open_start[p] = t;
+        }
+    }
+    fprintf(f, "%s  ]\n}\n", first ? "" : "\n");
+    fclose(f);
+    return true;
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+static void usage(void) {
+    fprintf(stderr, "Uso: buzzer_render <cenario> <saida.wav> <saida.json> [taxa_de_amostragem]\nCenários:");
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        fprintf(stderr, " %s", scenarios[i].name);
+    }
+    fprintf(stderr, "\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        usage();
+        return 2;
+    }
+    const scenario_t *scenario = NULL;
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (strcmp(argv[1], scenarios[i].name) == 0) {
+            scenario = &scenarios[i];
+        }
+    }
+    if (scenario == NULL) {
+        usage();
+        return 2;
+    }
+    uint32_t rate = DEFAULT_SAMPLE_RATE;
+    if (argc > 4) {
+        char *end;
+        unsigned long value = strtoul(argv[4], &end, 10);
+        if (end == argv[4] || *end != '\0' || value == 0 || value > MAX_SAMPLE_RATE) {
+            fprintf(stderr, "Taxa de amostragem inválida: %s (1 a %u Hz)\n", argv[4], MAX_SAMPLE_RATE);
+            return 2;
+        }
+        rate = (uint32_t)value;
+    }
+
+    fake_pico_reset();
+    scenario->run();
+    sleep_ms(100); // Silêncio final, para que o último evento apareça no áudio
+
+    size_t count;
+    const fake_event_t *events = fake_pico_events(&count);
+    uint64_t end_ns = fake_pico_now_ns();
+    collect_pins(events, count);
+
+    if (!write_wav(argv[2], events, count, end_ns, rate)) {
+        fprintf(stderr, "Erro ao gravar %s\n", argv[2]);
+        return 1;
+    }
+    if (!write_json(argv[3], scenario->name, events, count, end_ns, rate)) {
+        fprintf(stderr, "Erro ao gravar %s\n", argv[3]);
+        return 1;
+    }
+    printf("%s: %zu eventos, %.3f s, %u canal(is)\n", scenario->name, count, end_ns / 1e9, pin_count);
+    return 0;
+}
@@ -0,0 +1,461 @@
+#include "fake_pico.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file fake_pico.c
+ * @brief Implementação da camada falsa de PWM/clock/DMA usada pelo renderizador da BuzzerPi.
+ *
+ * O registro de eventos é feito por comparação de estado (`fake_sync`): a biblioteca pode tanto
+ * chamar a API do SDK quanto escrever diretamente em `pwm_hw`, como fazem as varreduras.
+ */
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+static pwm_hw_t fake_pwm;
+pwm_hw_t *const pwm_hw = &fake_pwm;
+
+static dma_hw_t fake_dma;
+dma_hw_t *const dma_hw = &fake_dma;
+
+/**
+ * @brief Estado de um canal DMA simulado.
+ *
+ * Os endereços são guardados com a largura de ponteiro do host; os registradores de `dma_hw`
+ * servem apenas para que os aliases de disparo tenham endereços reais.
+ */
+typedef struct {
+    bool claimed;
+    bool busy;
+    dma_channel_config config;
+    uintptr_t read_addr;
+    uintptr_t write_addr;
+    uint32_t count;        // Transferências restantes
+    uint32_t reload_count; // Valor recarregado a cada disparo
+} fake_dma_channel_t;
+
+static fake_dma_channel_t channels[NUM_DMA_CHANNELS];
+
+static uint64_t now_ns;                         // Relógio virtual
+static uint64_t next_wrap_ns[NUM_PWM_SLICES];   // Próximo wrap de cada slice habilitado
+static pwm_hw_t snapshot;                       // Estado na última sincronização
+
+static fake_event_t *events;
+static size_t event_count;
+static size_t event_capacity;
+
+/******************************
+ * Linha do tempo
+ ******************************/
+
+/**
+ * @brief Acrescenta um evento à linha do tempo.
+ */
+static void fake_record(uint8_t kind, uint8_t slice, uint32_t value) {
+    if (event_count == event_capacity) {
+        event_capacity = event_capacity ? event_capacity * 2 : 256;
+        events = realloc(events, event_capacity * sizeof(fake_event_t));
+        if (events == NULL) {
+            fprintf(stderr, "fake_pico: sem memória para a linha do tempo\n");
+            exit(1);
+        }
+    }
+    events[event_count++] = (fake_event_t){now_ns, kind, slice, value};
+}
+
+/**
+ * @brief Período de wrap de um slice em nanossegundos.
+ */
+static uint64_t fake_wrap_period_ns(uint slice) {
+    uint64_t div = fake_pwm.slice[slice].div ? fake_pwm.slice[slice].div : 16;
+    uint64_t top = (fake_pwm.slice[slice].top & 0xffff) + 1;
+    uint64_t period = div * top * 1000000000ull / (16ull * FAKE_SYS_CLOCK_HZ);
+    return period ? period : 1;
+}
+
+/**
+ * @brief Compara os registradores com a última sincronização e registra as diferenças.
+ */
+static void fake_sync(void) {
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        const pwm_slice_hw_t *cur = &fake_pwm.slice[s];
+        pwm_slice_hw_t *old = &snapshot.slice[s];
+
+        if (cur->top != old->top) {
+            fake_record(FAKE_EVT_WRAP, s, cur->top & 0xffff);
+        }
+        if (cur->div != old->div) {
+            fake_record(FAKE_EVT_CLKDIV, s, cur->div);
+        }
+        if ((cur->cc & 0xffff) != (old->cc & 0xffff)) {
+            fake_record(FAKE_EVT_LEVEL_A, s, cur->cc & 0xffff);
+        }
+        if ((cur->cc >> 16) != (old->cc >> 16)) {
+            fake_record(FAKE_EVT_LEVEL_B, s, cur->cc >> 16);
+        }
+
+        bool was_enabled = snapshot.en & (1u << s);
+        bool enabled = fake_pwm.en & (1u << s);
+        if (enabled != was_enabled) {
+            fake_record(FAKE_EVT_ENABLE, s, enabled);
+            if (enabled) {
+                next_wrap_ns[s] = now_ns + fake_wrap_period_ns(s);
+            }
+        }
+    }
+    snapshot = fake_pwm;
+}
+
+void fake_pico_reset(void) {
+    memset(&fake_pwm, 0, sizeof(fake_pwm));
+    memset(&fake_dma, 0, sizeof(fake_dma));
+    memset(channels, 0, sizeof(channels));
+    memset(&snapshot, 0, sizeof(snapshot));
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        fake_pwm.slice[s].div = 1 << PWM_CH0_DIV_INT_LSB;
+        fake_pwm.slice[s].top = 0xffff;
+    }
+    snapshot = fake_pwm;
+    now_ns = 0;
+    event_count = 0;
+}
+
+uint64_t fake_pico_now_ns(void) {
+    return now_ns;
+}
+
+const fake_event_t *fake_pico_events(size_t *count) {
+    *count = event_count;
+    return events;
+}
+
+/******************************
+ * DMA simulado
+ ******************************/
+
+static void fake_dma_trigger(uint channel, int depth);
+
+/**
+ * @brief Executa uma transferência de um canal.
+ *
+ * Escritas no alias `READ_ADDR_TRIG` de outro canal copiam um ponteiro inteiro do host e
+ * disparam o canal de destino, como no hardware.
+ */
+static void fake_dma_transfer(uint channel, int depth) {
+    fake_dma_channel_t *ch = &channels[channel];
+    uint size = 1u << ch->config.size;
+
+    bool retrigger = false;
+    uint target = 0;
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (ch->write_addr == (uintptr_t)&fake_dma.ch[i].al3_read_addr_trig) {
+            memcpy(&channels[i].read_addr, (const void *)ch->read_addr, sizeof(uintptr_t));
+            retrigger = true;
+            target = i;
+        }
+    }
+    if (!retrigger) {
+        memcpy((void *)ch->write_addr, (const void *)ch->read_addr, size);
+    }
+
+    if (ch->config.read_increment) {
+        ch->read_addr += size;
+    }
+    if (ch->config.write_increment) {
+        ch->write_addr += size;
+    }
+    if (--ch->count == 0) {
+        ch->busy = false;
+        if (ch->config.chain_to != channel) {
+            fake_dma_trigger(ch->config.chain_to, depth + 1);
+        }
+    }
+    if (retrigger) {
+        fake_dma_trigger(target, depth + 1);
+    }
+}
+
+/**
+ * @brief Dispara um canal; canais sem cadência executam todas as transferências na hora.
+ */
+static void fake_dma_trigger(uint channel, int depth) {
+    fake_dma_channel_t *ch = &channels[channel];
+    if (depth > 64) {
+        fprintf(stderr, "fake_pico: encadeamento de DMA sem fim (canal %u)\n", channel);
+        exit(1);
+    }
+    ch->count = ch->reload_count;
+    ch->busy = ch->count > 0;
+    while (ch->busy && ch->config.dreq == DREQ_FORCE) {
+        fake_dma_transfer(channel, depth);
+    }
+}
+
+/**
+ * @brief Atende o wrap de um slice: uma transferência para cada canal cadenciado por ele.
+ */
+static void fake_dma_service_wrap(uint slice) {
+    // Os canais atendidos são escolhidos antes, para que um canal redisparado no meio do
+    // atendimento não receba duas transferências no mesmo wrap
+    uint32_t pending = 0;
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (channels[i].busy && channels[i].config.dreq == DREQ_PWM_WRAP0 + slice) {
+            pending |= 1u << i;
+        }
+    }
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if ((pending & (1u << i)) && channels[i].busy) {
+            fake_dma_transfer(i, 0);
+        }
+    }
+}
+
+/**
+ * @brief Indica se algum canal ativo está cadenciado pelo slice.
+ */
+static bool fake_dma_waits_on(uint slice) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (channels[i].busy && channels[i].config.dreq == DREQ_PWM_WRAP0 + slice) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void fake_pico_advance_ns(uint64_t ns) {
+    uint64_t end = now_ns + ns;
+    while (true) {
+        // Próximo wrap de um slice habilitado que cadencia algum canal DMA
+        int next = -1;
+        for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+            if ((fake_pwm.en & (1u << s)) && fake_dma_waits_on(s) &&
+                (next < 0 || next_wrap_ns[s] < next_wrap_ns[next])) {
+                next = s;
+            }
+        }
+        if (next < 0 || next_wrap_ns[next] > end) {
+            break;
+        }
+        now_ns = next_wrap_ns[next];
+        next_wrap_ns[next] += fake_wrap_period_ns(next);
+        fake_dma_service_wrap(next);
+        fake_sync();
+    }
+    now_ns = end;
+    fake_sync();
+}
+
+int dma_claim_unused_channel(bool required) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!channels[i].claimed) {
+            channels[i].claimed = true;
+            return i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "fake_pico: nenhum canal DMA livre\n");
+        exit(1);
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    return (dma_channel_config){DMA_SIZE_32, true, false, DREQ_FORCE, channel};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) {
+    c->size = size;
+}
+
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) {
+    c->read_increment = incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) {
+    c->write_increment = incr;
+}
+
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) {
+    c->dreq = dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) {
+    c->chain_to = chain_to;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    fake_dma_channel_t *ch = &channels[channel];
+    ch->config = *config;
+    ch->write_addr = (uintptr_t)write_addr;
+    ch->read_addr = (uintptr_t)read_addr;
+    ch->reload_count = transfer_count;
+    if (trigger) {
+        fake_dma_trigger(channel, 0);
+        fake_sync();
+    }
+}
+
+void dma_channel_set_config(uint channel, const dma_channel_config *config, bool trigger) {
+    channels[channel].config = *config;
+    if (trigger) {
+        fake_dma_trigger(channel, 0);
+        fake_sync();
+    }
+}
+
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) {
+    // Como no hardware, a escrita muda só o valor recarregado; a transferência em curso segue
+    channels[channel].reload_count = trans_count;
+    if (trigger) {
+        fake_dma_trigger(channel, 0);
+        fake_sync();
+    }
+}
+
+void dma_start_channel_mask(uint32_t chan_mask) {
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (chan_mask & (1u << i)) {
+            fake_dma_trigger(i, 0);
+        }
+    }
+    fake_sync();
+}
+
+void dma_channel_abort(uint channel) {
+    channels[channel].busy = false;
+    channels[channel].count = 0;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    return channels[channel].busy;
+}
+
+/******************************
+ * PWM simulado
+ ******************************/
+
+uint pwm_gpio_to_slice_num(uint gpio) {
+    return (gpio >> 1u) & 7u;
+}
+
+uint pwm_gpio_to_channel(uint gpio) {
+    return gpio & 1u;
+}
+
+void pwm_set_wrap(uint slice_num, uint16_t wrap) {
+    fake_pwm.slice[slice_num].top = wrap;
+    fake_sync();
+}
+
+void pwm_set_clkdiv(uint slice_num, float divider) {
+    fake_pwm.slice[slice_num].div = (uint32_t)(divider * (1 << PWM_CH0_DIV_INT_LSB));
+    fake_sync();
+}
+
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level) {
+    uint shift = chan ? PWM_CH0_CC_B_LSB : PWM_CH0_CC_A_LSB;
+    uint32_t cc = fake_pwm.slice[slice_num].cc & ~(0xffffu << shift);
+    fake_pwm.slice[slice_num].cc = cc | ((uint32_t)level << shift);
+    fake_sync();
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+    pwm_set_chan_level(pwm_gpio_to_slice_num(gpio), pwm_gpio_to_channel(gpio), level);
+}
+
+void pwm_set_counter(uint slice_num, uint16_t c) {
+    fake_pwm.slice[slice_num].ctr = c;
+}
+
+void pwm_set_enabled(uint slice_num, bool enabled) {
+    if (enabled) {
+        fake_pwm.en |= 1u << slice_num;
+        fake_pwm.slice[slice_num].csr |= PWM_CH0_CSR_EN_BITS;
+    } else {
+        fake_pwm.en &= ~(1u << slice_num);
+        fake_pwm.slice[slice_num].csr &= ~PWM_CH0_CSR_EN_BITS;
+    }
+    fake_sync();
+}
+
+void pwm_set_mask_enabled(uint32_t mask) {
+    fake_pwm.en = mask & 0xff;
+    for (uint s = 0; s < NUM_PWM_SLICES; s++) {
+        if (mask & (1u << s)) {
+            fake_pwm.slice[s].csr |= PWM_CH0_CSR_EN_BITS;
+        } else {
+            fake_pwm.slice[s].csr &= ~PWM_CH0_CSR_EN_BITS;
+        }
+    }
+    fake_sync();
+}
+
+uint pwm_get_dreq(uint slice_num) {
+    return DREQ_PWM_WRAP0 + slice_num;
+}
+
+/******************************
+ * Clock, GPIO, tempo e sincronização
+ ******************************/
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    (void)clk_index;
+    return FAKE_SYS_CLOCK_HZ;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    if (fn == GPIO_FUNC_PWM) {
+        fake_record(FAKE_EVT_PIN_PWM, pwm_gpio_to_slice_num(gpio), gpio);
+    }
+}
+
+void sleep_ms(uint32_t ms) {
+    fake_pico_advance_ns((uint64_t)ms * 1000000ull);
+}
+
+void sleep_us(uint64_t us) {
+    fake_pico_advance_ns(us * 1000ull);
+}
+
+uint64_t time_us_64(void) {
+    return now_ns / 1000ull;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return now_ns / 1000ull;
+}
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+    return (int64_t)(to - from);
+}
+
+void tight_loop_contents(void) {
+    fake_pico_advance_ns(1000);
+}
+
+void stdio_init_all(void) {
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void)status;
+}
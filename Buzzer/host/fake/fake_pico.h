@@ -0,0 +1,75 @@
+#ifndef FAKE_PICO_H
+#define FAKE_PICO_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file fake_pico.h
+ * @brief Camada falsa de PWM/clock/DMA para executar a BuzzerPi no Linux.
+ *
+ * A camada mantém registradores PWM e canais DMA simulados e um relógio virtual. Depois de cada
+ * chamada da API (e a cada passo de DMA), o estado dos registradores é comparado com o anterior e
+ * cada alteração de wrap, divisor de clock, nível ou habilitação vira um evento com o instante
+ * virtual em que ocorreu. A linha do tempo resultante é usada pelo renderizador (`buzzer_render`).
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Tipos de evento registrados na linha do tempo.
+ */
+typedef enum {
+    FAKE_EVT_WRAP,     // Novo valor de TOP
+    FAKE_EVT_CLKDIV,   // Novo divisor de clock (formato 8.4)
+    FAKE_EVT_LEVEL_A,  // Novo nível do canal A
+    FAKE_EVT_LEVEL_B,  // Novo nível do canal B
+    FAKE_EVT_ENABLE,   // Slice habilitado (1) ou desabilitado (0)
+    FAKE_EVT_PIN_PWM   // Pino configurado como saída PWM (valor = número do pino)
+} fake_event_kind_t;
+
+/**
+ * @brief Evento da linha do tempo.
+ */
+typedef struct {
+    uint64_t t_ns;     // Instante virtual em nanossegundos
+    uint8_t kind;      // Tipo do evento (fake_event_kind_t)
+    uint8_t slice;     // Slice PWM afetado
+    uint32_t value;    // Novo valor
+} fake_event_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Zera o relógio virtual, os registradores simulados e a linha do tempo.
+ */
+void fake_pico_reset(void);
+
+/**
+ * @brief Retorna o instante virtual atual em nanossegundos.
+ */
+uint64_t fake_pico_now_ns(void);
+
+/**
+ * @brief Avança o relógio virtual, executando as transferências DMA cadenciadas no caminho.
+ *
+ * @param ns Intervalo em nanossegundos.
+ */
+void fake_pico_advance_ns(uint64_t ns);
+
+/**
+ * @brief Retorna a linha do tempo registrada.
+ *
+ * @param count Recebe o número de eventos.
+ * @return Ponteiro para o primeiro evento (válido até o próximo evento ou `fake_pico_reset`).
+ */
+const fake_event_t *fake_pico_events(size_t *count);
+
+#endif // FAKE_PICO_H
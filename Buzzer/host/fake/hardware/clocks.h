@@ -0,0 +1,22 @@
+#ifndef FAKE_HARDWARE_CLOCKS_H
+#define FAKE_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @brief Frequência do clock de sistema simulado (padrão do RP2040).
+ */
+#define FAKE_SYS_CLOCK_HZ 125000000u
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+};
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#endif // FAKE_HARDWARE_CLOCKS_H
@@ -0,0 +1,55 @@
+#ifndef FAKE_HARDWARE_PWM_H
+#define FAKE_HARDWARE_PWM_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file pwm.h
+ * @brief Registradores PWM simulados.
+ *
+ * O layout dos registradores segue o RP2040 (CSR, DIV, CTR, CC, TOP por slice e o alias EN),
+ * de forma que o código da biblioteca que escreve diretamente em `pwm_hw` funciona sem alterações.
+ * A divisão de clock usa o formato 8.4 do hardware.
+ */
+
+#define NUM_PWM_SLICES 8
+
+#define PWM_CH0_CSR_EN_BITS 0x00000001u
+#define PWM_CH0_CC_A_LSB 0
+#define PWM_CH0_CC_B_LSB 16
+#define PWM_CH0_DIV_INT_LSB 4
+
+#define DREQ_PWM_WRAP0 24
+
+enum pwm_chan {
+    PWM_CHAN_A = 0,
+    PWM_CHAN_B = 1,
+};
+
+typedef struct {
+    volatile uint32_t csr;
+    volatile uint32_t div;
+    volatile uint32_t ctr;
+    volatile uint32_t cc;
+    volatile uint32_t top;
+} pwm_slice_hw_t;
+
+typedef struct {
+    pwm_slice_hw_t slice[NUM_PWM_SLICES];
+    volatile uint32_t en;
+} pwm_hw_t;
+
+extern pwm_hw_t *const pwm_hw;
+
+uint pwm_gpio_to_slice_num(uint gpio);
+uint pwm_gpio_to_channel(uint gpio);
+void pwm_set_wrap(uint slice_num, uint16_t wrap);
+void pwm_set_clkdiv(uint slice_num, float divider);
+void pwm_set_chan_level(uint slice_num, uint chan, uint16_t level);
+void pwm_set_gpio_level(uint gpio, uint16_t level);
+void pwm_set_counter(uint slice_num, uint16_t c);
+void pwm_set_enabled(uint slice_num, bool enabled);
+void pwm_set_mask_enabled(uint32_t mask);
+uint pwm_get_dreq(uint slice_num);
+
+#endif // FAKE_HARDWARE_PWM_H
@@ -0,0 +1,10 @@
+#ifndef FAKE_HARDWARE_SYNC_H
+#define FAKE_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// No host não há interrupções: as seções críticas não fazem nada.
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+#endif // FAKE_HARDWARE_SYNC_H
@@ -0,0 +1,39 @@
+#ifndef FAKE_PICO_STDLIB_H
+#define FAKE_PICO_STDLIB_H
+
+/**
+ * @file stdlib.h
+ * @brief Substituto de `pico/stdlib.h` para a compilação da BuzzerPi no Linux.
+ *
+ * Declara apenas o que a BuzzerPi usa. O tempo é virtual: `sleep_ms` e `sleep_us` apenas avançam
+ * o relógio da camada falsa (`fake_pico.c`), que registra cada alteração dos registradores PWM.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+enum gpio_function {
+    GPIO_FUNC_SIO = 5,
+    GPIO_FUNC_PWM = 4,
+};
+
+void gpio_set_function(uint gpio, enum gpio_function fn);
+
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+uint64_t time_us_64(void);
+absolute_time_t get_absolute_time(void);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+
+/**
+ * @brief Em laços de espera ativa, avança o relógio virtual em 1 µs.
+ */
+void tight_loop_contents(void);
+
+void stdio_init_all(void);
+
+#endif // FAKE_PICO_STDLIB_H
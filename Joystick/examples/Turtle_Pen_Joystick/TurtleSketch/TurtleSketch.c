@@ -32,6 +32,11 @@
  */
 #define MATRIX_SIZE 10
 
+/**
+ * @brief Passos da tartaruga por segundo, na cadência do fluxo de amostras do joystick.
+ */
+#define TURTLE_STEP_HZ 10
+
 /******************************
  * Variáveis Globais
  ******************************/
@@ -117,13 +122,13 @@ void print_matrix() {
 }
 
 /**
- * @brief Move a tartaruga na matriz com base no estado do joystick.
- * @param state Estado atual do joystick (valores de X, Y e botão).
+ * @brief Move a tartaruga na matriz com base numa amostra do joystick.
+ * @param sample Amostra do fluxo do joystick (eixos X e Y e botão).
  */
-void move_turtle(joystick_state_t state) {
+void move_turtle(const joystick_sample_t *sample) {
     // Mapeia os valores do joystick para movimentos na matriz
-    int16_t x_mapped = joystickPi_map_value(state.x, 0, 4095, -2, 2);
-    int16_t y_mapped = joystickPi_map_value(state.y, 4095, 0, -1, 2);
+    int16_t x_mapped = joystickPi_map_value(sample->x_hires >> 4, 0, 4095, -2, 2);
+    int16_t y_mapped = joystickPi_map_value(sample->y_hires >> 4, 4095, 0, -1, 2);
 
     // Atualiza a posição da tartaruga
     turtle_x += x_mapped;
@@ -154,29 +159,40 @@ int main() {
 
     joystickPi_init(); // Inicializa o joystick
 
-    initialize_matrix(); // Inicializa a matriz com espaços em branco
+    // Amostragem contínua a 1 kHz com o filtro adaptativo, para a tartaruga não tremer parada
+    joystick_filter_params_t filter;
+    joystickPi_filter_defaults(&filter);
+    joystickPi_engine_start(1000);
+    joystickPi_engine_set_filter(&filter);
+
+    // Um passo da tartaruga por amostra do fluxo, em vez de ler e esperar com sleep_ms
+    joystickPi_stream_start(TURTLE_STEP_HZ);
 
-    // Loop principal do programa
-    while (1) {
-        // Lê o estado atual do joystick
-        joystick_state_t state = joystickPi_read();
+    initialize_matrix(); // Inicializa a matriz com espaços em branco
 
-        // Move a tartaruga com base no estado do joystick
-        move_turtle(state);
+    // Loop principal do programa, na cadência do fluxo
+    bool last_button = false;
+    joystick_sample_t sample;
+    while (joystickPi_stream_wait(&sample)) {
+        // Move a tartaruga com base na amostra do joystick
+        move_turtle(&sample);
 
-        // Verifica se o botão do joystick foi pressionado para alternar o estado da caneta
-        if (state.button) {
+        // Alterna a caneta só na borda de pressionamento, sem travar o laço esperando soltar
+        if (sample.button && !last_button) {
             pen_down = !pen_down;
-            // Aguarda o botão ser solto para evitar múltiplas alternâncias
-            while (joystickPi_read_button()) {}
         }
+        last_button = sample.button;
 
         // Limpa a tela e exibe a matriz atualizada
         printf("\033[H\033[J"); // Códigos ANSI para limpar a tela
         print_matrix();
 
-        // Pequena pausa para evitar atualizações excessivas
-        sleep_ms(100);
+        // Regularidade do fluxo medida contra o relógio: atraso da amostra mais nova, temporizador e perdas
+        joystick_stream_stats_t stats;
+        joystickPi_stream_get_stats(&stats);
+        printf("Amostragem: %.1f Hz, relogio %ld..%ld us (temporizador %lu us), perdidas %lu\n", stats.rate_hz,
+               (long)stats.clock_error_min_us, (long)stats.clock_error_max_us, (unsigned long)stats.tick_jitter_us,
+               (unsigned long)stats.dropped);
     }
 
     return 0;
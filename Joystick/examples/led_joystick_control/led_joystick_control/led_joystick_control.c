@@ -3,49 +3,75 @@
 #include "inc/JoystickPi.h"
 
 
-#define LED_PIN 12  
+#define LED_PIN 12
+
+// Taxa fixa do laço principal, ditada pelo fluxo de amostras do joystick
+#define SAMPLE_RATE_HZ 100
+
+// Amostras entre duas mensagens no terminal (100 ms)
+#define PRINT_EVERY 10
 
 int main() {
-    stdio_init_all();  
+    stdio_init_all();
 
     // Inicializa o joystick e o LED
     joystickPi_init();
+
+    // Amostragem contínua a 1 kHz com o filtro adaptativo: leituras estáveis no centro,
+    // sem o atraso de uma média longa quando o joystick é movido
+    joystick_filter_params_t filter;
+    joystickPi_filter_defaults(&filter);
+    joystickPi_engine_start(1000);
+    joystickPi_engine_set_filter(&filter);
+
+    // Fluxo de taxa fixa: cada amostra traz o instante da conversão, em vez de um sleep_ms
+    joystickPi_stream_start(SAMPLE_RATE_HZ);
     gpio_init(LED_PIN);
     gpio_set_dir(LED_PIN, GPIO_OUT);
 
-    bool led_state = false;  
+    bool led_state = false;
+    bool last_button = false;
+    uint count = 0;
 
-    while (true) 
+    joystick_sample_t sample;
+    while (joystickPi_stream_wait(&sample))
     {
-      
-        joystick_state_t state = joystickPi_read();
+        int16_t x_mapped = joystickPi_map_value(sample.x_hires, 0, 0xFFFF, -100, 100);
 
-        
-        int16_t x_mapped = joystickPi_map_value(state.x, 0, 4095, -100, 100);
 
-      
-        if (x_mapped > 50) 
+        if (x_mapped > 50)
         {
-            gpio_put(LED_PIN, 1); 
+            gpio_put(LED_PIN, 1);
             led_state = true;
-        } else if (x_mapped < -50) 
+        } else if (x_mapped < -50)
         {
-            gpio_put(LED_PIN, 0);  
+            gpio_put(LED_PIN, 0);
             led_state = false;
         }
 
-        
-        if (state.button) 
+        // Alterna o LED na borda de pressionamento (sem pausa, para não atrasar o fluxo)
+        if (sample.button && !last_button)
         {
-            led_state = !led_state;  
+            led_state = !led_state;
             gpio_put(LED_PIN, led_state);
-            sleep_ms(300);  
         }
+        last_button = sample.button;
 
-       
-        printf("X: %d, Button: %d, LED: %d\n", x_mapped, state.button, led_state);
+        if (++count % PRINT_EVERY == 0)
+        {
+            printf("t: %llu us, X: %d, Button: %d, LED: %d\n", (unsigned long long)sample.t_us, x_mapped,
+                   sample.button, led_state);
+        }
 
-        sleep_ms(100);  // Aguarda 100ms antes de ler novamente
+        // A cada segundo, medidos contra o relógio: temporizador, atraso do processamento e perdas
+        if (count % SAMPLE_RATE_HZ == 0)
+        {
+            joystick_stream_stats_t stats;
+            joystickPi_stream_get_stats(&stats);
+            printf("Fluxo %.2f Hz: temporizador %lu us, relogio %ld..%ld us, perdidas %lu\n",
+                   stats.rate_hz, (unsigned long)stats.tick_jitter_us,
+                   (long)stats.clock_error_min_us, (long)stats.clock_error_max_us, (unsigned long)stats.dropped);
+        }
     }
 
     return 0;
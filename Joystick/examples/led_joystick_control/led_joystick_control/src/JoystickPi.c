@@ -1,4 +1,8 @@
 #include "inc/JoystickPi.h"
+#include "hardware/clocks.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 
 /******************************
  * Documentação do Arquivo
@@ -18,81 +22,1021 @@
  * 2. Leitura dos valores dos eixos X e Y (valores brutos do ADC).
  * 3. Leitura do estado do botão (pressionado ou não pressionado).
  * 4. Mapeamento dos valores do ADC para uma faixa personalizada (útil para normalização).
+ * 5. Motor de amostragem em segundo plano com ADC round-robin, FIFO e DMA.
+ * 6. Sobreamostragem e decimação por CIC sobre as amostras capturadas pelo DMA.
+ * 7. Calibração persistida na flash e normalização em ponto fixo.
+ * 8. Zona morta radial e curva de resposta por tabela de ganho.
+ * 9. Filtro adaptativo One-Euro em ponto fixo sobre o fluxo de amostras.
+ * 10. Instâncias `JoystickPi_t` registradas num escalonador único do ADC (o motor de amostragem).
+ * 11. Fluxo de amostras de taxa fixa com instante calculado pela cadência do ADC e estatísticas de tempo medidas.
+ * 12. Compensação de temperatura e alimentação, com a deriva ajustada por mínimos quadrados.
  */
 
+/******************************
+ * Filtro Adaptativo (One-Euro)
+ ******************************/
+
+/**
+ * @brief Coeficiente de um passa-baixas de 1ª ordem: alpha = w / (1 + w), com w = 2π·fc/fs (Q16).
+ */
+static uint16_t euro_alpha(float cutoff_hz, uint32_t rate_hz) {
+    float w = 2.0f * 3.14159265f * cutoff_hz / (float)rate_hz;
+    float alpha = w / (1.0f + w) * 65536.0f + 0.5f;
+    return (uint16_t)(alpha > 65535.0f ? 65535.0f : alpha);
+}
+
+/******************************
+ * Motor de Amostragem (DMA)
+ ******************************/
+
+/**
+ * @brief Estado interno do motor de amostragem.
+ */
+typedef struct {
+    volatile bool running;
+    uint dma_data;              // Canal que drena a FIFO do ADC para o buffer
+    uint dma_ctrl;              // Canal que rearma `dma_data` ao fim de cada metade do buffer
+    uint channel_mask;          // Canais do ADC no round-robin
+    uint channel_count;         // Quantidade de canais no round-robin
+    uint first_channel;         // Canal convertido na posição 0 do buffer
+    uint extra_mask;            // Canais acrescentados por `joystickPi_engine_add_channel`
+    JoystickPi_t *sticks[JOYSTICK_MAX_INSTANCES]; // Joysticks registrados
+    uint stick_count;
+    uint32_t half_len;          // Amostras em cada metade do buffer (múltiplo de channel_count)
+    uint32_t ring_len;          // Amostras no buffer inteiro (duas metades)
+    volatile uint32_t halves;   // Metades completas desde o início
+    volatile uint32_t overruns; // Transbordamentos da FIFO detectados
+    uint64_t start_us;          // Instante em que o ADC começou a converter
+    uint32_t requested_rate_hz;
+    float achieved_rate_hz;
+    uint64_t group_period_q24;  // Duração de uma passada do round-robin, em µs (Q24)
+    uint64_t group_count;       // Passadas consumidas pelo temporizador desde start_us
+
+    uint decim_factor;          // Fator de decimação (1 = desligado)
+    uint decim_order;           // Ordem do CIC (1 = boxcar, 2)
+    int decim_shift;            // Deslocamento para a escala de 16 bits (positivo = à direita)
+    uint decim_phase;           // Grupos acumulados desde a última saída
+    volatile uint32_t decimated; // Saídas decimadas produzidas
+
+    bool filter_enabled;        // Filtro adaptativo ligado
+    joystick_filter_params_t filter_params; // Parâmetros do filtro, reaproveitados pelo fluxo
+    joystick_euro_t euro;       // Coeficientes do filtro na taxa de processamento
+
+    repeating_timer_t timer;    // Temporizador que consome o buffer a JOYSTICK_ENGINE_PROCESS_HZ
+    uint32_t cursor;            // Próximo grupo do buffer a ser processado
+} joystick_engine_t;
+
+static joystick_engine_t engine = { .decim_factor = 1, .decim_order = 1 };
+
+/**
+ * @brief Entrada da fila do fluxo, gravada pelo temporizador de processamento.
+ */
+typedef struct {
+    uint64_t t_us;
+    uint16_t x_hires;   // Canal do ADC, sem troca nem inversão (aplicadas na leitura)
+    uint16_t y_hires;
+    bool button;
+} joystick_stream_entry_t;
+
+/**
+ * @brief Estado interno do fluxo de amostras de taxa fixa.
+ */
+typedef struct {
+    JoystickPi_t *stick;        // Joystick do fluxo (NULL = desligado)
+    uint32_t requested_rate_hz;
+    uint32_t groups_per_sample; // Passadas do round-robin promediadas em cada amostra
+    uint64_t period_q24;        // Período das amostras em µs (Q24)
+    uint32_t phase;             // Passadas acumuladas na amostra em formação
+    uint32_t sum_x, sum_y;
+    bool filter_enabled;
+    joystick_euro_t euro;       // Coeficientes do filtro na taxa do fluxo
+    joystick_euro_axis_t euro_x;
+    joystick_euro_axis_t euro_y;
+
+    joystick_stream_entry_t queue[JOYSTICK_STREAM_QUEUE_SIZE];
+    volatile uint32_t head;     // Escrito só pelo temporizador
+    volatile uint32_t tail;     // Escrito só por quem lê
+
+    // Estatísticas
+    uint64_t last_t_us;         // Instante da última amostra produzida (0 = nenhuma)
+    uint64_t last_tick_us;      // Instante do último passo do temporizador (0 = nenhum)
+    uint32_t delivered;
+    uint32_t dropped;
+    int32_t clock_error_min_us;
+    int32_t clock_error_max_us;
+    uint32_t tick_jitter_us;
+} joystick_stream_t;
+
+static joystick_stream_t stream = { .clock_error_min_us = INT32_MAX, .clock_error_max_us = INT32_MIN };
+
+/**
+ * @brief Sensores da compensação, comuns a todos os joysticks.
+ */
+typedef struct {
+    bool enabled;
+    uint ref_channel;           // Canal de referência, ou JOYSTICK_COMP_NO_REF
+    uint temp_slot;             // Posição do sensor de temperatura dentro de cada grupo do round-robin
+    uint ref_slot;              // Posição do canal de referência dentro de cada grupo
+    volatile uint32_t temp_q8;  // Temperatura filtrada, escala de 16 bits em Q8
+    volatile uint32_t ref_q8;   // Referência filtrada, escala de 16 bits em Q8
+    volatile bool ready;        // Já houve ao menos uma leitura dos sensores
+} joystick_comp_sensors_t;
+
+static joystick_comp_sensors_t comp_sensors = { .ref_channel = JOYSTICK_COMP_NO_REF };
+
+// Buffer circular preenchido pelo DMA, em duas metades rearmadas alternadamente
+static uint16_t engine_ring[JOYSTICK_ENGINE_RING_SAMPLES];
+
+// Endereços de início de cada metade, lidos alternadamente pelo canal de rearme (anel de 8 bytes)
+static uint16_t *engine_half_addr[2] __attribute__((aligned(8)));
+
+/**
+ * @brief Posição no buffer da próxima amostra a ser gravada pelo DMA (0 a ring_len).
+ */
+static inline uint32_t engine_written() {
+    return (uint16_t *)(uintptr_t)dma_hw->ch[engine.dma_data].write_addr - engine_ring;
+}
+
+/**
+ * @brief (Re)inicia a conversão a partir do primeiro canal, com o DMA no início do buffer.
+ * 
+ * Mantém a correspondência entre posição no buffer e canal do ADC, que se perde quando
+ * a FIFO transborda e uma amostra é descartada pelo hardware.
+ */
+static void engine_restart_conversion() {
+    adc_run(false);
+    while (!(adc_hw->cs & ADC_CS_READY_BITS)) {
+        tight_loop_contents();
+    }
+
+    dma_channel_abort(engine.dma_data);
+    adc_fifo_drain();
+    hw_set_bits(&adc_hw->fcs, ADC_FCS_OVER_BITS | ADC_FCS_UNDER_BITS);
+    engine.halves = 0;
+    engine.cursor = 0;
+    engine.group_count = 0;
+
+    // A amostra do fluxo em formação misturaria passadas de antes e depois da lacuna
+    stream.phase = 0;
+    stream.sum_x = 0;
+    stream.sum_y = 0;
+
+    // O próximo rearme deve apontar para a segunda metade
+    dma_channel_set_read_addr(engine.dma_ctrl, &engine_half_addr[1], false);
+    dma_channel_set_write_addr(engine.dma_data, engine_ring, false);
+    dma_channel_set_trans_count(engine.dma_data, engine.half_len, true);
+
+    adc_select_input(engine.first_channel);
+
+    // Referência dos instantes do fluxo: a partir daqui as conversões seguem o divisor do ADC
+    engine.start_us = time_us_64();
+    adc_run(true);
+}
+
+/**
+ * @brief Passa o último integrador pelos pentes e devolve a saída do CIC.
+ */
+static inline uint32_t cic_output(joystick_cic_t *cic) {
+    uint32_t value = cic->integ[engine.decim_order - 1];
+    for (uint k = 0; k < engine.decim_order; k++) {
+        uint32_t diff = value - cic->comb[k];
+        cic->comb[k] = value;
+        value = diff;
+    }
+    return value;
+}
+
+/**
+ * @brief Converte a saída do CIC para a escala de 16 bits.
+ */
+static inline uint32_t cic_scale(uint32_t value) {
+    return engine.decim_shift >= 0 ? value >> engine.decim_shift : value << -engine.decim_shift;
+}
+
+/**
+ * @brief Acumula um grupo do round-robin nos CICs de todos os joysticks e, a cada
+ * `decim_factor` grupos, produz uma saída decimada de cada um.
+ */
+static inline void engine_decimate(const uint16_t *group) {
+    for (uint i = 0; i < engine.stick_count; i++) {
+        JoystickPi_t *js = engine.sticks[i];
+        js->cic_x.integ[0] += group[js->x_slot];
+        js->cic_y.integ[0] += group[js->y_slot];
+        if (engine.decim_order == 2) {
+            js->cic_x.integ[1] += js->cic_x.integ[0];
+            js->cic_y.integ[1] += js->cic_y.integ[0];
+        }
+    }
+
+    if (++engine.decim_phase < engine.decim_factor) {
+        return;
+    }
+    engine.decim_phase = 0;
+
+    for (uint i = 0; i < engine.stick_count; i++) {
+        JoystickPi_t *js = engine.sticks[i];
+        uint32_t out_x = cic_scale(cic_output(&js->cic_x));
+        uint32_t out_y = cic_scale(cic_output(&js->cic_y));
+        js->decim_xy = (out_x > 0xFFFF ? 0xFFFF : out_x) | ((out_y > 0xFFFF ? 0xFFFF : out_y) << 16);
+    }
+    engine.decimated++;
+}
+
+/**
+ * @brief Tratador da IRQ de DMA: conta metades e ressincroniza após transbordamento.
+ */
+static void engine_dma_irq_handler() {
+    uint32_t bit = 1u << engine.dma_data;
+    if (!(dma_hw->ints1 & bit)) {
+        return; // IRQ de outro canal que compartilha a linha
+    }
+    dma_hw->ints1 = bit;
+
+    if (adc_hw->fcs & ADC_FCS_OVER_BITS) {
+        engine.overruns++;
+        engine_restart_conversion();
+        return;
+    }
+    engine.halves++;
+}
+
+/**
+ * @brief Índice do grupo completo mais recente no buffer.
+ * 
+ * A amostra mais recente é ignorada, pois pode ainda estar em trânsito no barramento.
+ */
+static int32_t engine_latest_group() {
+    int32_t groups = engine.ring_len / engine.channel_count;
+    int32_t safe = (int32_t)engine_written() - 1;
+    int32_t group = (safe > 0 ? safe / (int32_t)engine.channel_count : 0) - 1;
+    return group < 0 ? group + groups : group;
+}
+
+/**
+ * @brief Instante em que terminou a passada de índice `count - 1` desde o início da conversão.
+ *
+ * O ADC converte a intervalos exatos de (1 + div) ciclos de clk_adc, então o instante sai da
+ * contagem de passadas, sem a latência da interrupção que as processou.
+ */
+static inline uint64_t engine_group_time(uint64_t count) {
+    return engine.start_us + ((count * engine.group_period_q24) >> 24);
+}
+
+/**
+ * @brief Passa uma leitura dos sensores da compensação (escala de 16 bits) pelo passa-baixas.
+ */
+static void comp_filter(uint32_t temp, uint32_t ref) {
+    if (!comp_sensors.ready) {
+        comp_sensors.temp_q8 = temp << 8;
+        comp_sensors.ref_q8 = ref << 8;
+        comp_sensors.ready = true;
+        return;
+    }
+    comp_sensors.temp_q8 += ((int32_t)(temp << 8) - (int32_t)comp_sensors.temp_q8) >> JOYSTICK_COMP_FILTER_SHIFT;
+    comp_sensors.ref_q8 += ((int32_t)(ref << 8) - (int32_t)comp_sensors.ref_q8) >> JOYSTICK_COMP_FILTER_SHIFT;
+}
+
+/**
+ * @brief Coloca uma amostra na fila do fluxo, contabilizando lacunas.
+ *
+ * Os instantes saem da contagem de passadas, então o intervalo entre amostras consecutivas é o
+ * período por construção; só as lacunas (passadas perdidas num transbordamento) são contadas aqui.
+ * A regularidade real é medida contra o relógio no temporizador de processamento.
+ */
+static void stream_push(uint16_t x, uint16_t y, uint64_t t_us) {
+    if (stream.last_t_us) {
+        // Quantos períodos se passaram desde a amostra anterior (mais de um = amostras perdidas)
+        uint64_t dt_q24 = (t_us - stream.last_t_us) << 24;
+        uint32_t steps = (uint32_t)((dt_q24 + stream.period_q24 / 2) / stream.period_q24);
+        if (steps > 1) {
+            stream.dropped += steps - 1;
+        }
+    }
+    stream.last_t_us = t_us;
+
+    uint32_t head = stream.head;
+    if (head - stream.tail == JOYSTICK_STREAM_QUEUE_SIZE) {
+        stream.dropped++; // Fila cheia: quem lê está atrasado
+        return;
+    }
+    joystick_stream_entry_t *e = &stream.queue[head & (JOYSTICK_STREAM_QUEUE_SIZE - 1)];
+    e->t_us = t_us;
+    e->x_hires = x;
+    e->y_hires = y;
+    e->button = JoystickPi_read_button(stream.stick);
+    __dmb(); // A entrada precisa estar completa antes de ficar visível
+    stream.head = head + 1;
+    stream.delivered++;
+}
+
+/**
+ * @brief Acumula uma passada do round-robin na amostra em formação e a entrega ao completar o bloco.
+ */
+static inline void stream_accumulate(const uint16_t *group) {
+    stream.sum_x += group[stream.stick->x_slot];
+    stream.sum_y += group[stream.stick->y_slot];
+    if (++stream.phase < stream.groups_per_sample) {
+        return;
+    }
+
+    uint32_t n = stream.groups_per_sample;
+    uint16_t x = (uint16_t)(((uint64_t)stream.sum_x * 16) / n);
+    uint16_t y = (uint16_t)(((uint64_t)stream.sum_y * 16) / n);
+    stream.phase = 0;
+    stream.sum_x = 0;
+    stream.sum_y = 0;
+
+    if (stream.filter_enabled) {
+        x = joystickPi_euro_step(&stream.euro, &stream.euro_x, x);
+        y = joystickPi_euro_step(&stream.euro, &stream.euro_y, y);
+    }
+    // Esta passada é a de índice group_count: termina no instante de group_count + 1
+    stream_push(x, y, engine_group_time(engine.group_count + 1));
+}
+
+/**
+ * @brief Temporizador de processamento: consome os grupos novos do buffer.
+ * 
+ * Roda a JOYSTICK_ENGINE_PROCESS_HZ independentemente da taxa do ADC, então a latência
+ * da decimação e do filtro não depende do tamanho do buffer. O filtro adaptativo recebe a
+ * última saída decimada ou, sem decimação, a média dos pares chegados desde o último passo.
+ * Com o fluxo ativo, também forma as amostras de taxa fixa e mede o próprio atraso.
+ */
+static bool engine_timer_callback(repeating_timer_t *rt) {
+    (void)rt;
+    uint64_t now = time_us_64();
+    if (stream.stick && stream.last_tick_us) {
+        int64_t deviation = (int64_t)(now - stream.last_tick_us) - 1000000 / JOYSTICK_ENGINE_PROCESS_HZ;
+        stream.tick_jitter_us = MAX(stream.tick_jitter_us, (uint32_t)(deviation < 0 ? -deviation : deviation));
+    }
+    stream.last_tick_us = now;
+
+    int32_t groups = engine.ring_len / engine.channel_count;
+    int32_t pending = engine_latest_group() + 1 - (int32_t)engine.cursor;
+    if (pending < 0) {
+        pending += groups;
+    }
+
+    uint32_t sum_x[JOYSTICK_MAX_INSTANCES] = {0}, sum_y[JOYSTICK_MAX_INSTANCES] = {0};
+    uint32_t sum_temp = 0, sum_ref = 0;
+    for (int32_t i = 0; i < pending; i++) {
+        const uint16_t *g = &engine_ring[engine.cursor * engine.channel_count];
+        if (comp_sensors.enabled) {
+            sum_temp += g[comp_sensors.temp_slot];
+            sum_ref += g[comp_sensors.ref_slot];
+        }
+        if (engine.decim_factor > 1) {
+            engine_decimate(g);
+        }
+        for (uint k = 0; k < engine.stick_count; k++) {
+            sum_x[k] += g[engine.sticks[k]->x_slot];
+            sum_y[k] += g[engine.sticks[k]->y_slot];
+        }
+        if (stream.stick) {
+            stream_accumulate(g);
+        }
+        engine.group_count++;
+        if (++engine.cursor == (uint32_t)groups) {
+            engine.cursor = 0;
+        }
+    }
+
+    if (comp_sensors.enabled && pending > 0) {
+        comp_filter(sum_temp * 16 / pending, sum_ref * 16 / pending);
+    }
+
+    // Confere os instantes calculados contra o relógio: a passada mais nova acabou de terminar
+    if (stream.stick && pending > 0) {
+        int32_t error = (int32_t)((int64_t)now - (int64_t)engine_group_time(engine.group_count));
+        stream.clock_error_min_us = MIN(stream.clock_error_min_us, error);
+        stream.clock_error_max_us = MAX(stream.clock_error_max_us, error);
+    }
+
+    if (engine.decim_factor > 1 ? engine.decimated == 0 : !(engine.filter_enabled && pending > 0)) {
+        return true;
+    }
+
+    for (uint k = 0; k < engine.stick_count; k++) {
+        JoystickPi_t *js = engine.sticks[k];
+        uint32_t xy;
+        if (engine.decim_factor > 1) {
+            xy = js->decim_xy;
+        } else {
+            xy = (sum_x[k] * 16 / pending) | ((sum_y[k] * 16 / pending) << 16);
+        }
+
+        if (engine.filter_enabled) {
+            uint16_t fx = joystickPi_euro_step(&engine.euro, &js->euro_x, xy & 0xFFFF);
+            uint16_t fy = joystickPi_euro_step(&engine.euro, &js->euro_y, xy >> 16);
+            xy = fx | ((uint32_t)fy << 16);
+        }
+        js->hires_xy = xy;
+        js->hires_valid = true;
+    }
+    return true;
+}
+
+/**
+ * @brief Média das últimas `JOYSTICK_ENGINE_READ_AVERAGE` conversões de uma posição do grupo.
+ */
+static uint32_t engine_slot_sum(uint slot) {
+    int32_t groups = engine.ring_len / engine.channel_count;
+    int32_t group = engine_latest_group();
+    uint32_t sum = 0;
+    for (uint i = 0; i < JOYSTICK_ENGINE_READ_AVERAGE; i++) {
+        sum += engine_ring[group * engine.channel_count + slot];
+        group = (group == 0) ? groups - 1 : group - 1;
+    }
+    return sum;
+}
+
+/**
+ * @brief Preenche os eixos de `state` a partir do motor em tempo constante.
+ * 
+ * Usa a última saída do processamento (decimação e/ou filtro) quando há uma; caso
+ * contrário, a média dos últimos `JOYSTICK_ENGINE_READ_AVERAGE` grupos do buffer.
+ */
+static void engine_latest(const JoystickPi_t *js, joystick_state_t *state) {
+    if (js->hires_valid) {
+        uint32_t xy = js->hires_xy;
+        state->x_hires = xy & 0xFFFF;
+        state->y_hires = xy >> 16;
+        state->x = state->x_hires >> 4;
+        state->y = state->y_hires >> 4;
+        return;
+    }
+
+    uint32_t sum_x = engine_slot_sum(js->x_slot);
+    uint32_t sum_y = engine_slot_sum(js->y_slot);
+    state->x = (uint16_t)(sum_x / JOYSTICK_ENGINE_READ_AVERAGE);
+    state->y = (uint16_t)(sum_y / JOYSTICK_ENGINE_READ_AVERAGE);
+    state->x_hires = (uint16_t)(sum_x * 16 / JOYSTICK_ENGINE_READ_AVERAGE);
+    state->y_hires = (uint16_t)(sum_y * 16 / JOYSTICK_ENGINE_READ_AVERAGE);
+}
+
+/**
+ * @brief Limpa o estado de decimação e filtro de todos os joysticks registrados.
+ * 
+ * Deve ser chamada com as interrupções desativadas.
+ */
+static void engine_reset_processing() {
+    engine.decim_phase = 0;
+    engine.decimated = 0;
+    for (uint i = 0; i < engine.stick_count; i++) {
+        JoystickPi_t *js = engine.sticks[i];
+        js->cic_x = (joystick_cic_t){0};
+        js->cic_y = (joystick_cic_t){0};
+        js->euro_x = (joystick_euro_axis_t){0};
+        js->euro_y = (joystick_euro_axis_t){0};
+        js->hires_valid = false;
+    }
+}
+
+/**
+ * @brief Canais do round-robin: os eixos dos joysticks registrados e os canais extras.
+ */
+static uint engine_round_robin_mask() {
+    uint mask = engine.extra_mask;
+    for (uint i = 0; i < engine.stick_count; i++) {
+        mask |= (1u << engine.sticks[i]->x_channel) | (1u << engine.sticks[i]->y_channel);
+    }
+    return mask;
+}
+
+/**
+ * @brief Reinicia o motor na mesma taxa, para incluir canais novos no round-robin.
+ *
+ * Se os canais novos levarem a taxa total acima de JOYSTICK_ENGINE_ADC_MAX_SPS, a taxa por
+ * eixo é reduzida ao maior valor aceito.
+ */
+static void engine_reconfigure() {
+    if (engine.running) {
+        uint channels = MAX(__builtin_popcount(engine_round_robin_mask()), 1);
+        uint32_t rate_hz = MIN(engine.requested_rate_hz, JOYSTICK_ENGINE_ADC_MAX_SPS / channels);
+        joystickPi_engine_stop();
+        joystickPi_engine_start(rate_hz);
+    }
+}
+
+/**
+ * @brief (Re)configura o fluxo para a taxa atual do motor e esvazia a fila.
+ *
+ * O bloco de cada amostra tem um número inteiro de passadas, então a taxa efetiva é a do
+ * motor dividida por esse número, que pode diferir um pouco de `rate_hz`.
+ */
+static bool stream_configure(JoystickPi_t *js, uint32_t rate_hz) {
+    if (rate_hz == 0 || rate_hz > (uint32_t)(engine.achieved_rate_hz + 0.5f)) {
+        return false;
+    }
+    uint32_t n = MAX((uint32_t)(engine.achieved_rate_hz / rate_hz + 0.5f), 1u);
+
+    // Os coeficientes são calculados fora da seção crítica (única etapa com ponto flutuante)
+    joystick_euro_t euro;
+    bool filter = engine.filter_enabled;
+    if (filter) {
+        joystickPi_euro_init(&euro, &engine.filter_params, (uint32_t)(engine.achieved_rate_hz / n + 0.5f));
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    stream.stick = js;
+    stream.requested_rate_hz = rate_hz;
+    stream.groups_per_sample = n;
+    stream.period_q24 = n * engine.group_period_q24;
+    stream.phase = 0;
+    stream.sum_x = 0;
+    stream.sum_y = 0;
+    stream.filter_enabled = filter;
+    if (filter) {
+        stream.euro = euro;
+    }
+    stream.euro_x = (joystick_euro_axis_t){0};
+    stream.euro_y = (joystick_euro_axis_t){0};
+    stream.tail = stream.head;
+    stream.last_t_us = 0;
+    stream.last_tick_us = 0;
+    restore_interrupts(irq_state);
+    return true;
+}
+
+/******************************
+ * Calibração
+ ******************************/
+
+/**
+ * @brief Registro de calibração gravado na flash.
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    joystick_calibration_t cal;
+    joystick_comp_t comp;
+    uint32_t crc;       // CRC-32 de todos os campos anteriores
+} joystick_cal_record_t;
+
+// Joystick usado pelas funções `joystickPi_*` sem instância
+static JoystickPi_t joystick_default;
+
+// Páginas do setor de calibração ocupadas (uma por instância, na ordem de inicialização)
+static uint cal_slots_used;
+
+/**
+ * @brief Pré-calcula curso útil e escala Q15 de um eixo (única divisão da normalização).
+ */
+static void cal_prepare_axis(joystick_axis_cal_t *axis, uint16_t center, uint16_t min, uint16_t max, uint16_t dead) {
+    axis->center = center;
+    axis->dead = dead;
+    axis->span_pos = MAX((int32_t)max - center - dead, 1);
+    axis->span_neg = MAX((int32_t)center - min - dead, 1);
+    axis->scale_pos = ((int32_t)JOYSTICK_NORM_MAX << 15) / axis->span_pos;
+    axis->scale_neg = ((int32_t)JOYSTICK_NORM_MAX << 15) / axis->span_neg;
+}
+
+/**
+ * @brief Normaliza uma leitura de 16 bits para -JOYSTICK_NORM_MAX a JOYSTICK_NORM_MAX.
+ * 
+ * O deslocamento é limitado ao curso útil antes da multiplicação, então o produto nunca
+ * passa de JOYSTICK_NORM_MAX << 15 e cabe em 32 bits.
+ */
+static inline int16_t cal_normalize(const joystick_axis_cal_t *axis, uint16_t value) {
+    int32_t d = (int32_t)value - axis->center;
+    if (d > axis->dead) {
+        d = MIN(d - axis->dead, axis->span_pos);
+        return (int16_t)((d * axis->scale_pos) >> 15);
+    }
+    if (d < -axis->dead) {
+        d = MIN(-d - axis->dead, axis->span_neg);
+        return (int16_t)-((d * axis->scale_neg) >> 15);
+    }
+    return 0;
+}
+
+/**
+ * @brief CRC-32 (polinômio refletido 0xEDB88320) usado para validar o registro da flash.
+ */
+static uint32_t cal_crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Deslocamento térmico (escala de 16 bits) para uma inclinação em Q16 e uma diferença de temperatura.
+ */
+static inline int32_t comp_offset(int32_t slope, int32_t dt) {
+    return (int32_t)(((int64_t)slope * dt) >> 16);
+}
+
+/**
+ * @brief Converte os sensores da compensação de forma bloqueante (motor parado).
+ */
+static void comp_sample_blocking() {
+    adc_select_input(JOYSTICK_COMP_TEMP_CHANNEL);
+    uint32_t temp = adc_read() << 4;
+    uint32_t ref = 0;
+    if (comp_sensors.ref_channel != JOYSTICK_COMP_NO_REF) {
+        adc_select_input(comp_sensors.ref_channel);
+        ref = adc_read() << 4;
+    }
+    comp_filter(temp, ref);
+}
+
+/**
+ * @brief Leva uma leitura de volta às condições de referência do joystick.
+ *
+ * Se o joystick ainda não tem referências (nem calibração de centro nem registro da flash),
+ * as condições desta primeira leitura passam a ser as de referência.
+ */
+static void comp_apply(JoystickPi_t *js, joystick_state_t *state) {
+    uint16_t temp, ref;
+    if (!joystickPi_compensation_sensors(&temp, &ref)) {
+        return;
+    }
+    if (!js->comp.temp_ref) {
+        js->comp.temp_ref = temp;
+        js->comp.supply_ref = ref;
+    }
+
+    uint32_t x = state->x_hires, y = state->y_hires;
+    if (ref && js->comp.supply_ref) {
+        // Correção ratiométrica: 65535 * 65535 ainda cabe em 32 bits sem sinal
+        x = x * js->comp.supply_ref / ref;
+        y = y * js->comp.supply_ref / ref;
+    }
+    int32_t dt = (int32_t)temp - js->comp.temp_ref;
+    int32_t cx = (int32_t)x - comp_offset(js->comp.temp_slope_x, dt);
+    int32_t cy = (int32_t)y - comp_offset(js->comp.temp_slope_y, dt);
+    state->x_hires = (uint16_t)MAX(MIN(cx, 0xFFFF), 0);
+    state->y_hires = (uint16_t)MAX(MIN(cy, 0xFFFF), 0);
+    state->x = state->x_hires >> 4;
+    state->y = state->y_hires >> 4;
+}
+
+/**
+ * @brief Arredonda uma inclinação para Q16.
+ */
+static int32_t comp_slope_q16(double slope) {
+    double q = slope * 65536.0;
+    return (int32_t)(q >= 0 ? q + 0.5 : q - 0.5);
+}
+
+/**
+ * @brief Acrescenta um centro medido em repouso à regressão e reajusta a deriva térmica.
+ *
+ * A regressão modela o centro sem a correção térmica (que depende da própria inclinação).
+ * O centro acabou de ser aprendido na temperatura atual, então, ao trocar a inclinação, ele é
+ * deslocado junto com as leituras compensadas para continuar no repouso.
+ *
+ * @param js Joystick.
+ * @param cx Centro X compensado, na escala de 16 bits.
+ * @param cy Centro Y compensado, na escala de 16 bits.
+ */
+static void comp_fit_add(JoystickPi_t *js, uint16_t cx, uint16_t cy) {
+    uint16_t temp, ref;
+    if (!joystickPi_compensation_sensors(&temp, &ref) || !js->comp.temp_ref) {
+        return;
+    }
+    int32_t dt = (int32_t)temp - js->comp.temp_ref;
+    int32_t rx = cx + comp_offset(js->comp.temp_slope_x, dt);
+    int32_t ry = cy + comp_offset(js->comp.temp_slope_y, dt);
+
+    joystick_comp_fit_t *f = &js->comp_fit;
+    if (f->n == 0) {
+        f->t0 = temp;
+        f->x0 = rx;
+        f->y0 = ry;
+        f->t_min = 0;
+        f->t_max = 0;
+    } else if (f->n == JOYSTICK_COMP_MAX_POINTS) {
+        // Esquecimento: os pontos antigos passam a valer metade
+        f->st /= 2; f->stt /= 2; f->sx /= 2; f->sy /= 2; f->stx /= 2; f->sty /= 2;
+        f->n /= 2;
+    }
+    int32_t t = temp - f->t0, x = rx - f->x0, y = ry - f->y0;
+    f->st += t;
+    f->stt += (int64_t)t * t;
+    f->sx += x;
+    f->sy += y;
+    f->stx += (int64_t)t * x;
+    f->sty += (int64_t)t * y;
+    f->n++;
+    f->t_min = MIN(f->t_min, t);
+    f->t_max = MAX(f->t_max, t);
+    if (f->t_max - f->t_min < JOYSTICK_COMP_MIN_SPAN) {
+        return;
+    }
+
+    double n = f->n;
+    double den = n * (double)f->stt - (double)f->st * f->st;
+    if (den <= 0) {
+        return;
+    }
+    int32_t slope_x = comp_slope_q16((n * (double)f->stx - (double)f->st * f->sx) / den);
+    int32_t slope_y = comp_slope_q16((n * (double)f->sty - (double)f->st * f->sy) / den);
+
+    joystick_calibration_t *cal = &js->calibration;
+    int32_t center_x = cal->center_x + comp_offset(js->comp.temp_slope_x, dt) - comp_offset(slope_x, dt);
+    int32_t center_y = cal->center_y + comp_offset(js->comp.temp_slope_y, dt) - comp_offset(slope_y, dt);
+    cal->center_x = (uint16_t)MAX(MIN(center_x, cal->max_x - 1), cal->min_x + 1);
+    cal->center_y = (uint16_t)MAX(MIN(center_y, cal->max_y - 1), cal->min_y + 1);
+    js->comp.temp_slope_x = slope_x;
+    js->comp.temp_slope_y = slope_y;
+    JoystickPi_calibration_set(js, cal);
+}
+
+/**
+ * @brief Reinicia a janela de repouso da calibração automática a partir de uma leitura.
+ */
+static void cal_idle_reset(JoystickPi_t *js, uint16_t x, uint16_t y) {
+    js->cal_idle.ref_x = x;
+    js->cal_idle.ref_y = y;
+    js->cal_idle.sum_x = 0;
+    js->cal_idle.sum_y = 0;
+    js->cal_idle.count = 0;
+}
+
+/**
+ * @brief Aprende faixa (e, no modo automático, centro) a partir de uma leitura.
+ * 
+ * Os fatores de escala só são recalculados quando algum limite muda.
+ */
+static void cal_learn(JoystickPi_t *js, const joystick_state_t *state) {
+    joystick_calibration_t *cal = &js->calibration;
+    bool changed = false;
+
+    if (state->x_hires < cal->min_x) { cal->min_x = state->x_hires; changed = true; }
+    if (state->x_hires > cal->max_x) { cal->max_x = state->x_hires; changed = true; }
+    if (state->y_hires < cal->min_y) { cal->min_y = state->y_hires; changed = true; }
+    if (state->y_hires > cal->max_y) { cal->max_y = state->y_hires; changed = true; }
+
+    if (js->cal_auto) {
+        int32_t dx = (int32_t)state->x_hires - js->cal_idle.ref_x;
+        int32_t dy = (int32_t)state->y_hires - js->cal_idle.ref_y;
+        if (abs(dx) > cal->deadzone || abs(dy) > cal->deadzone) {
+            // Saiu da janela de repouso: recomeça a contagem a partir daqui
+            cal_idle_reset(js, state->x_hires, state->y_hires);
+        } else {
+            js->cal_idle.sum_x += state->x_hires;
+            js->cal_idle.sum_y += state->y_hires;
+            if (++js->cal_idle.count == JOYSTICK_CAL_IDLE_READS) {
+                uint16_t cx = js->cal_idle.sum_x / JOYSTICK_CAL_IDLE_READS;
+                uint16_t cy = js->cal_idle.sum_y / JOYSTICK_CAL_IDLE_READS;
+                if (abs((int32_t)cx - cal->center_x) <= JOYSTICK_CAL_MAX_DRIFT &&
+                    abs((int32_t)cy - cal->center_y) <= JOYSTICK_CAL_MAX_DRIFT) {
+                    cal->center_x = cx;
+                    cal->center_y = cy;
+                    changed = true;
+                    comp_fit_add(js, cx, cy);
+                }
+                cal_idle_reset(js, state->x_hires, state->y_hires);
+            }
+        }
+    }
+
+    if (changed) {
+        JoystickPi_calibration_set(js, cal);
+    }
+}
+
+/**
+ * @brief Aplica a troca e depois a inversão de eixos de um joystick.
+ */
+static void orient_axes(const JoystickPi_t *js, joystick_state_t *state) {
+    if (js->swap_xy) {
+        uint16_t t = state->x;
+        state->x = state->y;
+        state->y = t;
+        t = state->x_hires;
+        state->x_hires = state->y_hires;
+        state->y_hires = t;
+    }
+    if (js->invert_x) {
+        state->x = 4095 - state->x;
+        state->x_hires = 0xFFFF - state->x_hires;
+    }
+    if (js->invert_y) {
+        state->y = 4095 - state->y;
+        state->y_hires = 0xFFFF - state->y_hires;
+    }
+}
+
+/**
+ * @brief Lê os eixos (do motor ou por conversão bloqueante) sem aplicar a calibração.
+ *
+ * A troca e a inversão de eixos são aplicadas aqui, então a calibração e a curva de
+ * resposta já recebem os eixos na orientação final.
+ */
+static void read_axes(JoystickPi_t *js, joystick_state_t *state) {
+    if (engine.running && js->registered) {
+        // Pares já capturados pelo DMA, sem tocar no ADC
+        engine_latest(js, state);
+    } else {
+        if (comp_sensors.enabled) {
+            comp_sample_blocking();
+        }
+
+        // Lê o valor do eixo X
+        adc_select_input(js->x_channel);
+        state->x = adc_read(); // Lê o valor do ADC
+
+        // Lê o valor do eixo Y
+        adc_select_input(js->y_channel);
+        state->y = adc_read(); // Lê o valor do ADC
+
+        state->x_hires = state->x << 4;
+        state->y_hires = state->y << 4;
+    }
+    orient_axes(js, state);
+    comp_apply(js, state);
+}
+
 /******************************
  * Funções
  ******************************/
 
 /**
- * @brief Inicializa o joystick.
+ * @brief Preenche a configuração do joystick da BitDogLab.
  * 
- * Configura os pinos ADC para leitura dos eixos X e Y e o pino GPIO para leitura do botão.
- * Habilita o resistor de pull-up no pino do botão.
+ * @param config Configuração a ser preenchida.
  */
-void joystickPi_init() {
-    // Inicializa o ADC
+void JoystickPi_config_default(JoystickPi_config_t *config) {
+    config->x_pin = JOYSTICK_X_PIN;
+    config->y_pin = JOYSTICK_Y_PIN;
+    config->button_pin = JOYSTICK_BUTTON_PIN;
+    config->invert_x = false;
+    config->invert_y = false;
+    config->swap_xy = false;
+}
+
+/**
+ * @brief Inicializa um joystick e o registra no motor de amostragem.
+ * 
+ * @param js Instância a ser inicializada.
+ * @param config Pinos e orientação.
+ * @return false se algum pino não é analógico ou se já há JOYSTICK_MAX_INSTANCES registrados.
+ */
+bool JoystickPi_init(JoystickPi_t *js, const JoystickPi_config_t *config) {
+    uint x_channel = config->x_pin - JOYSTICK_ADC_FIRST_PIN;
+    uint y_channel = config->y_pin - JOYSTICK_ADC_FIRST_PIN;
+    if (config->x_pin < JOYSTICK_ADC_FIRST_PIN || x_channel > 3 ||
+        config->y_pin < JOYSTICK_ADC_FIRST_PIN || y_channel > 3) {
+        return false;
+    }
+    if (!js->registered && engine.stick_count == JOYSTICK_MAX_INSTANCES) {
+        return false;
+    }
+
+    js->x_pin = config->x_pin;
+    js->y_pin = config->y_pin;
+    js->button_pin = config->button_pin;
+    js->x_channel = x_channel;
+    js->y_channel = y_channel;
+    js->invert_x = config->invert_x;
+    js->invert_y = config->invert_y;
+    js->swap_xy = config->swap_xy;
+
+    // Inicializa o ADC e configura os pinos dos eixos como entradas analógicas
     adc_init();
+    adc_gpio_init(js->x_pin);
+    adc_gpio_init(js->y_pin);
 
-    // Configura os pinos do joystick como entradas analógicas
-    adc_gpio_init(JOYSTICK_X_PIN); // Configura o pino do eixo X (GP26)
-    adc_gpio_init(JOYSTICK_Y_PIN); // Configura o pino do eixo Y (GP27)
+    // Configura o pino do botão como entrada digital com pull-up
+    if (js->button_pin != JOYSTICK_NO_BUTTON) {
+        gpio_init(js->button_pin);
+        gpio_set_dir(js->button_pin, GPIO_IN);
+        gpio_pull_up(js->button_pin);
+    }
 
-    // Configura o pino do botão como entrada digital
-    gpio_init(JOYSTICK_BUTTON_PIN);
-    gpio_set_dir(JOYSTICK_BUTTON_PIN, GPIO_IN);
-    gpio_pull_up(JOYSTICK_BUTTON_PIN); // Habilita o resistor de pull-up
+    // Calibração nominal até que outra seja carregada ou aprendida
+    if (!js->cal_ready) {
+        joystick_calibration_t cal;
+        joystickPi_calibration_defaults(&cal);
+        JoystickPi_calibration_set(js, &cal);
+    }
+
+    if (!js->registered) {
+        js->cal_slot = cal_slots_used++;
+        uint32_t irq_state = save_and_disable_interrupts();
+        engine.sticks[engine.stick_count++] = js;
+        js->registered = true;
+        restore_interrupts(irq_state);
+    }
+    engine_reconfigure();
+    return true;
 }
 
 /**
- * @brief Lê o estado atual do joystick (eixos X e Y e botão).
+ * @brief Lê os valores atuais de um joystick.
  * 
- * @return Estrutura `joystick_state_t` contendo os valores dos eixos X e Y e o estado do botão.
+ * @param js Instância inicializada.
+ * @return Estado dos eixos e do botão.
  */
-joystick_state_t joystickPi_read() {
+joystick_state_t JoystickPi_read(JoystickPi_t *js) {
     joystick_state_t state;
+    read_axes(js, &state);
+
+    // Calibração: aprendizado opcional e normalização sem divisão
+    if (js->cal_auto || js->cal_range_capture) {
+        cal_learn(js, &state);
+    }
+    JoystickPi_normalize(js, &state);
 
-    // Lê o valor do eixo X
-    adc_select_input(0); // Seleciona o canal ADC0 (GP26)
-    state.x = adc_read(); // Lê o valor do ADC
+    state.button = JoystickPi_read_button(js);
+    return state;
+}
 
-    // Lê o valor do eixo Y
-    adc_select_input(1); // Seleciona o canal ADC1 (GP27)
-    state.y = adc_read(); // Lê o valor do ADC
+/**
+ * @brief Preenche `x_norm`/`y_norm` a partir de `x_hires`/`y_hires`, com a calibração e a curva.
+ *
+ * @param js Instância inicializada.
+ * @param state Estado com os eixos de 16 bits já preenchidos.
+ */
+void JoystickPi_normalize(JoystickPi_t *js, joystick_state_t *state) {
+    state->x_norm = cal_normalize(&js->cal_x, state->x_hires);
+    state->y_norm = cal_normalize(&js->cal_y, state->y_hires);
+    if (js->shape_curve) {
+        joystickPi_shape(js->shape_curve, &state->x_norm, &state->y_norm);
+    }
+}
 
-    // Lê o estado do botão
-    state.button = !gpio_get(JOYSTICK_BUTTON_PIN); // Inverte o valor porque o botão está em pull-up
+/**
+ * @brief Lê o eixo X de um joystick, com troca e inversão aplicadas.
+ */
+uint16_t JoystickPi_read_x(JoystickPi_t *js) {
+    joystick_state_t state;
+    read_axes(js, &state);
+    return state.x;
+}
 
-    return state;
+/**
+ * @brief Lê o eixo Y de um joystick, com troca e inversão aplicadas.
+ */
+uint16_t JoystickPi_read_y(JoystickPi_t *js) {
+    joystick_state_t state;
+    read_axes(js, &state);
+    return state.y;
+}
+
+/**
+ * @brief Lê o botão de um joystick.
+ */
+bool JoystickPi_read_button(JoystickPi_t *js) {
+    if (js->button_pin == JOYSTICK_NO_BUTTON) {
+        return false;
+    }
+    return !gpio_get(js->button_pin); // Inverte o valor porque o botão está em pull-up
+}
+
+/**
+ * @brief Inicializa o joystick padrão.
+ * 
+ * Configura os pinos ADC para leitura dos eixos X e Y e o pino GPIO para leitura do botão.
+ * Habilita o resistor de pull-up no pino do botão.
+ */
+void joystickPi_init() {
+    JoystickPi_config_t config;
+    JoystickPi_config_default(&config);
+    JoystickPi_init(&joystick_default, &config);
+}
+
+/**
+ * @brief Lê o estado atual do joystick padrão (eixos X e Y e botão).
+ * 
+ * @return Estrutura `joystick_state_t` contendo os valores dos eixos X e Y e o estado do botão.
+ */
+joystick_state_t joystickPi_read() {
+    return JoystickPi_read(&joystick_default);
 }
 
 /**
- * @brief Lê apenas o valor do eixo X do joystick.
+ * @brief Lê apenas o valor do eixo X do joystick padrão.
  * 
  * @return Valor do eixo X (0-4095).
  */
 uint16_t joystickPi_read_x() {
-    adc_select_input(0); // Seleciona o canal ADC0 (GP26)
-    return adc_read(); // Lê o valor do ADC
+    return JoystickPi_read_x(&joystick_default);
 }
 
 /**
- * @brief Lê apenas o valor do eixo Y do joystick.
+ * @brief Lê apenas o valor do eixo Y do joystick padrão.
  * 
  * @return Valor do eixo Y (0-4095).
  */
 uint16_t joystickPi_read_y() {
-    adc_select_input(1); // Seleciona o canal ADC1 (GP27)
-    return adc_read(); // Lê o valor do ADC
+    return JoystickPi_read_y(&joystick_default);
 }
 
 /**
- * @brief Lê apenas o estado do botão do joystick.
+ * @brief Lê apenas o estado do botão do joystick padrão.
  * 
  * @return true se o botão estiver pressionado, false caso contrário.
  */
 bool joystickPi_read_button() {
-    return !gpio_get(JOYSTICK_BUTTON_PIN); // Inverte o valor porque o botão está em pull-up
+    return JoystickPi_read_button(&joystick_default);
 }
 
 /**
@@ -108,5 +1052,923 @@ bool joystickPi_read_button() {
  * @return Valor mapeado para a faixa de saída.
  */
 int16_t joystickPi_map_value(uint16_t value, uint16_t min_input, uint16_t max_input, int16_t min_output, int16_t max_output) {
-    return (int16_t)((value - min_input) * (max_output - min_output) / (max_input - min_input) + min_output);
+    if (max_input == min_input) {
+        return min_output;
+    }
+    int64_t scaled = (int64_t)((int32_t)value - min_input) * ((int32_t)max_output - min_output);
+    return (int16_t)(scaled / ((int32_t)max_input - min_input) + min_output);
+}
+
+/**
+ * @brief Inicia a amostragem contínua dos eixos X e Y em segundo plano.
+ * 
+ * @param rate_hz Taxa de amostragem por eixo (JOYSTICK_ENGINE_MIN_RATE_HZ a JOYSTICK_ENGINE_MAX_RATE_HZ);
+ *                `rate_hz` vezes o número de canais do round-robin não pode passar de JOYSTICK_ENGINE_ADC_MAX_SPS.
+ * @return true se o motor foi iniciado, false se a taxa é inválida ou não há canais de DMA livres.
+ */
+bool joystickPi_engine_start(uint32_t rate_hz) {
+    if (rate_hz < JOYSTICK_ENGINE_MIN_RATE_HZ || rate_hz > JOYSTICK_ENGINE_MAX_RATE_HZ) {
+        return false;
+    }
+
+    // Ordem do round-robin: canais crescentes a partir do menor da máscara
+    uint mask = engine_round_robin_mask();
+    if (mask == 0) {
+        return false;
+    }
+
+    // Acima da taxa total máxima o ADC satura e a taxa real deixa de ser a do divisor
+    if ((uint64_t)rate_hz * __builtin_popcount(mask) > JOYSTICK_ENGINE_ADC_MAX_SPS) {
+        return false;
+    }
+    if (engine.running) {
+        joystickPi_engine_stop();
+    }
+
+    int data = dma_claim_unused_channel(false);
+    int ctrl = dma_claim_unused_channel(false);
+    if (data < 0 || ctrl < 0) {
+        if (data >= 0) dma_channel_unclaim(data);
+        if (ctrl >= 0) dma_channel_unclaim(ctrl);
+        return false;
+    }
+    engine.dma_data = data;
+    engine.dma_ctrl = ctrl;
+
+    engine.channel_mask = mask;
+    engine.channel_count = __builtin_popcount(mask);
+    engine.first_channel = __builtin_ctz(mask);
+    for (uint i = 0; i < engine.stick_count; i++) {
+        JoystickPi_t *js = engine.sticks[i];
+        js->x_slot = __builtin_popcount(mask & ((1u << js->x_channel) - 1));
+        js->y_slot = __builtin_popcount(mask & ((1u << js->y_channel) - 1));
+    }
+    if (comp_sensors.enabled) {
+        // Sem canal de referência, a soma da referência lê a temperatura e é ignorada
+        uint ref = comp_sensors.ref_channel == JOYSTICK_COMP_NO_REF ? JOYSTICK_COMP_TEMP_CHANNEL
+                                                                    : comp_sensors.ref_channel;
+        comp_sensors.temp_slot = __builtin_popcount(mask & ((1u << JOYSTICK_COMP_TEMP_CHANNEL) - 1));
+        comp_sensors.ref_slot = __builtin_popcount(mask & ((1u << ref) - 1));
+    }
+    engine.half_len = (JOYSTICK_ENGINE_RING_SAMPLES / 2 / engine.channel_count) * engine.channel_count;
+    engine.ring_len = 2 * engine.half_len;
+    engine.overruns = 0;
+    engine_half_addr[0] = engine_ring;
+    engine_half_addr[1] = engine_ring + engine.half_len;
+    joystickPi_engine_set_decimation(engine.decim_factor, engine.decim_order);
+
+    // Divisor do ADC: cada conversão leva (1 + div) ciclos de clk_adc e cobre um canal
+    adc_run(false);
+    adc_set_round_robin(engine.channel_mask);
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / ((float)rate_hz * engine.channel_count) - 1.0f);
+    engine.requested_rate_hz = rate_hz;
+    engine.achieved_rate_hz = (float)clock_get_hz(clk_adc) /
+                              ((1.0f + adc_hw->div / 256.0f) * engine.channel_count);
+    engine.group_period_q24 = (uint64_t)((1.0 + adc_hw->div / 256.0) * engine.channel_count * 1e6 /
+                                         clock_get_hz(clk_adc) * (1 << 24) + 0.5);
+
+    // Canal de dados: FIFO do ADC -> buffer, uma metade por disparo
+    dma_channel_config c = dma_channel_get_default_config(engine.dma_data);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    channel_config_set_chain_to(&c, engine.dma_ctrl);
+    dma_channel_configure(engine.dma_data, &c, engine_ring, &adc_hw->fifo, engine.half_len, false);
+
+    // Canal de rearme: aponta o canal de dados para a próxima metade e o redispara
+    dma_channel_config r = dma_channel_get_default_config(engine.dma_ctrl);
+    channel_config_set_transfer_data_size(&r, DMA_SIZE_32);
+    channel_config_set_read_increment(&r, true);
+    channel_config_set_write_increment(&r, false);
+    channel_config_set_ring(&r, false, 3); // Alterna entre as duas entradas de engine_half_addr
+    dma_channel_configure(engine.dma_ctrl, &r, &dma_hw->ch[engine.dma_data].al2_write_addr_trig,
+                          &engine_half_addr[1], 1, false);
+
+    irq_add_shared_handler(JOYSTICK_ENGINE_DMA_IRQ, engine_dma_irq_handler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq1_enabled(engine.dma_data, true);
+    irq_set_enabled(JOYSTICK_ENGINE_DMA_IRQ, true);
+
+    engine_restart_conversion();
+    engine.running = true;
+    add_repeating_timer_us(-(int64_t)(1000000 / JOYSTICK_ENGINE_PROCESS_HZ), engine_timer_callback, NULL, &engine.timer);
+
+    // Aguarda pares suficientes para a primeira leitura não incluir o buffer vazio
+    while (engine_written() <= JOYSTICK_ENGINE_READ_AVERAGE * engine.channel_count) {
+        tight_loop_contents();
+    }
+
+    // O fluxo depende da taxa e da disposição dos canais, que podem ter mudado
+    if (stream.stick) {
+        stream_configure(stream.stick, stream.requested_rate_hz);
+    }
+    return true;
+}
+
+/**
+ * @brief Para o motor de amostragem e devolve o ADC ao modo de conversão avulsa.
+ */
+void joystickPi_engine_stop() {
+    if (!engine.running) {
+        return;
+    }
+    engine.running = false;
+    cancel_repeating_timer(&engine.timer);
+    for (uint i = 0; i < engine.stick_count; i++) {
+        engine.sticks[i]->hires_valid = false;
+    }
+
+    adc_run(false);
+    adc_set_round_robin(0);
+    adc_fifo_setup(false, false, 0, false, false);
+
+    dma_channel_set_irq1_enabled(engine.dma_data, false);
+    irq_remove_handler(JOYSTICK_ENGINE_DMA_IRQ, engine_dma_irq_handler);
+
+    // Quebra o encadeamento antes de abortar para o rearme não redisparar o canal de dados
+    hw_write_masked(&dma_hw->ch[engine.dma_data].al1_ctrl,
+                    engine.dma_data << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB, DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+    dma_channel_abort(engine.dma_ctrl);
+    dma_channel_abort(engine.dma_data);
+    dma_hw->ints1 = 1u << engine.dma_data;
+    dma_channel_unclaim(engine.dma_data);
+    dma_channel_unclaim(engine.dma_ctrl);
+
+    adc_fifo_drain();
+}
+
+/**
+ * @brief Indica se o motor de amostragem está ativo.
+ * 
+ * @return true se o motor estiver rodando.
+ */
+bool joystickPi_engine_running() {
+    return engine.running;
+}
+
+/**
+ * @brief Obtém as estatísticas do motor de amostragem.
+ * 
+ * @param stats Estrutura preenchida com as taxas, o total de amostras e os transbordamentos.
+ */
+void joystickPi_engine_get_stats(joystick_engine_stats_t *stats) {
+    stats->requested_rate_hz = engine.requested_rate_hz;
+    stats->achieved_rate_hz = engine.running ? engine.achieved_rate_hz : 0.0f;
+    stats->overruns = engine.overruns;
+    stats->samples = 0;
+    stats->measured_rate_hz = 0.0f;
+    stats->decimation_factor = engine.decim_factor;
+    stats->decimation_order = engine.decim_order;
+    stats->output_rate_hz = engine.running ? engine.achieved_rate_hz / engine.decim_factor : 0.0f;
+    stats->decimated = engine.decimated;
+    if (!engine.running) {
+        return;
+    }
+
+    // Relê as metades para não misturar a contagem com o rearme do DMA
+    uint32_t halves, written;
+    uint64_t start_us;
+    do {
+        halves = engine.halves;
+        start_us = engine.start_us;
+        written = engine_written();
+    } while (halves != engine.halves);
+
+    // Posição dentro da metade atual; cobre também a IRQ de fim de metade ainda pendente
+    if (halves & 1) {
+        written = written >= engine.half_len ? written - engine.half_len : written + engine.half_len;
+    }
+    stats->samples = (uint64_t)halves * engine.half_len + written;
+    uint64_t elapsed_us = time_us_64() - start_us;
+    if (elapsed_us > 0) {
+        stats->measured_rate_hz = (float)((double)stats->samples * 1e6 / elapsed_us / engine.channel_count);
+    }
+}
+
+/**
+ * @brief Configura o estágio de sobreamostragem e decimação do motor.
+ * 
+ * @param factor Fator de decimação: 1 desliga; potências de 2 de 4 a JOYSTICK_DECIMATION_MAX_FACTOR.
+ * @param order Ordem do CIC: 1 (boxcar) ou 2.
+ * @return true se a configuração foi aceita.
+ */
+bool joystickPi_engine_set_decimation(uint factor, uint order) {
+    bool power_of_two = factor && !(factor & (factor - 1));
+    if (!power_of_two || factor == 2 || factor > JOYSTICK_DECIMATION_MAX_FACTOR || order < 1 || order > 2) {
+        return false;
+    }
+
+    // O ganho do CIC é factor^order; o deslocamento leva os 12 + ordem*log2(factor) bits a 16
+    int gain_bits = 12 + (int)order * __builtin_ctz(factor);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    engine.decim_factor = factor;
+    engine.decim_order = order;
+    engine.decim_shift = gain_bits - 16;
+    engine_reset_processing();
+    restore_interrupts(irq_state);
+    return true;
+}
+
+/**
+ * @brief Copia os pares brutos mais recentes do buffer do DMA, do mais antigo ao mais novo.
+ * 
+ * @param x Destino das amostras do eixo X.
+ * @param y Destino das amostras do eixo Y.
+ * @param count Quantidade de pares desejada.
+ * @return Quantidade de pares copiados (no máximo uma metade do buffer).
+ */
+uint joystickPi_engine_snapshot(uint16_t *x, uint16_t *y, uint count) {
+    return JoystickPi_engine_snapshot(&joystick_default, x, y, count);
+}
+
+/**
+ * @brief Copia os pares brutos mais recentes de um joystick, do mais antigo ao mais novo.
+ * 
+ * @param js Joystick registrado.
+ * @param x Destino das amostras do eixo X (canal do ADC, sem troca nem inversão).
+ * @param y Destino das amostras do eixo Y.
+ * @param count Quantidade de pares desejada.
+ * @return Quantidade de pares copiados (no máximo uma metade do buffer).
+ */
+uint JoystickPi_engine_snapshot(JoystickPi_t *js, uint16_t *x, uint16_t *y, uint count) {
+    if (!engine.running || !js->registered) {
+        return 0;
+    }
+    uint32_t groups = engine.ring_len / engine.channel_count;
+    if (count > groups / 2) {
+        count = groups / 2;
+    }
+
+    int32_t group = engine_latest_group() - (int32_t)count + 1;
+    if (group < 0) {
+        group += groups;
+    }
+    for (uint i = 0; i < count; i++) {
+        const uint16_t *g = &engine_ring[group * engine.channel_count];
+        x[i] = g[js->x_slot];
+        y[i] = g[js->y_slot];
+        group = (group + 1 == (int32_t)groups) ? 0 : group + 1;
+    }
+    return count;
+}
+
+/**
+ * @brief Preenche uma calibração com os valores nominais (centro 2048, faixa completa do ADC).
+ * 
+ * @param cal Calibração a ser preenchida.
+ */
+void joystickPi_calibration_defaults(joystick_calibration_t *cal) {
+    cal->center_x = 2048 << 4;
+    cal->center_y = 2048 << 4;
+    cal->min_x = 0;
+    cal->min_y = 0;
+    cal->max_x = 4095 << 4;
+    cal->max_y = 4095 << 4;
+    cal->deadzone = 100 << 4;
+}
+
+/**
+ * @brief Aplica uma calibração ao joystick padrão e pré-calcula os fatores de escala em ponto fixo.
+ * 
+ * @param cal Calibração a ser aplicada.
+ */
+void joystickPi_calibration_set(const joystick_calibration_t *cal) {
+    JoystickPi_calibration_set(&joystick_default, cal);
+}
+
+/**
+ * @brief Aplica uma calibração a um joystick e pré-calcula os fatores de escala em ponto fixo.
+ * 
+ * @param js Joystick.
+ * @param cal Calibração a ser aplicada.
+ */
+void JoystickPi_calibration_set(JoystickPi_t *js, const joystick_calibration_t *cal) {
+    if (cal != &js->calibration) {
+        js->calibration = *cal;
+    }
+    cal_prepare_axis(&js->cal_x, cal->center_x, cal->min_x, cal->max_x, cal->deadzone);
+    cal_prepare_axis(&js->cal_y, cal->center_y, cal->min_y, cal->max_y, cal->deadzone);
+    js->cal_ready = true;
+}
+
+/**
+ * @brief Obtém a calibração em uso pelo joystick padrão.
+ * 
+ * @param cal Estrutura que recebe a calibração.
+ */
+void joystickPi_calibration_get(joystick_calibration_t *cal) {
+    JoystickPi_calibration_get(&joystick_default, cal);
+}
+
+/**
+ * @brief Obtém a calibração em uso por um joystick.
+ * 
+ * @param js Joystick.
+ * @param cal Estrutura que recebe a calibração.
+ */
+void JoystickPi_calibration_get(JoystickPi_t *js, joystick_calibration_t *cal) {
+    *cal = js->calibration;
+}
+
+/**
+ * @brief Carrega e aplica a calibração do joystick padrão gravada na flash.
+ * 
+ * @return true se havia um registro válido (assinatura e checksum corretos); false mantém a calibração atual.
+ */
+bool joystickPi_calibration_load() {
+    return JoystickPi_calibration_load(&joystick_default);
+}
+
+/**
+ * @brief Carrega e aplica a calibração de um joystick gravada na sua página da flash.
+ * 
+ * @param js Joystick.
+ * @return true se havia um registro válido; false mantém a calibração atual.
+ */
+bool JoystickPi_calibration_load(JoystickPi_t *js) {
+    uint32_t offset = JOYSTICK_CAL_FLASH_OFFSET + js->cal_slot * FLASH_PAGE_SIZE;
+    const joystick_cal_record_t *record = (const joystick_cal_record_t *)(XIP_BASE + offset);
+
+    if (record->magic != JOYSTICK_CAL_MAGIC || record->version != JOYSTICK_CAL_VERSION) {
+        return false;
+    }
+    if (record->crc != cal_crc32((const uint8_t *)record, offsetof(joystick_cal_record_t, crc))) {
+        return false;
+    }
+
+    const joystick_calibration_t *cal = &record->cal;
+    if (cal->min_x >= cal->center_x || cal->center_x >= cal->max_x ||
+        cal->min_y >= cal->center_y || cal->center_y >= cal->max_y) {
+        return false;
+    }
+    JoystickPi_calibration_set(js, cal);
+    js->comp = record->comp;
+    return true;
+}
+
+/**
+ * @brief Grava a calibração do joystick padrão no setor reservado da flash.
+ */
+void joystickPi_calibration_save() {
+    JoystickPi_calibration_save(&joystick_default);
+}
+
+/**
+ * @brief Grava a calibração de um joystick na sua página da flash.
+ * 
+ * O setor inteiro precisa ser apagado, então as páginas dos outros joysticks são copiadas
+ * para a RAM e regravadas junto.
+ * 
+ * @param js Joystick.
+ */
+void JoystickPi_calibration_save(JoystickPi_t *js) {
+    static uint8_t pages[JOYSTICK_MAX_INSTANCES * FLASH_PAGE_SIZE] __attribute__((aligned(4)));
+    joystick_cal_record_t record = {
+        .magic = JOYSTICK_CAL_MAGIC,
+        .version = JOYSTICK_CAL_VERSION,
+        .cal = js->calibration,
+        .comp = js->comp,
+    };
+    record.crc = cal_crc32((const uint8_t *)&record, offsetof(joystick_cal_record_t, crc));
+
+    memcpy(pages, (const void *)(XIP_BASE + JOYSTICK_CAL_FLASH_OFFSET), sizeof(pages));
+    uint8_t *page = pages + js->cal_slot * FLASH_PAGE_SIZE;
+    memset(page, 0xFF, FLASH_PAGE_SIZE);
+    memcpy(page, &record, sizeof(record));
+
+    // A flash não pode ser lida (XIP) durante o apagamento, então nenhum código em flash pode rodar
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(JOYSTICK_CAL_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(JOYSTICK_CAL_FLASH_OFFSET, pages, sizeof(pages));
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Calibra o centro e a zona morta do joystick padrão em repouso.
+ * 
+ * @param reads Quantidade de leituras (ex: 200); com 0 a calibração não é alterada.
+ */
+void joystickPi_calibrate_center(uint reads) {
+    JoystickPi_calibrate_center(&joystick_default, reads);
+}
+
+/**
+ * @brief Calibra o centro e a zona morta de um joystick em repouso.
+ * 
+ * @param js Joystick.
+ * @param reads Quantidade de leituras (ex: 200); com 0 a calibração não é alterada.
+ */
+void JoystickPi_calibrate_center(JoystickPi_t *js, uint reads) {
+    if (reads == 0) {
+        return; // Sem leituras não há média
+    }
+    joystick_calibration_t *cal = &js->calibration;
+    uint32_t sum_x = 0, sum_y = 0;
+    uint16_t min_x = 0xFFFF, max_x = 0, min_y = 0xFFFF, max_y = 0;
+
+    // As condições atuais passam a ser as de referência da compensação, então o centro medido
+    // abaixo vale para temp_ref e não muda quando a deriva térmica é reajustada
+    if (comp_sensors.enabled) {
+        if (!engine.running) {
+            comp_sample_blocking();
+        }
+        js->comp.temp_ref = 0; // Capturado na próxima leitura compensada
+    }
+
+    for (uint i = 0; i < reads; i++) {
+        joystick_state_t state;
+        read_axes(js, &state);
+        sum_x += state.x_hires;
+        sum_y += state.y_hires;
+        min_x = MIN(min_x, state.x_hires);
+        max_x = MAX(max_x, state.x_hires);
+        min_y = MIN(min_y, state.y_hires);
+        max_y = MAX(max_y, state.y_hires);
+        sleep_ms(1);
+    }
+
+    uint16_t cx = sum_x / reads;
+    uint16_t cy = sum_y / reads;
+    int32_t spread = MAX(MAX(max_x - cx, cx - min_x), MAX(max_y - cy, cy - min_y));
+
+    cal->center_x = cx;
+    cal->center_y = cy;
+    cal->deadzone = MIN(2 * spread + JOYSTICK_CAL_DEADZONE_MARGIN, 0xFFFF);
+    cal->min_x = MIN(cal->min_x, cx - 1);
+    cal->min_y = MIN(cal->min_y, cy - 1);
+    cal->max_x = MAX(cal->max_x, cx + 1);
+    cal->max_y = MAX(cal->max_y, cy + 1);
+    JoystickPi_calibration_set(js, cal);
+    cal_idle_reset(js, cx, cy);
+    comp_fit_add(js, cx, cy);
+}
+
+/**
+ * @brief Inicia a rotina guiada de faixa do joystick padrão: a partir daqui cada leitura amplia min/max.
+ */
+void joystickPi_calibration_begin_range() {
+    JoystickPi_calibration_begin_range(&joystick_default);
+}
+
+/**
+ * @brief Inicia a rotina guiada de faixa de um joystick.
+ * 
+ * @param js Joystick.
+ */
+void JoystickPi_calibration_begin_range(JoystickPi_t *js) {
+    joystick_calibration_t *cal = &js->calibration;
+    cal->min_x = cal->center_x - 1;
+    cal->max_x = cal->center_x + 1;
+    cal->min_y = cal->center_y - 1;
+    cal->max_y = cal->center_y + 1;
+    JoystickPi_calibration_set(js, cal);
+    js->cal_range_capture = true;
+}
+
+/**
+ * @brief Encerra a rotina guiada de faixa do joystick padrão e aplica os limites aprendidos.
+ */
+void joystickPi_calibration_end_range() {
+    JoystickPi_calibration_end_range(&joystick_default);
+}
+
+/**
+ * @brief Encerra a rotina guiada de faixa de um joystick.
+ * 
+ * @param js Joystick.
+ */
+void JoystickPi_calibration_end_range(JoystickPi_t *js) {
+    js->cal_range_capture = false;
+    JoystickPi_calibration_set(js, &js->calibration);
+}
+
+/**
+ * @brief Liga ou desliga a calibração automática do joystick padrão.
+ * 
+ * @param enabled true para ligar.
+ */
+void joystickPi_calibration_set_auto(bool enabled) {
+    JoystickPi_calibration_set_auto(&joystick_default, enabled);
+}
+
+/**
+ * @brief Liga ou desliga a calibração automática de um joystick.
+ * 
+ * @param js Joystick.
+ * @param enabled true para ligar.
+ */
+void JoystickPi_calibration_set_auto(JoystickPi_t *js, bool enabled) {
+    js->cal_auto = enabled;
+    cal_idle_reset(js, js->calibration.center_x, js->calibration.center_y);
+}
+
+/**
+ * @brief Define a curva de resposta aplicada a `x_norm`/`y_norm` em `joystickPi_read`.
+ * 
+ * @param curve Curva de resposta, ou NULL para desligar.
+ */
+void joystickPi_shape_set_curve(const joystick_curve_t *curve) {
+    JoystickPi_shape_set_curve(&joystick_default, curve);
+}
+
+/**
+ * @brief Define a curva de resposta de um joystick.
+ * 
+ * @param js Joystick.
+ * @param curve Curva de resposta, ou NULL para desligar.
+ */
+void JoystickPi_shape_set_curve(JoystickPi_t *js, const joystick_curve_t *curve) {
+    js->shape_curve = curve;
+}
+
+/**
+ * @brief Aplica uma curva de resposta a um par normalizado.
+ * 
+ * @param curve Curva de resposta.
+ * @param x Eixo X normalizado (entrada e saída).
+ * @param y Eixo Y normalizado (entrada e saída).
+ */
+void joystickPi_shape(const joystick_curve_t *curve, int16_t *x, int16_t *y) {
+    int32_t ix = *x, iy = *y;
+
+    // Raio ao quadrado em Q30: no máximo 2 * 32767², abaixo de 2^31
+    uint32_t r2 = (uint32_t)(ix * ix) + (uint32_t)(iy * iy);
+    if (r2 < curve->deadzone_r2) {
+        *x = 0;
+        *y = 0;
+        return;
+    }
+
+    const uint16_t *lut = curve->gain;
+    uint32_t index = r2 >> (31 - JOYSTICK_CURVE_LUT_BITS);
+    uint32_t frac = (r2 >> (31 - JOYSTICK_CURVE_LUT_BITS - JOYSTICK_CURVE_INTERP_BITS)) &
+                    ((1u << JOYSTICK_CURVE_INTERP_BITS) - 1);
+
+    // Interpolação linear entre as duas entradas vizinhas da tabela
+    int32_t g0 = lut[index];
+    int32_t gain = g0 + (((lut[index + 1] - g0) * (int32_t)frac) >> JOYSTICK_CURVE_INTERP_BITS);
+
+    // 32767 * 65535 ainda cabe em int32
+    ix = (ix * gain) >> JOYSTICK_CURVE_GAIN_FRAC_BITS;
+    iy = (iy * gain) >> JOYSTICK_CURVE_GAIN_FRAC_BITS;
+    *x = (int16_t)MAX(MIN(ix, JOYSTICK_NORM_MAX), -JOYSTICK_NORM_MAX);
+    *y = (int16_t)MAX(MIN(iy, JOYSTICK_NORM_MAX), -JOYSTICK_NORM_MAX);
+}
+
+/**
+ * @brief Preenche os parâmetros padrão do filtro adaptativo.
+ * 
+ * @param params Parâmetros a serem preenchidos.
+ */
+void joystickPi_filter_defaults(joystick_filter_params_t *params) {
+    params->min_cutoff_hz = JOYSTICK_FILTER_DEFAULT_MIN_CUTOFF_HZ;
+    params->beta = JOYSTICK_FILTER_DEFAULT_BETA;
+    params->d_cutoff_hz = JOYSTICK_FILTER_DEFAULT_D_CUTOFF_HZ;
+}
+
+/**
+ * @brief Pré-calcula os coeficientes do filtro adaptativo para uma taxa de amostragem.
+ * 
+ * @param euro Coeficientes a serem calculados.
+ * @param params Parâmetros do filtro.
+ * @param rate_hz Taxa com que `joystickPi_euro_step` será chamado.
+ */
+void joystickPi_euro_init(joystick_euro_t *euro, const joystick_filter_params_t *params, uint32_t rate_hz) {
+    for (uint i = 0; i < JOYSTICK_FILTER_LUT_SIZE; i++) {
+        // Velocidade no centro da faixa i, em cursos completos (65536) por segundo
+        float speed = (i + 0.5f) * (1u << JOYSTICK_FILTER_SPEED_SHIFT) * rate_hz / 65536.0f;
+        euro->alpha[i] = euro_alpha(params->min_cutoff_hz + params->beta * speed, rate_hz);
+    }
+    euro->alpha_d = euro_alpha(params->d_cutoff_hz, rate_hz);
+}
+
+/**
+ * @brief Filtra uma amostra de um eixo.
+ * 
+ * @param euro Coeficientes do filtro.
+ * @param axis Estado do eixo (zerado antes da primeira amostra).
+ * @param value Amostra na escala de 16 bits.
+ * @return Amostra filtrada na escala de 16 bits.
+ */
+uint16_t joystickPi_euro_step(const joystick_euro_t *euro, joystick_euro_axis_t *axis, uint16_t value) {
+    int32_t v = (int32_t)value << 8;
+    if (!axis->primed) {
+        axis->value = v;
+        axis->slope = 0;
+        axis->primed = true;
+        return value;
+    }
+
+    // Velocidade: derivada (por passo) suavizada pelo passa-baixas de corte fixo
+    int32_t dx = v - axis->value;
+    axis->slope += (int32_t)(((int64_t)(dx - axis->slope) * euro->alpha_d) >> 16);
+
+    // Corte adaptativo: a faixa de velocidade escolhe o coeficiente na tabela
+    uint32_t band = (uint32_t)abs(axis->slope) >> (8 + JOYSTICK_FILTER_SPEED_SHIFT);
+    uint16_t alpha = euro->alpha[MIN(band, JOYSTICK_FILTER_LUT_SIZE - 1)];
+    axis->value += (int32_t)(((int64_t)(v - axis->value) * alpha) >> 16);
+
+    return (uint16_t)((axis->value + 128) >> 8);
+}
+
+/**
+ * @brief Liga, reconfigura ou desliga o filtro adaptativo do motor de amostragem.
+ * 
+ * @param params Parâmetros do filtro, ou NULL para desligar.
+ */
+void joystickPi_engine_set_filter(const joystick_filter_params_t *params) {
+    joystick_euro_t euro;
+    if (params) {
+        joystickPi_euro_init(&euro, params, JOYSTICK_ENGINE_PROCESS_HZ);
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    if (params) {
+        engine.euro = euro;
+        engine.filter_params = *params;
+    }
+    engine.filter_enabled = params != NULL;
+    engine_reset_processing();
+    restore_interrupts(irq_state);
+
+    // O fluxo tem coeficientes próprios, calculados para a sua taxa
+    if (stream.stick && engine.running) {
+        stream_configure(stream.stick, stream.requested_rate_hz);
+    }
+}
+
+/**
+ * @brief Acrescenta um canal do ADC ao round-robin do motor.
+ * 
+ * @param channel Canal do ADC (0 a JOYSTICK_ADC_CHANNELS - 1).
+ * @return false se o canal é inválido.
+ */
+bool joystickPi_engine_add_channel(uint channel) {
+    if (channel >= JOYSTICK_ADC_CHANNELS) {
+        return false;
+    }
+    adc_init();
+    if (channel < JOYSTICK_ADC_CHANNELS - 1) {
+        adc_gpio_init(JOYSTICK_ADC_FIRST_PIN + channel);
+    }
+    engine.extra_mask |= 1u << channel;
+    engine_reconfigure();
+    return true;
+}
+
+/**
+ * @brief Lê um canal do ADC, pelo buffer do motor quando ativo.
+ * 
+ * @param channel Canal do ADC.
+ * @return Valor de 12 bits, ou 0 se o motor está ativo e o canal não faz parte do round-robin.
+ */
+uint16_t joystickPi_engine_read_channel(uint channel) {
+    if (channel >= JOYSTICK_ADC_CHANNELS) {
+        return 0;
+    }
+    if (!engine.running) {
+        adc_select_input(channel);
+        return adc_read();
+    }
+    if (!(engine.channel_mask & (1u << channel))) {
+        return 0;
+    }
+    uint slot = __builtin_popcount(engine.channel_mask & ((1u << channel) - 1));
+    return (uint16_t)(engine_slot_sum(slot) / JOYSTICK_ENGINE_READ_AVERAGE);
+}
+
+/**
+ * @brief Inicia o fluxo de amostras de taxa fixa do joystick padrão.
+ *
+ * @param rate_hz Taxa desejada, de 1 Hz até a taxa do motor por eixo.
+ * @return false se o motor está parado ou a taxa é inválida.
+ */
+bool joystickPi_stream_start(uint32_t rate_hz) {
+    return JoystickPi_stream_start(&joystick_default, rate_hz);
+}
+
+/**
+ * @brief Inicia o fluxo de amostras de taxa fixa de um joystick.
+ *
+ * @param js Joystick registrado.
+ * @param rate_hz Taxa desejada, de 1 Hz até a taxa do motor por eixo.
+ * @return false se o motor está parado, o joystick não está registrado ou a taxa é inválida.
+ */
+bool JoystickPi_stream_start(JoystickPi_t *js, uint32_t rate_hz) {
+    if (!engine.running || !js->registered) {
+        return false;
+    }
+    if (!stream_configure(js, rate_hz)) {
+        return false;
+    }
+    joystickPi_stream_reset_stats();
+    return true;
+}
+
+/**
+ * @brief Encerra o fluxo de amostras e descarta as que estão na fila.
+ */
+void joystickPi_stream_stop() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    stream.stick = NULL;
+    stream.tail = stream.head;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Retira a amostra mais antiga da fila do fluxo, sem bloquear.
+ *
+ * @param sample Amostra retirada.
+ * @return false se a fila está vazia.
+ */
+bool joystickPi_stream_read(joystick_sample_t *sample) {
+    JoystickPi_t *js = stream.stick;
+    uint32_t tail = stream.tail;
+    if (!js || tail == stream.head) {
+        return false;
+    }
+    __dmb(); // Lê a entrada só depois de ver o índice que a publicou
+    joystick_stream_entry_t e = stream.queue[tail & (JOYSTICK_STREAM_QUEUE_SIZE - 1)];
+    __dmb();
+    stream.tail = tail + 1;
+
+    joystick_state_t state = {
+        .x = e.x_hires >> 4,
+        .y = e.y_hires >> 4,
+        .x_hires = e.x_hires,
+        .y_hires = e.y_hires,
+    };
+    orient_axes(js, &state);
+    comp_apply(js, &state);
+
+    JoystickPi_normalize(js, &state);
+
+    sample->t_us = e.t_us;
+    sample->x_hires = state.x_hires;
+    sample->y_hires = state.y_hires;
+    sample->x = state.x_norm;
+    sample->y = state.y_norm;
+    sample->button = e.button;
+    return true;
+}
+
+/**
+ * @brief Aguarda a próxima amostra do fluxo.
+ *
+ * @param sample Amostra retirada.
+ * @return false se o fluxo ou o motor foram encerrados.
+ */
+bool joystickPi_stream_wait(joystick_sample_t *sample) {
+    while (!joystickPi_stream_read(sample)) {
+        if (!stream.stick || !engine.running) {
+            return false;
+        }
+        tight_loop_contents();
+    }
+    return true;
+}
+
+/**
+ * @brief Obtém as estatísticas de tempo e de perdas do fluxo.
+ *
+ * @param stats Estrutura preenchida.
+ */
+void joystickPi_stream_get_stats(joystick_stream_stats_t *stats) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    bool active = stream.stick && engine.running;
+    stats->groups_per_sample = active ? stream.groups_per_sample : 0;
+    stats->rate_hz = active ? engine.achieved_rate_hz / stream.groups_per_sample : 0.0f;
+    stats->delivered = stream.delivered;
+    stats->dropped = stream.dropped;
+    bool measured = stream.clock_error_min_us <= stream.clock_error_max_us;
+    stats->clock_error_min_us = measured ? stream.clock_error_min_us : 0;
+    stats->clock_error_max_us = measured ? stream.clock_error_max_us : 0;
+    stats->tick_jitter_us = stream.tick_jitter_us;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Zera os contadores e os extremos das estatísticas do fluxo.
+ */
+void joystickPi_stream_reset_stats() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    stream.delivered = 0;
+    stream.dropped = 0;
+    stream.clock_error_min_us = INT32_MAX;
+    stream.clock_error_max_us = INT32_MIN;
+    stream.tick_jitter_us = 0;
+    restore_interrupts(irq_state);
+}
+
+/**
+ * @brief Liga a compensação de temperatura e, opcionalmente, de alimentação.
+ *
+ * @param ref_channel Canal (0 a 3) ligado à alimentação dos potenciômetros, ou JOYSTICK_COMP_NO_REF.
+ * @return false se o canal de referência é inválido.
+ */
+bool joystickPi_compensation_enable(uint ref_channel) {
+    if (ref_channel != JOYSTICK_COMP_NO_REF && ref_channel >= JOYSTICK_COMP_TEMP_CHANNEL) {
+        return false;
+    }
+    adc_init();
+    adc_set_temp_sensor_enabled(true);
+    engine.extra_mask |= 1u << JOYSTICK_COMP_TEMP_CHANNEL;
+    if (ref_channel != JOYSTICK_COMP_NO_REF) {
+        adc_gpio_init(JOYSTICK_ADC_FIRST_PIN + ref_channel);
+        engine.extra_mask |= 1u << ref_channel;
+    }
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    comp_sensors.ref_channel = ref_channel;
+    comp_sensors.ready = false;
+    comp_sensors.enabled = true;
+    restore_interrupts(irq_state);
+
+    // Uma única reinicialização para incluir os dois canais no round-robin
+    engine_reconfigure();
+    return true;
+}
+
+/**
+ * @brief Desliga a compensação.
+ */
+void joystickPi_compensation_disable() {
+    comp_sensors.enabled = false;
+}
+
+/**
+ * @brief Lê os sensores da compensação já filtrados, na escala de 16 bits.
+ *
+ * @param temp Leitura do sensor de temperatura.
+ * @param ref Leitura do canal de referência (0 sem canal de referência).
+ * @return false se a compensação está desligada ou ainda não há leituras.
+ */
+bool joystickPi_compensation_sensors(uint16_t *temp, uint16_t *ref) {
+    if (!comp_sensors.enabled || !comp_sensors.ready) {
+        return false;
+    }
+    *temp = (uint16_t)((comp_sensors.temp_q8 + 128) >> 8);
+    *ref = comp_sensors.ref_channel == JOYSTICK_COMP_NO_REF ? 0 : (uint16_t)((comp_sensors.ref_q8 + 128) >> 8);
+    return true;
+}
+
+/**
+ * @brief Converte uma leitura do sensor de temperatura para °C.
+ *
+ * @param temp Leitura do sensor, na escala de 16 bits.
+ * @return Temperatura em °C.
+ */
+float joystickPi_temperature_c(uint16_t temp) {
+    float volts = temp * 3.3f / 65536.0f;
+    return 27.0f - (volts - 0.706f) / 0.001721f;
+}
+
+/**
+ * @brief Aplica coeficientes de compensação ao joystick padrão.
+ *
+ * @param comp Coeficientes.
+ */
+void joystickPi_compensation_set(const joystick_comp_t *comp) {
+    JoystickPi_compensation_set(&joystick_default, comp);
+}
+
+/**
+ * @brief Aplica coeficientes de compensação a um joystick.
+ *
+ * @param js Joystick.
+ * @param comp Coeficientes.
+ */
+void JoystickPi_compensation_set(JoystickPi_t *js, const joystick_comp_t *comp) {
+    js->comp = *comp;
+}
+
+/**
+ * @brief Obtém os coeficientes de compensação do joystick padrão.
+ *
+ * @param comp Estrutura que recebe os coeficientes.
+ */
+void joystickPi_compensation_get(joystick_comp_t *comp) {
+    JoystickPi_compensation_get(&joystick_default, comp);
+}
+
+/**
+ * @brief Obtém os coeficientes de compensação em uso por um joystick.
+ *
+ * @param js Joystick.
+ * @param comp Estrutura que recebe os coeficientes.
+ */
+void JoystickPi_compensation_get(JoystickPi_t *js, joystick_comp_t *comp) {
+    *comp = js->comp;
+}
+
+/**
+ * @brief Descarta os pontos de repouso acumulados no ajuste da deriva.
+ *
+ * @param js Joystick.
+ */
+void JoystickPi_compensation_reset_fit(JoystickPi_t *js) {
+    js->comp_fit = (joystick_comp_fit_t){0};
 }
@@ -0,0 +1,95 @@
+#include "inc/joystick_curve.h"
+
+/**
+ * Arquivo: joystick_curve.c
+ * 
+ * Descrição:
+ * Tabelas de ganho radial geradas por Joystick/host/gen_curve_lut.py. Não edite à mão.
+ */
+
+// zona morta 0.10, anti-zona-morta 0.00, curva linear
+const joystick_curve_t joystick_curve_linear = {
+    .deadzone_r2 = 10737418u,
+    .gain = {
+            0,     0,  3641,  6313,  7906,  8994,  9796, 10420, 10923, 11339, 11691, 11995,
+        12259, 12492, 12700, 12887, 13055, 13209, 13350, 13479, 13599, 13710, 13813, 13910,
+        14000, 14085, 14165, 14241, 14312, 14380, 14444, 14505, 14564, 14619, 14672, 14723,
+        14772, 14818, 14863, 14906, 14948, 14988, 15026, 15064, 15099, 15134, 15168, 15200,
+        15232, 15262, 15292, 15320, 15348, 15375, 15402, 15427, 15452, 15476, 15500, 15523,
+        15546, 15567, 15589, 15610, 15630, 15650, 15669, 15688, 15707, 15725, 15743, 15760,
+        15777, 15794, 15810, 15826, 15842, 15857, 15872, 15887, 15902, 15916, 15930, 15944,
+        15957, 15970, 15984, 15996, 16009, 16021, 16033, 16045, 16057, 16069, 16080, 16091,
+        16102, 16113, 16124, 16134, 16145, 16155, 16165, 16175, 16185, 16194, 16204, 16213,
+        16223, 16232, 16241, 16250, 16258, 16267, 16275, 16284, 16292, 16300, 16308, 16316,
+        16324, 16332, 16340, 16347, 16355, 16362, 16370, 16377, 16384, 16320, 16257, 16195,
+        16134, 16073, 16013, 15954, 15895, 15837, 15779, 15722, 15666, 15610, 15555, 15501,
+        15447, 15394, 15341, 15289, 15237, 15186, 15135, 15085, 15035, 14986, 14937, 14889,
+        14841, 14794, 14747, 14700, 14654, 14609, 14564, 14519, 14474, 14431, 14387, 14344,
+        14301, 14259, 14217, 14175, 14134, 14093, 14052, 14012, 13972, 13933, 13894, 13855,
+        13816, 13778, 13740, 13702, 13665, 13628, 13592, 13555, 13519, 13483, 13448, 13412,
+        13377, 13343, 13308, 13274, 13240, 13207, 13173, 13140, 13107, 13075, 13042, 13010,
+        12978, 12946, 12915, 12884, 12853, 12822, 12791, 12761, 12731, 12701, 12671, 12642,
+        12612, 12583, 12554, 12526, 12497, 12469, 12441, 12413, 12385, 12358, 12330, 12303,
+        12276, 12249, 12223, 12196, 12170, 12144, 12118, 12092, 12066, 12041, 12015, 11990,
+        11965, 11940, 11916, 11891, 11867, 11842, 11818, 11794, 11771, 11747, 11723, 11700,
+        11677, 11654, 11631, 11608, 11585,
+    },
+};
+
+// zona morta 0.10, anti-zona-morta 0.00, curva exponencial (expo = 3)
+const joystick_curve_t joystick_curve_expo = {
+    .deadzone_r2 = 10737418u,
+    .gain = {
+            0,     0,   597,  1086,  1416,  1671,  1882,  2064,  2228,  2377,  2516,  2647,
+         2771,  2890,  3005,  3117,  3225,  3332,  3436,  3538,  3640,  3739,  3838,  3936,
+         4033,  4130,  4226,  4322,  4417,  4512,  4607,  4702,  4796,  4891,  4986,  5081,
+         5175,  5270,  5366,  5461,  5557,  5653,  5749,  5845,  5942,  6039,  6137,  6234,
+         6333,  6431,  6531,  6630,  6730,  6831,  6932,  7033,  7135,  7238,  7341,  7445,
+         7549,  7654,  7759,  7865,  7972,  8079,  8187,  8295,  8404,  8514,  8624,  8735,
+         8847,  8959,  9072,  9186,  9300,  9416,  9531,  9648,  9765,  9883, 10002, 10122,
+        10242, 10363, 10485, 10608, 10731, 10855, 10980, 11106, 11233, 11360, 11488, 11617,
+        11747, 11878, 12010, 12142, 12275, 12410, 12545, 12681, 12818, 12955, 13094, 13233,
+        13374, 13515, 13658, 13801, 13945, 14090, 14236, 14383, 14531, 14680, 14830, 14981,
+        15133, 15286, 15439, 15594, 15750, 15907, 16065, 16224, 16384, 16320, 16257, 16195,
+        16134, 16073, 16013, 15954, 15895, 15837, 15779, 15722, 15666, 15610, 15555, 15501,
+        15447, 15394, 15341, 15289, 15237, 15186, 15135, 15085, 15035, 14986, 14937, 14889,
+        14841, 14794, 14747, 14700, 14654, 14609, 14564, 14519, 14474, 14431, 14387, 14344,
+        14301, 14259, 14217, 14175, 14134, 14093, 14052, 14012, 13972, 13933, 13894, 13855,
+        13816, 13778, 13740, 13702, 13665, 13628, 13592, 13555, 13519, 13483, 13448, 13412,
+        13377, 13343, 13308, 13274, 13240, 13207, 13173, 13140, 13107, 13075, 13042, 13010,
+        12978, 12946, 12915, 12884, 12853, 12822, 12791, 12761, 12731, 12701, 12671, 12642,
+        12612, 12583, 12554, 12526, 12497, 12469, 12441, 12413, 12385, 12358, 12330, 12303,
+        12276, 12249, 12223, 12196, 12170, 12144, 12118, 12092, 12066, 12041, 12015, 11990,
+        11965, 11940, 11916, 11891, 11867, 11842, 11818, 11794, 11771, 11747, 11723, 11700,
+        11677, 11654, 11631, 11608, 11585,
+    },
+};
+
+// zona morta 0.06, anti-zona-morta 0.12, curva exponencial (expo = 1.5)
+const joystick_curve_t joystick_curve_precise = {
+    .deadzone_r2 = 3865471u,
+    .gain = {
+        32768, 24415, 19349, 17174, 15920, 15094, 14507, 14069, 13731, 13464, 13249, 13073,
+        12929, 12810, 12711, 12628, 12559, 12502, 12455, 12417, 12386, 12361, 12343, 12329,
+        12320, 12315, 12313, 12315, 12320, 12327, 12337, 12350, 12364, 12380, 12398, 12417,
+        12438, 12460, 12484, 12509, 12535, 12562, 12590, 12619, 12648, 12679, 12710, 12742,
+        12775, 12809, 12843, 12877, 12913, 12948, 12985, 13021, 13059, 13096, 13134, 13173,
+        13212, 13251, 13291, 13331, 13371, 13412, 13453, 13494, 13536, 13578, 13620, 13662,
+        13705, 13748, 13791, 13835, 13878, 13922, 13966, 14011, 14055, 14100, 14145, 14190,
+        14235, 14281, 14327, 14373, 14419, 14465, 14512, 14558, 14605, 14652, 14699, 14746,
+        14794, 14841, 14889, 14937, 14985, 15033, 15081, 15130, 15179, 15227, 15276, 15325,
+        15374, 15424, 15473, 15523, 15572, 15622, 15672, 15722, 15772, 15823, 15873, 15924,
+        15974, 16025, 16076, 16127, 16178, 16229, 16281, 16332, 16384, 16320, 16257, 16195,
+        16134, 16073, 16013, 15954, 15895, 15837, 15779, 15722, 15666, 15610, 15555, 15501,
+        15447, 15394, 15341, 15289, 15237, 15186, 15135, 15085, 15035, 14986, 14937, 14889,
+        14841, 14794, 14747, 14700, 14654, 14609, 14564, 14519, 14474, 14431, 14387, 14344,
+        14301, 14259, 14217, 14175, 14134, 14093, 14052, 14012, 13972, 13933, 13894, 13855,
+        13816, 13778, 13740, 13702, 13665, 13628, 13592, 13555, 13519, 13483, 13448, 13412,
+        13377, 13343, 13308, 13274, 13240, 13207, 13173, 13140, 13107, 13075, 13042, 13010,
+        12978, 12946, 12915, 12884, 12853, 12822, 12791, 12761, 12731, 12701, 12671, 12642,
+        12612, 12583, 12554, 12526, 12497, 12469, 12441, 12413, 12385, 12358, 12330, 12303,
+        12276, 12249, 12223, 12196, 12170, 12144, 12118, 12092, 12066, 12041, 12015, 11990,
+        11965, 11940, 11916, 11891, 11867, 11842, 11818, 11794, 11771, 11747, 11723, 11700,
+        11677, 11654, 11631, 11608, 11585,
+    },
+};
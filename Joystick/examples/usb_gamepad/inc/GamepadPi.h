@@ -0,0 +1,154 @@
+#ifndef GAMEPAD_PI_H
+#define GAMEPAD_PI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "inc/JoystickPi.h"
+#include "inc/ButtonPi.h"
+#include "inc/joystick_direction.h"
+#include "inc/gamepad_report.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file GamepadPi.h
+ * @brief Gamepad USB HID (classe TinyUSB) com o joystick e os botões da BitDogLab
+ *
+ * O gamepad expõe os eixos normalizados da JoystickPi, até 8 botões (o do joystick e outros
+ * lidos pela ButtonPi) e um chapéu de 8 direções dado pelo detector de direção com histerese.
+ * O endpoint é consultado pelo computador a cada 1 ms (bInterval = 1 em full speed).
+ *
+ * O relatório é montado no início de cada quadro USB (SOF), a partir do estado que o motor de
+ * amostragem da JoystickPi já mantém atualizado pelo DMA: montar um relatório não toca no ADC,
+ * só lê o par mais recente, aplica a calibração e compara alguns bits. Ele só é enviado quando
+ * muda, e o computador mantém o último recebido.
+ *
+ * Os botões têm debounce sem atraso: a primeira borda é enviada na hora e as seguintes são
+ * ignoradas durante `debounce_us`.
+ *
+ * Funcionalidades:
+ * 1. Descritores de dispositivo, configuração, HID e strings para o TinyUSB.
+ * 2. Montagem do relatório a partir do motor de amostragem, a cada quadro de 1 ms.
+ * 3. Estatísticas de quadros, relatórios enviados e custo de montagem.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Intervalo de consulta do endpoint HID, em quadros de 1 ms.
+ */
+#define GAMEPAD_POLL_INTERVAL_MS 1
+
+/**
+ * @brief Botões A e B da BitDogLab, usados pela configuração padrão como botões 2 e 3.
+ */
+#define GAMEPAD_BUTTON_A_PIN 5
+#define GAMEPAD_BUTTON_B_PIN 6
+
+/**
+ * @brief Identificação USB (VID de testes do TinyUSB).
+ */
+#define GAMEPAD_USB_VID 0xCAFE
+#define GAMEPAD_USB_PID 0x4011
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Configuração do gamepad.
+ */
+typedef struct {
+    JoystickPi_t *stick;                             // Joystick dos eixos e do botão 1 (NULL = joystick padrão)
+    uint button_pins[GAMEPAD_MAX_BUTTONS - 1];       // Pinos dos botões 2 em diante (ButtonPi)
+    uint button_count;                               // Quantidade de pinos em `button_pins`
+    uint32_t debounce_us;                            // Tempo em que bordas seguidas de um botão são ignoradas
+    bool hat;                                        // Envia o chapéu de 8 direções
+} GamepadPi_config_t;
+
+/**
+ * @brief Estatísticas do gamepad.
+ */
+typedef struct {
+    uint32_t frames;          // Quadros USB (SOF) recebidos
+    uint32_t reports;         // Relatórios enviados
+    uint32_t unchanged;       // Quadros em que o relatório não mudou
+    uint32_t busy;            // Quadros em que o endpoint ainda não tinha liberado o anterior
+    uint32_t build_max_us;    // Maior tempo de montagem de um relatório
+} gamepad_stats_t;
+
+/**
+ * @brief Estado de um gamepad.
+ */
+typedef struct {
+    JoystickPi_t *stick;
+    ButtonPi buttons[GAMEPAD_MAX_BUTTONS - 1];
+    uint button_count;
+    uint32_t debounce_us;
+    bool hat;
+    uint8_t stable;                                  // Botões após o debounce
+    uint32_t changed_at[GAMEPAD_MAX_BUTTONS];        // Instante da última borda aceita de cada botão
+    joystick_tracker_t tracker;
+    gamepad_report_t report;                         // Último relatório montado
+    gamepad_report_t sent;                           // Último relatório enviado
+    bool has_sent;
+    volatile bool frame_pending;                     // Chegou um SOF ainda não atendido
+    gamepad_stats_t stats;
+} GamepadPi;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche a configuração da BitDogLab: joystick padrão, botões A e B, debounce de 5 ms e chapéu.
+ *
+ * @param config Configuração a ser preenchida.
+ */
+void GamepadPi_config_default(GamepadPi_config_t *config);
+
+/**
+ * @brief Inicializa os botões e a pilha USB e passa a responder como gamepad.
+ *
+ * O joystick já deve estar inicializado; com o motor de amostragem ligado, montar um relatório
+ * não faz conversões do ADC. Só um gamepad pode estar ativo.
+ *
+ * @param gp Gamepad a ser inicializado.
+ * @param config Configuração, ou NULL para a padrão.
+ * @return false se já há um gamepad ativo.
+ */
+bool GamepadPi_init(GamepadPi *gp, const GamepadPi_config_t *config);
+
+/**
+ * @brief Atende a pilha USB e, a cada quadro, envia o relatório se ele mudou.
+ *
+ * Deve ser chamada continuamente no laço principal.
+ *
+ * @param gp Gamepad inicializado.
+ */
+void GamepadPi_task(GamepadPi *gp);
+
+/**
+ * @brief Monta o relatório com o estado atual do joystick e dos botões.
+ *
+ * @param gp Gamepad inicializado.
+ * @param report Relatório montado.
+ */
+void GamepadPi_build_report(GamepadPi *gp, gamepad_report_t *report);
+
+/**
+ * @brief Indica se o computador já configurou o dispositivo.
+ */
+bool GamepadPi_connected(GamepadPi *gp);
+
+/**
+ * @brief Copia as estatísticas do gamepad.
+ */
+void GamepadPi_get_stats(GamepadPi *gp, gamepad_stats_t *stats);
+
+#endif // GAMEPAD_PI_H
@@ -0,0 +1,96 @@
+#ifndef GAMEPAD_REPORT_H
+#define GAMEPAD_REPORT_H
+
+#include <stdint.h>
+#include "inc/joystick_direction.h"
+
+/**
+ * @file gamepad_report.h
+ * @brief Descritor HID e relatório de entrada do gamepad USB (eixos, botões e chapéu).
+ *
+ * Não depende do TinyUSB nem do SDK, para que o descritor e o layout dos bytes possam ser
+ * decodificados e conferidos no host. O relatório não usa Report ID; seus campos seguem a ordem
+ * do descritor:
+ *
+ * | Byte | Campo | Faixa |
+ * |---|---|---|
+ * | 0-1 | X (int16, little-endian) | -32767 a 32767, positivo para a direita |
+ * | 2-3 | Y (int16, little-endian) | -32767 a 32767, positivo para baixo (convenção HID) |
+ * | 4 | Botões 1 a 8 (bit 0 = botão 1) | 0 ou 1 por bit |
+ * | 5 | Chapéu (4 bits baixos) + 4 bits de preenchimento | 0 (cima) a 7 no sentido horário, 8 = solto |
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Tamanho do relatório de entrada, em bytes.
+ */
+#define GAMEPAD_REPORT_SIZE 6
+
+/**
+ * @brief Tamanho do descritor de relatório, em bytes (constante para os descritores do TinyUSB).
+ */
+#define GAMEPAD_REPORT_DESCRIPTOR_SIZE 69
+
+/**
+ * @brief Quantidade de botões no relatório.
+ */
+#define GAMEPAD_MAX_BUTTONS 8
+
+/**
+ * @brief Valor do chapéu fora da faixa lógica (0 a 7): nenhuma direção.
+ */
+#define GAMEPAD_HAT_NULL 8
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Relatório de entrada, na ordem e no tamanho exatos dos bytes enviados.
+ */
+typedef struct {
+    int16_t x;        // Eixo X normalizado
+    int16_t y;        // Eixo Y normalizado, com o sinal do HID (positivo para baixo)
+    uint8_t buttons;  // Bit n = botão n + 1
+    uint8_t hat;      // Direção do chapéu (GAMEPAD_HAT_NULL = solto)
+} gamepad_report_t;
+
+_Static_assert(sizeof(gamepad_report_t) == GAMEPAD_REPORT_SIZE, "relatório do gamepad deve ter 6 bytes");
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Descritor de relatório HID do gamepad.
+ */
+extern const uint8_t gamepad_report_descriptor[GAMEPAD_REPORT_DESCRIPTOR_SIZE];
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Valor do chapéu HID para uma direção do detector.
+ *
+ * @param direction Direção (JOYSTICK_DIR_CENTER vira GAMEPAD_HAT_NULL).
+ * @return 0 (cima) a 7, no sentido horário, ou GAMEPAD_HAT_NULL.
+ */
+uint8_t gamepad_hat(joystick_direction_t direction);
+
+/**
+ * @brief Preenche um relatório a partir dos eixos normalizados da JoystickPi.
+ *
+ * @param report Relatório a ser preenchido.
+ * @param x_norm Eixo X (positivo para a direita), de -32767 a 32767.
+ * @param y_norm Eixo Y (positivo para cima), de -32767 a 32767; é invertido para o HID.
+ * @param buttons Máscara dos botões pressionados (bit 0 = botão 1).
+ * @param direction Direção do chapéu.
+ */
+void gamepad_report_pack(gamepad_report_t *report, int16_t x_norm, int16_t y_norm, uint8_t buttons,
+                         joystick_direction_t direction);
+
+#endif // GAMEPAD_REPORT_H
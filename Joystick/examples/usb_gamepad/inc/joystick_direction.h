@@ -0,0 +1,151 @@
+#ifndef JOYSTICK_DIRECTION_H
+#define JOYSTICK_DIRECTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file joystick_direction.h
+ * @brief Detector de direção (8 setores) e zona radial do joystick, orientado a eventos.
+ *
+ * Recebe os eixos centrados na escala de ±32767 (a mesma de `x_norm`/`y_norm` da JoystickPi),
+ * calcula o ângulo por uma tabela de arco-tangente em ponto fixo e só troca de setor ou de
+ * zona depois de atravessar uma faixa de histerese, evitando a oscilação nas fronteiras.
+ * Cada troca é avisada por callback, para que o programa só trabalhe quando algo mudar.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Volta completa na unidade de ângulo do detector (ângulo binário de 16 bits).
+ */
+#define JOYSTICK_ANGLE_TURN 65536
+
+/**
+ * @brief Largura de cada um dos 8 setores de direção (45°).
+ */
+#define JOYSTICK_ANGLE_SECTOR (JOYSTICK_ANGLE_TURN / 8)
+
+/**
+ * @brief Máscaras dos eventos, devolvidas por `joystick_tracker_update`.
+ */
+#define JOYSTICK_EVENT_DIRECTION_CHANGED (1u << 0)
+#define JOYSTICK_EVENT_ZONE_CHANGED (1u << 1)
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Direção do joystick. Os setores seguem o sentido anti-horário a partir da direita.
+ */
+typedef enum {
+    JOYSTICK_DIR_CENTER,      // Dentro da zona central
+    JOYSTICK_DIR_RIGHT,
+    JOYSTICK_DIR_UP_RIGHT,
+    JOYSTICK_DIR_UP,
+    JOYSTICK_DIR_UP_LEFT,
+    JOYSTICK_DIR_LEFT,
+    JOYSTICK_DIR_DOWN_LEFT,
+    JOYSTICK_DIR_DOWN,
+    JOYSTICK_DIR_DOWN_RIGHT
+} joystick_direction_t;
+
+/**
+ * @brief Zona radial do joystick.
+ */
+typedef enum {
+    JOYSTICK_ZONE_CENTER,     // Em repouso: sem direção
+    JOYSTICK_ZONE_ACTIVE,     // Inclinado
+    JOYSTICK_ZONE_EDGE,       // Encostado no limite do curso
+    JOYSTICK_ZONE_COUNT
+} joystick_zone_t;
+
+/**
+ * @brief Evento entregue ao callback do detector.
+ */
+typedef struct {
+    uint32_t type;                   // JOYSTICK_EVENT_DIRECTION_CHANGED ou JOYSTICK_EVENT_ZONE_CHANGED
+    joystick_direction_t direction;  // Direção atual
+    joystick_direction_t previous;   // Direção antes do evento
+    joystick_zone_t zone;            // Zona atual
+    joystick_zone_t previous_zone;   // Zona antes do evento
+    uint16_t angle;                  // Ângulo atual (JOYSTICK_ANGLE_TURN = 360°)
+} joystick_direction_event_t;
+
+/**
+ * @brief Callback chamado a cada troca de direção ou de zona.
+ */
+typedef void (*joystick_direction_callback_t)(const joystick_direction_event_t *event, void *user_data);
+
+/**
+ * @brief Limiares do detector, na escala de ±32767 dos eixos.
+ */
+typedef struct {
+    uint16_t center_radius;       // Raio que separa a zona central da ativa
+    uint16_t edge_radius;         // Raio que separa a zona ativa da borda
+    uint16_t radial_hysteresis;   // Meia largura da faixa de histerese em volta de cada raio
+    uint16_t angular_hysteresis;  // Quanto o ângulo pode passar da fronteira do setor sem trocá-lo
+} joystick_tracker_config_t;
+
+/**
+ * @brief Estado de um detector.
+ */
+typedef struct {
+    uint32_t center_enter_r2;     // Raio² abaixo do qual volta para a zona central
+    uint32_t active_enter_r2;     // Raio² acima do qual sai da zona central
+    uint32_t active_return_r2;    // Raio² abaixo do qual sai da borda
+    uint32_t edge_enter_r2;       // Raio² acima do qual entra na borda
+    uint16_t angular_hysteresis;
+    joystick_direction_t direction;
+    joystick_zone_t zone;
+    uint16_t angle;
+    joystick_direction_callback_t callback;
+    void *user_data;
+} joystick_tracker_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche os limiares padrão: centro em 25% do curso, borda em 85%, histerese radial
+ * de 4% e angular de ~5,6°.
+ *
+ * @param config Limiares a serem preenchidos.
+ */
+void joystick_tracker_config_defaults(joystick_tracker_config_t *config);
+
+/**
+ * @brief Inicializa um detector na zona central.
+ *
+ * @param tracker Detector a ser inicializado.
+ * @param config Limiares, ou NULL para os padrões.
+ * @param callback Função chamada a cada evento (pode ser NULL).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_tracker_init(joystick_tracker_t *tracker, const joystick_tracker_config_t *config,
+                           joystick_direction_callback_t callback, void *user_data);
+
+/**
+ * @brief Atualiza o detector com uma nova leitura e dispara os eventos de troca.
+ *
+ * @param tracker Detector.
+ * @param x Eixo X centrado (positivo para a direita).
+ * @param y Eixo Y centrado (positivo para cima).
+ * @return Máscara dos eventos disparados (0 se nada mudou).
+ */
+uint32_t joystick_tracker_update(joystick_tracker_t *tracker, int16_t x, int16_t y);
+
+/**
+ * @brief Ângulo do vetor (x, y), no sentido anti-horário a partir da direita.
+ *
+ * @param x Eixo X centrado.
+ * @param y Eixo Y centrado.
+ * @return Ângulo com JOYSTICK_ANGLE_TURN = 360° (erro menor que 0,02°).
+ */
+uint16_t joystick_angle(int16_t x, int16_t y);
+
+#endif // JOYSTICK_DIRECTION_H
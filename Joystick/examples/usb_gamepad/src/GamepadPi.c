@@ -0,0 +1,320 @@
+#include <string.h>
+#include "inc/GamepadPi.h"
+#include "tusb.h"
+#include "pico/unique_id.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file GamepadPi.c
+ * @brief Implementação do gamepad USB HID sobre o TinyUSB, a JoystickPi e a ButtonPi
+ *
+ * Os descritores e os callbacks exigidos pelo TinyUSB ficam aqui. O SOF (início de quadro,
+ * a cada 1 ms) só marca o quadro como pendente; o relatório é montado e enviado em
+ * `GamepadPi_task`, fora do contexto da pilha USB.
+ */
+
+/******************************
+ * Descritores USB
+ ******************************/
+
+enum {
+    ITF_NUM_HID,
+    ITF_NUM_TOTAL
+};
+
+enum {
+    STRID_LANGID,
+    STRID_MANUFACTURER,
+    STRID_PRODUCT,
+    STRID_SERIAL,
+    STRID_COUNT
+};
+
+#define EPNUM_HID 0x81
+#define CONFIG_TOTAL_LEN (TUD_CONFIG_DESC_LEN + TUD_HID_DESC_LEN)
+
+// Maior string aceita, em caracteres
+#define STRING_MAX_CHARS 32
+
+static const tusb_desc_device_t desc_device = {
+    .bLength = sizeof(tusb_desc_device_t),
+    .bDescriptorType = TUSB_DESC_DEVICE,
+    .bcdUSB = 0x0200,
+    .bDeviceClass = 0x00, // Classe definida na interface
+    .bDeviceSubClass = 0x00,
+    .bDeviceProtocol = 0x00,
+    .bMaxPacketSize0 = CFG_TUD_ENDPOINT0_SIZE,
+    .idVendor = GAMEPAD_USB_VID,
+    .idProduct = GAMEPAD_USB_PID,
+    .bcdDevice = 0x0100,
+    .iManufacturer = STRID_MANUFACTURER,
+    .iProduct = STRID_PRODUCT,
+    .iSerialNumber = STRID_SERIAL,
+    .bNumConfigurations = 1,
+};
+
+static const uint8_t desc_configuration[] = {
+    TUD_CONFIG_DESCRIPTOR(1, ITF_NUM_TOTAL, 0, CONFIG_TOTAL_LEN, 0, 100),
+    TUD_HID_DESCRIPTOR(ITF_NUM_HID, 0, HID_ITF_PROTOCOL_NONE, GAMEPAD_REPORT_DESCRIPTOR_SIZE, EPNUM_HID,
+                       CFG_TUD_HID_EP_BUFSIZE, GAMEPAD_POLL_INTERVAL_MS),
+};
+
+static const char *const string_table[STRID_COUNT] = {
+    [STRID_MANUFACTURER] = "BitDogLab",
+    [STRID_PRODUCT] = "BitDogLab Gamepad",
+};
+
+static uint16_t desc_string[STRING_MAX_CHARS + 1];
+
+/******************************
+ * Variáveis Globais
+ ******************************/
+
+/**
+ * @brief Gamepad atendido pelos callbacks do TinyUSB.
+ */
+static GamepadPi *gamepad_active;
+
+/******************************
+ * Callbacks do TinyUSB
+ ******************************/
+
+uint8_t const *tud_descriptor_device_cb(void) {
+    return (uint8_t const *)&desc_device;
+}
+
+uint8_t const *tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return desc_configuration;
+}
+
+uint16_t const *tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+    uint count;
+    if (index == STRID_LANGID) {
+        desc_string[1] = 0x0409; // Inglês (EUA), o idioma que os sistemas pedem por padrão
+        count = 1;
+    } else if (index < STRID_COUNT) {
+        // Número de série tirado do identificador único da flash
+        char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+        const char *str = string_table[index];
+        if (index == STRID_SERIAL) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            str = serial;
+        }
+        count = strlen(str);
+        if (count > STRING_MAX_CHARS) {
+            count = STRING_MAX_CHARS;
+        }
+        for (uint i = 0; i < count; i++) {
+            desc_string[1 + i] = (uint8_t)str[i];
+        }
+    } else {
+        return NULL;
+    }
+    desc_string[0] = (uint16_t)((TUSB_DESC_STRING << 8) | (2 * count + 2));
+    return desc_string;
+}
+
+uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance) {
+    (void)instance;
+    return gamepad_report_descriptor;
+}
+
+uint16_t tud_hid_get_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                               uint8_t *buffer, uint16_t reqlen) {
+    (void)instance;
+    (void)report_id;
+    if (!gamepad_active || report_type != HID_REPORT_TYPE_INPUT || reqlen < sizeof(gamepad_report_t)) {
+        return 0;
+    }
+    memcpy(buffer, &gamepad_active->report, sizeof(gamepad_report_t));
+    return sizeof(gamepad_report_t);
+}
+
+void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id, hid_report_type_t report_type,
+                           uint8_t const *buffer, uint16_t bufsize) {
+    // O gamepad não tem saídas (LEDs, vibração)
+    (void)instance;
+    (void)report_id;
+    (void)report_type;
+    (void)buffer;
+    (void)bufsize;
+}
+
+void tud_mount_cb(void) {
+    // Reenvia o estado completo depois de uma nova enumeração
+    if (gamepad_active) {
+        gamepad_active->has_sent = false;
+    }
+}
+
+void tud_sof_cb(uint32_t frame_count) {
+    (void)frame_count;
+    if (gamepad_active) {
+        gamepad_active->frame_pending = true;
+        gamepad_active->stats.frames++;
+    }
+}
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Debounce sem atraso: aceita a borda na hora e ignora as seguintes durante `debounce_us`.
+ */
+static uint8_t debounce_buttons(GamepadPi *gp, uint8_t raw, uint32_t now) {
+    uint8_t changed = raw ^ gp->stable;
+    while (changed) {
+        uint bit = __builtin_ctz(changed);
+        changed &= changed - 1;
+        if (now - gp->changed_at[bit] >= gp->debounce_us) {
+            gp->stable ^= 1u << bit;
+            gp->changed_at[bit] = now;
+        }
+    }
+    return gp->stable;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche a configuração da BitDogLab.
+ *
+ * @param config Configuração a ser preenchida.
+ */
+void GamepadPi_config_default(GamepadPi_config_t *config) {
+    memset(config, 0, sizeof(*config));
+    config->stick = NULL;
+    config->button_pins[0] = GAMEPAD_BUTTON_A_PIN;
+    config->button_pins[1] = GAMEPAD_BUTTON_B_PIN;
+    config->button_count = 2;
+    config->debounce_us = 5000;
+    config->hat = true;
+}
+
+/**
+ * @brief Inicializa os botões e a pilha USB.
+ *
+ * @param gp Gamepad a ser inicializado.
+ * @param config Configuração, ou NULL para a padrão.
+ * @return false se já há um gamepad ativo.
+ */
+bool GamepadPi_init(GamepadPi *gp, const GamepadPi_config_t *config) {
+    if (gamepad_active) {
+        return false;
+    }
+
+    GamepadPi_config_t defaults;
+    if (!config) {
+        GamepadPi_config_default(&defaults);
+        config = &defaults;
+    }
+
+    memset(gp, 0, sizeof(*gp));
+    gp->stick = config->stick;
+    gp->button_count = config->button_count < GAMEPAD_MAX_BUTTONS - 1 ? config->button_count
+                                                                       : GAMEPAD_MAX_BUTTONS - 1;
+    for (uint i = 0; i < gp->button_count; i++) {
+        ButtonPi_init(&gp->buttons[i], config->button_pins[i]);
+    }
+    gp->debounce_us = config->debounce_us;
+    gp->hat = config->hat;
+
+    // Primeira borda de cada botão aceita de imediato
+    uint32_t now = time_us_32();
+    for (uint i = 0; i < GAMEPAD_MAX_BUTTONS; i++) {
+        gp->changed_at[i] = now - gp->debounce_us;
+    }
+    joystick_tracker_init(&gp->tracker, NULL, NULL, NULL);
+    gamepad_report_pack(&gp->report, 0, 0, 0, JOYSTICK_DIR_CENTER);
+
+    gamepad_active = gp;
+    tusb_init();
+    tud_sof_cb_enable(true); // Um callback por quadro de 1 ms
+    return true;
+}
+
+/**
+ * @brief Atende a pilha USB e envia o relatório do quadro, se mudou.
+ *
+ * @param gp Gamepad inicializado.
+ */
+void GamepadPi_task(GamepadPi *gp) {
+    tud_task();
+    if (!gp->frame_pending) {
+        return;
+    }
+    gp->frame_pending = false;
+
+    if (!tud_hid_ready()) {
+        gp->stats.busy++;
+        return;
+    }
+
+    uint32_t start = time_us_32();
+    GamepadPi_build_report(gp, &gp->report);
+    uint32_t elapsed = time_us_32() - start;
+    if (elapsed > gp->stats.build_max_us) {
+        gp->stats.build_max_us = elapsed;
+    }
+
+    if (gp->has_sent && memcmp(&gp->report, &gp->sent, sizeof(gamepad_report_t)) == 0) {
+        gp->stats.unchanged++;
+        return;
+    }
+    if (tud_hid_report(0, &gp->report, sizeof(gamepad_report_t))) {
+        gp->sent = gp->report;
+        gp->has_sent = true;
+        gp->stats.reports++;
+    }
+}
+
+/**
+ * @brief Monta o relatório com o estado atual do joystick e dos botões.
+ *
+ * Com o motor de amostragem ligado, a leitura do joystick só copia o par mais recente do DMA.
+ *
+ * @param gp Gamepad inicializado.
+ * @param report Relatório montado.
+ */
+void GamepadPi_build_report(GamepadPi *gp, gamepad_report_t *report) {
+    joystick_state_t state = gp->stick ? JoystickPi_read(gp->stick) : joystickPi_read();
+
+    // Botão 1 é o do joystick; os demais seguem a ordem de `button_pins`
+    uint8_t raw = state.button ? 1u : 0u;
+    for (uint i = 0; i < gp->button_count; i++) {
+        if (ButtonPi_read(&gp->buttons[i])) {
+            raw |= (uint8_t)(1u << (i + 1));
+        }
+    }
+    uint8_t buttons = debounce_buttons(gp, raw, time_us_32());
+
+    joystick_direction_t direction = JOYSTICK_DIR_CENTER;
+    if (gp->hat) {
+        joystick_tracker_update(&gp->tracker, state.x_norm, state.y_norm);
+        direction = gp->tracker.direction;
+    }
+    gamepad_report_pack(report, state.x_norm, state.y_norm, buttons, direction);
+}
+
+/**
+ * @brief Indica se o computador já configurou o dispositivo.
+ */
+bool GamepadPi_connected(GamepadPi *gp) {
+    (void)gp;
+    return tud_mounted() && !tud_suspended();
+}
+
+/**
+ * @brief Copia as estatísticas do gamepad.
+ */
+void GamepadPi_get_stats(GamepadPi *gp, gamepad_stats_t *stats) {
+    *stats = gp->stats;
+}
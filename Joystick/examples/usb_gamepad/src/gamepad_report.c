@@ -0,0 +1,95 @@
+#include "inc/gamepad_report.h"
+
+/**
+ * Arquivo: gamepad_report.c
+ *
+ * Descrição:
+ * Descritor HID do gamepad e montagem do relatório de entrada. O descritor é escrito item a
+ * item (prefixo + dados little-endian), sem as macros do TinyUSB, para compilar também no host.
+ */
+
+/******************************
+ * Descritor de Relatório
+ ******************************/
+
+// Sem tamanho explícito: se a contagem divergir de GAMEPAD_REPORT_DESCRIPTOR_SIZE, o tipo conflita com o do cabeçalho
+const uint8_t gamepad_report_descriptor[] = {
+    0x05, 0x01,              // Usage Page (Generic Desktop)
+    0x09, 0x05,              // Usage (Game Pad)
+    0xA1, 0x01,              // Collection (Application)
+
+    // Eixos X e Y: 16 bits com sinal, simétricos como x_norm/y_norm
+    0x09, 0x01,              //   Usage (Pointer)
+    0xA1, 0x00,              //   Collection (Physical)
+    0x09, 0x30,              //     Usage (X)
+    0x09, 0x31,              //     Usage (Y)
+    0x16, 0x01, 0x80,        //     Logical Minimum (-32767)
+    0x26, 0xFF, 0x7F,        //     Logical Maximum (32767)
+    0x75, 0x10,              //     Report Size (16)
+    0x95, 0x02,              //     Report Count (2)
+    0x81, 0x02,              //     Input (Data, Variable, Absolute)
+    0xC0,                    //   End Collection
+
+    // Botões 1 a 8, um bit cada
+    0x05, 0x09,              //   Usage Page (Button)
+    0x19, 0x01,              //   Usage Minimum (1)
+    0x29, GAMEPAD_MAX_BUTTONS, //   Usage Maximum (8)
+    0x15, 0x00,              //   Logical Minimum (0)
+    0x25, 0x01,              //   Logical Maximum (1)
+    0x75, 0x01,              //   Report Size (1)
+    0x95, GAMEPAD_MAX_BUTTONS, //   Report Count (8)
+    0x81, 0x02,              //   Input (Data, Variable, Absolute)
+
+    // Chapéu de 8 direções (0 a 315 graus), com estado nulo fora da faixa
+    0x05, 0x01,              //   Usage Page (Generic Desktop)
+    0x09, 0x39,              //   Usage (Hat Switch)
+    0x15, 0x00,              //   Logical Minimum (0)
+    0x25, 0x07,              //   Logical Maximum (7)
+    0x35, 0x00,              //   Physical Minimum (0)
+    0x46, 0x3B, 0x01,        //   Physical Maximum (315)
+    0x65, 0x14,              //   Unit (English Rotation: graus)
+    0x75, 0x04,              //   Report Size (4)
+    0x95, 0x01,              //   Report Count (1)
+    0x81, 0x42,              //   Input (Data, Variable, Absolute, Null State)
+    0x65, 0x00,              //   Unit (None)
+    0x81, 0x03,              //   Input (Constant): 4 bits de preenchimento
+    0xC0,                    // End Collection
+};
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Valor do chapéu HID para uma direção do detector.
+ *
+ * O detector conta os setores no sentido anti-horário a partir da direita; o chapéu conta no
+ * sentido horário a partir de cima.
+ *
+ * @param direction Direção (JOYSTICK_DIR_CENTER vira GAMEPAD_HAT_NULL).
+ * @return 0 (cima) a 7, no sentido horário, ou GAMEPAD_HAT_NULL.
+ */
+uint8_t gamepad_hat(joystick_direction_t direction) {
+    if (direction == JOYSTICK_DIR_CENTER) {
+        return GAMEPAD_HAT_NULL;
+    }
+    unsigned sector = direction - JOYSTICK_DIR_RIGHT; // 0 = direita, 2 = cima
+    return (uint8_t)((10 - sector) & 7);
+}
+
+/**
+ * @brief Preenche um relatório a partir dos eixos normalizados da JoystickPi.
+ *
+ * @param report Relatório a ser preenchido.
+ * @param x_norm Eixo X (positivo para a direita), de -32767 a 32767.
+ * @param y_norm Eixo Y (positivo para cima), de -32767 a 32767; é invertido para o HID.
+ * @param buttons Máscara dos botões pressionados (bit 0 = botão 1).
+ * @param direction Direção do chapéu.
+ */
+void gamepad_report_pack(gamepad_report_t *report, int16_t x_norm, int16_t y_norm, uint8_t buttons,
+                         joystick_direction_t direction) {
+    report->x = x_norm;
+    report->y = (int16_t)-y_norm;
+    report->buttons = buttons;
+    report->hat = gamepad_hat(direction);
+}
@@ -0,0 +1,31 @@
+#ifndef TUSB_CONFIG_H
+#define TUSB_CONFIG_H
+
+/**
+ * @file tusb_config.h
+ * @brief Configuração do TinyUSB para o gamepad: só o modo dispositivo, com uma interface HID.
+ */
+
+#ifndef CFG_TUSB_MCU
+#error CFG_TUSB_MCU deve ser definido pelo SDK
+#endif
+
+#define CFG_TUSB_RHPORT0_MODE OPT_MODE_DEVICE
+#define CFG_TUD_ENABLED 1
+
+#ifndef CFG_TUSB_OS
+#define CFG_TUSB_OS OPT_OS_PICO
+#endif
+
+#define CFG_TUD_ENDPOINT0_SIZE 64
+
+// Uma interface HID; o relatório de 6 bytes cabe com folga no endpoint
+#define CFG_TUD_HID 1
+#define CFG_TUD_HID_EP_BUFSIZE 16
+
+#define CFG_TUD_CDC 0
+#define CFG_TUD_MSC 0
+#define CFG_TUD_MIDI 0
+#define CFG_TUD_VENDOR 0
+
+#endif // TUSB_CONFIG_H
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "inc/JoystickPi.h"
+#include "inc/GamepadPi.h"
+
+// Montagens usadas para medir o custo médio de um relatório
+#define BUILD_TIMING_REPORTS 1000
+
+// Intervalo entre as estatísticas na UART
+#define STATS_INTERVAL_MS 1000
+
+int main() {
+    stdio_init_all(); // Mensagens pela UART0; a USB fica com o gamepad
+
+    // Eixos amostrados pelo DMA a 1 kHz com o filtro adaptativo: o relatório só copia o estado
+    joystickPi_init();
+    joystick_filter_params_t filter;
+    joystickPi_filter_defaults(&filter);
+    joystickPi_engine_start(1000);
+    joystickPi_engine_set_filter(&filter);
+
+    // Usa a calibração salva; no primeiro uso aprende o centro com o joystick em repouso e grava
+    if (!joystickPi_calibration_load()) {
+        joystickPi_calibrate_center(200);
+        joystickPi_calibration_save();
+    }
+    joystickPi_calibration_set_auto(true);
+
+    // Joystick (botão 1), A (botão 2), B (botão 3) e chapéu de 8 direções
+    static GamepadPi gamepad;
+    GamepadPi_init(&gamepad, NULL);
+
+    // Custo de montar um relatório a partir do estado do motor
+    gamepad_report_t report;
+    uint64_t start = time_us_64();
+    for (uint i = 0; i < BUILD_TIMING_REPORTS; i++) {
+        GamepadPi_build_report(&gamepad, &report);
+    }
+    uint64_t elapsed = time_us_64() - start;
+    printf("Montagem do relatório: %.2f us\n", (double)elapsed / BUILD_TIMING_REPORTS);
+
+    gamepad_stats_t last = {0};
+    uint64_t next_stats = time_us_64() + STATS_INTERVAL_MS * 1000ull;
+    while (true) {
+        GamepadPi_task(&gamepad);
+
+        if (time_us_64() >= next_stats) {
+            next_stats += STATS_INTERVAL_MS * 1000ull;
+            gamepad_stats_t stats;
+            GamepadPi_get_stats(&gamepad, &stats);
+            printf("%s: %lu quadros/s, %lu relatórios/s, %lu sem mudança, %lu ocupado, montagem máx. %lu us"
+                   " | X %d Y %d botões %02x chapéu %u\n",
+                   GamepadPi_connected(&gamepad) ? "Conectado" : "Desconectado",
+                   (unsigned long)(stats.frames - last.frames), (unsigned long)(stats.reports - last.reports),
+                   (unsigned long)(stats.unchanged - last.unchanged), (unsigned long)(stats.busy - last.busy),
+                   (unsigned long)stats.build_max_us, gamepad.report.x, gamepad.report.y, gamepad.report.buttons,
+                   gamepad.report.hat);
+            last = stats;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include "fake_pico.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/flash.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file fake_pico.c
+ * @brief Implementação da camada falsa de ADC/GPIO/flash usada pelos testes de host da JoystickPi.
+ */
+
+/******************************
+ * Estado Simulado
+ ******************************/
+
+#define FAKE_ADC_CHANNELS 5
+#define FAKE_GPIO_COUNT 30
+
+static uint64_t now_us;
+static uint16_t adc_values[FAKE_ADC_CHANNELS];
+static uint adc_selected;
+static bool gpio_levels[FAKE_GPIO_COUNT];
+
+static adc_hw_t adc_regs;
+static dma_hw_t dma_regs;
+adc_hw_t *const adc_hw = &adc_regs;
+dma_hw_t *const dma_hw = &dma_regs;
+uint8_t fake_flash[PICO_FLASH_SIZE_BYTES];
+
+/******************************
+ * Controle da Camada Falsa
+ ******************************/
+
+void fake_pico_reset(void) {
+    now_us = 0;
+    adc_selected = 0;
+    for (uint i = 0; i < FAKE_ADC_CHANNELS; i++) {
+        adc_values[i] = 2048;
+    }
+    for (uint i = 0; i < FAKE_GPIO_COUNT; i++) {
+        gpio_levels[i] = true;
+    }
+    memset(&adc_regs, 0, sizeof(adc_regs));
+    memset(&dma_regs, 0, sizeof(dma_regs));
+    memset(fake_flash, 0xFF, sizeof(fake_flash));
+}
+
+void fake_adc_set(uint channel, uint16_t value) {
+    if (channel < FAKE_ADC_CHANNELS) {
+        adc_values[channel] = value & 0xFFF;
+    }
+}
+
+void fake_gpio_set(uint gpio, bool level) {
+    if (gpio < FAKE_GPIO_COUNT) {
+        gpio_levels[gpio] = level;
+    }
+}
+
+void fake_pico_advance_us(uint64_t us) {
+    now_us += us;
+}
+
+/******************************
+ * pico/stdlib
+ ******************************/
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_pull_up(uint gpio) { (void)gpio; }
+
+bool gpio_get(uint gpio) {
+    return gpio < FAKE_GPIO_COUNT ? gpio_levels[gpio] : false;
+}
+
+void sleep_ms(uint32_t ms) { now_us += (uint64_t)ms * 1000ull; }
+void sleep_us(uint64_t us) { now_us += us; }
+uint64_t time_us_64(void) { return now_us; }
+absolute_time_t get_absolute_time(void) { return now_us; }
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) { return (int64_t)(to - from); }
+void tight_loop_contents(void) { now_us++; }
+void stdio_init_all(void) {}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    out->delay_us = delay_us;
+    out->callback = callback;
+    out->user_data = user_data;
+    return true;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    timer->callback = NULL;
+    return true;
+}
+
+/******************************
+ * hardware/adc
+ ******************************/
+
+void adc_init(void) {}
+void adc_gpio_init(uint gpio) { (void)gpio; }
+
+void adc_select_input(uint input) {
+    adc_selected = input < FAKE_ADC_CHANNELS ? input : 0;
+}
+
+uint adc_get_selected_input(void) {
+    return adc_selected;
+}
+
+uint16_t adc_read(void) {
+    now_us += 2; // Uma conversão leva 96 ciclos de 48 MHz
+    return adc_values[adc_selected];
+}
+
+void adc_set_round_robin(uint input_mask) { (void)input_mask; }
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)en; (void)dreq_en; (void)dreq_thresh; (void)err_in_fifo; (void)byte_shift;
+}
+void adc_set_clkdiv(float clkdiv) { adc_regs.div = (uint32_t)(clkdiv * 256.0f); }
+void adc_run(bool run) { (void)run; }
+void adc_fifo_drain(void) {}
+void adc_set_temp_sensor_enabled(bool enable) { (void)enable; }
+
+/******************************
+ * hardware/dma e hardware/irq
+ ******************************/
+
+int dma_claim_unused_channel(bool required) { (void)required; return -1; }
+void dma_channel_unclaim(uint channel) { (void)channel; }
+dma_channel_config dma_channel_get_default_config(uint channel) { (void)channel; return (dma_channel_config){0}; }
+void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size) { (void)c; (void)size; }
+void channel_config_set_read_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_write_increment(dma_channel_config *c, bool incr) { (void)c; (void)incr; }
+void channel_config_set_dreq(dma_channel_config *c, uint dreq) { (void)c; (void)dreq; }
+void channel_config_set_chain_to(dma_channel_config *c, uint chain_to) { (void)c; (void)chain_to; }
+void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits) { (void)c; (void)write; (void)size_bits; }
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger) {
+    (void)channel; (void)config; (void)write_addr; (void)read_addr; (void)transfer_count; (void)trigger;
+}
+void dma_channel_set_read_addr(uint channel, const volatile void *read_addr, bool trigger) { (void)channel; (void)read_addr; (void)trigger; }
+void dma_channel_set_write_addr(uint channel, volatile void *write_addr, bool trigger) { (void)channel; (void)write_addr; (void)trigger; }
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger) { (void)channel; (void)trans_count; (void)trigger; }
+void dma_channel_abort(uint channel) { (void)channel; }
+void dma_channel_set_irq1_enabled(uint channel, bool enabled) { (void)channel; (void)enabled; }
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) { (void)num; (void)handler; (void)order_priority; }
+void irq_remove_handler(uint num, irq_handler_t handler) { (void)num; (void)handler; }
+void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
+
+/******************************
+ * hardware/sync, hardware/clocks e hardware/flash
+ ******************************/
+
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) { (void)status; }
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    return clk_index == clk_adc || clk_index == clk_usb ? 48000000u : FAKE_SYS_CLOCK_HZ;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    memset(fake_flash + flash_offs, 0xFF, count);
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    // Programar só leva bits de 1 para 0, como na flash real
+    for (size_t i = 0; i < count; i++) {
+        fake_flash[flash_offs + i] &= data[i];
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef FAKE_PICO_H
+#define FAKE_PICO_H
+
+#include "pico/stdlib.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file fake_pico.h
+ * @brief Camada falsa de ADC/GPIO/flash para executar a JoystickPi no Linux.
+ *
+ * O programa de teste define o valor de cada canal do ADC e o nível de cada pino antes de
+ * chamar a biblioteca. O relógio é virtual e só avança com `sleep_*`, `tight_loop_contents`
+ * e `fake_pico_advance_us`, o que torna as execuções determinísticas.
+ */
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Zera o relógio virtual, os canais do ADC (em 2048), os pinos (em nível alto) e a flash (em 0xFF).
+ */
+void fake_pico_reset(void);
+
+/**
+ * @brief Define o valor devolvido pelo ADC para um canal.
+ *
+ * @param channel Canal do ADC (0 a 4).
+ * @param value Valor de 12 bits.
+ */
+void fake_adc_set(uint channel, uint16_t value);
+
+/**
+ * @brief Define o nível lido em um pino.
+ *
+ * @param gpio Número do pino.
+ * @param level Nível lógico.
+ */
+void fake_gpio_set(uint gpio, bool level);
+
+/**
+ * @brief Avança o relógio virtual.
+ *
+ * @param us Intervalo em microssegundos.
+ */
+void fake_pico_advance_us(uint64_t us);
+
+#endif // FAKE_PICO_H
@@ -0,0 +1,46 @@
+#ifndef FAKE_HARDWARE_ADC_H
+#define FAKE_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file adc.h
+ * @brief ADC simulado.
+ *
+ * `adc_read` devolve o valor definido com `fake_adc_set` para o canal selecionado. O modo
+ * livre com FIFO e round-robin não é emulado; os registradores existem apenas para a
+ * biblioteca compilar.
+ */
+
+#define ADC_CS_READY_BITS 0x00000100u
+#define ADC_FCS_UNDER_BITS 0x00000400u
+#define ADC_FCS_OVER_BITS 0x00000800u
+#define ADC_TEMPERATURE_CHANNEL_NUM 4
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} adc_hw_t;
+
+extern adc_hw_t *const adc_hw;
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+uint adc_get_selected_input(void);
+uint16_t adc_read(void);
+void adc_set_round_robin(uint input_mask);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+void adc_set_temp_sensor_enabled(bool enable);
+
+#endif // FAKE_HARDWARE_ADC_H
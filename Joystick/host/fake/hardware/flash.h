@@ -0,0 +1,24 @@
+#ifndef FAKE_HARDWARE_FLASH_H
+#define FAKE_HARDWARE_FLASH_H
+
+#include "pico/stdlib.h"
+
+/**
+ * @file flash.h
+ * @brief Flash simulada.
+ *
+ * A flash é um vetor em RAM de `PICO_FLASH_SIZE_BYTES` bytes, e `XIP_BASE` aponta para ele,
+ * de modo que a leitura direta pelo endereço XIP funciona como no RP2040. Apagar grava 0xFF.
+ */
+
+#define FLASH_PAGE_SIZE (1u << 8)
+#define FLASH_SECTOR_SIZE (1u << 12)
+#define PICO_FLASH_SIZE_BYTES (4 * FLASH_SECTOR_SIZE)
+
+extern uint8_t fake_flash[PICO_FLASH_SIZE_BYTES];
+#define XIP_BASE ((uintptr_t)fake_flash)
+
+void flash_range_erase(uint32_t flash_offs, size_t count);
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count);
+
+#endif // FAKE_HARDWARE_FLASH_H
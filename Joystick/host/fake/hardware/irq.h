@@ -0,0 +1,15 @@
+#ifndef FAKE_HARDWARE_IRQ_H
+#define FAKE_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+// No host não há interrupções: os tratadores são aceitos e nunca chamados.
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_enabled(uint num, bool enabled);
+
+#endif // FAKE_HARDWARE_IRQ_H
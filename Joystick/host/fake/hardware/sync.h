@@ -0,0 +1,13 @@
+#ifndef FAKE_HARDWARE_SYNC_H
+#define FAKE_HARDWARE_SYNC_H
+
+#include "pico/stdlib.h"
+
+// No host não há interrupções: as seções críticas não fazem nada.
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+// Barreira de memória: no host as duas pontas da fila rodam na mesma thread.
+static inline void __dmb(void) {}
+
+#endif // FAKE_HARDWARE_SYNC_H
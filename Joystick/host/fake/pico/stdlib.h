@@ -0,0 +1,70 @@
+#ifndef FAKE_PICO_STDLIB_H
+#define FAKE_PICO_STDLIB_H
+
+/**
+ * @file stdlib.h
+ * @brief Substituto de `pico/stdlib.h` para a compilação da JoystickPi no Linux.
+ *
+ * Declara apenas o que a JoystickPi usa. O tempo é virtual: `sleep_ms` e `sleep_us` apenas avançam
+ * o relógio da camada falsa (`fake_pico.c`), e os pinos e canais do ADC devolvem os valores
+ * definidos pelo programa de teste.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define GPIO_IN 0
+#define GPIO_OUT 1
+
+#ifndef MIN
+#define MIN(a, b) ((b) < (a) ? (b) : (a))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) < (b) ? (b) : (a))
+#endif
+
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_pull_up(uint gpio);
+bool gpio_get(uint gpio);
+
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+uint64_t time_us_64(void);
+absolute_time_t get_absolute_time(void);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+
+/**
+ * @brief Em laços de espera ativa, avança o relógio virtual em 1 µs.
+ */
+void tight_loop_contents(void);
+
+void stdio_init_all(void);
+
+// Temporizadores periódicos: no host nunca disparam, o programa de teste chama a rotina diretamente
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+struct repeating_timer {
+    int64_t delay_us;
+    repeating_timer_callback_t callback;
+    void *user_data;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+
+// Acesso atômico aos registradores: no host basta a operação comum
+static inline void hw_set_bits(volatile uint32_t *addr, uint32_t mask) { *addr |= mask; }
+static inline void hw_clear_bits(volatile uint32_t *addr, uint32_t mask) { *addr &= ~mask; }
+static inline void hw_write_masked(volatile uint32_t *addr, uint32_t values, uint32_t mask) {
+    *addr = (*addr & ~mask) | (values & mask);
+}
+
+#endif // FAKE_PICO_STDLIB_H
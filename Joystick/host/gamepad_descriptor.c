@@ -0,0 +1,368 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fake_pico.h"
+#include "inc/JoystickPi.h"
+#include "inc/gamepad_report.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file gamepad_descriptor.c
+ * @brief Decodifica no host o descritor HID do gamepad USB e confere o layout do relatório.
+ *
+ * Interpreta `gamepad_report_descriptor` como faria o driver HID do computador (itens curtos,
+ * estado global e local, campos de entrada em ordem de bits) e exibe a tabela de campos. Em
+ * seguida confere que o tamanho e a posição de cada campo batem com `gamepad_report_t`, e
+ * decodifica relatórios montados por `gamepad_report_pack` pelo layout do descritor: eixos nos
+ * extremos (com o Y invertido para a convenção HID), cada botão e cada direção do chapéu.
+ * Retorna 1 se alguma verificação falhar.
+ */
+
+// Maior quantidade de campos e de usages locais tratados pelo decodificador
+#define MAX_FIELDS 64
+#define MAX_USAGES 16
+
+// Chamadas usadas na medição de tempo
+#define BENCH_CALLS 20000000
+
+/******************************
+ * Decodificador de Descritor HID
+ ******************************/
+
+/**
+ * @brief Um campo do relatório de entrada, como o driver HID o enxerga.
+ */
+typedef struct {
+    uint16_t usage_page;
+    uint16_t usage;
+    uint32_t bit_offset;
+    uint32_t bit_size;
+    int32_t logical_min;
+    int32_t logical_max;
+    int32_t physical_min;
+    int32_t physical_max;
+    bool constant;      // Preenchimento
+    bool null_state;    // Valores fora da faixa lógica significam "sem valor"
+} hid_field_t;
+
+typedef struct {
+    hid_field_t fields[MAX_FIELDS];
+    uint count;
+    uint32_t total_bits;
+    bool has_report_id;
+    int depth;          // Coleções abertas ao fim (deve ser 0)
+} hid_layout_t;
+
+static int32_t item_signed(const uint8_t *data, uint size) {
+    switch (size) {
+        case 1: return (int8_t)data[0];
+        case 2: return (int16_t)(data[0] | data[1] << 8);
+        case 4: return (int32_t)(data[0] | data[1] << 8 | data[2] << 16 | (uint32_t)data[3] << 24);
+        default: return 0;
+    }
+}
+
+static uint32_t item_unsigned(const uint8_t *data, uint size) {
+    uint32_t v = 0;
+    for (uint i = 0; i < size; i++) {
+        v |= (uint32_t)data[i] << (8 * i);
+    }
+    return v;
+}
+
+/**
+ * @brief Percorre o descritor e monta a lista de campos de entrada.
+ */
+static bool hid_parse(const uint8_t *desc, uint len, hid_layout_t *layout) {
+    struct {
+        uint16_t usage_page;
+        int32_t logical_min, logical_max, physical_min, physical_max;
+        uint32_t report_size, report_count;
+    } global = {0};
+    uint16_t usages[MAX_USAGES];
+    uint usage_count = 0;
+    uint32_t usage_min = 0, usage_max = 0;
+    bool has_range = false;
+
+    memset(layout, 0, sizeof(*layout));
+    for (uint pos = 0; pos < len;) {
+        uint8_t prefix = desc[pos++];
+        if (prefix == 0xFE) {
+            printf("Item longo não suportado na posição %u\n", pos - 1);
+            return false;
+        }
+        uint size = prefix & 3;
+        size = size == 3 ? 4 : size;
+        uint type = (prefix >> 2) & 3;
+        uint tag = prefix >> 4;
+        if (pos + size > len) {
+            printf("Item truncado na posição %u\n", pos - 1);
+            return false;
+        }
+        const uint8_t *data = &desc[pos];
+        pos += size;
+        uint32_t u = item_unsigned(data, size);
+        int32_t s = item_signed(data, size);
+
+        if (type == 1) { // Global
+            switch (tag) {
+                case 0: global.usage_page = (uint16_t)u; break;
+                case 1: global.logical_min = s; break;
+                case 2: global.logical_max = global.logical_min < 0 ? s : (int32_t)u; break;
+                case 3: global.physical_min = s; break;
+                case 4: global.physical_max = global.physical_min < 0 ? s : (int32_t)u; break;
+                case 7: global.report_size = u; break;
+                case 8: layout->has_report_id = true; break;
+                case 9: global.report_count = u; break;
+                default: break; // Unidade e expoente não mudam o layout
+            }
+        } else if (type == 2) { // Local
+            switch (tag) {
+                case 0: if (usage_count < MAX_USAGES) usages[usage_count++] = (uint16_t)u; break;
+                case 1: usage_min = u; has_range = true; break;
+                case 2: usage_max = u; has_range = true; break;
+                default: break;
+            }
+        } else if (type == 0) { // Main
+            if (tag == 0xA) {
+                layout->depth++;
+            } else if (tag == 0xC) {
+                layout->depth--;
+            } else if (tag == 0x8) { // Input
+                for (uint32_t i = 0; i < global.report_count; i++) {
+                    if (layout->count == MAX_FIELDS) {
+                        return false;
+                    }
+                    hid_field_t *f = &layout->fields[layout->count++];
+                    f->usage_page = global.usage_page;
+                    if (has_range) {
+                        f->usage = (uint16_t)(usage_min + i <= usage_max ? usage_min + i : usage_max);
+                    } else if (usage_count) {
+                        f->usage = usages[i < usage_count ? i : usage_count - 1];
+                    }
+                    f->bit_offset = layout->total_bits;
+                    f->bit_size = global.report_size;
+                    f->logical_min = global.logical_min;
+                    f->logical_max = global.logical_max;
+                    f->physical_min = global.physical_min;
+                    f->physical_max = global.physical_max;
+                    f->constant = u & 0x01;
+                    f->null_state = u & 0x40;
+                    layout->total_bits += global.report_size;
+                }
+            }
+            // Locais valem só até o próximo item principal
+            usage_count = 0;
+            has_range = false;
+        }
+    }
+    return true;
+}
+
+static const char *usage_name(const hid_field_t *f) {
+    static char buf[24];
+    if (f->constant) {
+        return "(preenchimento)";
+    }
+    if (f->usage_page == 0x01) {
+        switch (f->usage) {
+            case 0x30: return "X";
+            case 0x31: return "Y";
+            case 0x39: return "Chapéu";
+        }
+    } else if (f->usage_page == 0x09) {
+        snprintf(buf, sizeof(buf), "Botão %u", f->usage);
+        return buf;
+    }
+    snprintf(buf, sizeof(buf), "%02x:%02x", f->usage_page, f->usage);
+    return buf;
+}
+
+/**
+ * @brief Largura de `%-*s` que alinha `text` em `width` colunas, contando os acentos UTF-8 como um caractere.
+ */
+static int column_width(const char *text, int width) {
+    for (const char *c = text; *c; c++) {
+        width += ((uint8_t)*c & 0xC0) == 0x80;
+    }
+    return width;
+}
+
+static const hid_field_t *find_field(const hid_layout_t *layout, uint16_t page, uint16_t usage) {
+    for (uint i = 0; i < layout->count; i++) {
+        const hid_field_t *f = &layout->fields[i];
+        if (!f->constant && f->usage_page == page && f->usage == usage) {
+            return f;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Extrai um campo dos bytes do relatório, com extensão de sinal se a faixa lógica for negativa.
+ */
+static int32_t field_value(const hid_field_t *f, const uint8_t *report) {
+    uint32_t v = 0;
+    for (uint32_t b = 0; b < f->bit_size; b++) {
+        uint32_t bit = f->bit_offset + b;
+        v |= (uint32_t)((report[bit / 8] >> (bit % 8)) & 1) << b;
+    }
+    if (f->logical_min < 0 && f->bit_size < 32 && (v & (1u << (f->bit_size - 1)))) {
+        return (int32_t)(v | ~((1u << f->bit_size) - 1));
+    }
+    return (int32_t)v;
+}
+
+/******************************
+ * Verificações
+ ******************************/
+
+static int check(bool ok, const char *what) {
+    if (!ok) {
+        printf("ERRO: %s\n", what);
+    }
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief Confere a posição, o tamanho e a faixa de um campo.
+ */
+static int check_field(const hid_field_t *f, const char *name, size_t byte_offset, uint32_t bit, uint32_t bits,
+                       int32_t min, int32_t max) {
+    char what[96];
+    snprintf(what, sizeof(what), "campo %s no bit %zu com %u bits e faixa %d..%d", name, byte_offset * 8 + bit,
+             bits, min, max);
+    return check(f && f->bit_offset == byte_offset * 8 + bit && f->bit_size == bits && f->logical_min == min &&
+                 f->logical_max == max, what);
+}
+
+/**
+ * @brief Monta um relatório e o decodifica pelo layout do descritor.
+ */
+static int check_roundtrip(const hid_layout_t *layout, int16_t x_norm, int16_t y_norm, uint8_t buttons,
+                           joystick_direction_t direction) {
+    gamepad_report_t report;
+    gamepad_report_pack(&report, x_norm, y_norm, buttons, direction);
+    uint8_t bytes[GAMEPAD_REPORT_SIZE];
+    memcpy(bytes, &report, sizeof(bytes)); // RP2040 e host são little-endian, como o USB
+
+    int failures = 0;
+    failures += check(field_value(find_field(layout, 0x01, 0x30), bytes) == x_norm, "X decodificado");
+    failures += check(field_value(find_field(layout, 0x01, 0x31), bytes) == -y_norm, "Y decodificado (invertido)");
+    for (uint i = 0; i < GAMEPAD_MAX_BUTTONS; i++) {
+        failures += check(field_value(find_field(layout, 0x09, (uint16_t)(i + 1)), bytes) == ((buttons >> i) & 1),
+                          "botão decodificado");
+    }
+
+    // Chapéu: fora da faixa lógica no centro; senão, ângulo horário a partir de cima
+    const hid_field_t *hat = find_field(layout, 0x01, 0x39);
+    int32_t value = field_value(hat, bytes);
+    if (direction == JOYSTICK_DIR_CENTER) {
+        failures += check(value < hat->logical_min || value > hat->logical_max, "chapéu nulo no centro");
+    } else {
+        // Setores do detector: anti-horário a partir da direita, de 45 em 45 graus
+        int ccw_from_right = (direction - JOYSTICK_DIR_RIGHT) * 45;
+        int cw_from_up = ((90 - ccw_from_right) % 360 + 360) % 360;
+        int32_t degrees = hat->physical_min +
+                          value * (hat->physical_max - hat->physical_min) / (hat->logical_max - hat->logical_min);
+        failures += check(value >= hat->logical_min && value <= hat->logical_max && degrees == cw_from_up,
+                          "ângulo do chapéu");
+    }
+    return failures;
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/******************************
+ * Programa Principal
+ ******************************/
+
+int main(void) {
+    int failures = 0;
+    hid_layout_t layout;
+
+    if (!hid_parse(gamepad_report_descriptor, GAMEPAD_REPORT_DESCRIPTOR_SIZE, &layout)) {
+        printf("ERRO: descritor inválido\n");
+        return 1;
+    }
+
+    printf("Descritor HID: %u bytes, %u campos, relatório de %u bits\n\n", GAMEPAD_REPORT_DESCRIPTOR_SIZE,
+           layout.count, layout.total_bits);
+    printf("%-16s %6s %6s %*s %*s\n", "campo", "bit", "bits", column_width("lógico", 14), "lógico",
+           column_width("físico", 12), "físico");
+    for (uint i = 0; i < layout.count; i++) {
+        const hid_field_t *f = &layout.fields[i];
+        char logical[24] = "", physical[24] = "";
+        if (!f->constant) {
+            snprintf(logical, sizeof(logical), "%d..%d", f->logical_min, f->logical_max);
+        }
+        if (!f->constant && f->physical_max != 0) {
+            snprintf(physical, sizeof(physical), "%d..%d", f->physical_min, f->physical_max);
+        }
+        const char *name = usage_name(f);
+        printf("%-*s %6u %6u %14s %12s %s\n", column_width(name, 16), name, f->bit_offset, f->bit_size, logical,
+               physical, f->null_state ? "(nulo fora da faixa)" : "");
+    }
+    printf("\n");
+
+    // Estrutura do descritor
+    failures += check(layout.depth == 0, "coleções balanceadas");
+    failures += check(!layout.has_report_id, "relatório sem Report ID");
+    failures += check(layout.total_bits == 8 * sizeof(gamepad_report_t), "tamanho do relatório igual a gamepad_report_t");
+
+    // Posição de cada campo em gamepad_report_t
+    failures += check_field(find_field(&layout, 0x01, 0x30), "X", offsetof(gamepad_report_t, x), 0, 16,
+                            -JOYSTICK_NORM_MAX, JOYSTICK_NORM_MAX);
+    failures += check_field(find_field(&layout, 0x01, 0x31), "Y", offsetof(gamepad_report_t, y), 0, 16,
+                            -JOYSTICK_NORM_MAX, JOYSTICK_NORM_MAX);
+    for (uint i = 0; i < GAMEPAD_MAX_BUTTONS; i++) {
+        failures += check_field(find_field(&layout, 0x09, (uint16_t)(i + 1)), "botão",
+                                offsetof(gamepad_report_t, buttons), i, 1, 0, 1);
+    }
+    const hid_field_t *hat = find_field(&layout, 0x01, 0x39);
+    failures += check_field(hat, "chapéu", offsetof(gamepad_report_t, hat), 0, 4, 0, 7);
+    failures += check(hat && hat->null_state && GAMEPAD_HAT_NULL > hat->logical_max, "chapéu com estado nulo");
+    if (failures) {
+        printf("Layout divergente; decodificação não testada\n");
+        return 1;
+    }
+
+    // Relatórios decodificados pelo layout do descritor
+    static const int16_t axes[] = {-JOYSTICK_NORM_MAX, -1, 0, 1, 12345, JOYSTICK_NORM_MAX};
+    for (uint i = 0; i < count_of(axes); i++) {
+        for (uint j = 0; j < count_of(axes); j++) {
+            failures += check_roundtrip(&layout, axes[i], axes[j], 0, JOYSTICK_DIR_CENTER);
+        }
+    }
+    for (uint b = 0; b < GAMEPAD_MAX_BUTTONS; b++) {
+        failures += check_roundtrip(&layout, 0, 0, (uint8_t)(1u << b), JOYSTICK_DIR_CENTER);
+    }
+    failures += check_roundtrip(&layout, 0, 0, 0xFF, JOYSTICK_DIR_CENTER);
+    for (int d = JOYSTICK_DIR_CENTER; d <= JOYSTICK_DIR_DOWN_RIGHT; d++) {
+        failures += check_roundtrip(&layout, 20000, -20000, 0x05, (joystick_direction_t)d);
+    }
+    printf("Relatórios decodificados pelo descritor: %s\n", failures ? "ERRO" : "ok");
+
+    // Custo de montar o relatório (a parte que não depende do ADC nem da USB)
+    gamepad_report_t report;
+    volatile int32_t sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_CALLS; i++) {
+        gamepad_report_pack(&report, (int16_t)i, (int16_t)(i >> 3), (uint8_t)i,
+                            (joystick_direction_t)(i % (JOYSTICK_DIR_DOWN_RIGHT + 1)));
+        sink += report.y + report.hat;
+    }
+    printf("gamepad_report_pack: %.2f ns por relatório\n", (now_ns() - t0) / BENCH_CALLS);
+    (void)sink;
+
+    return failures ? 1 : 0;
+}
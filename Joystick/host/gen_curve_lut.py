@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Gera as tabelas de curva de resposta da JoystickPi (joystick_curve.h/.c).
+
+Cada tabela mapeia o raio ao quadrado do vetor normalizado (x² + y², de 0 a 2) para o ganho
+radial em Q14 aplicado a X e Y. A tabela já incorpora a anti-zona-morta e a curva (linear,
+exponencial ou definida por pontos), de modo que a biblioteca só precisa de multiplicações e
+de uma interpolação linear por leitura. A zona morta radial vira um limiar de raio ao quadrado
+(Q30) comparado antes da tabela; abaixo dele as entradas repetem o ganho da borda, para que
+a interpolação não espalhe o degrau da anti-zona-morta.
+
+Uso:
+    python3 gen_curve_lut.py <pasta do projeto> [--curve nome:zona_morta:anti:expo] ...
+    python3 gen_curve_lut.py <pasta do projeto> --curve fina:0.08:0.0:pts=0/0,0.5/0.25,1/1
+
+A zona morta e a anti-zona-morta são frações do curso (0 a 1). Com expo = 0 a curva é linear;
+com expo > 0 é exponencial, (e^(expo*r) - 1) / (e^expo - 1). Com pts= a curva é a interpolação
+linear dos pares entrada/saída informados.
+"""
+
+import argparse
+import math
+import os
+
+LUT_BITS = 8
+LUT_SIZE = 1 << LUT_BITS
+GAIN_FRAC_BITS = 14
+GAIN_MAX = (1 << 16) - 1
+
+DEFAULT_CURVES = [
+    "linear:0.10:0.0:0",
+    "expo:0.10:0.0:3",
+    "precise:0.06:0.12:1.5",
+]
+
+
+def parse_curve(spec):
+    name, dz, anti, shape = spec.split(":", 3)
+    dz, anti = float(dz), float(anti)
+    if shape.startswith("pts="):
+        pts = sorted(tuple(map(float, p.split("/"))) for p in shape[4:].split(","))
+
+        def curve(r):
+            for (x0, y0), (x1, y1) in zip(pts, pts[1:]):
+                if r <= x1:
+                    return y0 + (y1 - y0) * (r - x0) / (x1 - x0) if x1 > x0 else y1
+            return pts[-1][1]
+
+        desc = "pontos " + shape[4:]
+    else:
+        expo = float(shape)
+        if expo == 0:
+            curve = lambda r: r
+            desc = "linear"
+        else:
+            curve = lambda r, a=expo: (math.exp(a * r) - 1) / (math.exp(a) - 1)
+            desc = "exponencial (expo = %g)" % expo
+    return name, dz, anti, curve, desc
+
+
+def gain(r, dz, anti, curve):
+    """Ganho radial: raio de saída dividido pelo raio de entrada."""
+    if r <= dz:
+        return 0.0
+    rp = min((r - dz) / (1.0 - dz), 1.0)
+    out = anti + (1.0 - anti) * curve(rp)
+    return out / r
+
+
+def build_lut(dz, anti, curve):
+    lut = []
+    for i in range(LUT_SIZE + 1):
+        r2 = 2.0 * i / LUT_SIZE
+        r = max(math.sqrt(r2), dz + 1e-9)
+        g = gain(r, dz, anti, curve)
+        lut.append(min(int(round(g * (1 << GAIN_FRAC_BITS))), GAIN_MAX))
+    return lut
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("project", help="pasta com inc/ e src/ da JoystickPi")
+    parser.add_argument("--curve", action="append", help="nome:zona_morta:anti:expo|pts=...")
+    args = parser.parse_args()
+
+    curves = [parse_curve(s) for s in (args.curve or DEFAULT_CURVES)]
+
+    h = [
+        "#ifndef JOYSTICK_CURVE_H",
+        "#define JOYSTICK_CURVE_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "/**",
+        " * @file joystick_curve.h",
+        " * @brief Tabelas de curva de resposta da JoystickPi (gerado por Joystick/host/gen_curve_lut.py).",
+        " * ",
+        " * Cada curva tem o limiar da zona morta radial (raio ao quadrado em Q30) e",
+        " * JOYSTICK_CURVE_LUT_SIZE + 1 ganhos radiais em Q14, indexados pelo raio ao quadrado do",
+        " * vetor normalizado (0 a 2). Não edite à mão: rode o gerador novamente.",
+        " */",
+        "",
+        "#define JOYSTICK_CURVE_LUT_BITS %d" % LUT_BITS,
+        "#define JOYSTICK_CURVE_LUT_SIZE (1 << JOYSTICK_CURVE_LUT_BITS)",
+        "#define JOYSTICK_CURVE_GAIN_FRAC_BITS %d" % GAIN_FRAC_BITS,
+        "",
+        "/**",
+        " * @brief Curva de resposta radial.",
+        " */",
+        "typedef struct {",
+        "    uint32_t deadzone_r2;                        // Raio ao quadrado (Q30) abaixo do qual a saída é zero",
+        "    uint16_t gain[JOYSTICK_CURVE_LUT_SIZE + 1];  // Ganho radial em Q14",
+        "} joystick_curve_t;",
+        "",
+    ]
+    c = [
+        '#include "inc/joystick_curve.h"',
+        "",
+        "/**",
+        " * Arquivo: joystick_curve.c",
+        " * ",
+        " * Descrição:",
+        " * Tabelas de ganho radial geradas por Joystick/host/gen_curve_lut.py. Não edite à mão.",
+        " */",
+    ]
+    for name, dz, anti, curve, desc in curves:
+        ident = "joystick_curve_" + name
+        comment = "zona morta %.2f, anti-zona-morta %.2f, curva %s" % (dz, anti, desc)
+        h += ["/**", " * @brief Curva %s: %s." % (name, comment), " */",
+              "extern const joystick_curve_t %s;" % ident, ""]
+        lut = build_lut(dz, anti, curve)
+        c += ["", "// %s" % comment, "const joystick_curve_t %s = {" % ident,
+              "    .deadzone_r2 = %du," % round(dz * dz * (1 << 30)),
+              "    .gain = {"]
+        for i in range(0, len(lut), 12):
+            c.append("        " + ", ".join("%5d" % v for v in lut[i:i + 12]) + ",")
+        c += ["    },", "};"]
+    h += ["#endif // JOYSTICK_CURVE_H", ""]
+    c.append("")
+
+    with open(os.path.join(args.project, "inc", "joystick_curve.h"), "w", encoding="utf-8") as f:
+        f.write("\n".join(h))
+    with open(os.path.join(args.project, "src", "joystick_curve.c"), "w", encoding="utf-8") as f:
+        f.write("\n".join(c))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,298 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "fake_pico.h"
+#include "inc/JoystickPi.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file joystick_bench.c
+ * @brief Benchmark e verificação, no host, da normalização e da curva de resposta da JoystickPi.
+ *
+ * Compara `joystickPi_shape` (tabela de ganho em Q14) com uma referência em ponto flutuante
+ * (hypot/exp/divisão) em toda a área do joystick, mede o custo por chamada de cada uma e
+ * confere que `joystickPi_map_value` não transborda em faixas largas e que os canais, a troca e a
+ * inversão de eixos das instâncias `JoystickPi_t` batem com o ADC simulado. Também simula uma
+ * deriva térmica do centro e confere que a compensação a ajusta e a remove. Retorna 1 se o erro
+ * máximo passar de MAX_ERROR_PERCENT ou se alguma verificação falhar.
+ */
+
+// Maior erro aceito em relação à referência, em % do curso
+#define MAX_ERROR_PERCENT 2.0
+
+// Chamadas usadas em cada medição de tempo
+#define BENCH_CALLS 20000000
+
+// Pares de entrada reaproveitados nas medições de tempo
+#define BENCH_INPUTS 4096
+
+/**
+ * @brief Parâmetros de uma curva padrão (os mesmos de DEFAULT_CURVES em gen_curve_lut.py).
+ */
+typedef struct {
+    const char *name;
+    const joystick_curve_t *curve;
+    double deadzone;
+    double anti;
+    double expo;
+} curve_ref_t;
+
+static const curve_ref_t curves[] = {
+    {"linear", &joystick_curve_linear, 0.10, 0.00, 0.0},
+    {"expo", &joystick_curve_expo, 0.10, 0.00, 3.0},
+    {"precise", &joystick_curve_precise, 0.06, 0.12, 1.5},
+};
+
+static int16_t bench_x[BENCH_INPUTS];
+static int16_t bench_y[BENCH_INPUTS];
+
+/**
+ * @brief Curva de resposta calculada em ponto flutuante, como no gerador das tabelas.
+ */
+static void reference_shape(const curve_ref_t *c, double x, double y, double *ox, double *oy) {
+    double r = hypot(x, y);
+    if (r <= c->deadzone) {
+        *ox = *oy = 0.0;
+        return;
+    }
+    double rp = fmin((r - c->deadzone) / (1.0 - c->deadzone), 1.0);
+    double curve = c->expo == 0.0 ? rp : (exp(c->expo * rp) - 1.0) / (exp(c->expo) - 1.0);
+    double gain = (c->anti + (1.0 - c->anti) * curve) / r;
+    *ox = fmax(fmin(x * gain, 1.0), -1.0);
+    *oy = fmax(fmin(y * gain, 1.0), -1.0);
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Percorre toda a área do joystick e devolve o erro máximo e o RMS (em % do curso).
+ */
+static void measure_error(const curve_ref_t *c, double *max_err, double *rms_err) {
+    double sum_sq = 0.0;
+    long count = 0;
+    *max_err = 0.0;
+
+    for (int32_t x = -JOYSTICK_NORM_MAX; x <= JOYSTICK_NORM_MAX; x += 97) {
+        for (int32_t y = -JOYSTICK_NORM_MAX; y <= JOYSTICK_NORM_MAX; y += 97) {
+            int16_t sx = x, sy = y;
+            double rx, ry;
+            joystickPi_shape(c->curve, &sx, &sy);
+            reference_shape(c, x / (double)JOYSTICK_NORM_MAX, y / (double)JOYSTICK_NORM_MAX, &rx, &ry);
+
+            double ex = fabs(sx / (double)JOYSTICK_NORM_MAX - rx) * 100.0;
+            double ey = fabs(sy / (double)JOYSTICK_NORM_MAX - ry) * 100.0;
+            *max_err = fmax(*max_err, fmax(ex, ey));
+            sum_sq += ex * ex + ey * ey;
+            count += 2;
+        }
+    }
+    *rms_err = sqrt(sum_sq / count);
+}
+
+/**
+ * @brief Custo médio (ns) de `joystickPi_shape` sobre as entradas de teste.
+ */
+static double time_lut(const curve_ref_t *c) {
+    volatile int32_t sink = 0;
+    double start = now_ns();
+    for (long i = 0; i < BENCH_CALLS; i++) {
+        int16_t x = bench_x[i & (BENCH_INPUTS - 1)];
+        int16_t y = bench_y[i & (BENCH_INPUTS - 1)];
+        joystickPi_shape(c->curve, &x, &y);
+        sink += x ^ y;
+    }
+    return (now_ns() - start) / BENCH_CALLS;
+}
+
+/**
+ * @brief Custo médio (ns) da referência em ponto flutuante sobre as mesmas entradas.
+ */
+static double time_reference(const curve_ref_t *c) {
+    volatile double sink = 0.0;
+    double start = now_ns();
+    for (long i = 0; i < BENCH_CALLS; i++) {
+        double x, y;
+        reference_shape(c, bench_x[i & (BENCH_INPUTS - 1)] / 32767.0, bench_y[i & (BENCH_INPUTS - 1)] / 32767.0, &x, &y);
+        sink += x + y;
+    }
+    return (now_ns() - start) / BENCH_CALLS;
+}
+
+/**
+ * @brief Custo médio (ns) de um `joystickPi_read` completo (ADC falso, normalização e curva).
+ */
+static double time_read(const curve_ref_t *c) {
+    volatile int32_t sink = 0;
+    joystickPi_shape_set_curve(c->curve);
+    double start = now_ns();
+    for (long i = 0; i < BENCH_CALLS / 4; i++) {
+        fake_adc_set(JOYSTICK_X_ADC_CHANNEL, (uint16_t)(bench_x[i & (BENCH_INPUTS - 1)] / 16 + 2048));
+        fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, (uint16_t)(bench_y[i & (BENCH_INPUTS - 1)] / 16 + 2048));
+        joystick_state_t state = joystickPi_read();
+        sink += state.x_norm ^ state.y_norm;
+    }
+    joystickPi_shape_set_curve(NULL);
+    return (now_ns() - start) / (BENCH_CALLS / 4);
+}
+
+/**
+ * @brief Confere os canais do joystick padrão e de uma segunda instância girada em 90°.
+ * 
+ * @return Quantidade de verificações que falharam.
+ */
+static int check_instances(void) {
+    int failures = 0;
+
+    // Joystick padrão: X em GP27 (ADC1), Y em GP26 (ADC0), tanto em read quanto em read_x/read_y
+    fake_adc_set(JOYSTICK_X_ADC_CHANNEL, 3000);
+    fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, 1000);
+    joystick_state_t state = joystickPi_read();
+    bool ok = state.x == 3000 && state.y == 1000 && joystickPi_read_x() == 3000 && joystickPi_read_y() == 1000;
+    printf("joystick padrão: read (%u, %u), read_x/read_y (%u, %u) %s\n", state.x, state.y,
+           joystickPi_read_x(), joystickPi_read_y(), ok ? "(ok)" : "(ERRO)");
+    failures += !ok;
+
+    // Segundo joystick em GP28/GP29, sem botão, com os eixos trocados e Y invertido
+    static JoystickPi_t second;
+    JoystickPi_config_t config = {
+        .x_pin = 28, .y_pin = 29, .button_pin = JOYSTICK_NO_BUTTON,
+        .invert_x = false, .invert_y = true, .swap_xy = true,
+    };
+    ok = JoystickPi_init(&second, &config);
+    fake_adc_set(2, 500);
+    fake_adc_set(3, 3500);
+    state = JoystickPi_read(&second);
+    ok = ok && state.x == 3500 && state.y == 4095 - 500 && !state.button;
+    printf("segundo joystick (troca + inversão): (%u, %u) %s\n", state.x, state.y, ok ? "(ok)" : "(ERRO)");
+    failures += !ok;
+
+    // Não há espaço para um terceiro joystick
+    static JoystickPi_t third;
+    ok = !JoystickPi_init(&third, &config);
+    printf("terceiro joystick recusado: %s\n", ok ? "(ok)" : "(ERRO)");
+    failures += !ok;
+
+    fake_adc_set(JOYSTICK_X_ADC_CHANNEL, 2048);
+    fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, 2048);
+    return failures;
+}
+
+/**
+ * @brief Deixa o passa-baixas dos sensores da compensação assentar nos valores atuais do ADC.
+ */
+static void settle_compensation(void) {
+    for (int i = 0; i < 2000; i++) {
+        joystickPi_read();
+    }
+}
+
+/**
+ * @brief Simula o centro andando com a temperatura e confere o ajuste e a correção da deriva.
+ *
+ * O sensor de temperatura cai ~2,1 LSB de 12 bits por °C; a 10 °C acima da calibração o centro
+ * do X sobe 30 LSB e o do Y desce 10, o que já passa da zona morta.
+ */
+static int check_compensation(void) {
+    const uint16_t temp_cold = 876, temp_hot = 855;
+    const int drift_x = 30, drift_y = -10;
+    int failures = 0;
+
+    joystickPi_shape_set_curve(NULL);
+    joystickPi_compensation_enable(JOYSTICK_COMP_NO_REF);
+
+    // Calibração do centro a frio
+    fake_adc_set(JOYSTICK_COMP_TEMP_CHANNEL, temp_cold);
+    fake_adc_set(JOYSTICK_X_ADC_CHANNEL, 2048);
+    fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, 2048);
+    settle_compensation();
+    joystickPi_calibrate_center(200);
+
+    // Aquece: sem deriva ajustada, o repouso sai do centro
+    fake_adc_set(JOYSTICK_COMP_TEMP_CHANNEL, temp_hot);
+    fake_adc_set(JOYSTICK_X_ADC_CHANNEL, 2048 + drift_x);
+    fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, 2048 + drift_y);
+    settle_compensation();
+    joystick_state_t before = joystickPi_read();
+
+    // Uma janela da calibração automática em repouso fornece o segundo ponto da regressão
+    joystickPi_calibration_set_auto(true);
+    for (int i = 0; i < 2 * JOYSTICK_CAL_IDLE_READS + 2; i++) {
+        joystickPi_read();
+    }
+    joystickPi_calibration_set_auto(false);
+    joystick_comp_t comp;
+    joystickPi_compensation_get(&comp);
+    joystick_state_t hot = joystickPi_read();
+
+    // Esfria de volta: sem recalibrar, o repouso continua no centro
+    fake_adc_set(JOYSTICK_COMP_TEMP_CHANNEL, temp_cold);
+    fake_adc_set(JOYSTICK_X_ADC_CHANNEL, 2048);
+    fake_adc_set(JOYSTICK_Y_ADC_CHANNEL, 2048);
+    settle_compensation();
+    joystick_state_t cold = joystickPi_read();
+
+    double slope_x = comp.temp_slope_x / 65536.0, slope_y = comp.temp_slope_y / 65536.0;
+    double expected_x = (double)drift_x / (temp_hot - temp_cold);
+    double expected_y = (double)drift_y / (temp_hot - temp_cold);
+    bool ok = fabs(slope_x - expected_x) < 0.05 && fabs(slope_y - expected_y) < 0.05;
+    printf("\ncompensação: deriva ajustada X %.3f Y %.3f LSB/LSB (esperado %.3f %.3f) %s\n", slope_x, slope_y,
+           expected_x, expected_y, ok ? "(ok)" : "(ERRO)");
+    failures += !ok;
+
+    ok = (before.x_norm != 0 || before.y_norm != 0) && hot.x_norm == 0 && hot.y_norm == 0 &&
+         cold.x_norm == 0 && cold.y_norm == 0;
+    printf("repouso a %.1f °C antes do ajuste (%d, %d), depois (%d, %d), de volta a %.1f °C (%d, %d) %s\n",
+           joystickPi_temperature_c(temp_hot << 4), before.x_norm, before.y_norm, hot.x_norm, hot.y_norm,
+           joystickPi_temperature_c(temp_cold << 4), cold.x_norm, cold.y_norm, ok ? "(ok)" : "(ERRO)");
+    failures += !ok;
+
+    joystickPi_compensation_disable();
+    return failures;
+}
+
+int main(void) {
+    int failures = 0;
+
+    fake_pico_reset();
+    joystickPi_init();
+
+    srand(1);
+    for (int i = 0; i < BENCH_INPUTS; i++) {
+        bench_x[i] = (int16_t)(rand() % (2 * JOYSTICK_NORM_MAX + 1) - JOYSTICK_NORM_MAX);
+        bench_y[i] = (int16_t)(rand() % (2 * JOYSTICK_NORM_MAX + 1) - JOYSTICK_NORM_MAX);
+    }
+
+    // joystickPi_map_value com faixa de entrada de 16 bits e saída completa de int16_t
+    int16_t mapped = joystickPi_map_value(65535, 0, 65535, -32767, 32767);
+    printf("joystickPi_map_value(65535, 0..65535 -> -32767..32767) = %d %s\n",
+           mapped, mapped == 32767 ? "(ok)" : "(ERRO)");
+    failures += mapped != 32767;
+
+    failures += check_instances();
+
+    printf("\n%-8s %10s %10s %12s %12s %12s\n", "curva", "erro max", "erro rms", "LUT (ns)", "float (ns)", "read (ns)");
+    for (size_t i = 0; i < count_of(curves); i++) {
+        const curve_ref_t *c = &curves[i];
+        double max_err, rms_err;
+        measure_error(c, &max_err, &rms_err);
+        double lut_ns = time_lut(c);
+        double ref_ns = time_reference(c);
+        double read_ns = time_read(c);
+
+        printf("%-8s %9.3f%% %9.3f%% %12.2f %12.2f %12.2f%s\n", c->name, max_err, rms_err,
+               lut_ns, ref_ns, read_ns, max_err > MAX_ERROR_PERCENT ? "  (ERRO)" : "");
+        failures += max_err > MAX_ERROR_PERCENT;
+    }
+
+    failures += check_compensation();
+
+    return failures ? 1 : 0;
+}
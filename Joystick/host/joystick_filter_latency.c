@@ -0,0 +1,281 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fake_pico.h"
+#include "inc/JoystickPi.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file joystick_filter_latency.c
+ * @brief Mede, no host, a redução de ruído e o atraso do filtro adaptativo da JoystickPi.
+ *
+ * Alimenta `joystickPi_euro_step` na taxa do temporizador do motor (JOYSTICK_ENGINE_PROCESS_HZ)
+ * com sinais sintéticos mais ruído gaussiano de NOISE_LSB12: repouso, senoides lentas e um
+ * movimento rápido ("flick"). Compara com uma média móvel cuja janela dá a mesma redução de
+ * ruído em repouso, que é o que o filtro substitui. Retorna 1 se o filtro não reduzir o ruído
+ * em pelo menos MIN_NOISE_REDUCTION vezes ou atrasar o flick em mais de MAX_FLICK_DELAY_MS.
+ */
+
+// Desvio padrão do ruído do ADC, em LSB de 12 bits (medido com o Joystick_DMA na BitDogLab)
+#define NOISE_LSB12 6.0
+
+// Duração de cada cenário, em passos do filtro
+#define SCENARIO_STEPS 4000
+
+// Passos descartados no início de cada cenário, até o filtro assentar
+#define SETTLE_STEPS 500
+
+// Maior deslocamento testado na correlação cruzada, em passos (no máximo SETTLE_STEPS)
+#define MAX_LAG_STEPS 500
+
+// Maior janela testada para a média móvel equivalente
+#define MAX_AVERAGE_WINDOW 1000
+
+// Critérios de aprovação
+#define MIN_NOISE_REDUCTION 4.0
+#define MAX_FLICK_DELAY_MS 8.0
+
+// Chamadas usadas na medição de tempo
+#define BENCH_CALLS 20000000
+
+static double clean[SCENARIO_STEPS];
+static double noisy[SCENARIO_STEPS];
+static double out_euro[SCENARIO_STEPS];
+static double out_avg[SCENARIO_STEPS];
+
+/******************************
+ * Sinais Sintéticos
+ ******************************/
+
+/**
+ * @brief Ruído gaussiano determinístico (LCG + Box-Muller), para resultados reproduzíveis.
+ */
+static double gaussian(void) {
+    static uint64_t state = 0x2545F4914F6CDD1Dull;
+    double u[2];
+    for (int i = 0; i < 2; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        u[i] = ((state >> 11) + 0.5) / 9007199254740992.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+/**
+ * @brief Centro do curso mais uma senoide de amplitude `amplitude` (fração do curso).
+ */
+static double signal_sine(int step, double freq_hz, double amplitude) {
+    double t = (double)step / JOYSTICK_ENGINE_PROCESS_HZ;
+    return 32768.0 + amplitude * 32767.0 * sin(2.0 * M_PI * freq_hz * t);
+}
+
+/**
+ * @brief Flick: centro -> 90% do curso em 80 ms (meio cosseno), espera e volta.
+ */
+static double signal_flick(int step) {
+    const int start = 1000, ramp = 80, hold = 1000;
+    double target = 0.9 * 32767.0;
+    double pos;
+    if (step < start) {
+        pos = 0.0;
+    } else if (step < start + ramp) {
+        pos = target * 0.5 * (1.0 - cos(M_PI * (step - start) / ramp));
+    } else if (step < start + ramp + hold) {
+        pos = target;
+    } else if (step < start + 2 * ramp + hold) {
+        pos = target * 0.5 * (1.0 + cos(M_PI * (step - start - ramp - hold) / ramp));
+    } else {
+        pos = 0.0;
+    }
+    return 32768.0 + pos;
+}
+
+/**
+ * @brief Quantiza como o ADC (12 bits) e leva à escala de 16 bits do motor.
+ */
+static uint16_t adc_sample(double value) {
+    double lsb12 = value / 16.0 + NOISE_LSB12 * gaussian();
+    long q = lround(lsb12);
+    q = q < 0 ? 0 : (q > 4095 ? 4095 : q);
+    return (uint16_t)(q << 4);
+}
+
+/******************************
+ * Filtros Comparados
+ ******************************/
+
+static void run_euro(const joystick_euro_t *euro) {
+    joystick_euro_axis_t axis = {0};
+    for (int i = 0; i < SCENARIO_STEPS; i++) {
+        out_euro[i] = joystickPi_euro_step(euro, &axis, (uint16_t)noisy[i]);
+    }
+}
+
+static void run_average(int window) {
+    double sum = 0.0;
+    for (int i = 0; i < SCENARIO_STEPS; i++) {
+        sum += noisy[i];
+        if (i >= window) {
+            sum -= noisy[i - window];
+        }
+        out_avg[i] = sum / (i + 1 < window ? i + 1 : window);
+    }
+}
+
+/******************************
+ * Métricas
+ ******************************/
+
+/**
+ * @brief Desvio padrão em relação ao sinal limpo, em LSB de 12 bits.
+ */
+static double noise_lsb12(const double *out) {
+    double acc = 0.0;
+    for (int i = SETTLE_STEPS; i < SCENARIO_STEPS; i++) {
+        double e = out[i] - clean[i];
+        acc += e * e;
+    }
+    return sqrt(acc / (SCENARIO_STEPS - SETTLE_STEPS)) / 16.0;
+}
+
+/**
+ * @brief Atraso (ms) que minimiza o erro quadrático entre a saída e o sinal limpo deslocado.
+ * 
+ * Fica com o primeiro mínimo, já que em sinais periódicos o erro se repete a cada período.
+ */
+static double lag_xcorr_ms(const double *out) {
+    int best = 0;
+    double best_err = INFINITY;
+    for (int lag = 0; lag <= MAX_LAG_STEPS; lag++) {
+        double acc = 0.0;
+        for (int i = SETTLE_STEPS; i < SCENARIO_STEPS; i++) {
+            double e = out[i] - clean[i - lag];
+            acc += e * e;
+        }
+        if (acc > best_err) {
+            break;
+        }
+        best_err = acc;
+        best = lag;
+    }
+    return best * 1000.0 / JOYSTICK_ENGINE_PROCESS_HZ;
+}
+
+/**
+ * @brief Passo em que `out` cruza pela primeira vez `level` (em fração do flick) a partir de `from`.
+ */
+static int crossing(const double *out, int from, double level) {
+    double threshold = 32768.0 + level * 0.9 * 32767.0;
+    for (int i = from; i < SCENARIO_STEPS; i++) {
+        if (out[i] >= threshold) {
+            return i;
+        }
+    }
+    return SCENARIO_STEPS;
+}
+
+/**
+ * @brief Atraso (ms) da saída em relação ao sinal limpo ao cruzar `level` na subida do flick.
+ */
+static double flick_delay_ms(const double *out, double level) {
+    int ref = crossing(clean, SETTLE_STEPS, level);
+    return (crossing(out, SETTLE_STEPS, level) - ref) * 1000.0 / JOYSTICK_ENGINE_PROCESS_HZ;
+}
+
+/******************************
+ * Programa Principal
+ ******************************/
+
+typedef enum { SCENARIO_REST, SCENARIO_SINE_1HZ, SCENARIO_SINE_3HZ, SCENARIO_FLICK } scenario_t;
+
+static const char *scenario_names[] = {"repouso", "senoide 1 Hz", "senoide 3 Hz", "flick 80 ms"};
+
+static void build_scenario(scenario_t s) {
+    for (int i = 0; i < SCENARIO_STEPS; i++) {
+        switch (s) {
+        case SCENARIO_REST: clean[i] = 32768.0; break;
+        case SCENARIO_SINE_1HZ: clean[i] = signal_sine(i, 1.0, 0.4); break;
+        case SCENARIO_SINE_3HZ: clean[i] = signal_sine(i, 3.0, 0.4); break;
+        case SCENARIO_FLICK: clean[i] = signal_flick(i); break;
+        }
+        noisy[i] = adc_sample(clean[i]);
+    }
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void) {
+    joystick_filter_params_t params;
+    joystickPi_filter_defaults(&params);
+    joystick_euro_t euro;
+    joystickPi_euro_init(&euro, &params, JOYSTICK_ENGINE_PROCESS_HZ);
+
+    printf("Filtro adaptativo a %d Hz: min_cutoff %.2f Hz, beta %.2f, d_cutoff %.2f Hz\n",
+           JOYSTICK_ENGINE_PROCESS_HZ, params.min_cutoff_hz, params.beta, params.d_cutoff_hz);
+    printf("Ruído de entrada: %.1f LSB12\n\n", NOISE_LSB12);
+
+    // Janela da média móvel com a mesma redução de ruído em repouso
+    build_scenario(SCENARIO_REST);
+    run_euro(&euro);
+    double in_noise = noise_lsb12(noisy);
+    double rest_noise = noise_lsb12(out_euro);
+    int window = 1;
+    do {
+        run_average(++window);
+    } while (noise_lsb12(out_avg) > rest_noise && window < MAX_AVERAGE_WINDOW);
+    printf("Média móvel equivalente em repouso: %d amostras\n\n", window);
+
+    printf("%-14s %12s %12s %12s %12s %12s\n", "cenário", "ruído in", "ruído euro", "ruído média",
+           "atraso euro", "atraso média");
+    double flick_50 = 0.0;
+    for (scenario_t s = SCENARIO_REST; s <= SCENARIO_FLICK; s++) {
+        build_scenario(s);
+        run_euro(&euro);
+        run_average(window);
+
+        // Em repouso não há atraso a medir; em movimento o erro inclui o atraso, então só o atraso é exibido
+        if (s == SCENARIO_REST) {
+            printf("%-14s %9.2f    %9.2f    %9.2f    %12s %12s\n", scenario_names[s], noise_lsb12(noisy),
+                   noise_lsb12(out_euro), noise_lsb12(out_avg), "-", "-");
+        } else if (s == SCENARIO_FLICK) {
+            flick_50 = flick_delay_ms(out_euro, 0.5);
+            printf("%-14s %12s %12s %12s %9.1f ms %9.1f ms\n", scenario_names[s], "-", "-", "-", flick_50,
+                   flick_delay_ms(out_avg, 0.5));
+        } else {
+            printf("%-14s %12s %12s %12s %9.1f ms %9.1f ms\n", scenario_names[s], "-", "-", "-",
+                   lag_xcorr_ms(out_euro), lag_xcorr_ms(out_avg));
+        }
+        if (s == SCENARIO_FLICK) {
+            printf("%-14s %12s %12s %12s %9.1f ms %9.1f ms\n", "flick 90%", "-", "-", "-",
+                   flick_delay_ms(out_euro, 0.9), flick_delay_ms(out_avg, 0.9));
+        }
+    }
+
+    // Custo por passo
+    build_scenario(SCENARIO_SINE_3HZ);
+    uint16_t inputs[SCENARIO_STEPS];
+    for (int i = 0; i < SCENARIO_STEPS; i++) {
+        inputs[i] = (uint16_t)noisy[i];
+    }
+    joystick_euro_axis_t axis = {0};
+    volatile uint32_t sink = 0;
+    double t0 = now_s();
+    for (int i = 0; i < BENCH_CALLS; i++) {
+        sink += joystickPi_euro_step(&euro, &axis, inputs[i % SCENARIO_STEPS]);
+    }
+    double t1 = now_s();
+    printf("\njoystickPi_euro_step: %.1f ns por chamada\n", (t1 - t0) * 1e9 / BENCH_CALLS);
+
+    double reduction = in_noise / rest_noise;
+    bool ok = reduction >= MIN_NOISE_REDUCTION && flick_50 <= MAX_FLICK_DELAY_MS;
+    printf("Redução de ruído %.1fx, atraso do flick %.1f ms: %s\n", reduction, flick_50, ok ? "OK" : "FALHOU");
+    return ok ? 0 : 1;
+}
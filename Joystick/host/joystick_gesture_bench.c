@@ -0,0 +1,450 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fake_pico.h"
+#include "inc/JoystickPi.h"
+#include "inc/joystick_gesture.h"
+#include "trace_file.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file joystick_gesture_bench.c
+ * @brief Verifica e mede, no host, o reconhecedor de gestos do joystick sobre traces.
+ *
+ * Um trace roteirizado (flicks nas oito direções, empurrões lentos ou curtos demais, segurar na
+ * borda, deslizar pela borda e giros nos dois sentidos, rápidos e lentos) é gerado no formato
+ * da placa, com ruído de ADC, e passa pela mesma cadeia do `joystick_replay`: ADC simulado,
+ * `JoystickPi_read`, filtro adaptativo e normalização. Os gestos reconhecidos em cada trecho
+ * do roteiro são comparados com os esperados; o programa retorna 1 se algum faltar ou sobrar.
+ *
+ * Traces gravados na placa (`Joystick_Trace`) passados na linha de comando são reproduzidos
+ * pela mesma cadeia, com a lista dos gestos reconhecidos. Em todos os traces é medido o custo
+ * por amostra de `joystick_gesture_update`, com janelas de giro de tamanhos diferentes, para
+ * mostrar que ele não depende do tamanho da janela.
+ */
+
+// Trace roteirizado: taxa e ruído (o mesmo NOISE_LSB12 de joystick_filter_latency.c)
+#define SCRIPT_RATE_HZ 1000
+#define SCRIPT_NOISE_LSB12 6.0
+
+// Repouso depois de cada trecho do roteiro, em ms
+#define SCRIPT_REST_MS 400
+
+// Gestos esperados por trecho, no máximo
+#define SCRIPT_MAX_EXPECTED 2
+
+// Maior número de gestos guardados por trace
+#define MAX_EVENTS 4096
+
+// Passadas pelo trace em cada medição de tempo
+#define BENCH_REPEAT 50
+
+/******************************
+ * Roteiro
+ ******************************/
+
+/**
+ * @brief Gesto esperado num trecho do roteiro.
+ */
+typedef struct {
+    joystick_gesture_type_t type;
+    joystick_direction_t direction;
+} expected_t;
+
+/**
+ * @brief Trecho do roteiro: sobe do centro até `radius` no ângulo inicial, espera, varre até o
+ * ângulo final, espera de novo e volta ao centro; depois repousa por SCRIPT_REST_MS.
+ */
+typedef struct {
+    const char *name;
+    double angle0, angle1;   // Graus, no sentido anti-horário a partir da direita
+    double radius;           // Fração do curso
+    double rise_ms;          // Subida e descida
+    double dwell0_ms;        // Parado no ângulo inicial
+    double sweep_ms;         // Varredura do ângulo inicial ao final
+    double dwell1_ms;        // Parado no ângulo final
+    expected_t expected[SCRIPT_MAX_EXPECTED];
+} segment_t;
+
+#define FLICK(dir) {JOYSTICK_GESTURE_FLICK, JOYSTICK_DIR_##dir}
+#define HOLD(dir) {JOYSTICK_GESTURE_HOLD, JOYSTICK_DIR_##dir}
+#define CIRCLE_CW {JOYSTICK_GESTURE_CIRCLE_CW, JOYSTICK_DIR_CENTER}
+#define CIRCLE_CCW {JOYSTICK_GESTURE_CIRCLE_CCW, JOYSTICK_DIR_CENTER}
+
+static const segment_t script[] = {
+    {"flick direita", 0, 0, 0.95, 50, 40, 0, 0, {FLICK(RIGHT)}},
+    {"flick cima", 90, 90, 0.95, 50, 40, 0, 0, {FLICK(UP)}},
+    {"flick esquerda", 180, 180, 0.95, 50, 40, 0, 0, {FLICK(LEFT)}},
+    {"flick baixo", 270, 270, 0.95, 50, 40, 0, 0, {FLICK(DOWN)}},
+    {"flick cima-direita", 45, 45, 0.95, 40, 20, 0, 0, {FLICK(UP_RIGHT)}},
+    {"flick cima-esquerda", 135, 135, 0.95, 40, 20, 0, 0, {FLICK(UP_LEFT)}},
+    {"flick baixo-esquerda", 225, 225, 0.95, 40, 20, 0, 0, {FLICK(DOWN_LEFT)}},
+    {"flick baixo-direita", 315, 315, 0.95, 40, 20, 0, 0, {FLICK(DOWN_RIGHT)}},
+    {"empurrão lento", 0, 0, 0.95, 250, 150, 0, 0, {{0}}},
+    {"flick curto (60%)", 90, 90, 0.60, 50, 40, 0, 0, {{0}}},
+    {"segurar direita", 0, 0, 0.95, 80, 900, 0, 0, {HOLD(RIGHT)}},
+    {"segurar cima-esquerda", 135, 135, 0.95, 80, 900, 0, 0, {HOLD(UP_LEFT)}},
+    {"segurar breve", 270, 270, 0.95, 80, 400, 0, 0, {{0}}},
+    {"segurar e deslizar", 0, 90, 0.95, 80, 800, 250, 800, {HOLD(RIGHT), HOLD(UP)}},
+    {"giro anti-horário", 0, 360, 0.80, 100, 0, 1000, 0, {CIRCLE_CCW}},
+    {"giro horário duplo", 90, -630, 0.80, 100, 0, 1800, 0, {CIRCLE_CW, CIRCLE_CW}},
+    {"giro na borda", 180, 540, 0.95, 100, 0, 1200, 0, {CIRCLE_CCW}},
+    {"meia-volta", 0, 200, 0.80, 100, 0, 600, 0, {{0}}},
+    {"giro lento (3 s)", 0, -360, 0.80, 100, 0, 3000, 0, {{0}}},
+    {"giro pequeno (40%)", 0, 360, 0.40, 100, 0, 1000, 0, {{0}}},
+};
+
+/**
+ * @brief Duração de um trecho, com o repouso, em ms.
+ */
+static double segment_ms(const segment_t *s) {
+    return 2 * s->rise_ms + s->dwell0_ms + s->sweep_ms + s->dwell1_ms + SCRIPT_REST_MS;
+}
+
+/**
+ * @brief Posição (fração do curso) no instante `t_ms` do trecho.
+ */
+static void segment_position(const segment_t *s, double t_ms, double *x, double *y) {
+    double moving = s->dwell0_ms + s->sweep_ms + s->dwell1_ms;
+    double r, angle;
+
+    if (t_ms < s->rise_ms) {
+        r = s->radius * t_ms / s->rise_ms;
+    } else if (t_ms < s->rise_ms + moving) {
+        r = s->radius;
+    } else if (t_ms < 2 * s->rise_ms + moving) {
+        r = s->radius * (2 * s->rise_ms + moving - t_ms) / s->rise_ms;
+    } else {
+        r = 0.0;
+    }
+
+    double t_sweep = t_ms - s->rise_ms - s->dwell0_ms;
+    if (t_sweep <= 0 || s->sweep_ms <= 0) {
+        angle = t_sweep <= 0 ? s->angle0 : s->angle1;
+    } else if (t_sweep < s->sweep_ms) {
+        angle = s->angle0 + (s->angle1 - s->angle0) * t_sweep / s->sweep_ms;
+    } else {
+        angle = s->angle1;
+    }
+    *x = r * cos(angle * M_PI / 180.0);
+    *y = r * sin(angle * M_PI / 180.0);
+}
+
+/**
+ * @brief Monta o trace roteirizado, com 1 s de repouso no início.
+ */
+static void script_trace(trace_t *trace) {
+    trace_init(trace, SCRIPT_RATE_HZ);
+    uint32_t lead = SCRIPT_RATE_HZ;
+    for (uint32_t i = 0; i < lead; i++) {
+        trace_append(trace, joystick_trace_record(trace_synth_adc(0, SCRIPT_NOISE_LSB12),
+                                                  trace_synth_adc(0, SCRIPT_NOISE_LSB12), false, false));
+    }
+    for (uint k = 0; k < count_of(script); k++) {
+        uint32_t samples = (uint32_t)(segment_ms(&script[k]) * SCRIPT_RATE_HZ / 1000.0);
+        for (uint32_t i = 0; i < samples; i++) {
+            double x, y;
+            segment_position(&script[k], i * 1000.0 / SCRIPT_RATE_HZ, &x, &y);
+            trace_append(trace, joystick_trace_record(trace_synth_adc(x, SCRIPT_NOISE_LSB12),
+                                                      trace_synth_adc(y, SCRIPT_NOISE_LSB12), false, false));
+        }
+    }
+}
+
+/******************************
+ * Reprodução
+ ******************************/
+
+static const char *direction_names[] = {
+    "centro", "direita", "cima-direita", "cima", "cima-esquerda",
+    "esquerda", "baixo-esquerda", "baixo", "baixo-direita",
+};
+
+static const char *gesture_names[] = {"nenhum", "flick", "segurar", "giro horário", "giro anti-horário"};
+
+/**
+ * @brief Eixos normalizados e instante de cada amostra, como sairiam do fluxo da placa.
+ */
+typedef struct {
+    uint32_t t_us;
+    int16_t x;
+    int16_t y;
+} point_t;
+
+/**
+ * @brief Gestos reconhecidos numa passada.
+ */
+typedef struct {
+    joystick_gesture_event_t events[MAX_EVENTS];
+    uint32_t count;
+} event_list_t;
+
+/**
+ * @brief Largura de campo do printf que ocupa `width` colunas com um texto em UTF-8.
+ */
+static int column_width(const char *text, int width) {
+    for (const char *c = text; *c; c++) {
+        width += ((uint8_t)*c & 0xC0) == 0x80;
+    }
+    return width;
+}
+
+static void collect_gesture(const joystick_gesture_event_t *event, void *user_data) {
+    event_list_t *list = user_data;
+    if (list->count < MAX_EVENTS) {
+        list->events[list->count++] = *event;
+    }
+}
+
+/**
+ * @brief Passa o trace pelo ADC simulado, `JoystickPi_read`, filtro adaptativo e normalização.
+ *
+ * @return Vetor com uma amostra por registro (liberado por quem chamou), ou NULL.
+ */
+static point_t *trace_points(const trace_t *trace) {
+    const joystick_trace_header_t *h = &trace->header;
+    // Estática e reaproveitada entre traces: `JoystickPi_init` espera a instância zerada e a
+    // mantém registrada no motor
+    fake_pico_reset();
+    static JoystickPi_t js;
+    JoystickPi_config_t config;
+    JoystickPi_config_default(&config);
+    config.x_pin = JOYSTICK_ADC_FIRST_PIN + h->x_channel;
+    config.y_pin = JOYSTICK_ADC_FIRST_PIN + h->y_channel;
+    config.button_pin = h->button_pin;
+    if (!JoystickPi_init(&js, &config)) {
+        fprintf(stderr, "Canais do trace inválidos: X %u, Y %u\n", h->x_channel, h->y_channel);
+        return NULL;
+    }
+    JoystickPi_calibration_set(&js, &h->cal);
+
+    joystick_filter_params_t params;
+    joystick_euro_t euro;
+    joystick_euro_axis_t euro_x = {0}, euro_y = {0};
+    joystickPi_filter_defaults(&params);
+    joystickPi_euro_init(&euro, &params, h->rate_hz);
+
+    point_t *points = malloc(trace->count * sizeof(point_t));
+    uint32_t period_us = 1000000u / h->rate_hz;
+    for (uint32_t i = 0; i < trace->count; i++) {
+        joystick_trace_record_t record = trace->records[i];
+        fake_adc_set(h->x_channel, record.x & JOYSTICK_TRACE_VALUE_MASK);
+        fake_adc_set(h->y_channel, record.y & JOYSTICK_TRACE_VALUE_MASK);
+        fake_pico_advance_us(period_us);
+        joystick_state_t state = JoystickPi_read(&js);
+        state.x_hires = joystickPi_euro_step(&euro, &euro_x, state.x_hires);
+        state.y_hires = joystickPi_euro_step(&euro, &euro_y, state.y_hires);
+        JoystickPi_normalize(&js, &state);
+        points[i] = (point_t){.t_us = i * period_us, .x = state.x_norm, .y = state.y_norm};
+    }
+    return points;
+}
+
+static void recognize(const point_t *points, uint32_t count, const joystick_gesture_config_t *config,
+                      event_list_t *list) {
+    static joystick_gesture_t gesture;
+    list->count = 0;
+    joystick_gesture_init(&gesture, config, collect_gesture, list);
+    for (uint32_t i = 0; i < count; i++) {
+        joystick_gesture_update(&gesture, points[i].t_us, points[i].x, points[i].y);
+    }
+}
+
+static void print_event(const joystick_gesture_event_t *e) {
+    const char *name = gesture_names[e->type];
+    const char *direction =
+        e->type == JOYSTICK_GESTURE_FLICK || e->type == JOYSTICK_GESTURE_HOLD ? direction_names[e->direction] : "";
+    printf("%8.3f s  %-*s %-15s %4u ms  raio %3u%%\n", e->t_us / 1e6, column_width(name, 18), name, direction,
+           (unsigned)(e->duration_us / 1000), (unsigned)((e->radius * 100u + 16383) / 32767));
+}
+
+/**
+ * @brief Compara os gestos de cada trecho do roteiro com os esperados.
+ *
+ * @return Número de trechos com gestos faltando ou sobrando.
+ */
+static uint32_t check_script(const event_list_t *list) {
+    uint32_t failures = 0, next = 0;
+    double start_ms = 1000.0;
+
+    printf("Roteiro (%u trechos):\n", (unsigned)count_of(script));
+    for (uint k = 0; k < count_of(script); k++) {
+        const segment_t *s = &script[k];
+        double end_ms = start_ms + segment_ms(s);
+
+        // Gestos que caíram dentro do trecho
+        uint32_t first = next;
+        while (next < list->count && list->events[next].t_us < end_ms * 1000.0) {
+            next++;
+        }
+        uint32_t found = next - first;
+
+        uint32_t expected = 0;
+        while (expected < SCRIPT_MAX_EXPECTED && s->expected[expected].type != JOYSTICK_GESTURE_NONE) {
+            expected++;
+        }
+        bool ok = found == expected;
+        for (uint32_t i = 0; ok && i < found; i++) {
+            const joystick_gesture_event_t *e = &list->events[first + i];
+            ok = e->type == s->expected[i].type && e->direction == s->expected[i].direction;
+        }
+        failures += !ok;
+
+        printf("  %-*s %s", column_width(s->name, 24), s->name, ok ? "ok  " : "ERRO");
+        if (found == 0) {
+            printf(" nenhum gesto");
+        }
+        for (uint32_t i = 0; i < found; i++) {
+            const joystick_gesture_event_t *e = &list->events[first + i];
+            printf("%s %s%s%s (%u ms)", i ? "," : "", gesture_names[e->type],
+                   e->type == JOYSTICK_GESTURE_FLICK || e->type == JOYSTICK_GESTURE_HOLD ? " " : "",
+                   e->type == JOYSTICK_GESTURE_FLICK || e->type == JOYSTICK_GESTURE_HOLD ? direction_names[e->direction]
+                                                                                          : "",
+                   (unsigned)(e->duration_us / 1000));
+        }
+        if (!ok) {
+            printf(" | esperado:");
+            for (uint32_t i = 0; i < expected; i++) {
+                printf(" %s %s", gesture_names[s->expected[i].type],
+                       s->expected[i].direction != JOYSTICK_DIR_CENTER ? direction_names[s->expected[i].direction] : "");
+            }
+            if (expected == 0) {
+                printf(" nenhum");
+            }
+        }
+        printf("\n");
+        start_ms = end_ms;
+    }
+    if (next < list->count) {
+        printf("  %u gestos depois do fim do roteiro\n", list->count - next);
+        failures++;
+    }
+    return failures;
+}
+
+/******************************
+ * Medições de Tempo
+ ******************************/
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Custo por amostra de `joystick_gesture_update` com janelas de giro de 16, 150 e 256 pontos.
+ */
+static void bench_gesture(const point_t *points, uint32_t count) {
+    static const uint32_t windows_ms[] = {160, 1500, 2560};
+    static event_list_t list;
+
+    printf("Custo por amostra de joystick_gesture_update (%d passadas, estado de %u bytes):\n", BENCH_REPEAT,
+           (unsigned)sizeof(joystick_gesture_t));
+    for (uint i = 0; i < count_of(windows_ms); i++) {
+        joystick_gesture_config_t config;
+        joystick_gesture_config_defaults(&config);
+        config.circle_max_us = windows_ms[i] * 1000u;
+
+        volatile uint32_t sink = 0;
+        double t0 = now_ns();
+        for (int pass = 0; pass < BENCH_REPEAT; pass++) {
+            recognize(points, count, &config, &list);
+            sink += list.count;
+        }
+        double ns = (now_ns() - t0) / ((double)count * BENCH_REPEAT);
+        printf("  janela do giro %4u ms (%3u pontos) %6.1f ns\n", windows_ms[i],
+               windows_ms[i] * 1000u / config.point_interval_us, ns);
+        (void)sink;
+    }
+}
+
+/******************************
+ * Programa Principal
+ ******************************/
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s [trace.jtr ...] [--no-bench]\n"
+            "     %s --generate <trace>   (grava o trace roteirizado)\n", prog, prog);
+}
+
+/**
+ * @brief Reconhece os gestos de um trace gravado e lista-os.
+ */
+static bool run_recorded(const char *path, bool bench) {
+    trace_t trace;
+    if (!trace_load(path, &trace)) {
+        return false;
+    }
+    printf("\nTrace %s: %u amostras a %u Hz (%.1f s)\n", path, trace.count, trace.header.rate_hz,
+           (double)trace.count / trace.header.rate_hz);
+    point_t *points = trace_points(&trace);
+    if (!points) {
+        trace_free(&trace);
+        return false;
+    }
+
+    static event_list_t list;
+    recognize(points, trace.count, NULL, &list);
+    for (uint32_t i = 0; i < list.count; i++) {
+        print_event(&list.events[i]);
+    }
+    printf("%u gestos\n", list.count);
+    if (bench) {
+        bench_gesture(points, trace.count);
+    }
+
+    free(points);
+    trace_free(&trace);
+    return true;
+}
+
+int main(int argc, char **argv) {
+    bool bench = true;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            trace_t trace;
+            script_trace(&trace);
+            bool ok = trace_save(&trace, argv[i + 1]);
+            if (ok) {
+                printf("Trace roteirizado: %s (%.1f s a %u Hz)\n", argv[i + 1],
+                       (double)trace.count / SCRIPT_RATE_HZ, SCRIPT_RATE_HZ);
+            }
+            trace_free(&trace);
+            return ok ? 0 : 1;
+        } else if (strcmp(argv[i], "--no-bench") == 0) {
+            bench = false;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Roteiro com os gestos esperados
+    trace_t trace;
+    script_trace(&trace);
+    point_t *points = trace_points(&trace);
+    static event_list_t list;
+    recognize(points, trace.count, NULL, &list);
+    uint32_t failures = check_script(&list);
+    printf("%u gestos em %.1f s, %u trechos com erro\n", list.count, (double)trace.count / SCRIPT_RATE_HZ, failures);
+    if (bench) {
+        bench_gesture(points, trace.count);
+    }
+    free(points);
+    trace_free(&trace);
+
+    int result = failures ? 1 : 0;
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] != '-' && !run_recorded(argv[i], bench)) {
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,539 @@
+#include <stdarg.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fake_pico.h"
+#include "inc/JoystickPi.h"
+#include "inc/joystick_direction.h"
+#include "trace_file.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file joystick_replay.c
+ * @brief Reproduz no host um trace gravado na placa pela cadeia de processamento da JoystickPi.
+ *
+ * Cada registro do trace vira o valor dos canais do ADC simulado e o nível do pino do botão;
+ * `JoystickPi_read` então lê pelo `adc_select_input`/`adc_read` falsos, como na placa. Em
+ * seguida vêm o filtro adaptativo (aplicado antes da normalização, como no motor), a curva de
+ * resposta opcional e o detector de direção. As decisões dos programas são reproduzidas a
+ * partir delas: a cor escolhida no Genius, as bordas do botão e os passos da tartaruga do
+ * TurtleSketch (no ritmo do fluxo de TURTLE_STEP_HZ).
+ *
+ * As decisões formam um log de texto, uma por linha, que pode ser salvo (--log) e comparado
+ * com o de outra versão da biblioteca (--check); o programa retorna 1 na primeira diferença.
+ * Também mede o custo por amostra de cada etapa da cadeia.
+ *
+ * Sem a placa, --generate grava um trace sintético com repouso, as oito direções, um círculo,
+ * toques no botão e oscilações em cima de uma fronteira entre setores.
+ */
+
+// Passos da tartaruga por segundo (o mesmo TURTLE_STEP_HZ do TurtleSketch)
+#define TURTLE_STEP_HZ 10
+
+// Tamanho da matriz da tartaruga (o mesmo MATRIX_SIZE do TurtleSketch)
+#define TURTLE_MATRIX_SIZE 10
+
+// Tamanho máximo de uma linha do log de decisões
+#define LOG_LINE_SIZE 64
+
+// Passadas pelo trace em cada medição de tempo
+#define BENCH_REPEAT 50
+
+// Trace sintético: duração, taxa e ruído (o mesmo NOISE_LSB12 de joystick_filter_latency.c)
+#define SYNTH_SECONDS 20
+#define SYNTH_RATE_HZ 1000
+#define SYNTH_NOISE_LSB12 6.0
+
+/******************************
+ * Trace Sintético
+ ******************************/
+
+/**
+ * @brief Posição sintética (fração do curso, -1 a 1) e botão no instante `t` (s).
+ */
+static void synth_position(double t, double *x, double *y, bool *button) {
+    double r = 0.0, angle = 0.0;
+    *button = false;
+
+    if (t >= 2.0 && t < 10.0) {
+        // Oito empurrões de 1 s, um por direção: sobe em 150 ms, segura e volta
+        int k = (int)(t - 2.0);
+        double p = t - 2.0 - k;
+        angle = k * M_PI / 4.0;
+        r = p < 0.15 ? 0.9 * p / 0.15 : (p < 0.6 ? 0.9 : (p < 0.75 ? 0.9 * (0.75 - p) / 0.15 : 0.0));
+    } else if (t >= 10.0 && t < 14.0) {
+        // Círculo lento a 0,5 Hz com 70% do curso
+        angle = 2.0 * M_PI * 0.5 * (t - 10.0);
+        r = 0.7;
+    } else if (t >= 14.0 && t < 18.0) {
+        // Toques de 200 ms no botão, os dois últimos com o joystick inclinado para a direita
+        double p = fmod(t - 14.0, 1.0);
+        *button = p >= 0.3 && p < 0.5;
+        r = t >= 16.0 ? 0.6 : 0.0;
+    } else if (t >= 18.0) {
+        // Oscilação de ±3° em volta da fronteira entre direita e cima-direita (22,5°)
+        angle = (22.5 + 3.0 * sin(2.0 * M_PI * 2.0 * (t - 18.0))) * M_PI / 180.0;
+        r = 0.6;
+    }
+    *x = r * cos(angle);
+    *y = r * sin(angle);
+}
+
+/**
+ * @brief Grava um trace sintético no formato da placa.
+ */
+static bool trace_generate(const char *path) {
+    trace_t trace;
+    trace_init(&trace, SYNTH_RATE_HZ);
+    uint32_t total = SYNTH_SECONDS * SYNTH_RATE_HZ;
+    for (uint32_t i = 0; i < total; i++) {
+        double x, y;
+        bool button;
+        synth_position((double)i / SYNTH_RATE_HZ, &x, &y, &button);
+        trace_append(&trace, joystick_trace_record(trace_synth_adc(x, SYNTH_NOISE_LSB12),
+                                                   trace_synth_adc(y, SYNTH_NOISE_LSB12), button, false));
+    }
+
+    bool ok = trace_save(&trace, path);
+    trace_free(&trace);
+    if (ok) {
+        printf("Trace sintético: %s (%u s a %u Hz)\n", path, SYNTH_SECONDS, SYNTH_RATE_HZ);
+    }
+    return ok;
+}
+
+/******************************
+ * Log de Decisões
+ ******************************/
+
+typedef struct {
+    char (*lines)[LOG_LINE_SIZE];
+    uint32_t count;
+    uint32_t capacity;
+} decision_log_t;
+
+static void log_add(decision_log_t *log, uint32_t index, const char *fmt, ...) {
+    if (!log) {
+        return;
+    }
+    if (log->count == log->capacity) {
+        log->capacity = log->capacity ? log->capacity * 2 : 256;
+        log->lines = realloc(log->lines, log->capacity * LOG_LINE_SIZE);
+    }
+    char *line = log->lines[log->count++];
+    int n = snprintf(line, LOG_LINE_SIZE, "%u ", index);
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line + n, LOG_LINE_SIZE - n, fmt, args);
+    va_end(args);
+}
+
+/**
+ * @brief Resumo FNV-1a do log, para comparar versões de relance.
+ */
+static uint32_t log_digest(const decision_log_t *log) {
+    uint32_t hash = 2166136261u;
+    for (uint32_t i = 0; i < log->count; i++) {
+        for (const char *c = log->lines[i]; *c; c++) {
+            hash = (hash ^ (uint8_t)*c) * 16777619u;
+        }
+        hash = (hash ^ '\n') * 16777619u;
+    }
+    return hash;
+}
+
+static bool log_save(const decision_log_t *log, const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    for (uint32_t i = 0; i < log->count; i++) {
+        fprintf(f, "%s\n", log->lines[i]);
+    }
+    fclose(f);
+    return true;
+}
+
+/**
+ * @brief Compara o log com um arquivo de referência e mostra a primeira diferença.
+ */
+static bool log_check(const decision_log_t *log, const char *path) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char line[LOG_LINE_SIZE + 2];
+    uint32_t i = 0;
+    bool same = true;
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (i >= log->count || strcmp(line, log->lines[i]) != 0) {
+            printf("Decisão %u difere: referência \"%s\", atual \"%s\"\n", i + 1, line,
+                   i < log->count ? log->lines[i] : "(fim)");
+            same = false;
+            break;
+        }
+        i++;
+    }
+    if (same && i != log->count) {
+        printf("Decisão %u difere: referência (fim), atual \"%s\"\n", i + 1, log->lines[i]);
+        same = false;
+    }
+    fclose(f);
+    return same;
+}
+
+/******************************
+ * Cadeia de Processamento
+ ******************************/
+
+// Cores do Genius (joystick_direction_callback em Genius_2.c)
+typedef enum { COLOR_RED, COLOR_GREEN, COLOR_BLUE } genius_color_t;
+
+static const char *color_names[] = {"vermelho", "verde", "azul"};
+
+static const char *direction_names[] = {
+    "centro", "direita", "cima-direita", "cima", "cima-esquerda",
+    "esquerda", "baixo-esquerda", "baixo", "baixo-direita",
+};
+
+static const char *zone_names[] = {"centro", "ativa", "borda"};
+
+typedef struct {
+    JoystickPi_t *js;
+    const joystick_trace_header_t *header;
+    bool filter;                      // Passa os eixos pelo filtro adaptativo
+    joystick_euro_t euro;
+    joystick_euro_axis_t euro_x;
+    joystick_euro_axis_t euro_y;
+    joystick_tracker_t tracker;
+    genius_color_t color;
+    bool last_button;
+    uint32_t turtle_period;           // Amostras do trace por passo da tartaruga
+    int turtle_x;
+    int turtle_y;
+    bool pen_down;
+    bool turtle_last_button;
+    uint32_t index;                   // Registro atual
+    decision_log_t *log;              // NULL nas medições de tempo
+} replay_t;
+
+/**
+ * @brief Seleção de cor do Genius: esquerda verde, direita vermelho, o resto azul.
+ */
+static genius_color_t genius_color(joystick_direction_t direction) {
+    switch (direction) {
+        case JOYSTICK_DIR_LEFT:
+        case JOYSTICK_DIR_UP_LEFT:
+        case JOYSTICK_DIR_DOWN_LEFT:
+            return COLOR_GREEN;
+        case JOYSTICK_DIR_RIGHT:
+        case JOYSTICK_DIR_UP_RIGHT:
+        case JOYSTICK_DIR_DOWN_RIGHT:
+            return COLOR_RED;
+        default:
+            return COLOR_BLUE;
+    }
+}
+
+static void replay_direction_callback(const joystick_direction_event_t *event, void *user_data) {
+    replay_t *r = user_data;
+    if (event->type == JOYSTICK_EVENT_ZONE_CHANGED) {
+        log_add(r->log, r->index, "zona %s", zone_names[event->zone]);
+        return;
+    }
+    log_add(r->log, r->index, "dir %s", direction_names[event->direction]);
+
+    genius_color_t color = genius_color(event->direction);
+    if (color != r->color) {
+        r->color = color;
+        log_add(r->log, r->index, "cor %s", color_names[color]);
+    }
+}
+
+/**
+ * @brief Passo da tartaruga (move_turtle e a caneta do TurtleSketch) com uma amostra do fluxo.
+ */
+static void turtle_step(replay_t *r, const joystick_state_t *state) {
+    int x = r->turtle_x + joystickPi_map_value(state->x_hires >> 4, 0, 4095, -2, 2);
+    int y = r->turtle_y + joystickPi_map_value(state->y_hires >> 4, 4095, 0, -1, 2);
+    x = x < 0 ? 0 : (x >= TURTLE_MATRIX_SIZE ? TURTLE_MATRIX_SIZE - 1 : x);
+    y = y < 0 ? 0 : (y >= TURTLE_MATRIX_SIZE ? TURTLE_MATRIX_SIZE - 1 : y);
+
+    bool pen_down = r->pen_down;
+    if (state->button && !r->turtle_last_button) {
+        pen_down = !pen_down;
+    }
+    r->turtle_last_button = state->button;
+
+    if (x != r->turtle_x || y != r->turtle_y || pen_down != r->pen_down) {
+        r->turtle_x = x;
+        r->turtle_y = y;
+        r->pen_down = pen_down;
+        log_add(r->log, r->index, "tartaruga %d %d %s", x, y, pen_down ? "caneta" : "livre");
+    }
+}
+
+static void replay_reset(replay_t *r) {
+    memset(&r->euro_x, 0, sizeof(r->euro_x));
+    memset(&r->euro_y, 0, sizeof(r->euro_y));
+    joystick_tracker_init(&r->tracker, NULL, replay_direction_callback, r);
+    r->color = COLOR_BLUE;
+    r->last_button = false;
+    r->turtle_x = r->turtle_y = 0;
+    r->pen_down = false;
+    r->turtle_last_button = false;
+    r->index = 0;
+}
+
+/**
+ * @brief Leitura: coloca o registro no ADC e no pino simulados e lê pela biblioteca.
+ */
+static inline joystick_state_t replay_read(replay_t *r, joystick_trace_record_t record) {
+    fake_adc_set(r->header->x_channel, record.x & JOYSTICK_TRACE_VALUE_MASK);
+    fake_adc_set(r->header->y_channel, record.y & JOYSTICK_TRACE_VALUE_MASK);
+    if (r->header->button_pin != JOYSTICK_NO_BUTTON) {
+        fake_gpio_set(r->header->button_pin, !(record.x & JOYSTICK_TRACE_BUTTON)); // Pull-up: pressionado = 0
+    }
+    fake_pico_advance_us(1000000u / r->header->rate_hz);
+    return JoystickPi_read(r->js);
+}
+
+/**
+ * @brief Filtro: One-Euro nos eixos de 16 bits e nova normalização, na ordem do motor.
+ */
+static inline void replay_filter(replay_t *r, joystick_state_t *state) {
+    if (!r->filter) {
+        return;
+    }
+    state->x_hires = joystickPi_euro_step(&r->euro, &r->euro_x, state->x_hires);
+    state->y_hires = joystickPi_euro_step(&r->euro, &r->euro_y, state->y_hires);
+    JoystickPi_normalize(r->js, state);
+}
+
+/**
+ * @brief Decisões: detector de direção (e cor do Genius), botão e tartaruga.
+ */
+static inline void replay_decide(replay_t *r, const joystick_state_t *state) {
+    joystick_tracker_update(&r->tracker, state->x_norm, state->y_norm);
+
+    if (state->button != r->last_button) {
+        r->last_button = state->button;
+        log_add(r->log, r->index, "botao %d", state->button);
+    }
+
+    if (r->index % r->turtle_period == r->turtle_period - 1) {
+        turtle_step(r, state);
+    }
+}
+
+static void replay_run(replay_t *r, const trace_t *trace) {
+    replay_reset(r);
+    for (uint32_t i = 0; i < trace->count; i++) {
+        r->index = i;
+        joystick_state_t state = replay_read(r, trace->records[i]);
+        replay_filter(r, &state);
+        replay_decide(r, &state);
+    }
+}
+
+/******************************
+ * Medições de Tempo
+ ******************************/
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Custo por amostra de cada etapa, medida separadamente sobre o trace inteiro.
+ */
+static void bench_stages(replay_t *r, const trace_t *trace) {
+    joystick_state_t *states = malloc(trace->count * sizeof(joystick_state_t));
+    volatile int32_t sink = 0;
+    double t0, read_ns, filter_ns, decide_ns, total_ns;
+    double samples = (double)trace->count * BENCH_REPEAT;
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_REPEAT; pass++) {
+        for (uint32_t i = 0; i < trace->count; i++) {
+            states[i] = replay_read(r, trace->records[i]);
+        }
+        sink += states[trace->count - 1].x_norm;
+    }
+    read_ns = (now_ns() - t0) / samples;
+
+    joystick_state_t *filtered = malloc(trace->count * sizeof(joystick_state_t));
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_REPEAT; pass++) {
+        replay_reset(r);
+        for (uint32_t i = 0; i < trace->count; i++) {
+            filtered[i] = states[i];
+            replay_filter(r, &filtered[i]);
+        }
+        sink += filtered[trace->count - 1].x_norm;
+    }
+    filter_ns = (now_ns() - t0) / samples;
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_REPEAT; pass++) {
+        replay_reset(r);
+        for (uint32_t i = 0; i < trace->count; i++) {
+            r->index = i;
+            replay_decide(r, &filtered[i]);
+        }
+        sink += r->turtle_x;
+    }
+    decide_ns = (now_ns() - t0) / samples;
+
+    t0 = now_ns();
+    for (int pass = 0; pass < BENCH_REPEAT; pass++) {
+        replay_run(r, trace);
+        sink += r->turtle_y;
+    }
+    total_ns = (now_ns() - t0) / samples;
+    (void)sink;
+
+    printf("\nCusto por amostra (%d passadas pelo trace):\n", BENCH_REPEAT);
+    printf("  leitura (ADC simulado, calibração, curva) %8.1f ns\n", read_ns);
+    printf("  filtro adaptativo + normalização          %8.1f ns%s\n", filter_ns, r->filter ? "" : " (desligado)");
+    printf("  direção, botão e tartaruga                %8.1f ns\n", decide_ns);
+    printf("  cadeia completa                           %8.1f ns\n", total_ns);
+
+    free(filtered);
+    free(states);
+}
+
+/******************************
+ * Programa Principal
+ ******************************/
+
+static void usage(const char *prog) {
+    fprintf(stderr,
+            "Uso: %s <trace> [--log saida.txt] [--check referencia.txt] [--curve linear|expo|precise]\n"
+            "           [--no-filter] [--no-bench]\n"
+            "     %s --generate <trace>\n", prog, prog);
+}
+
+int main(int argc, char **argv) {
+    const char *trace_path = NULL, *log_path = NULL, *check_path = NULL, *curve_name = NULL;
+    bool filter = true, bench = true;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            return trace_generate(argv[i + 1]) ? 0 : 1;
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            log_path = argv[++i];
+        } else if (strcmp(argv[i], "--check") == 0 && i + 1 < argc) {
+            check_path = argv[++i];
+        } else if (strcmp(argv[i], "--curve") == 0 && i + 1 < argc) {
+            curve_name = argv[++i];
+        } else if (strcmp(argv[i], "--no-filter") == 0) {
+            filter = false;
+        } else if (strcmp(argv[i], "--no-bench") == 0) {
+            bench = false;
+        } else if (argv[i][0] != '-' && !trace_path) {
+            trace_path = argv[i];
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (!trace_path) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    trace_t trace;
+    if (!trace_load(trace_path, &trace)) {
+        return 1;
+    }
+    const joystick_trace_header_t *h = &trace.header;
+    printf("Trace %s: %u amostras a %u Hz (%.1f s), %u lacunas", trace_path, trace.count, h->rate_hz,
+           (double)trace.count / h->rate_hz, trace.gaps);
+    if (trace.has_footer) {
+        printf(", %u perdidas na placa\n", trace.footer.dropped);
+    } else {
+        printf(", sem rodapé (gravação interrompida)\n");
+    }
+
+    // Joystick com os canais e o botão da gravação, e a calibração da placa
+    // Estática: `JoystickPi_init` espera a instância zerada e a mantém registrada no motor
+    fake_pico_reset();
+    static JoystickPi_t js;
+    JoystickPi_config_t config;
+    JoystickPi_config_default(&config);
+    config.x_pin = JOYSTICK_ADC_FIRST_PIN + h->x_channel;
+    config.y_pin = JOYSTICK_ADC_FIRST_PIN + h->y_channel;
+    config.button_pin = h->button_pin;
+    if (!JoystickPi_init(&js, &config)) {
+        fprintf(stderr, "Canais do trace inválidos: X %u, Y %u\n", h->x_channel, h->y_channel);
+        return 1;
+    }
+    JoystickPi_calibration_set(&js, &h->cal);
+
+    if (curve_name) {
+        const joystick_curve_t *curve = strcmp(curve_name, "linear") == 0 ? &joystick_curve_linear
+                                        : strcmp(curve_name, "expo") == 0  ? &joystick_curve_expo
+                                        : strcmp(curve_name, "precise") == 0 ? &joystick_curve_precise
+                                                                              : NULL;
+        if (!curve) {
+            usage(argv[0]);
+            return 2;
+        }
+        JoystickPi_shape_set_curve(&js, curve);
+    }
+
+    replay_t replay = {
+        .js = &js,
+        .header = h,
+        .filter = filter,
+        .turtle_period = h->rate_hz >= TURTLE_STEP_HZ ? h->rate_hz / TURTLE_STEP_HZ : 1,
+    };
+    joystick_filter_params_t params;
+    joystickPi_filter_defaults(&params);
+    joystickPi_euro_init(&replay.euro, &params, h->rate_hz);
+
+    decision_log_t log = {0};
+    replay.log = &log;
+    replay_run(&replay, &trace);
+    replay.log = NULL;
+
+    uint32_t counts[5] = {0};
+    static const char *kinds[] = {"dir", "zona", "cor", "botao", "tartaruga"};
+    for (uint32_t i = 0; i < log.count; i++) {
+        const char *kind = strchr(log.lines[i], ' ') + 1;
+        for (uint k = 0; k < count_of(kinds); k++) {
+            counts[k] += strncmp(kind, kinds[k], strlen(kinds[k])) == 0 && kind[strlen(kinds[k])] == ' ';
+        }
+    }
+    printf("Decisões: %u (direção %u, zona %u, cor %u, botão %u, tartaruga %u), resumo %08x\n", log.count,
+           counts[0], counts[1], counts[2], counts[3], counts[4], log_digest(&log));
+
+    int result = 0;
+    if (log_path && !log_save(&log, log_path)) {
+        result = 1;
+    }
+    if (check_path) {
+        bool same = log_check(&log, check_path);
+        printf("Comparação com %s: %s\n", check_path, same ? "decisões idênticas" : "DIFERENTE");
+        result |= !same;
+    }
+
+    if (bench) {
+        bench_stages(&replay, &trace);
+    }
+
+    free(log.lines);
+    trace_free(&trace);
+    return result;
+}
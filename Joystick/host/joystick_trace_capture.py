@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Grava num arquivo o trace enviado pelo programa Joystick_Trace pela USB.
+
+O programa da placa escreve mensagens de texto e, entre elas, um trace binário (cabeçalho
+"JTRC", registros de 4 bytes e rodapé "JEND", ver joystick_trace.h). Este script põe a porta
+serial em modo cru, descarta o texto até o cabeçalho e salva o trace até o rodapé. Com Ctrl+C
+o que já chegou é salvo sem rodapé, e o replay usa os registros completos.
+
+Uso:
+    python3 joystick_trace_capture.py /dev/ttyACM0 trace.jtr
+
+Só usa a biblioteca padrão (termios), então funciona no Linux e no macOS.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import termios
+import tty
+
+MAGIC = b"JTRC"
+END_MAGIC = b"JEND"
+HEADER_SIZE = 32
+RECORD_SIZE = 4
+FOOTER_SIZE = 12
+
+
+class Port:
+    """Leitura bloqueante de uma quantidade exata de bytes da porta serial."""
+
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+        self.saved = termios.tcgetattr(self.fd)
+        tty.setraw(self.fd)
+
+    def read(self, size):
+        data = b""
+        while len(data) < size:
+            chunk = os.read(self.fd, size - len(data))
+            if not chunk:
+                raise EOFError("porta fechada")
+            data += chunk
+        return data
+
+    def close(self):
+        termios.tcsetattr(self.fd, termios.TCSANOW, self.saved)
+        os.close(self.fd)
+
+
+def wait_header(port):
+    """Repassa o texto da placa para o terminal até encontrar o cabeçalho."""
+    pending = b""
+    while True:
+        pending += port.read(1)
+        if pending.endswith(MAGIC):
+            return MAGIC + port.read(HEADER_SIZE - len(MAGIC))
+        # Segura só o final que ainda pode ser o começo do cabeçalho
+        keep = next(n for n in range(len(MAGIC) - 1, -1, -1) if pending.endswith(MAGIC[:n]))
+        sys.stdout.buffer.write(pending[:len(pending) - keep])
+        sys.stdout.flush()
+        pending = pending[len(pending) - keep:]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="porta serial da placa (ex.: /dev/ttyACM0)")
+    parser.add_argument("output", help="arquivo do trace")
+    args = parser.parse_args()
+
+    port = Port(args.port)
+    samples = 0
+    try:
+        header = wait_header(port)
+        _, version, _, rate_hz = struct.unpack_from("<IHHI", header)
+        print(f"\nTrace v{version} a {rate_hz} Hz, gravando em {args.output} (Ctrl+C para parar)")
+
+        with open(args.output, "wb") as out:
+            out.write(header)
+            try:
+                while True:
+                    record = port.read(RECORD_SIZE)
+                    if record == END_MAGIC:
+                        footer = record + port.read(FOOTER_SIZE - RECORD_SIZE)
+                        out.write(footer)
+                        _, total, dropped = struct.unpack("<III", footer)
+                        print(f"\n{total} amostras, {dropped} perdidas na placa")
+                        break
+                    out.write(record)
+                    samples += 1
+                    if samples % rate_hz == 0:
+                        print(f"\r{samples // rate_hz} s", end="", flush=True)
+            except KeyboardInterrupt:
+                print(f"\nInterrompido: {samples} amostras salvas sem rodapé")
+    finally:
+        port.close()
+
+
+if __name__ == "__main__":
+    main()
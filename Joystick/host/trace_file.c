@@ -0,0 +1,117 @@
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "trace_file.h"
+#include "inc/JoystickPi.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file trace_file.c
+ * @brief Leitura e gravação dos traces do joystick no host.
+ */
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Ruído gaussiano determinístico (LCG + Box-Muller).
+ */
+static double gaussian(void) {
+    static uint64_t state = 0x2545F4914F6CDD1Dull;
+    double u[2];
+    for (int i = 0; i < 2; i++) {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        u[i] = ((state >> 11) + 0.5) / 9007199254740992.0;
+    }
+    return sqrt(-2.0 * log(u[0])) * cos(2.0 * M_PI * u[1]);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+bool trace_load(const char *path, trace_t *trace) {
+    memset(trace, 0, sizeof(*trace));
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+
+    joystick_trace_header_t *h = &trace->header;
+    if (fread(h, sizeof(*h), 1, f) != 1 || h->magic != JOYSTICK_TRACE_MAGIC ||
+        h->version != JOYSTICK_TRACE_VERSION || h->header_size < sizeof(*h) || h->rate_hz == 0) {
+        fprintf(stderr, "%s: não é um trace da JoystickPi (versão %u)\n", path, JOYSTICK_TRACE_VERSION);
+        fclose(f);
+        return false;
+    }
+    fseek(f, h->header_size - (long)sizeof(*h), SEEK_CUR);
+
+    joystick_trace_record_t record;
+    while (fread(&record, sizeof(record), 1, f) == 1) {
+        if (joystick_trace_is_footer(record)) {
+            trace->footer.magic = JOYSTICK_TRACE_END_MAGIC;
+            trace->has_footer = fread(&trace->footer.samples, sizeof(uint32_t), 2, f) == 2;
+            break;
+        }
+        trace->gaps += (record.x & JOYSTICK_TRACE_GAP) != 0;
+        trace_append(trace, record);
+    }
+    fclose(f);
+    return trace->count > 0;
+}
+
+void trace_init(trace_t *trace, uint32_t rate_hz) {
+    memset(trace, 0, sizeof(*trace));
+    trace->header = (joystick_trace_header_t){
+        .magic = JOYSTICK_TRACE_MAGIC,
+        .version = JOYSTICK_TRACE_VERSION,
+        .header_size = sizeof(joystick_trace_header_t),
+        .rate_hz = rate_hz,
+        .x_channel = JOYSTICK_X_ADC_CHANNEL,
+        .y_channel = JOYSTICK_Y_ADC_CHANNEL,
+        .button_pin = JOYSTICK_BUTTON_PIN,
+    };
+    joystickPi_calibration_defaults(&trace->header.cal);
+}
+
+void trace_append(trace_t *trace, joystick_trace_record_t record) {
+    if (trace->count == trace->capacity) {
+        trace->capacity = trace->capacity ? trace->capacity * 2 : 4096;
+        trace->records = realloc(trace->records, trace->capacity * sizeof(record));
+    }
+    trace->records[trace->count++] = record;
+}
+
+bool trace_save(const trace_t *trace, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    joystick_trace_footer_t footer = {.magic = JOYSTICK_TRACE_END_MAGIC, .samples = trace->count, .dropped = 0};
+    bool ok = fwrite(&trace->header, sizeof(trace->header), 1, f) == 1 &&
+              fwrite(trace->records, sizeof(joystick_trace_record_t), trace->count, f) == trace->count &&
+              fwrite(&footer, sizeof(footer), 1, f) == 1;
+    ok &= fclose(f) == 0;
+    if (!ok) {
+        perror(path);
+    }
+    return ok;
+}
+
+void trace_free(trace_t *trace) {
+    free(trace->records);
+    trace->records = NULL;
+    trace->count = trace->capacity = 0;
+}
+
+uint16_t trace_synth_adc(double pos, double noise_lsb12) {
+    long q = lround(2048.0 + pos * 2047.0 + noise_lsb12 * gaussian());
+    return (uint16_t)(q < 0 ? 0 : (q > 4095 ? 4095 : q));
+}
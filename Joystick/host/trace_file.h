@@ -0,0 +1,76 @@
+#ifndef TRACE_FILE_H
+#define TRACE_FILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "inc/joystick_trace.h"
+
+/**
+ * @file trace_file.h
+ * @brief Leitura e gravação, no host, dos traces do joystick (formato em `inc/joystick_trace.h`).
+ *
+ * Compartilhado pelos programas que reproduzem traces gravados na placa ou geram traces sintéticos.
+ */
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Trace carregado na memória.
+ */
+typedef struct {
+    joystick_trace_header_t header;
+    joystick_trace_record_t *records;
+    uint32_t count;
+    uint32_t capacity;
+    uint32_t gaps;                   // Registros marcados com JOYSTICK_TRACE_GAP
+    bool has_footer;                 // Falta quando a gravação foi interrompida
+    joystick_trace_footer_t footer;
+} trace_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Carrega um trace; registros incompletos no fim do arquivo são ignorados.
+ *
+ * @return false se o arquivo não abre, não é um trace ou não tem registros.
+ */
+bool trace_load(const char *path, trace_t *trace);
+
+/**
+ * @brief Inicia um trace vazio com os canais, o botão e a calibração padrão da BitDogLab.
+ *
+ * @param trace Trace a ser iniciado.
+ * @param rate_hz Taxa de amostragem dos registros.
+ */
+void trace_init(trace_t *trace, uint32_t rate_hz);
+
+/**
+ * @brief Acrescenta um registro ao trace.
+ */
+void trace_append(trace_t *trace, joystick_trace_record_t record);
+
+/**
+ * @brief Grava o trace no formato da placa, com o rodapé.
+ */
+bool trace_save(const trace_t *trace, const char *path);
+
+/**
+ * @brief Libera os registros do trace.
+ */
+void trace_free(trace_t *trace);
+
+/**
+ * @brief Quantiza uma posição (fração do curso, -1 a 1) como o ADC de 12 bits, com ruído
+ * gaussiano determinístico, para traces sintéticos reproduzíveis.
+ *
+ * @param pos Posição no eixo.
+ * @param noise_lsb12 Desvio padrão do ruído, em LSB de 12 bits.
+ * @return Leitura de 0 a 4095.
+ */
+uint16_t trace_synth_adc(double pos, double noise_lsb12);
+
+#endif // TRACE_FILE_H
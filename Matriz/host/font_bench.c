@@ -0,0 +1,122 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "inc/alphabet.h"
+#include "inc/font5x5.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file font_bench.c
+ * @brief Confere a fonte 5x5 em bits contra a tabela `alphabet` e compara memória e tempo de busca.
+ *
+ * Cada caractere de `alphabet.c` deve ter o mesmo desenho em `font5x5` (também nas minúsculas, que
+ * antes passavam por `toupper`), e os caracteres fora da tabela não devem ter desenho. Em seguida,
+ * compara o espaço das duas tabelas e o custo de achar um caractere: busca linear com `toupper`, como
+ * fazia a MatrizRGBPI, contra o índice direto pelo código ASCII. Retorna 1 se alguma verificação falhar.
+ */
+
+// Buscas usadas na medição de tempo
+#define BENCH_LOOKUPS 20000000
+
+// Texto usado na medição (letras, minúsculas, números e símbolos)
+static const char bench_text[] = "GENIUS Acertou! Nivel 10 <> Led Matriz 2025";
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Busca antiga: converte para maiúscula e percorre a tabela `alphabet`.
+ */
+static const Letter *legacy_lookup(char c) {
+    c = (char)toupper((unsigned char)c);
+    for (size_t j = 0; j < ALPHABET_COUNT; j++) {
+        if (alphabet[j].character == c) {
+            return &alphabet[j];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Confere se o desenho em bits tem os mesmos pixels acesos que a matriz da letra.
+ */
+static int same_glyph(const Letter *letter, const uint8_t *glyph) {
+    for (int y = 0; y < FONT5X5_ROWS; y++) {
+        for (int x = 0; x < FONT5X5_COLS; x++) {
+            const int *pixel = letter->matrix[y][x];
+            int on = pixel[0] || pixel[1] || pixel[2];
+            int bit = (glyph[y] >> (FONT5X5_COLS - 1 - x)) & 1;
+            if (on != bit) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(void) {
+    int failures = 0;
+    int checked = 0;
+
+    // Desenhos: todo código ASCII imprimível deve ter o mesmo desenho (ou a mesma ausência) nas duas tabelas
+    for (int code = 0; code < 256; code++) {
+        const Letter *letter = legacy_lookup((char)code);
+        const uint8_t *glyph = font5x5_glyph((char)code);
+        if (code < FONT5X5_FIRST || code > FONT5X5_LAST) {
+            letter = NULL; // Fora da fonte; a tabela antiga também só tem caracteres imprimíveis
+        }
+        if ((letter == NULL) != (glyph == NULL)) {
+            printf("ERRO: caractere %d %s na fonte em bits\n", code, glyph ? "sobrando" : "faltando");
+            failures++;
+        } else if (letter && !same_glyph(letter, glyph)) {
+            printf("ERRO: desenho diferente para '%c'\n", code);
+            failures++;
+        } else if (letter) {
+            checked++;
+        }
+    }
+    printf("Desenhos conferidos: %d caracteres (%zu na tabela antiga, mais as minúsculas): %s\n\n", checked,
+           ALPHABET_COUNT, failures ? "ERRO" : "ok");
+
+    // Memória: as tabelas ficam na flash; na RAM, o scroll montava frames de int[5][5][3] na pilha
+    size_t legacy_flash = sizeof(Letter) * ALPHABET_COUNT;
+    size_t font_flash = sizeof(font5x5) + sizeof(font5x5_defined);
+    printf("%-38s %10s %10s\n", "", "alphabet", "font5x5");
+    printf("%-38s %8zu B %8zu B\n", "Tabela na flash", legacy_flash, font_flash);
+    printf("%-38s %8zu B %8zu B\n", "Por caractere", sizeof(Letter), (size_t)FONT5X5_ROWS);
+    printf("%-38s %8zu B %8zu B\n", "Frame montado na pilha pelo scroll", sizeof(int[5][5][3]), (size_t)0);
+    printf("\n");
+
+    // Tempo de busca de um caractere
+    size_t text_len = strlen(bench_text);
+    volatile uintptr_t sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_LOOKUPS; i++) {
+        sink += (uintptr_t)legacy_lookup(bench_text[i % text_len]);
+    }
+    double legacy_ns = (now_ns() - t0) / BENCH_LOOKUPS;
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_LOOKUPS; i++) {
+        sink += (uintptr_t)font5x5_glyph(bench_text[i % text_len]);
+    }
+    double font_ns = (now_ns() - t0) / BENCH_LOOKUPS;
+    printf("Busca de um caractere: linear com toupper %.2f ns, índice direto %.2f ns\n", legacy_ns, font_ns);
+    (void)sink;
+
+    return failures ? 1 : 0;
+}
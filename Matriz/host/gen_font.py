@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Gera a fonte 5x5 em bits da MatrizRGBPI (font5x5.h/.c) a partir da tabela de src/alphabet.c.
+
+Cada `Letter` de alphabet.c guarda o desenho como int[5][5][3] (300 bytes para 25 pixels ligados ou
+desligados). A fonte gerada guarda um byte por linha, com a coluna 0 no bit 4, e é indexada
+diretamente pelo código ASCII (de FONT5X5_FIRST a FONT5X5_LAST); um bit por caractere indica quais
+têm desenho. As minúsculas recebem o desenho das maiúsculas, como o `toupper` do código antigo.
+
+Uso:
+    python3 gen_font.py <pasta do projeto>
+
+O desenho das letras continua sendo editado em src/alphabet.c, que não é mais compilado na placa.
+"""
+
+import argparse
+import os
+import re
+
+FIRST = 32
+LAST = 126
+COUNT = LAST - FIRST + 1
+ROWS = 5
+COLS = 5
+
+
+def parse_alphabet(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+    glyphs = {}
+    entries = list(re.finditer(r"\{\s*'(\\.|[^'])'\s*,", text))
+    for i, m in enumerate(entries):
+        end = entries[i + 1].start() if i + 1 < len(entries) else len(text)
+        values = [int(v) for v in re.findall(r"\d+", text[m.end():end])[:ROWS * COLS * 3]]
+        if len(values) != ROWS * COLS * 3:
+            raise SystemExit("%s: desenho incompleto para '%s'" % (path, m.group(1)))
+        char = m.group(1)[-1] if m.group(1).startswith("\\") else m.group(1)
+        rows = []
+        for y in range(ROWS):
+            bits = 0
+            for x in range(COLS):
+                pixel = values[(y * COLS + x) * 3:(y * COLS + x) * 3 + 3]
+                if any(pixel):
+                    bits |= 1 << (COLS - 1 - x)
+            rows.append(bits)
+        glyphs[char] = rows
+    return glyphs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("project", help="pasta com inc/ e src/ da MatrizRGBPI")
+    args = parser.parse_args()
+
+    glyphs = parse_alphabet(os.path.join(args.project, "src", "alphabet.c"))
+    for c in list(glyphs):
+        if c.isupper() and c.lower() not in glyphs:
+            glyphs[c.lower()] = glyphs[c]
+
+    defined = [0, 0, 0]
+    for c in glyphs:
+        code = ord(c) - FIRST
+        if 0 <= code < COUNT:
+            defined[code // 32] |= 1 << (code % 32)
+
+    h = [
+        "#ifndef FONT5X5_H",
+        "#define FONT5X5_H",
+        "",
+        "#include <stdint.h>",
+        "#include <stddef.h>",
+        "",
+        "/**",
+        " * @file font5x5.h",
+        " * @brief Fonte 5x5 da matriz de LEDs em bits (gerado por Matriz/host/gen_font.py a partir de src/alphabet.c).",
+        " * ",
+        " * Cada caractere ocupa FONT5X5_ROWS bytes, um por linha (de cima para baixo), com a coluna 0 no",
+        " * bit 4. A tabela é indexada pelo código ASCII, então achar o desenho de um caractere custa uma",
+        " * subtração e um teste de bit. Não edite à mão: altere src/alphabet.c e rode o gerador novamente.",
+        " */",
+        "",
+        "#define FONT5X5_FIRST %d  // Primeiro código ASCII da tabela" % FIRST,
+        "#define FONT5X5_LAST %d  // Último código ASCII da tabela" % LAST,
+        "#define FONT5X5_COUNT (FONT5X5_LAST - FONT5X5_FIRST + 1)",
+        "#define FONT5X5_ROWS %d" % ROWS,
+        "#define FONT5X5_COLS %d" % COLS,
+        "",
+        "/**",
+        " * @brief Desenho de cada caractere, a partir de FONT5X5_FIRST.",
+        " */",
+        "extern const uint8_t font5x5[FONT5X5_COUNT][FONT5X5_ROWS];",
+        "",
+        "/**",
+        " * @brief Um bit por caractere da tabela: 1 se ele tem desenho.",
+        " */",
+        "extern const uint32_t font5x5_defined[(FONT5X5_COUNT + 31) / 32];",
+        "",
+        "/**",
+        " * @brief Desenho de um caractere.",
+        " * @param c Caractere.",
+        " * @return As FONT5X5_ROWS linhas do desenho, ou NULL se o caractere não tem desenho.",
+        " */",
+        "static inline const uint8_t *font5x5_glyph(char c) {",
+        "    unsigned code = (unsigned)(uint8_t)c - FONT5X5_FIRST;",
+        "    if (code >= FONT5X5_COUNT || !(font5x5_defined[code / 32] & (1u << (code % 32)))) {",
+        "        return NULL;",
+        "    }",
+        "    return font5x5[code];",
+        "}",
+        "",
+        "#endif // FONT5X5_H",
+        "",
+    ]
+    c = [
+        '#include "inc/font5x5.h"',
+        "",
+        "/**",
+        " * Arquivo: font5x5.c",
+        " * ",
+        " * Descrição:",
+        " * Fonte 5x5 gerada por Matriz/host/gen_font.py a partir de src/alphabet.c. Não edite à mão.",
+        " */",
+        "",
+        "const uint8_t font5x5[FONT5X5_COUNT][FONT5X5_ROWS] = {",
+    ]
+    for code in range(FIRST, LAST + 1):
+        ch = chr(code)
+        rows = glyphs.get(ch, [0] * ROWS)
+        label = ("'%s'" % ch) if ch in glyphs else ""
+        if ch == "\\" and ch in glyphs:
+            label = "'\\\\'"
+        c.append(("    {%s},  // %3d %s" % (", ".join("0x%02X" % r for r in rows), code, label)).rstrip())
+    c += [
+        "};",
+        "",
+        "const uint32_t font5x5_defined[(FONT5X5_COUNT + 31) / 32] = {%s};" % ", ".join("0x%08Xu" % d for d in defined),
+        "",
+    ]
+
+    with open(os.path.join(args.project, "inc", "font5x5.h"), "w", encoding="utf-8") as f:
+        f.write("\n".join(h))
+    with open(os.path.join(args.project, "src", "font5x5.c"), "w", encoding="utf-8") as f:
+        f.write("\n".join(c))
+
+
+if __name__ == "__main__":
+    main()
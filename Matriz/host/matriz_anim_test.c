@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <time.h>
+#include "inc/matriz_anim.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file matriz_anim_test.c
+ * @brief Confere no host as trilhas e a composição de `matriz_anim` e mede o custo de um quadro.
+ *
+ * Verifica a interpolação de posição e cor nas três curvas, o fim e a repetição das trilhas, a ordem
+ * das camadas, a transparência dos desenhos e o corte nas bordas. Depois mede `matriz_anim_update`
+ * mais `matriz_anim_render` numa cena cheia. Retorna 1 se alguma verificação falhar.
+ */
+
+// Quadros usados na medição de tempo
+#define BENCH_FRAMES 200000
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static int failures = 0;
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Largura de `text` em colunas do terminal (acentos UTF-8 contam como um caractere).
+ */
+static int column_width(const char *text, int width) {
+    for (const char *c = text; *c; c++) {
+        width += ((uint8_t)*c & 0xC0) == 0x80;
+    }
+    return width;
+}
+
+static void check(int ok, const char *what) {
+    printf("%-*s %s\n", column_width(what, 58), what, ok ? "ok" : "ERRO");
+    failures += !ok;
+}
+
+/**
+ * @brief Confere posição e cor de um sprite.
+ */
+static int sprite_is(const matriz_anim_t *anim, int id, int x, int y, int r, int g, int b) {
+    const matriz_sprite_t *s = &anim->sprites[id];
+    return s->x == x && s->y == y && s->r == r && s->g == g && s->b == b;
+}
+
+/******************************
+ * Verificações
+ ******************************/
+
+static void check_tracks(void) {
+    static const matriz_keyframe_t move[] = {
+        {0, 0, 0, 0, 0, 0},
+        {100, 10, -4, 200, 100, 0},
+        {300, 10, 6, 0, 100, 255},
+    };
+    matriz_anim_t anim;
+    matriz_anim_init(&anim, 5, 5);
+    int id = matriz_anim_add(&anim, NULL, 1, 1, 0);
+
+    matriz_anim_play(&anim, id, move, 3, MATRIZ_EASE_LINEAR, false, 1000);
+    matriz_anim_update(&anim, 1050);
+    check(sprite_is(&anim, id, 5, -2, 100, 50, 0), "linear: metade do primeiro trecho");
+    matriz_anim_update(&anim, 1200);
+    check(sprite_is(&anim, id, 10, 1, 100, 100, 128), "linear: metade do segundo trecho");
+    matriz_anim_update(&anim, 1100);
+    check(sprite_is(&anim, id, 10, -4, 200, 100, 0), "linear: instante anterior ao trecho atual");
+    matriz_anim_update(&anim, 1400);
+    check(sprite_is(&anim, id, 10, 6, 0, 100, 255) && !matriz_anim_playing(&anim),
+          "fim: fica no último quadro-chave e para");
+
+    matriz_anim_play(&anim, id, move, 3, MATRIZ_EASE_STEP, false, 0);
+    matriz_anim_update(&anim, 99);
+    check(sprite_is(&anim, id, 0, 0, 0, 0, 0), "degrau: mantém o quadro-chave até o próximo");
+    matriz_anim_update(&anim, 100);
+    check(sprite_is(&anim, id, 10, -4, 200, 100, 0), "degrau: salta no instante do quadro-chave");
+
+    matriz_anim_play(&anim, id, move, 2, MATRIZ_EASE_IN_OUT, false, 0);
+    matriz_anim_update(&anim, 50);
+    int mid = sprite_is(&anim, id, 5, -2, 100, 50, 0);
+    matriz_anim_update(&anim, 25);
+    int slow_start = anim.sprites[id].r < 50 && anim.sprites[id].r > 0;
+    matriz_anim_update(&anim, 75);
+    int slow_end = anim.sprites[id].r > 150 && anim.sprites[id].r < 200;
+    check(mid && slow_start && slow_end, "suave: meio igual ao linear, lento nas pontas");
+
+    matriz_anim_play(&anim, id, move, 3, MATRIZ_EASE_LINEAR, true, 0);
+    matriz_anim_update(&anim, 250);
+    matriz_anim_update(&anim, 3 * 300 + 50);
+    check(sprite_is(&anim, id, 5, -2, 100, 50, 0) && matriz_anim_playing(&anim),
+          "repetição: recomeça no início da trilha");
+
+    static const matriz_keyframe_t unordered[] = {{100, 0, 0, 0, 0, 0}, {50, 0, 0, 0, 0, 0}};
+    check(!matriz_anim_play(&anim, id, unordered, 2, MATRIZ_EASE_LINEAR, false, 0) &&
+              !matriz_anim_play(&anim, 7, move, 3, MATRIZ_EASE_LINEAR, false, 0),
+          "trilha fora de ordem e sprite inexistente recusados");
+}
+
+static void check_render(void) {
+    static const uint8_t cross[3] = {0x2, 0x7, 0x2}; // Cruz 3x3 (cantos transparentes)
+    uint8_t frame[25][3];
+    matriz_anim_t anim;
+    matriz_anim_init(&anim, 5, 5);
+    anim.background[2] = 9;
+
+    int top = matriz_anim_add(&anim, cross, 3, 3, 2);
+    int bottom = matriz_anim_add(&anim, NULL, 5, 5, 1);
+    int clipped = matriz_anim_add(&anim, NULL, 2, 2, 3);
+    matriz_anim_set(&anim, top, 1, 1, 255, 0, 0);
+    matriz_anim_set(&anim, bottom, 0, 1, 0, 255, 0);
+    matriz_anim_set(&anim, clipped, -1, -1, 1, 2, 3);
+    matriz_anim_render(&anim, frame);
+
+    check(frame[2 * 5 + 2][0] == 255 && frame[1 * 5 + 2][0] == 255,
+          "camadas: a mais alta por cima, mesmo criada antes");
+    check(frame[1 * 5 + 1][1] == 255 && frame[1 * 5 + 1][0] == 0, "desenho: pixels apagados são transparentes");
+    check(frame[0 * 5 + 4][2] == 9 && frame[0 * 5 + 1][2] == 9, "fundo: cor de fundo fora dos sprites");
+    check(frame[0][0] == 1 && frame[0][2] == 3 && frame[1][2] == 9, "corte: sprite parcialmente fora da imagem");
+
+    matriz_anim_show(&anim, top, false);
+    matriz_anim_render(&anim, frame);
+    check(frame[2 * 5 + 2][1] == 255, "sprite escondido não é desenhado");
+
+    matriz_anim_init(&anim, 5, 5);
+    int big = matriz_anim_add(&anim, cross, 9, 3, 0);
+    int solid = matriz_anim_add(&anim, NULL, 16, 16, 0);
+    check(big == -1 && solid == 0, "desenho maior que 8x8 recusado, retângulo liberado");
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(void) {
+    check_tracks();
+    check_render();
+    printf("\n");
+
+    // Custo de um quadro: cena cheia numa imagem 16x16, todos os sprites andando e mudando de cor
+    static const uint8_t ball[4] = {0x6, 0xF, 0xF, 0x6};
+    static const matriz_keyframe_t bounce[] = {
+        {0, 0, 0, 255, 0, 0}, {400, 12, 6, 0, 255, 0}, {800, 3, 12, 0, 0, 255}, {1200, 0, 0, 255, 0, 0},
+    };
+    static uint8_t frame[256][3];
+    static matriz_anim_t anim;
+    matriz_anim_init(&anim, 16, 16);
+    for (int i = 0; i < MATRIZ_ANIM_MAX_SPRITES; i++) {
+        int id = matriz_anim_add(&anim, ball, 4, 4, (uint8_t)(i % 3));
+        matriz_anim_play(&anim, id, bounce, 4, i % 2 ? MATRIZ_EASE_IN_OUT : MATRIZ_EASE_LINEAR, true,
+                         (uint32_t)i * 75);
+    }
+    volatile uint8_t sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_FRAMES; i++) {
+        matriz_anim_update(&anim, 2000 + i * 20); // 50 quadros por segundo
+        matriz_anim_render(&anim, frame);
+        sink += frame[i & 255][0];
+    }
+    double frame_ns = (now_ns() - t0) / BENCH_FRAMES;
+    printf("Quadro (%d sprites, 16x16): %.0f ns\n", MATRIZ_ANIM_MAX_SPRITES, frame_ns);
+    (void)sink;
+
+    return failures ? 1 : 0;
+}
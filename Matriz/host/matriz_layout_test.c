@@ -0,0 +1,264 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "inc/matriz_layout.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file matriz_layout_test.c
+ * @brief Confere no host a tabela de coordenadas de `matriz_layout` para várias montagens.
+ *
+ * Para cada montagem, a tabela de `matriz_layout_build` é comparada com uma referência construída no
+ * sentido do fio: os painéis e os LEDs são percorridos na ordem da cadeia e cada LED marca a sua
+ * coordenada na imagem. Também confere que cada LED aparece uma única vez, alguns índices calculados
+ * à mão e, para a matriz da BitDogLab, a fórmula do antigo `getIndex`. Retorna 1 se alguma
+ * verificação falhar.
+ */
+
+// Maior imagem testada (em pixels)
+#define MAX_PIXELS 1024
+
+// Consultas usadas na medição de tempo
+#define BENCH_LOOKUPS 20000000
+
+/******************************
+ * Montagens Testadas
+ ******************************/
+
+/**
+ * @brief Índice esperado de um pixel, calculado à mão.
+ */
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t index;
+} spot_t;
+
+typedef struct {
+    const char *name;
+    matriz_layout_t layout;
+    spot_t spots[6];
+    unsigned spot_count;
+} layout_case_t;
+
+static const layout_case_t cases[] = {
+    {"BitDogLab 5x5", MATRIZ_LAYOUT_BITDOGLAB, {{4, 4, 0}, {0, 4, 4}, {0, 3, 5}, {0, 0, 24}, {4, 0, 20}}, 5},
+    {"8x8 progressiva",
+     {8, 8, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 1, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 0},
+     {{0, 0, 0}, {7, 0, 7}, {0, 1, 8}, {3, 2, 19}, {7, 7, 63}}, 5},
+    {"8x8 serpentina",
+     {8, 8, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_TOP_LEFT, 1, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 0},
+     {{7, 0, 7}, {7, 1, 8}, {0, 1, 15}, {0, 2, 16}}, 4},
+    {"16x16 serpentina, início embaixo à esquerda",
+     {16, 16, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_BOTTOM_LEFT, 1, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 0},
+     {{0, 15, 0}, {15, 15, 15}, {15, 14, 16}, {0, 14, 31}, {0, 0, 255}, {15, 0, 240}}, 6},
+    {"8x8 progressiva, girada 90°",
+     {8, 8, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 1, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 1},
+     {{0, 0, 7}, {7, 0, 63}, {0, 7, 0}, {7, 7, 56}}, 4},
+    {"8x4 serpentina, girada 180°",
+     {8, 4, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_TOP_RIGHT, 1, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 2},
+     {{7, 3, 7}, {0, 3, 0}, {0, 2, 15}, {7, 0, 24}}, 4},
+    {"2x2 painéis 8x8, cadeia em serpentina",
+     {8, 8, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 2, 2, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_TOP_LEFT, 0},
+     {{8, 0, 64}, {15, 15, 191}, {0, 8, 192}, {7, 7, 63}}, 4},
+    {"4x1 painéis 8x8 serpentina, girada 270°",
+     {8, 8, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_TOP_LEFT, 4, 1, MATRIZ_WIRING_PROGRESSIVE, MATRIZ_ORIGIN_TOP_LEFT, 3},
+     {{0, 0, 63}, {7, 0, 0}, {7, 31, 199}}, 3},
+    {"3x2 painéis 5x5, cadeia de baixo para cima",
+     {5, 5, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_BOTTOM_RIGHT, 3, 2, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_BOTTOM_LEFT, 0},
+     {{4, 9, 0}, {9, 9, 25}, {14, 4, 75}}, 3},
+};
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Largura de `text` em colunas do terminal (acentos UTF-8 contam como um caractere).
+ */
+static int column_width(const char *text, int width) {
+    for (const char *c = text; *c; c++) {
+        width += ((uint8_t)*c & 0xC0) == 0x80;
+    }
+    return width;
+}
+
+/**
+ * @brief Posição (coluna, linha) do passo `step` de uma fita que percorre uma grade a partir de `origin`.
+ */
+static void walk(unsigned step, unsigned width, unsigned height, matriz_wiring_t wiring, matriz_origin_t origin,
+                 unsigned *col, unsigned *row) {
+    *row = step / width;
+    *col = step % width;
+    if (wiring == MATRIZ_WIRING_SERPENTINE && (*row & 1)) {
+        *col = width - 1 - *col;
+    }
+    if (origin == MATRIZ_ORIGIN_TOP_RIGHT || origin == MATRIZ_ORIGIN_BOTTOM_RIGHT) {
+        *col = width - 1 - *col;
+    }
+    if (origin == MATRIZ_ORIGIN_BOTTOM_LEFT || origin == MATRIZ_ORIGIN_BOTTOM_RIGHT) {
+        *row = height - 1 - *row;
+    }
+}
+
+/**
+ * @brief Tabela de referência, no sentido do fio: cada LED da cadeia marca o seu pixel na imagem.
+ */
+static void reference_lut(const matriz_layout_t *l, uint16_t *lut) {
+    unsigned tx = l->tiles_x ? l->tiles_x : 1;
+    unsigned ty = l->tiles_y ? l->tiles_y : 1;
+    unsigned pw = l->panel_width * tx;     // Montagem, antes da rotação
+    unsigned ph = l->panel_height * ty;
+    unsigned width = (l->rotation & 1) ? ph : pw;
+    unsigned index = 0;
+
+    for (unsigned t = 0; t < tx * ty; t++) {
+        unsigned tcol, trow;
+        walk(t, tx, ty, l->tile_wiring, l->tile_origin, &tcol, &trow);
+        for (unsigned s = 0; s < (unsigned)l->panel_width * l->panel_height; s++, index++) {
+            unsigned col, row;
+            walk(s, l->panel_width, l->panel_height, l->wiring, l->origin, &col, &row);
+            unsigned px = tcol * l->panel_width + col;
+            unsigned py = trow * l->panel_height + row;
+
+            // Pixel da imagem que a rotação leva até (px, py)
+            unsigned x, y;
+            switch (l->rotation & 3) {
+                case 1:  x = py; y = pw - 1 - px; break;
+                case 2:  x = pw - 1 - px; y = ph - 1 - py; break;
+                case 3:  x = ph - 1 - py; y = px; break;
+                default: x = px; y = py; break;
+            }
+            lut[y * width + x] = (uint16_t)index;
+        }
+    }
+}
+
+/**
+ * @brief Índice da matriz 5x5 pela fórmula do `getIndex` original.
+ */
+static int legacy_get_index(int x, int y) {
+    if (y % 2 == 0) {
+        return 24 - (y * 5 + x);
+    } else {
+        return 24 - (y * 5 + (4 - x));
+    }
+}
+
+static int check(int ok, const char *what) {
+    if (!ok) {
+        printf("ERRO: %s\n", what);
+    }
+    return !ok;
+}
+
+/**
+ * @brief Confere uma montagem; devolve o número de falhas.
+ */
+static int check_case(const layout_case_t *c) {
+    static uint16_t lut[MAX_PIXELS], ref[MAX_PIXELS];
+    unsigned width = matriz_layout_width(&c->layout);
+    unsigned height = matriz_layout_height(&c->layout);
+    unsigned count = width * height;
+    int failures = 0;
+
+    if (count > MAX_PIXELS || !matriz_layout_build(&c->layout, lut, count)) {
+        printf("%-*s %3ux%-3u ERRO: tabela não gerada\n", column_width(c->name, 46), c->name, width, height);
+        return 1;
+    }
+    reference_lut(&c->layout, ref);
+
+    unsigned mismatches = 0, duplicates = 0;
+    static uint8_t seen[MAX_PIXELS];
+    memset(seen, 0, sizeof(seen));
+    for (unsigned i = 0; i < count; i++) {
+        mismatches += lut[i] != ref[i];
+        duplicates += lut[i] >= count || seen[lut[i]]++;
+    }
+    unsigned spot_errors = 0;
+    for (unsigned i = 0; i < c->spot_count; i++) {
+        const spot_t *s = &c->spots[i];
+        if (lut[s->y * width + s->x] != s->index) {
+            printf("  (%u, %u): LED %u, esperado %u\n", s->x, s->y, lut[s->y * width + s->x], s->index);
+            spot_errors++;
+        }
+    }
+    failures = mismatches || duplicates || spot_errors;
+
+    printf("%-*s %3ux%-3u %s", column_width(c->name, 46), c->name, width, height, failures ? "ERRO" : "ok");
+    if (failures) {
+        printf(" (%u diferentes da referência, %u repetidos, %u índices errados)", mismatches, duplicates,
+               spot_errors);
+    }
+    printf("\n");
+    return failures;
+}
+
+/******************************
+ * Programa Principal
+ ******************************/
+
+int main(void) {
+    int failures = 0;
+
+    printf("%-*s %7s\n", column_width("montagem", 46), "montagem", "imagem");
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        failures += check_case(&cases[i]);
+    }
+    printf("\n");
+
+    // A montagem da BitDogLab reproduz o getIndex antigo em toda a imagem
+    static const matriz_layout_t bitdoglab = MATRIZ_LAYOUT_BITDOGLAB;
+    int legacy_errors = 0;
+    printf("BitDogLab (LED de cada pixel):\n");
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 5; x++) {
+            int32_t index = matriz_layout_index(&bitdoglab, (uint16_t)x, (uint16_t)y);
+            legacy_errors += index != legacy_get_index(x, y);
+            printf("%4d", (int)index);
+        }
+        printf("\n");
+    }
+    failures += check(legacy_errors == 0, "BitDogLab diferente do getIndex original");
+
+    // Entradas inválidas
+    uint16_t lut[MAX_PIXELS];
+    matriz_layout_t empty = bitdoglab;
+    empty.panel_width = 0;
+    int invalid_errors = check(!matriz_layout_build(&empty, lut, 0), "painel sem largura aceito");
+    invalid_errors += check(!matriz_layout_build(&bitdoglab, lut, 24), "tabela de tamanho errado aceita");
+    invalid_errors += check(matriz_layout_index(&bitdoglab, 5, 0) == -1 && matriz_layout_index(&bitdoglab, 0, 5) == -1,
+                            "pixel fora da imagem com índice");
+    printf("Entradas inválidas: %s\n\n", invalid_errors ? "ERRO" : "ok");
+    failures += invalid_errors;
+
+    // Custo por pixel: cálculo direto contra a tabela, numa imagem de 16x16 em quatro painéis
+    const matriz_layout_t chained = {8, 8, MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_BOTTOM_RIGHT, 2, 2,
+                                     MATRIZ_WIRING_SERPENTINE, MATRIZ_ORIGIN_TOP_LEFT, 1};
+    matriz_layout_build(&chained, lut, 256);
+    volatile uint32_t sink = 0;
+    double t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_LOOKUPS; i++) {
+        sink += (uint32_t)matriz_layout_index(&chained, (uint16_t)(i & 15), (uint16_t)((i >> 4) & 15));
+    }
+    double direct_ns = (now_ns() - t0) / BENCH_LOOKUPS;
+    t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_LOOKUPS; i++) {
+        sink += lut[((i >> 4) & 15) * 16 + (i & 15)];
+    }
+    double lut_ns = (now_ns() - t0) / BENCH_LOOKUPS;
+    printf("Índice de um pixel (16x16, 2x2 painéis, girada): cálculo %.2f ns, tabela %.2f ns\n", direct_ns, lut_ns);
+    (void)sink;
+
+    return failures ? 1 : 0;
+}
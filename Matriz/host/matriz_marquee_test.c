@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <string.h>
+#include "inc/matriz_marquee.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file matriz_marquee_test.c
+ * @brief Confere no host as colunas geradas por `matriz_marquee` para textos curtos.
+ *
+ * As colunas esperadas foram montadas à mão a partir dos desenhos de `font5x5.c` (linha 0 no bit 0).
+ * Verifica o corte das colunas vazias de cada letra, o intervalo entre letras, o espaço, os caracteres
+ * sem desenho, as colunas do fim (`tail`), o fim sem repetição e a repetição com `loop`, inclusive
+ * que um texto sem nada para desenhar termina mesmo com `loop`. Retorna 1 se alguma verificação falhar.
+ */
+
+// Maior número de colunas lidas numa verificação
+#define MAX_COLUMNS 64
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static int failures = 0;
+
+/**
+ * @brief Largura de `text` em colunas do terminal (acentos UTF-8 contam como um caractere).
+ */
+static int column_width(const char *text, int width) {
+    for (const char *c = text; *c; c++) {
+        width += ((uint8_t)*c & 0xC0) == 0x80;
+    }
+    return width;
+}
+
+static void check(int ok, const char *what) {
+    printf("%-*s %s\n", column_width(what, 58), what, ok ? "ok" : "ERRO");
+    failures += !ok;
+}
+
+/**
+ * @brief Lê até `max` colunas; devolve quantas vieram antes do fim do letreiro.
+ */
+static int run(matriz_marquee_t *marquee, uint8_t *columns, int max) {
+    int count = 0;
+    while (count < max && matriz_marquee_next(marquee, &columns[count])) {
+        count++;
+    }
+    return count;
+}
+
+static int columns_are(const uint8_t *columns, int count, const uint8_t *expected, int expected_count) {
+    return count == expected_count && memcmp(columns, expected, (size_t)count) == 0;
+}
+
+/******************************
+ * Verificações
+ ******************************/
+
+// '1': colunas 1 a 3 do desenho; '!': só a coluna 2
+#define COLS_1 0x12, 0x1F, 0x10
+#define COLS_BANG 0x17
+
+static void check_columns(void) {
+    matriz_marquee_t marquee;
+    uint8_t columns[MAX_COLUMNS];
+
+    static const uint8_t one[] = {COLS_1, 0x00};
+    matriz_marquee_start(&marquee, "1", 0, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), one, sizeof(one)),
+          "letra sem as colunas vazias, seguida do intervalo");
+
+    static const uint8_t word[] = {COLS_1, 0x00, COLS_BANG, 0x00};
+    matriz_marquee_start(&marquee, "1!", 0, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), word, sizeof(word)),
+          "letras de larguras diferentes, um intervalo entre elas");
+
+    static const uint8_t spaced[] = {COLS_1, 0x00, 0x00, 0x00, COLS_BANG, 0x00};
+    matriz_marquee_start(&marquee, "1 !", 0, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), spaced, sizeof(spaced)),
+          "espaço: MATRIZ_MARQUEE_SPACE colunas além do intervalo");
+
+    matriz_marquee_start(&marquee, "1\"\x01!", 0, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), word, sizeof(word)),
+          "caracteres sem desenho são ignorados");
+
+    static const uint8_t tail[] = {COLS_1, 0x00, COLS_BANG, 0x00, 0x00, 0x00, 0x00, 0x00};
+    matriz_marquee_start(&marquee, "1!", 5, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), tail, sizeof(tail)),
+          "fim: `tail` colunas apagadas contando o último intervalo");
+    check(!matriz_marquee_next(&marquee, &columns[0]), "fim: continua terminado nas chamadas seguintes");
+}
+
+static void check_loop(void) {
+    matriz_marquee_t marquee;
+    uint8_t columns[MAX_COLUMNS];
+
+    static const uint8_t lap[] = {COLS_1, 0x00, 0x00, 0x00, COLS_BANG, 0x00, 0x00, 0x00};
+    matriz_marquee_start(&marquee, "1 !", 3, true);
+    int count = run(&marquee, columns, 3 * sizeof(lap));
+    int repeated = count == 3 * (int)sizeof(lap);
+    for (int i = 0; repeated && i < 3; i++) {
+        repeated = memcmp(&columns[i * sizeof(lap)], lap, sizeof(lap)) == 0;
+    }
+    check(repeated, "repetição: a mesma volta, com as colunas do fim, sem parar");
+
+    matriz_marquee_start(&marquee, "", 0, true);
+    int empty = run(&marquee, columns, MAX_COLUMNS) == 0;
+    matriz_marquee_start(&marquee, "\"\x01", 0, true);
+    int undrawable = run(&marquee, columns, MAX_COLUMNS) == 0;
+    check(empty && undrawable, "repetição: texto sem colunas termina em vez de travar");
+
+    static const uint8_t restarted[] = {COLS_BANG, 0x00};
+    matriz_marquee_start(&marquee, "1", 0, true);
+    run(&marquee, columns, 2);
+    matriz_marquee_start(&marquee, "!", 0, false);
+    check(columns_are(columns, run(&marquee, columns, MAX_COLUMNS), restarted, sizeof(restarted)),
+          "novo texto no meio de uma letra recomeça do zero");
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(void) {
+    check_columns();
+    check_loop();
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,122 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "inc/matriz_parallel.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file matriz_parallel_test.c
+ * @brief Confere no host a transposição de `matriz_parallel` e mede o custo dela.
+ *
+ * Os planos gerados passam por uma simulação do programa `ws2812_parallel` (cada byte, do mais
+ * significativo ao menos, é um bit de todas as fitas) e o sinal de cada pino é comparado com o que
+ * o programa de uma fita enviaria para os mesmos pixels (24 ou 32 bits por LED, do bit mais
+ * significativo ao menos). Depois mede a transposição e compara o tempo de linha de N fitas em
+ * sequência e em paralelo. Retorna 1 se alguma verificação falhar.
+ */
+
+// Maior fita testada (LEDs)
+#define MAX_STRIP_LEDS 64
+
+// Medição de tempo: LEDs por fita e repetições
+#define BENCH_STRIP_LEDS 256
+#define BENCH_ROUNDS 2000
+
+// Bits por segundo na linha do WS2812B
+#define BIT_FREQ_HZ 800000
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Confere uma combinação de fitas e canais com pixels aleatórios; devolve o número de bits errados.
+ */
+static unsigned check_case(uint8_t strips, uint8_t channels, uint32_t strip_leds) {
+    static uint32_t pixels[MATRIZ_PARALLEL_MAX_STRIPS * MAX_STRIP_LEDS];
+    static uint32_t planes[MAX_STRIP_LEDS * MATRIZ_PARALLEL_WORDS(4)];
+    for (uint32_t i = 0; i < strips * strip_leds; i++) {
+        pixels[i] = (uint32_t)rand() << 16 ^ (uint32_t)rand();
+        if (channels == 3) {
+            pixels[i] &= 0xFFFFFF00u; // O byte W não é enviado
+        }
+    }
+    matriz_parallel_transpose(pixels, strip_leds, strips, channels, planes);
+
+    // Simulação da máquina: palavras em ordem, bytes do mais significativo ao menos
+    unsigned errors = 0;
+    uint32_t words = strip_leds * MATRIZ_PARALLEL_WORDS(channels);
+    for (uint32_t w = 0; w < words; w++) {
+        for (int byte = 3; byte >= 0; byte--) {
+            uint8_t plane = (uint8_t)(planes[w] >> (8 * byte));
+            uint32_t bit_time = w * 4 + (3 - byte);          // Bit na linha
+            uint32_t led = bit_time / (channels * 8);
+            uint32_t bit = 31 - bit_time % (channels * 8);   // Bit da palavra do pixel
+            for (uint8_t s = 0; s < MATRIZ_PARALLEL_MAX_STRIPS; s++) {
+                int expected = s < strips ? (pixels[s * strip_leds + led] >> bit) & 1 : 0;
+                errors += ((plane >> s) & 1) != expected;
+            }
+        }
+    }
+    return errors;
+}
+
+/******************************
+ * Função Principal
+ ******************************/
+
+int main(void) {
+    int failures = 0;
+    srand(1);
+
+    printf("%6s %8s %8s %s\n", "fitas", "canais", "LEDs", "resultado");
+    for (uint8_t channels = 3; channels <= 4; channels++) {
+        for (uint8_t strips = 1; strips <= MATRIZ_PARALLEL_MAX_STRIPS; strips++) {
+            uint32_t strip_leds = 1 + (uint32_t)rand() % MAX_STRIP_LEDS;
+            unsigned errors = check_case(strips, channels, strip_leds);
+            printf("%6u %8u %8u %s", strips, channels, strip_leds, errors ? "ERRO" : "ok");
+            if (errors) {
+                printf(" (%u bits diferentes)", errors);
+            }
+            printf("\n");
+            failures += errors != 0;
+        }
+    }
+    printf("\n");
+
+    // Custo da transposição: 8 fitas de BENCH_STRIP_LEDS LEDs RGB
+    static uint32_t pixels[MATRIZ_PARALLEL_MAX_STRIPS * BENCH_STRIP_LEDS];
+    static uint32_t planes[BENCH_STRIP_LEDS * MATRIZ_PARALLEL_WORDS(3)];
+    for (uint32_t i = 0; i < MATRIZ_PARALLEL_MAX_STRIPS * BENCH_STRIP_LEDS; i++) {
+        pixels[i] = (uint32_t)rand() << 8;
+    }
+    volatile uint32_t sink = 0;
+    double t0 = now_ns();
+    for (int r = 0; r < BENCH_ROUNDS; r++) {
+        pixels[r % BENCH_STRIP_LEDS] ^= (uint32_t)r << 8;
+        matriz_parallel_transpose(pixels, BENCH_STRIP_LEDS, MATRIZ_PARALLEL_MAX_STRIPS, 3, planes);
+        sink += planes[r % BENCH_STRIP_LEDS];
+    }
+    double frame_ns = (now_ns() - t0) / BENCH_ROUNDS;
+    printf("Transposição de 8 fitas x %d LEDs: %.1f us por quadro (%.1f ns por LED)\n", BENCH_STRIP_LEDS,
+           frame_ns / 1000, frame_ns / (MATRIZ_PARALLEL_MAX_STRIPS * BENCH_STRIP_LEDS));
+    (void)sink;
+
+    // Tempo de linha: as fitas em sequência somam os tempos; em paralelo, vale o de uma fita
+    printf("\n%6s %19s %18s\n", "fitas", "em sequência", "em paralelo");
+    for (int strips = 1; strips <= MATRIZ_PARALLEL_MAX_STRIPS; strips *= 2) {
+        double strip_ms = BENCH_STRIP_LEDS * 24 * 1000.0 / BIT_FREQ_HZ;
+        printf("%6d %15.2f ms %15.2f ms\n", strips, strips * strip_ms, strip_ms);
+    }
+
+    return failures ? 1 : 0;
+}
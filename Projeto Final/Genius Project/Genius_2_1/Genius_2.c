@@ -4,7 +4,7 @@
  * 
  * Este código implementa um jogo de memória de sequência de cores usando:
  * - Matriz LED 5x5 RGB para exibição
- * - Joystick para seleção de cores
+ * - Joystick para seleção de cores (detector de direção com histerese)
  * - Dois botões para confirmação e controle
  * - Buzzer para feedback sonoro
  * - Display OLED SSD1306 para informações do jogo
@@ -15,6 +15,7 @@
  */
 
 #include "inc/JoystickPi.h"
+#include "inc/joystick_direction.h"
 #include "inc/ButtonPi.h"
 #include "inc/BuzzerPi.h"
 #include "inc/MatrizRGBPI.h"
@@ -33,6 +34,9 @@
 #define BUTTON_A_PIN 5  // Pino do botão A (confirmação)
 #define BUTTON_B_PIN 6  // Pino do botão B (alternativo)
 
+// Terço do curso normalizado: raio da zona central, em que a seleção fica no azul
+#define JOYSTICK_SELECT_THRESHOLD (JOYSTICK_NORM_MAX / 3)
+
 /******************************
  * Definições de cores
  ******************************/
@@ -40,38 +44,64 @@
 #define BLUE 1     // Índice para cor azul
 #define RED 2      // Índice para cor vermelha
 
+// Correção de cor da matriz: as cores abaixo são lineares e saem com gama e a um quarto do brilho
+#define MATRIX_GAMMA 2.2f
+#define MATRIX_BRIGHTNESS 64
+
 // Definições de cores RGB para a matriz LED
-#define COLOR_WHITE 20, 20, 20
+#define COLOR_WHITE 160, 160, 160
 #define COLOR_GREEN 0, 255, 0
 #define COLOR_BLUE 0, 0, 255
 #define COLOR_RED 255, 0, 0
 #define COLOR_OFF 0, 0, 0
 
+// Tempo de cada coluna dos letreiros da matriz (ms)
+#define MARQUEE_COLUMN_MS 100
+
+// Quadros por segundo das animações da matriz
+#define MATRIX_ANIM_FPS 50
+
+// Tempos de cada passo da sequência exibida (ms): cor acesa, com o som no início, e pausa apagada
+#define SEQUENCE_LIGHT_MS 700
+#define SEQUENCE_TONE_MS 200
+#define SEQUENCE_STEP_MS 900
+
+// Maior sequência guardada
+#define SEQUENCE_MAX_LENGTH 100
+
 /******************************
  * Estados do jogo
  ******************************/
 typedef enum {
-    STATE_SHOW_SEQUENCE, // Exibindo a sequência de cores
-    STATE_WAIT_INPUT,    // Aguardando entrada do jogador
-    STATE_CHECK_INPUT,   // Verificando a entrada
-    STATE_GAME_OVER,     // Fim de jogo (erro do jogador)
-    STATE_ROUND_COMPLETE // Rodada completada com sucesso
+    STATE_SHOW_SEQUENCE,  // Início da exibição da sequência de cores
+    STATE_SHOWING_SEQUENCE, // Sequência passando na matriz e no buzzer
+    STATE_WAIT_INPUT,     // Aguardando entrada do jogador
+    STATE_CHECK_INPUT,    // Verificando a entrada
+    STATE_GAME_OVER,      // Fim de jogo (erro do jogador)
+    STATE_ROUND_COMPLETE, // Rodada completada com sucesso
+    STATE_ROUND_MESSAGE,  // Letreiro da próxima rodada passando na matriz
+    STATE_ROUND_FLASH     // Matriz piscando em branco antes da próxima rodada
 } GameState;
 
 /******************************
  * Variáveis globais
  ******************************/
-int sequence[100];             // Armazena a sequência de cores
+int sequence[SEQUENCE_MAX_LENGTH]; // Armazena a sequência de cores
 int sequence_length = 1;       // Tamanho atual da sequência
 int current_step = 0;          // Passo atual na sequência
 GameState game_state = STATE_SHOW_SEQUENCE; // Estado inicial do jogo
 int selected_color = GREEN;    // Cor selecionada pelo jogador
+bool selection_changed = true; // A matriz precisa ser redesenhada com a cor selecionada
+joystick_tracker_t joystick_tracker; // Detector de direção usado na seleção de cor
 bool button_b_pressed = false; // Flag para botão B pressionado
 int round_number = 1;          // Número da rodada atual
 bool reset_requested = false;   // Flag para reiniciar o jogo
 bool check_input_requested = false; // Flag para verificar entrada
 bool game_over_shown = false;  // Flag para controle de exibição de Game Over
 absolute_time_t last_activity_time; // Tempo da última atividade
+volatile int sequence_sound_step = 0; // Passo da sequência cujo som o alarme controla
+volatile bool sequence_tone_on = false; // Som do passo atual ligado
+volatile alarm_id_t sequence_alarm = 0; // Alarme dos sons da sequência (0: nenhum agendado)
 const uint32_t INACTIVITY_TIMEOUT_MS = 30000; // 30 segundos de timeout
 
 /******************************
@@ -83,16 +113,20 @@ void init_display();
 void update_display();
 void show_game_over_display();
 void show_timeout_display();
+uint32_t color_frequency(int color);
+void color_to_rgb(int color, uint8_t rgb[3]);
 void play_color_sound(int color);
 void light_up_matrix(int color);
 void show_white_matrix();
 void show_round_message();
 void generate_sequence();
 void show_sequence();
+void stop_sequence();
 void check_choice();
 void reset_game();
 void button_a_callback();
 void button_b_callback();
+void joystick_direction_callback(const joystick_direction_event_t *event, void *user_data);
 
 /**
  * @brief Atualiza o tempo da última atividade do usuário
@@ -163,16 +197,36 @@ void show_timeout_display() {
     sleep_ms(2000);
 }
 
+/**
+ * @brief Nota musical correspondente a uma cor
+ * @param color Cor (GREEN, BLUE ou RED)
+ * @return Frequência da nota em Hz
+ */
+uint32_t color_frequency(int color) {
+    switch (color) {
+        case GREEN: return 523; // Nota C5
+        case BLUE:  return 659; // Nota E5
+        default:    return 440; // Nota A4 (vermelho)
+    }
+}
+
+/**
+ * @brief Componentes RGB de uma cor do jogo
+ * @param color Cor (GREEN, BLUE ou RED; outro valor é apagado)
+ * @param rgb Destino dos componentes R, G e B
+ */
+void color_to_rgb(int color, uint8_t rgb[3]) {
+    rgb[0] = color == RED ? 255 : 0;
+    rgb[1] = color == GREEN ? 255 : 0;
+    rgb[2] = color == BLUE ? 255 : 0;
+}
+
 /**
  * @brief Toca um som correspondente à cor selecionada
  * @param color Cor selecionada (GREEN, BLUE ou RED)
  */
 void play_color_sound(int color) {
-    switch (color) {
-        case GREEN: play_tone(BUZZER_PIN, 523, 200); break; // Nota C5
-        case BLUE:  play_tone(BUZZER_PIN, 659, 200); break; // Nota E5
-        case RED:   play_tone(BUZZER_PIN, 440, 200); break; // Nota A4
-    }
+    play_tone(BUZZER_PIN, color_frequency(color), SEQUENCE_TONE_MS);
 }
 
 /**
@@ -182,46 +236,47 @@ void play_color_sound(int color) {
 void light_up_matrix(int color) {
     MatrizRGBPI_Clear();
     
-    uint8_t r, g, b;
-    switch (color) {
-        case GREEN: r = 0; g = 255; b = 0; break;
-        case BLUE:  r = 0; g = 0; b = 255; break;
-        case RED:   r = 255; g = 0; b = 0; break;
-        default:    r = 0; g = 0; b = 0; break;
-    }
+    uint8_t rgb[3];
+    color_to_rgb(color, rgb);
     
     // Acende o centro 3x3 da matriz
     for (int x = 1; x < 4; x++) {
         for (int y = 1; y < 4; y++) {
             int pos = getIndex(x, y);
-            MatrizRGBPI_SetLED(pos, r, g, b);
+            MatrizRGBPI_SetLED(pos, rgb[0], rgb[1], rgb[2]);
         }
     }
     
-    MatrizRGBPI_Write();
+    MatrizRGBPI_Present(); // Não reenvia se a cor já estava na matriz
 }
 
 /**
- * @brief Mostra toda a matriz LED branca
+ * @brief Anima a matriz LED inteira em branco por 1 s: acende, fica acesa e apaga (não bloqueia)
  */
 void show_white_matrix() {
-    MatrizRGBPI_Clear();
-    for (int x = 0; x < 5; x++) {
-        for (int y = 0; y < 5; y++) {
-            int pos = getIndex(x, y);
-            MatrizRGBPI_SetLED(pos, COLOR_WHITE);
-        }
-    }
-    MatrizRGBPI_Write();
+    static const matriz_keyframe_t flash[] = {
+        {0, 0, 0, COLOR_OFF},
+        {200, 0, 0, COLOR_WHITE},
+        {800, 0, 0, COLOR_WHITE},
+        {1000, 0, 0, COLOR_OFF},
+    };
+
+    matriz_anim_t *anim = MatrizRGBPI_AnimLock();
+    matriz_anim_init(anim, MATRIZ_WIDTH, MATRIZ_HEIGHT);
+    int sprite = matriz_anim_add(anim, NULL, MATRIZ_WIDTH, MATRIZ_HEIGHT, 0);
+    matriz_anim_play(anim, sprite, flash, sizeof(flash) / sizeof(flash[0]), MATRIZ_EASE_IN_OUT, false,
+                     MatrizRGBPI_AnimNow());
+    MatrizRGBPI_AnimUnlock();
+    MatrizRGBPI_AnimStart(MATRIX_ANIM_FPS);
 }
 
 /**
- * @brief Exibe mensagem da rodada atual com scroll na matriz LED
+ * @brief Inicia o letreiro com a rodada atual na matriz LED (não bloqueia)
  */
 void show_round_message() {
-    char round_msg[20];
+    static char round_msg[20]; // O letreiro lê o texto enquanto passa
     snprintf(round_msg, sizeof(round_msg), "Round %d", round_number);
-    MatrizRGBPI_displayStringWithScroll(round_msg, 150, COLOR_GREEN);
+    MatrizRGBPI_MarqueeStart(round_msg, MARQUEE_COLUMN_MS, false, COLOR_GREEN);
 }
 
 /**
@@ -234,18 +289,72 @@ void generate_sequence() {
 }
 
 /**
- * @brief Exibe a sequência de cores para o jogador memorizar
+ * @brief Alarme dos sons da sequência: liga o som no início de cada passo e o desliga depois de
+ * SEQUENCE_TONE_MS, reagendando-se a partir do instante previsto, sem acumular atraso
+ */
+int64_t sequence_sound_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    if (!sequence_tone_on) {
+        start_tone(BUZZER_PIN, color_frequency(sequence[sequence_sound_step]));
+        sequence_tone_on = true;
+        return -(int64_t)SEQUENCE_TONE_MS * 1000;
+    }
+    stop_tone(BUZZER_PIN);
+    sequence_tone_on = false;
+    if (++sequence_sound_step < sequence_length) {
+        return -(int64_t)(SEQUENCE_STEP_MS - SEQUENCE_TONE_MS) * 1000;
+    }
+    sequence_alarm = 0;
+    return 0;
+}
+
+/**
+ * @brief Inicia a exibição da sequência de cores para o jogador memorizar (não bloqueia)
+ *
+ * As cores viram uma trilha de quadros-chave em degrau no centro 3x3 da matriz, tocada pelo relógio
+ * de quadros; os sons seguem o mesmo relógio num alarme. A exibição terminou quando
+ * `MatrizRGBPI_AnimPlaying` e `sequence_alarm` zeram.
  */
 void show_sequence() {
+    static matriz_keyframe_t keys[2 * SEQUENCE_MAX_LENGTH + 1]; // A trilha é lida enquanto toca
+    int count = 0;
     for (int i = 0; i < sequence_length; i++) {
-        light_up_matrix(sequence[i]);
-        play_color_sound(sequence[i]);
-        sleep_ms(500);
-        MatrizRGBPI_Clear();
-        MatrizRGBPI_Write();
-        sleep_ms(200);
+        uint8_t rgb[3];
+        color_to_rgb(sequence[i], rgb);
+        uint32_t at = (uint32_t)i * SEQUENCE_STEP_MS;
+        keys[count++] = (matriz_keyframe_t){at, 1, 1, rgb[0], rgb[1], rgb[2]};
+        keys[count++] = (matriz_keyframe_t){at + SEQUENCE_LIGHT_MS, 1, 1, COLOR_OFF};
     }
-    game_state = STATE_WAIT_INPUT; // Muda para estado de espera por input
+    keys[count++] = (matriz_keyframe_t){(uint32_t)sequence_length * SEQUENCE_STEP_MS, 1, 1, COLOR_OFF};
+
+    matriz_anim_t *anim = MatrizRGBPI_AnimLock();
+    uint32_t now = MatrizRGBPI_AnimNow();
+    matriz_anim_init(anim, MATRIZ_WIDTH, MATRIZ_HEIGHT);
+    int sprite = matriz_anim_add(anim, NULL, 3, 3, 0);
+    matriz_anim_play(anim, sprite, keys, (uint8_t)count, MATRIZ_EASE_STEP, false, now);
+    MatrizRGBPI_AnimUnlock();
+
+    // O primeiro som começa junto com a trilha; os seguintes são contados a partir do mesmo instante
+    sequence_sound_step = 0;
+    sequence_tone_on = true;
+    start_tone(BUZZER_PIN, color_frequency(sequence[0]));
+    sequence_alarm = add_alarm_at(from_us_since_boot(((uint64_t)now + SEQUENCE_TONE_MS) * 1000),
+                                  sequence_sound_callback, NULL, true);
+    MatrizRGBPI_AnimStart(MATRIX_ANIM_FPS);
+}
+
+/**
+ * @brief Interrompe a exibição da sequência: cancela os sons pendentes e para o relógio de quadros
+ */
+void stop_sequence() {
+    alarm_id_t alarm = sequence_alarm;
+    if (alarm > 0) {
+        cancel_alarm(alarm);
+    }
+    sequence_alarm = 0;
+    stop_tone(BUZZER_PIN);
+    MatrizRGBPI_AnimStop();
 }
 
 /**
@@ -275,6 +384,8 @@ void reset_game() {
     sequence_length = 1;
     current_step = 0;
     round_number = 1;
+    MatrizRGBPI_MarqueeStop();
+    stop_sequence();
     MatrizRGBPI_Clear();
     MatrizRGBPI_Write();
     generate_sequence();
@@ -310,6 +421,42 @@ void button_b_callback() {
     update_activity_time();
 }
 
+/**
+ * @brief Callback do detector de direção: escolhe a cor pelo lado para onde o joystick aponta
+ * 
+ * Esquerda (incluindo as diagonais) seleciona verde, direita seleciona vermelho e o centro,
+ * cima ou baixo selecionam azul. Só uma cor diferente marca a matriz para ser redesenhada
+ * pelo laço principal; `MatrizRGBPI_Present` ainda descarta um quadro igual ao que já está nos LEDs.
+ */
+void joystick_direction_callback(const joystick_direction_event_t *event, void *user_data) {
+    (void)user_data;
+    if (event->type != JOYSTICK_EVENT_DIRECTION_CHANGED) {
+        return;
+    }
+
+    int color;
+    switch (event->direction) {
+        case JOYSTICK_DIR_LEFT:
+        case JOYSTICK_DIR_UP_LEFT:
+        case JOYSTICK_DIR_DOWN_LEFT:
+            color = GREEN;
+            break;
+        case JOYSTICK_DIR_RIGHT:
+        case JOYSTICK_DIR_UP_RIGHT:
+        case JOYSTICK_DIR_DOWN_RIGHT:
+            color = RED;
+            break;
+        default:
+            color = BLUE;
+            break;
+    }
+
+    if (color != selected_color) {
+        selected_color = color;
+        selection_changed = true;
+    }
+}
+
 /**
  * @brief Função principal do jogo
  * @return int Não retorna (loop infinito)
@@ -325,7 +472,27 @@ int main() {
     // Inicializa componentes
     init_display();
     joystickPi_init();
+    joystickPi_engine_start(1000); // Eixos amostrados em segundo plano pelo DMA
+
+    // Sensor de temperatura no round-robin: o limiar de seleção não anda com o aquecimento da placa
+    // (na BitDogLab os potenciômetros e o ADC usam o mesmo 3V3, então não há canal de referência)
+    joystickPi_compensation_enable(JOYSTICK_COMP_NO_REF);
+
+    // Usa a calibração salva; no primeiro uso aprende o centro com o joystick em repouso e grava
+    if (!joystickPi_calibration_load()) {
+        joystickPi_calibrate_center(200);
+        joystickPi_calibration_save();
+    }
+    joystickPi_calibration_set_auto(true);
+
+    joystick_tracker_config_t tracker_config;
+    joystick_tracker_config_defaults(&tracker_config);
+    tracker_config.center_radius = JOYSTICK_SELECT_THRESHOLD;
+    joystick_tracker_init(&joystick_tracker, &tracker_config, joystick_direction_callback, NULL);
+    selected_color = BLUE; // Joystick começa em repouso
     MatrizRGBPI_Init(LED_PIN);
+    MatrizRGBPI_SetGamma(MATRIX_GAMMA);
+    MatrizRGBPI_SetBrightness(MATRIX_BRIGHTNESS);
     
     // Configura botões
     ButtonPi button_a, button_b;
@@ -340,10 +507,8 @@ int main() {
     // Configura tempo inicial
     update_activity_time();
     
-    // Gera e mostra primeira sequência
+    // Gera a primeira sequência (exibida pela máquina de estados)
     generate_sequence();
-    show_sequence();
-    update_display();
 
     // Loop principal do jogo
     while (1) {
@@ -374,21 +539,28 @@ int main() {
             case STATE_SHOW_SEQUENCE:
                 show_sequence();
                 update_display();
+                game_state = STATE_SHOWING_SEQUENCE;
+                break;
+
+            case STATE_SHOWING_SEQUENCE:
+                update_activity_time(); // Assistir à sequência não conta como inatividade
+                if (MatrizRGBPI_AnimPlaying() || sequence_alarm) {
+                    break; // Cores e sons seguem nos temporizadores; o laço segue atendendo o watchdog
+                }
+                MatrizRGBPI_AnimStop();
+                selection_changed = true; // A sequência apagou a matriz: redesenha a seleção atual
+                game_state = STATE_WAIT_INPUT;
                 break;
 
             case STATE_WAIT_INPUT:
-                // Lê joystick para seleção de cor
+                // Lê joystick para seleção de cor; a matriz só é redesenhada quando a cor muda
                 joystick_state_t state = joystickPi_read();
-                if (state.x < 1365) {
-                    selected_color = GREEN;
-                } else if (state.x < 2730) {
-                    selected_color = BLUE;
-                } else {
-                    selected_color = RED;
+                joystick_tracker_update(&joystick_tracker, state.x_norm, state.y_norm);
+                if (selection_changed) {
+                    selection_changed = false;
+                    light_up_matrix(selected_color);
                 }
 
-                light_up_matrix(selected_color);
-
                 if (button_b_pressed) {
                     button_b_pressed = false;
                     game_state = STATE_CHECK_INPUT;
@@ -401,11 +573,27 @@ int main() {
 
             case STATE_ROUND_COMPLETE:
                 show_round_message();
+                game_state = STATE_ROUND_MESSAGE;
+                break;
+
+            case STATE_ROUND_MESSAGE:
+                if (MatrizRGBPI_MarqueeRunning()) {
+                    break; // O letreiro passa sozinho; o laço segue atendendo o watchdog
+                }
                 show_white_matrix();
-                sleep_ms(1000);
-                
-                // Prepara próxima rodada
-                sequence_length++;
+                game_state = STATE_ROUND_FLASH;
+                break;
+
+            case STATE_ROUND_FLASH:
+                if (MatrizRGBPI_AnimPlaying()) {
+                    break;
+                }
+                MatrizRGBPI_AnimStop();
+
+                // Prepara próxima rodada (a sequência para de crescer no tamanho máximo)
+                if (sequence_length < SEQUENCE_MAX_LENGTH) {
+                    sequence_length++;
+                }
                 current_step = 0;
                 round_number++;
                 game_state = STATE_SHOW_SEQUENCE;
@@ -415,7 +603,7 @@ int main() {
 
             case STATE_GAME_OVER:
                 if (!game_over_shown) {
-                    MatrizRGBPI_displayStringWithScroll("Game Over", 150, COLOR_RED);
+                    MatrizRGBPI_MarqueeStart("Game Over", MARQUEE_COLUMN_MS, true, COLOR_RED);
                     show_game_over_display();
                     game_over_shown = true;
                 }
@@ -62,6 +62,21 @@ void initialize_pwm(uint pin);
  */
 uint16_t calculate_wrap(uint32_t target_frequency, float clkdiv);
 
+/**
+ * @brief Liga um tom contínuo no buzzer e retorna em seguida (pode ser chamada de um alarme).
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param freq Frequência do tom em Hz.
+ */
+void start_tone(uint pin, uint32_t freq);
+
+/**
+ * @brief Desliga o tom iniciado por `start_tone`.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ */
+void stop_tone(uint pin);
+
 /**
  * @brief Toca um tom no buzzer com a frequência e duração especificadas.
  * 
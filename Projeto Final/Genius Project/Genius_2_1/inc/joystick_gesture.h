@@ -0,0 +1,184 @@
+#ifndef JOYSTICK_GESTURE_H
+#define JOYSTICK_GESTURE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/joystick_direction.h"
+
+/**
+ * @file joystick_gesture.h
+ * @brief Reconhecedor de gestos do joystick (flick, giro completo e segurar na borda), em fluxo.
+ *
+ * Recebe as amostras já filtradas (por exemplo, as do fluxo `joystickPi_stream_*`), com os
+ * eixos centrados na escala de ±32767, e mantém só atributos incrementais: raio de pico e
+ * instante de saída do centro (flick), tempo de permanência na borda (segurar) e a soma dos
+ * deltas de ângulo numa janela deslizante sobre um anel de pontos recentes (giro). Os pontos
+ * entram no anel em intervalos fixos, independentes da taxa das amostras, então a memória é
+ * constante e cada amostra custa o mesmo, qualquer que seja a duração do gesto.
+ *
+ * Gestos:
+ * - Flick: sai do centro, chega à borda e volta ao centro em até `flick_max_us`.
+ * - Segurar: fica na borda, sem girar mais que `hold_tolerance`, por `hold_us`.
+ * - Giro: com o joystick além de `circle_radius`, o ângulo acumulado chega a uma volta
+ *   completa dentro de `circle_max_us` (horário ou anti-horário).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Pontos guardados no anel do giro (potência de 2); limita a janela a
+ * JOYSTICK_GESTURE_RING_SIZE * `point_interval_us`.
+ */
+#define JOYSTICK_GESTURE_RING_SIZE 256
+
+/**
+ * @brief Máscara de um tipo de gesto no valor devolvido por `joystick_gesture_update`.
+ */
+#define JOYSTICK_GESTURE_MASK(type) (1u << (type))
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Tipo de gesto reconhecido.
+ */
+typedef enum {
+    JOYSTICK_GESTURE_NONE,
+    JOYSTICK_GESTURE_FLICK,       // Ida rápida à borda e volta ao centro
+    JOYSTICK_GESTURE_HOLD,        // Parado na borda
+    JOYSTICK_GESTURE_CIRCLE_CW,   // Volta completa no sentido horário
+    JOYSTICK_GESTURE_CIRCLE_CCW,  // Volta completa no sentido anti-horário
+    JOYSTICK_GESTURE_COUNT
+} joystick_gesture_type_t;
+
+/**
+ * @brief Gesto entregue ao callback.
+ */
+typedef struct {
+    joystick_gesture_type_t type;
+    joystick_direction_t direction;  // Direção do flick ou do segurar (JOYSTICK_DIR_CENTER no giro)
+    uint32_t t_us;                   // Instante da amostra que completou o gesto
+    uint32_t duration_us;            // Duração do gesto
+    uint16_t radius;                 // Raio de pico (flick), atual (segurar) ou médio (giro)
+} joystick_gesture_event_t;
+
+/**
+ * @brief Callback chamado a cada gesto reconhecido.
+ */
+typedef void (*joystick_gesture_callback_t)(const joystick_gesture_event_t *event, void *user_data);
+
+/**
+ * @brief Limiares do reconhecedor, na escala de ±32767 dos eixos.
+ */
+typedef struct {
+    uint16_t center_radius;       // Abaixo dele o joystick está em repouso
+    uint16_t edge_radius;         // Acima dele o joystick está na borda
+    uint16_t radial_hysteresis;   // Quanto o raio precisa recuar para sair da borda ou voltar ao centro
+    uint32_t flick_max_us;        // Tempo máximo entre sair do centro e voltar a ele num flick
+    uint32_t hold_us;             // Permanência na borda que conta como segurar
+    uint16_t hold_tolerance;      // Giro tolerado na borda durante o segurar (JOYSTICK_ANGLE_TURN = 360°)
+    uint16_t circle_radius;       // Raio mínimo para os pontos do giro
+    uint32_t circle_max_us;       // Tempo máximo para completar uma volta
+    uint32_t point_interval_us;   // Intervalo entre os pontos do anel
+} joystick_gesture_config_t;
+
+/**
+ * @brief Ponto do anel: delta de ângulo desde o ponto anterior e raio.
+ */
+typedef struct {
+    int16_t delta;
+    uint16_t radius;
+} joystick_gesture_point_t;
+
+/**
+ * @brief Estado de um reconhecedor (tamanho fixo).
+ */
+typedef struct {
+    // Limiares ao quadrado, comparados sem raiz
+    uint32_t center_enter_r2;
+    uint32_t center_exit_r2;
+    uint32_t edge_enter_r2;
+    uint32_t edge_exit_r2;
+    uint32_t circle_r2;
+    uint32_t flick_max_us;
+    uint32_t hold_us;
+    uint16_t hold_tolerance;
+    uint32_t point_interval_us;
+    uint32_t circle_window;                      // Pontos na janela do giro
+
+    // Flick
+    bool at_center;                              // Dentro do centro (com histerese)
+    bool flick_armed;                            // Saiu de um repouso: pode virar flick
+    bool reached_edge;                           // Chegou à borda desde que saiu do centro
+    uint32_t out_t_us;                           // Instante em que saiu do centro
+    uint32_t peak_r2;                            // Maior raio² desde que saiu do centro
+    uint16_t peak_angle;
+
+    // Segurar
+    bool at_edge;
+    bool hold_fired;
+    uint32_t edge_t_us;                          // Início da permanência atual na borda
+    uint16_t edge_angle;                         // Ângulo de referência da permanência
+
+    // Giro
+    joystick_gesture_point_t ring[JOYSTICK_GESTURE_RING_SIZE];
+    uint32_t ring_head;                          // Próxima posição de escrita
+    uint32_t ring_count;                         // Pontos na janela atual
+    int32_t angle_sum;                           // Soma dos deltas na janela
+    uint32_t radius_sum;                         // Soma dos raios na janela
+    bool circle_active;                          // Último ponto estava além de circle_radius
+    uint16_t last_point_angle;
+    uint32_t last_point_t_us;
+    bool has_point;
+
+    joystick_gesture_callback_t callback;
+    void *user_data;
+} joystick_gesture_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche os limiares padrão: centro em 25% e borda em 85% do curso (como o detector de
+ * direção), flick em até 250 ms, segurar por 600 ms com ±22,5° de tolerância e giro além de 50%
+ * do curso em até 1,5 s, com pontos a cada 10 ms.
+ *
+ * @param config Limiares a serem preenchidos.
+ */
+void joystick_gesture_config_defaults(joystick_gesture_config_t *config);
+
+/**
+ * @brief Inicializa um reconhecedor em repouso.
+ *
+ * @param gesture Reconhecedor a ser inicializado.
+ * @param config Limiares, ou NULL para os padrões.
+ * @param callback Função chamada a cada gesto (pode ser NULL).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_gesture_init(joystick_gesture_t *gesture, const joystick_gesture_config_t *config,
+                           joystick_gesture_callback_t callback, void *user_data);
+
+/**
+ * @brief Processa uma amostra e dispara os gestos completados por ela.
+ *
+ * @param gesture Reconhecedor.
+ * @param t_us Instante da amostra (pode dar a volta em 32 bits).
+ * @param x Eixo X centrado (positivo para a direita).
+ * @param y Eixo Y centrado (positivo para cima).
+ * @return Máscara (JOYSTICK_GESTURE_MASK) dos gestos reconhecidos, ou 0.
+ */
+uint32_t joystick_gesture_update(joystick_gesture_t *gesture, uint32_t t_us, int16_t x, int16_t y);
+
+/**
+ * @brief Direção de 8 setores de um ângulo (sem zona central).
+ *
+ * @param angle Ângulo (JOYSTICK_ANGLE_TURN = 360°).
+ * @return JOYSTICK_DIR_RIGHT a JOYSTICK_DIR_DOWN_RIGHT.
+ */
+joystick_direction_t joystick_gesture_direction(uint16_t angle);
+
+#endif // JOYSTICK_GESTURE_H
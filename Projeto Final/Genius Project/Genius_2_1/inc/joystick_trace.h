@@ -0,0 +1,111 @@
+#ifndef JOYSTICK_TRACE_H
+#define JOYSTICK_TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "inc/JoystickPi.h"
+
+/**
+ * @file joystick_trace.h
+ * @brief Formato binário das gravações ("traces") do joystick, lidas pelo replay no host.
+ *
+ * Um trace é um cabeçalho, uma sequência de registros de 4 bytes (leituras brutas de 12 bits
+ * do ADC e o botão, em taxa fixa) e um rodapé opcional com o total de amostras e de perdas.
+ * Todos os campos são little-endian, a ordem nativa do RP2040 e dos PCs.
+ *
+ * Os 4 bits altos do eixo Y de um registro são sempre zero, então os 4 bytes do rodapé
+ * (JOYSTICK_TRACE_END_MAGIC) nunca são confundidos com um registro.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Identificadores do cabeçalho ("JTRC") e do rodapé ("JEND").
+ */
+#define JOYSTICK_TRACE_MAGIC 0x4352544Au
+#define JOYSTICK_TRACE_END_MAGIC 0x444E454Au
+
+/**
+ * @brief Versão do formato.
+ */
+#define JOYSTICK_TRACE_VERSION 1
+
+/**
+ * @brief Bits de `joystick_trace_record_t.x` além da leitura de 12 bits.
+ */
+#define JOYSTICK_TRACE_VALUE_MASK 0x0FFFu
+#define JOYSTICK_TRACE_GAP (1u << 14)     // Houve amostras perdidas logo antes desta
+#define JOYSTICK_TRACE_BUTTON (1u << 15)  // Botão pressionado
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Cabeçalho do trace (32 bytes).
+ */
+typedef struct {
+    uint32_t magic;               // JOYSTICK_TRACE_MAGIC
+    uint16_t version;             // JOYSTICK_TRACE_VERSION
+    uint16_t header_size;         // sizeof(joystick_trace_header_t), para pular campos de versões futuras
+    uint32_t rate_hz;             // Taxa das amostras
+    uint8_t x_channel;            // Canal do ADC do eixo X
+    uint8_t y_channel;            // Canal do ADC do eixo Y
+    uint8_t button_pin;           // Pino do botão (JOYSTICK_NO_BUTTON se não há)
+    uint8_t reserved;
+    joystick_calibration_t cal;   // Calibração da placa na gravação
+    uint16_t reserved2;
+} joystick_trace_header_t;
+
+/**
+ * @brief Uma amostra: leituras brutas dos eixos e o botão (4 bytes).
+ */
+typedef struct {
+    uint16_t x;  // Leitura de 12 bits do eixo X | JOYSTICK_TRACE_GAP | JOYSTICK_TRACE_BUTTON
+    uint16_t y;  // Leitura de 12 bits do eixo Y
+} joystick_trace_record_t;
+
+/**
+ * @brief Rodapé, escrito ao fim da gravação (12 bytes).
+ */
+typedef struct {
+    uint32_t magic;    // JOYSTICK_TRACE_END_MAGIC
+    uint32_t samples;  // Registros gravados
+    uint32_t dropped;  // Amostras perdidas por falta de espaço na fila
+} joystick_trace_footer_t;
+
+_Static_assert(sizeof(joystick_trace_header_t) == 32, "cabeçalho do trace deve ter 32 bytes");
+_Static_assert(sizeof(joystick_trace_record_t) == 4, "registro do trace deve ter 4 bytes");
+_Static_assert(sizeof(joystick_trace_footer_t) == 12, "rodapé do trace deve ter 12 bytes");
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Monta um registro a partir das leituras brutas.
+ *
+ * @param x Leitura de 12 bits do eixo X.
+ * @param y Leitura de 12 bits do eixo Y.
+ * @param button Botão pressionado.
+ * @param gap Houve amostras perdidas antes desta.
+ */
+static inline joystick_trace_record_t joystick_trace_record(uint16_t x, uint16_t y, bool button, bool gap) {
+    joystick_trace_record_t record = {
+        .x = (uint16_t)((x & JOYSTICK_TRACE_VALUE_MASK) | (button ? JOYSTICK_TRACE_BUTTON : 0) |
+                        (gap ? JOYSTICK_TRACE_GAP : 0)),
+        .y = (uint16_t)(y & JOYSTICK_TRACE_VALUE_MASK),
+    };
+    return record;
+}
+
+/**
+ * @brief Indica se os 4 bytes lidos no lugar de um registro são o início do rodapé.
+ */
+static inline bool joystick_trace_is_footer(joystick_trace_record_t record) {
+    return ((uint32_t)record.y << 16 | record.x) == JOYSTICK_TRACE_END_MAGIC;
+}
+
+#endif // JOYSTICK_TRACE_H
@@ -0,0 +1,116 @@
+#ifndef MATRIZ_LAYOUT_H
+#define MATRIZ_LAYOUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file matriz_layout.h
+ * @brief Descrição da montagem de uma matriz de LEDs endereçáveis e tabela de coordenadas para índices.
+ *
+ * Uma matriz é formada por painéis iguais, encadeados em `tiles_x` por `tiles_y`. Em cada painel a fita
+ * percorre as linhas a partir do canto `origin`, todas no mesmo sentido (progressiva) ou alternando o
+ * sentido a cada linha (serpentina). Os painéis são encadeados da mesma forma, a partir do canto
+ * `tile_origin`. Por fim, a imagem pode ser girada em quartos de volta (`rotation`) sobre a montagem.
+ *
+ * As coordenadas lógicas têm (0, 0) no canto superior esquerdo da imagem, x para a direita e y para
+ * baixo. `matriz_layout_build` gera uma tabela com o índice do LED de cada coordenada, então o desenho
+ * custa uma leitura por pixel, qualquer que seja a montagem.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Montagem da matriz 5x5 da BitDogLab: uma fita em serpentina começando no canto inferior direito.
+ */
+#define MATRIZ_LAYOUT_BITDOGLAB                     \
+    {                                               \
+        .panel_width = 5,                           \
+        .panel_height = 5,                          \
+        .wiring = MATRIZ_WIRING_SERPENTINE,         \
+        .origin = MATRIZ_ORIGIN_BOTTOM_RIGHT,       \
+        .tiles_x = 1,                               \
+        .tiles_y = 1,                               \
+        .tile_wiring = MATRIZ_WIRING_PROGRESSIVE,   \
+        .tile_origin = MATRIZ_ORIGIN_TOP_LEFT,      \
+        .rotation = 0,                              \
+    }
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Sentido das linhas da fita.
+ */
+typedef enum {
+    MATRIZ_WIRING_PROGRESSIVE,  // Todas as linhas no mesmo sentido
+    MATRIZ_WIRING_SERPENTINE,   // O sentido inverte a cada linha
+} matriz_wiring_t;
+
+/**
+ * @brief Canto em que a fita (ou a cadeia de painéis) começa.
+ */
+typedef enum {
+    MATRIZ_ORIGIN_TOP_LEFT,
+    MATRIZ_ORIGIN_TOP_RIGHT,
+    MATRIZ_ORIGIN_BOTTOM_LEFT,
+    MATRIZ_ORIGIN_BOTTOM_RIGHT,
+} matriz_origin_t;
+
+/**
+ * @brief Montagem de uma matriz de LEDs.
+ */
+typedef struct {
+    uint8_t panel_width;          // LEDs por linha de um painel
+    uint8_t panel_height;         // Linhas de um painel
+    matriz_wiring_t wiring;       // Sentido das linhas dentro do painel
+    matriz_origin_t origin;       // Canto do primeiro LED do painel
+    uint8_t tiles_x;              // Painéis na horizontal (0 equivale a 1)
+    uint8_t tiles_y;              // Painéis na vertical (0 equivale a 1)
+    matriz_wiring_t tile_wiring;  // Sentido das linhas de painéis
+    matriz_origin_t tile_origin;  // Canto do primeiro painel da cadeia
+    uint8_t rotation;             // Quartos de volta, no sentido horário, da imagem sobre a montagem (0-3)
+} matriz_layout_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Largura da imagem (já considerada a rotação).
+ * @param layout Montagem.
+ * @return Pixels por linha da imagem.
+ */
+uint16_t matriz_layout_width(const matriz_layout_t *layout);
+
+/**
+ * @brief Altura da imagem (já considerada a rotação).
+ * @param layout Montagem.
+ * @return Linhas da imagem.
+ */
+uint16_t matriz_layout_height(const matriz_layout_t *layout);
+
+/**
+ * @brief Índice de um LED calculado a partir da montagem, sem tabela.
+ *
+ * Usado para gerar a tabela; no desenho, prefira a tabela de `matriz_layout_build`.
+ * @param layout Montagem.
+ * @param x Coluna da imagem (0 à esquerda).
+ * @param y Linha da imagem (0 em cima).
+ * @return Posição do LED na cadeia, ou -1 fora da imagem.
+ */
+int32_t matriz_layout_index(const matriz_layout_t *layout, uint16_t x, uint16_t y);
+
+/**
+ * @brief Gera a tabela de coordenadas para índices: `lut[y * largura + x]` é o LED do pixel (x, y).
+ * @param layout Montagem.
+ * @param lut Tabela de destino.
+ * @param lut_size Entradas da tabela (largura * altura da imagem).
+ * @return false se a montagem é inválida ou a tabela não tem o tamanho da imagem.
+ */
+bool matriz_layout_build(const matriz_layout_t *layout, uint16_t *lut, uint32_t lut_size);
+
+#endif // MATRIZ_LAYOUT_H
@@ -0,0 +1,68 @@
+#ifndef MATRIZ_MARQUEE_H
+#define MATRIZ_MARQUEE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @file matriz_marquee.h
+ * @brief Gerador das colunas de um letreiro: o texto vira uma sequência de colunas da fonte 5x5.
+ *
+ * Cada coluna é um byte com a linha 0 (de cima) no bit 0. As letras têm largura variável: as colunas
+ * vazias dos lados do desenho são descartadas e cada letra é seguida por MATRIZ_MARQUEE_GAP colunas
+ * apagadas; o espaço vira MATRIZ_MARQUEE_SPACE colunas apagadas. Depois do fim do texto vêm `tail`
+ * colunas apagadas, para que o texto saia da matriz, e o letreiro termina ou recomeça.
+ *
+ * O texto não é copiado nem medido: ele é lido um caractere por vez e precisa continuar válido
+ * enquanto o letreiro roda.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define MATRIZ_MARQUEE_GAP 1    // Colunas apagadas depois de cada letra
+#define MATRIZ_MARQUEE_SPACE 2  // Colunas apagadas de um espaço (além do espaço da letra anterior)
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estado do gerador de colunas.
+ */
+typedef struct {
+    const char *text;      // Início do texto
+    const char *next;      // Próximo caractere a carregar
+    const uint8_t *glyph;  // Desenho da letra atual (NULL entre letras)
+    uint8_t column;        // Próxima coluna da letra atual
+    uint8_t last;          // Última coluna com pixels da letra atual
+    uint16_t blank;        // Colunas apagadas pendentes
+    uint16_t tail;         // Colunas apagadas depois do fim do texto
+    bool ended;            // As colunas do fim do texto já foram agendadas
+    bool emitted;          // A volta atual já gerou alguma coluna
+    bool loop;             // Recomeça o texto depois do fim
+} matriz_marquee_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Prepara o gerador para um texto.
+ * @param marquee Estado do gerador.
+ * @param text Texto (caracteres sem desenho na fonte são ignorados).
+ * @param tail Colunas apagadas depois do fim do texto (a largura da matriz faz o texto sair inteiro).
+ * @param loop true para recomeçar o texto depois das colunas do fim.
+ */
+void matriz_marquee_start(matriz_marquee_t *marquee, const char *text, uint16_t tail, bool loop);
+
+/**
+ * @brief Próxima coluna do letreiro.
+ * @param marquee Estado do gerador.
+ * @param column Destino da coluna (linha 0 no bit 0).
+ * @return false quando o letreiro terminou (sem `loop`, depois das colunas do fim).
+ */
+bool matriz_marquee_next(matriz_marquee_t *marquee, uint8_t *column);
+
+#endif // MATRIZ_MARQUEE_H
@@ -0,0 +1,43 @@
+#ifndef MATRIZ_PARALLEL_H
+#define MATRIZ_PARALLEL_H
+
+#include <stdint.h>
+
+/**
+ * @file matriz_parallel.h
+ * @brief Conversão dos pixels de até 8 fitas para os planos de bits do programa `ws2812_parallel`.
+ *
+ * Os pixels estão no formato da linha (uma palavra por LED, G nos bits 31-24, R em 23-16, B em 15-8
+ * e W em 7-0), fita após fita. Para cada posição na fita e cada canal, os bytes das fitas formam uma
+ * matriz de 8x8 bits que é transposta com deslocamentos e máscaras, sem percorrer bit a bit: o byte
+ * `j` do resultado junta o bit `7 - j` do canal de todas as fitas (fita `s` no bit `s`).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define MATRIZ_PARALLEL_MAX_STRIPS 8  // Fitas num byte de plano
+
+/**
+ * @brief Palavras de planos geradas por posição na fita (8 planos de um byte por canal).
+ */
+#define MATRIZ_PARALLEL_WORDS(channels) ((channels) * 2)
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Transpõe os pixels das fitas para planos de bits, na ordem em que saem na linha.
+ * @param pixels Pixels de `strips` fitas com `strip_leds` LEDs cada, a fita `s` a partir de `s * strip_leds`.
+ * @param strip_leds LEDs por fita.
+ * @param strips Número de fitas (1 a MATRIZ_PARALLEL_MAX_STRIPS).
+ * @param channels Canais por pixel: 3 (GRB) ou 4 (GRBW).
+ * @param planes Destino, com `strip_leds * MATRIZ_PARALLEL_WORDS(channels)` palavras; cada palavra leva
+ *               quatro planos, do byte mais significativo para o menos significativo.
+ */
+void matriz_parallel_transpose(const uint32_t *pixels, uint32_t strip_leds, uint8_t strips, uint8_t channels,
+                               uint32_t *planes);
+
+#endif // MATRIZ_PARALLEL_H
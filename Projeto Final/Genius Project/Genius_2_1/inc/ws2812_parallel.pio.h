@@ -0,0 +1,105 @@
+// -------------------------------------------------- //
+// Arquivo gerado automaticamente pelo pioasm - não editar! //
+// -------------------------------------------------- //
+
+#pragma once
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+/**
+ * @file ws2812_parallel.pio.h
+ * @brief Driver PIO para até 8 fitas WS2812B em pinos consecutivos, enviadas ao mesmo tempo
+ *
+ * Cada byte da FIFO é um plano de bits: o bit `s` é o valor do bit atual para a fita ligada no
+ * pino `pin_base + s`. A cada bit da linha, todos os pinos sobem juntos, ficam no valor do plano e
+ * descem juntos, então o quadro de N fitas leva o tempo de uma fita só. Os planos saem do byte mais
+ * significativo de cada palavra para o menos significativo (`matriz_parallel_transpose` gera os
+ * planos nessa ordem).
+ *
+ * Fonte (ws2812_parallel.pio):
+ *
+ *     .program ws2812_parallel
+ *     .define public T1 2
+ *     .define public T2 5
+ *     .define public T3 3
+ *     .wrap_target
+ *         out x, 8
+ *         mov pins, !null [T1-1]
+ *         mov pins, x     [T2-1]
+ *         mov pins, null  [T3-2]
+ *     .wrap
+ */
+
+// --- CONSTANTES ---
+#define ws2812_parallel_wrap_target 0  // Índice inicial do loop
+#define ws2812_parallel_wrap 3         // Índice final do loop
+
+#define ws2812_parallel_T1 2  // Ciclos com todos os pinos em nível alto
+#define ws2812_parallel_T2 5  // Ciclos com o valor do bit
+#define ws2812_parallel_T3 3  // Ciclos em nível baixo
+
+// --- PROGRAMA PIO ---
+// Instruções em Assembly para a máquina PIO
+static const uint16_t ws2812_parallel_program_instructions[] = {
+    //     .wrap_target
+    0x6028, // 0: out    x, 8                    // Próximo plano de bits
+    0xa10b, // 1: mov    pins, !null      [1]    // Todos os pinos em nível alto
+    0xa401, // 2: mov    pins, x          [4]    // Valor do bit de cada fita
+    0xa103, // 3: mov    pins, null       [1]    // Todos os pinos em nível baixo
+    //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+// --- CONFIGURAÇÃO DO PROGRAMA PIO ---
+static const struct pio_program ws2812_parallel_program = {
+    .instructions = ws2812_parallel_program_instructions,
+    .length = 4,      // Número de instruções
+    .origin = -1,     // Sem origem fixa (alocação dinâmica)
+};
+
+/**
+ * @brief Obtém a configuração padrão para o programa paralelo
+ * @param offset Offset do programa no PIO
+ * @return Configuração inicial da máquina de estados
+ */
+static inline pio_sm_config ws2812_parallel_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + ws2812_parallel_wrap_target, offset + ws2812_parallel_wrap);
+    return c;
+}
+
+/**
+ * @brief Inicializa o programa paralelo em `pin_count` pinos consecutivos
+ * @param pio Instância PIO (0 ou 1)
+ * @param sm Máquina de estados (0-3)
+ * @param offset Offset do programa no PIO
+ * @param pin_base Pino da fita 0
+ * @param pin_count Número de fitas (1 a 8)
+ * @param freq Frequência de comunicação (em Hz)
+ */
+static void ws2812_parallel_program_init(PIO pio, uint sm, uint offset, uint pin_base, uint pin_count, float freq) {
+    // Configuração dos pinos GPIO
+    for (uint i = pin_base; i < pin_base + pin_count; i++) {
+        pio_gpio_init(pio, i);
+    }
+    pio_sm_set_consecutive_pindirs(pio, sm, pin_base, pin_count, true);
+
+    // Configuração do programa
+    pio_sm_config c = ws2812_parallel_program_get_default_config(offset);
+    sm_config_set_out_pins(&c, pin_base, pin_count);  // mov pins escreve em todas as fitas
+    sm_config_set_out_shift(&c, false, true, 32);     // Shift left: o byte mais significativo sai primeiro
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);    // Usa apenas FIFO TX
+
+    // Calcula divisor de clock
+    int cycles_per_bit = ws2812_parallel_T1 + ws2812_parallel_T2 + ws2812_parallel_T3;
+    float prescaler = clock_get_hz(clk_sys) / (cycles_per_bit * freq);
+    sm_config_set_clkdiv(&c, prescaler);
+
+    // Inicializa máquina de estados
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+#endif
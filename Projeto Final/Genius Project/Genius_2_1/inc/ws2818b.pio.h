@@ -15,6 +15,10 @@
  * Este arquivo contém o programa Assembly para a máquina de estados PIO
  * que controla a comunicação com tiras de LEDs WS2812B/NeoPixel.
  * Gerado automaticamente pelo pioasm (não modificar manualmente).
+ *
+ * O mesmo programa tem duas configurações: `ws2818b_program_init` puxa um byte por palavra da
+ * FIFO, e `ws2818b_packed_program_init` puxa um pixel inteiro (24 bits GRB, ou 32 GRBW) por
+ * palavra, do bit mais significativo ao menos, como o protocolo exige.
  */
 
 // --- CONSTANTES ---
@@ -80,4 +84,33 @@ static void ws2818b_program_init(PIO pio, uint sm, uint offset, uint pin, float
     pio_sm_set_enabled(pio, sm, true);
 }
 
+/**
+ * @brief Inicializa o programa PIO com um pixel empacotado por palavra da FIFO
+ * @param pio Instância PIO (0 ou 1)
+ * @param sm Máquina de estados (0-3)
+ * @param offset Offset do programa no PIO
+ * @param pin Pino GPIO conectado aos LEDs
+ * @param freq Frequência de comunicação (em Hz)
+ * @param rgbw true para LEDs RGBW (32 bits por pixel), false para RGB (24 bits)
+ */
+static void ws2818b_packed_program_init(PIO pio, uint sm, uint offset, uint pin, float freq, bool rgbw) {
+    // Configuração do pino GPIO
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, sm, pin, 1, true);
+
+    // Configuração do programa
+    pio_sm_config c = ws2818b_program_get_default_config(offset);
+    sm_config_set_sideset_pins(&c, pin);                   // Usa pino sideset
+    sm_config_set_out_shift(&c, false, true, rgbw ? 32 : 24); // Shift left, um pixel por palavra
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);         // Usa apenas FIFO TX
+
+    // Calcula divisor de clock
+    float prescaler = clock_get_hz(clk_sys) / (10.f * freq);
+    sm_config_set_clkdiv(&c, prescaler);
+
+    // Inicializa máquina de estados
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
 #endif
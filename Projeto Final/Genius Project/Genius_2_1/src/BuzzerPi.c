@@ -53,15 +53,15 @@ uint16_t calculate_wrap(uint32_t target_frequency, float clkdiv) {
 }
 
 /**
- * @brief Toca um tom no buzzer com a frequência e duração especificadas.
+ * @brief Liga um tom contínuo no buzzer e retorna em seguida.
  * 
- * Usa o divisor de clock padrão definido em `CLK_DIV_DEFAULT`.
+ * Usa o divisor de clock padrão definido em `CLK_DIV_DEFAULT`. Só escreve nos registradores do
+ * PWM, então pode ser chamada de um alarme ou temporizador.
  * 
  * @param pin Pino GPIO onde o buzzer está conectado.
  * @param freq Frequência do tom em Hz.
- * @param duration_ms Duração do tom em milissegundos.
  */
-void play_tone(uint pin, uint32_t freq, uint duration_ms) {
+void start_tone(uint pin, uint32_t freq) {
     uint slice_num = pwm_gpio_to_slice_num(pin); // Obtém o número do slice PWM associado ao pino
 
     uint16_t wrap_value = calculate_wrap(freq, CLK_DIV_DEFAULT); // Calcula o valor de wrap
@@ -70,12 +70,32 @@ void play_tone(uint pin, uint32_t freq, uint duration_ms) {
     pwm_set_clkdiv(slice_num, CLK_DIV_DEFAULT); // Configura o divisor de clock
     pwm_set_gpio_level(pin, wrap_value / 2); // Define o nível do PWM para 50% (duty cycle)
     pwm_set_enabled(slice_num, true); // Habilita o PWM
+}
 
-    sleep_ms(duration_ms); // Mantém o tom ativo pelo tempo especificado
-
+/**
+ * @brief Desliga o tom iniciado por `start_tone`.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ */
+void stop_tone(uint pin) {
     pwm_set_gpio_level(pin, 0); // Desliga o PWM
 }
 
+/**
+ * @brief Toca um tom no buzzer com a frequência e duração especificadas.
+ * 
+ * Usa o divisor de clock padrão definido em `CLK_DIV_DEFAULT`.
+ * 
+ * @param pin Pino GPIO onde o buzzer está conectado.
+ * @param freq Frequência do tom em Hz.
+ * @param duration_ms Duração do tom em milissegundos.
+ */
+void play_tone(uint pin, uint32_t freq, uint duration_ms) {
+    start_tone(pin, freq);
+    sleep_ms(duration_ms); // Mantém o tom ativo pelo tempo especificado
+    stop_tone(pin);
+}
+
 /**
  * @brief Toca um tom no buzzer com a frequência, duração e divisor de clock especificados.
  * 
@@ -0,0 +1,108 @@
+#include "inc/font5x5.h"
+
+/**
+ * Arquivo: font5x5.c
+ * 
+ * Descrição:
+ * Fonte 5x5 gerada por Matriz/host/gen_font.py a partir de src/alphabet.c. Não edite à mão.
+ */
+
+const uint8_t font5x5[FONT5X5_COUNT][FONT5X5_ROWS] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  32 ' '
+    {0x04, 0x04, 0x04, 0x00, 0x04},  //  33 '!'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  34
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  35
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  36
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  37
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  38
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  39
+    {0x00, 0x0A, 0x00, 0x0E, 0x11},  //  40 '('
+    {0x00, 0x0A, 0x00, 0x11, 0x0E},  //  41 ')'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  42
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  43
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  44
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  45
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  46
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  47
+    {0x04, 0x0A, 0x0A, 0x0A, 0x04},  //  48 '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x0E},  //  49 '1'
+    {0x04, 0x0A, 0x02, 0x04, 0x0E},  //  50 '2'
+    {0x0E, 0x02, 0x06, 0x02, 0x0E},  //  51 '3'
+    {0x08, 0x0A, 0x0E, 0x02, 0x02},  //  52 '4'
+    {0x0E, 0x08, 0x0E, 0x02, 0x0E},  //  53 '5'
+    {0x0E, 0x08, 0x0E, 0x0A, 0x0E},  //  54 '6'
+    {0x0E, 0x02, 0x02, 0x02, 0x02},  //  55 '7'
+    {0x0E, 0x0A, 0x0E, 0x0A, 0x0E},  //  56 '8'
+    {0x0E, 0x0A, 0x0E, 0x02, 0x0E},  //  57 '9'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  58
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  59
+    {0x04, 0x08, 0x1F, 0x08, 0x04},  //  60 '<'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  61
+    {0x04, 0x02, 0x1F, 0x02, 0x04},  //  62 '>'
+    {0x0E, 0x0A, 0x02, 0x04, 0x04},  //  63 '?'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  64
+    {0x0E, 0x11, 0x1F, 0x11, 0x11},  //  65 'A'
+    {0x1E, 0x11, 0x1E, 0x11, 0x1E},  //  66 'B'
+    {0x0F, 0x10, 0x10, 0x10, 0x0F},  //  67 'C'
+    {0x1E, 0x11, 0x11, 0x11, 0x1E},  //  68 'D'
+    {0x1F, 0x10, 0x1F, 0x10, 0x1F},  //  69 'E'
+    {0x1F, 0x10, 0x1F, 0x10, 0x10},  //  70 'F'
+    {0x0F, 0x10, 0x17, 0x11, 0x0E},  //  71 'G'
+    {0x11, 0x11, 0x1F, 0x11, 0x11},  //  72 'H'
+    {0x1F, 0x04, 0x04, 0x04, 0x1F},  //  73 'I'
+    {0x01, 0x01, 0x01, 0x11, 0x0E},  //  74 'J'
+    {0x11, 0x12, 0x1C, 0x12, 0x11},  //  75 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x1F},  //  76 'L'
+    {0x11, 0x1B, 0x15, 0x11, 0x11},  //  77 'M'
+    {0x11, 0x19, 0x15, 0x13, 0x11},  //  78 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x0E},  //  79 'O'
+    {0x1E, 0x11, 0x1E, 0x10, 0x10},  //  80 'P'
+    {0x0E, 0x11, 0x11, 0x13, 0x0F},  //  81 'Q'
+    {0x1E, 0x11, 0x1E, 0x12, 0x11},  //  82 'R'
+    {0x0F, 0x10, 0x0E, 0x01, 0x1E},  //  83 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04},  //  84 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x0E},  //  85 'U'
+    {0x11, 0x11, 0x11, 0x0A, 0x04},  //  86 'V'
+    {0x11, 0x11, 0x15, 0x1B, 0x11},  //  87 'W'
+    {0x11, 0x0A, 0x04, 0x0A, 0x11},  //  88 'X'
+    {0x11, 0x0A, 0x04, 0x04, 0x04},  //  89 'Y'
+    {0x1F, 0x02, 0x04, 0x08, 0x1F},  //  90 'Z'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  91
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  92
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  93
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  94
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  95
+    {0x00, 0x00, 0x00, 0x00, 0x00},  //  96
+    {0x0E, 0x11, 0x1F, 0x11, 0x11},  //  97 'a'
+    {0x1E, 0x11, 0x1E, 0x11, 0x1E},  //  98 'b'
+    {0x0F, 0x10, 0x10, 0x10, 0x0F},  //  99 'c'
+    {0x1E, 0x11, 0x11, 0x11, 0x1E},  // 100 'd'
+    {0x1F, 0x10, 0x1F, 0x10, 0x1F},  // 101 'e'
+    {0x1F, 0x10, 0x1F, 0x10, 0x10},  // 102 'f'
+    {0x0F, 0x10, 0x17, 0x11, 0x0E},  // 103 'g'
+    {0x11, 0x11, 0x1F, 0x11, 0x11},  // 104 'h'
+    {0x1F, 0x04, 0x04, 0x04, 0x1F},  // 105 'i'
+    {0x01, 0x01, 0x01, 0x11, 0x0E},  // 106 'j'
+    {0x11, 0x12, 0x1C, 0x12, 0x11},  // 107 'k'
+    {0x10, 0x10, 0x10, 0x10, 0x1F},  // 108 'l'
+    {0x11, 0x1B, 0x15, 0x11, 0x11},  // 109 'm'
+    {0x11, 0x19, 0x15, 0x13, 0x11},  // 110 'n'
+    {0x0E, 0x11, 0x11, 0x11, 0x0E},  // 111 'o'
+    {0x1E, 0x11, 0x1E, 0x10, 0x10},  // 112 'p'
+    {0x0E, 0x11, 0x11, 0x13, 0x0F},  // 113 'q'
+    {0x1E, 0x11, 0x1E, 0x12, 0x11},  // 114 'r'
+    {0x0F, 0x10, 0x0E, 0x01, 0x1E},  // 115 's'
+    {0x1F, 0x04, 0x04, 0x04, 0x04},  // 116 't'
+    {0x11, 0x11, 0x11, 0x11, 0x0E},  // 117 'u'
+    {0x11, 0x11, 0x11, 0x0A, 0x04},  // 118 'v'
+    {0x11, 0x11, 0x15, 0x1B, 0x11},  // 119 'w'
+    {0x11, 0x0A, 0x04, 0x0A, 0x11},  // 120 'x'
+    {0x11, 0x0A, 0x04, 0x04, 0x04},  // 121 'y'
+    {0x1F, 0x02, 0x04, 0x08, 0x1F},  // 122 'z'
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // 123
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // 124
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // 125
+    {0x00, 0x00, 0x00, 0x00, 0x00},  // 126
+};
+
+const uint32_t font5x5_defined[(FONT5X5_COUNT + 31) / 32] = {0xD3FF0303u, 0x07FFFFFEu, 0x07FFFFFEu};
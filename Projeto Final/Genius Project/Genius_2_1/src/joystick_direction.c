@@ -0,0 +1,201 @@
+#include "inc/joystick_direction.h"
+#include <stdlib.h>
+
+/**
+ * Arquivo: joystick_direction.c
+ *
+ * Descrição:
+ * Detector de direção e zona do joystick com histerese angular e radial. O raio é comparado
+ * ao quadrado (sem raiz) e o ângulo vem de uma tabela de arco-tangente com interpolação linear,
+ * então uma atualização custa algumas multiplicações inteiras.
+ */
+
+/******************************
+ * Tabela de Arco-Tangente
+ ******************************/
+
+#define ATAN_LUT_BITS 5
+#define ATAN_FRAC_BITS 8
+
+/**
+ * @brief atan(i / 32) para i = 0..32, em unidades de JOYSTICK_ANGLE_TURN (0 a 45°).
+ */
+static const uint16_t atan_lut[(1 << ATAN_LUT_BITS) + 1] = {
+       0,  326,  651,  975, 1297, 1617, 1933, 2246, 2555, 2860, 3159,
+    3453, 3742, 4025, 4302, 4572, 4836, 5094, 5344, 5589, 5826, 6058,
+    6282, 6500, 6712, 6917, 7117, 7310, 7498, 7679, 7856, 8026, 8192,
+};
+
+/**
+ * @brief Arco-tangente de num/den, com 0 <= num <= den, por interpolação na tabela.
+ */
+static uint16_t atan_ratio(uint32_t num, uint32_t den) {
+    uint32_t ratio = (num << (ATAN_LUT_BITS + ATAN_FRAC_BITS)) / den;
+    uint32_t index = ratio >> ATAN_FRAC_BITS;
+    uint32_t frac = ratio & ((1u << ATAN_FRAC_BITS) - 1);
+    if (index >= (1u << ATAN_LUT_BITS)) {
+        return atan_lut[1 << ATAN_LUT_BITS];
+    }
+    uint32_t a = atan_lut[index];
+    uint32_t b = atan_lut[index + 1];
+    return (uint16_t)(a + (((b - a) * frac + (1u << (ATAN_FRAC_BITS - 1))) >> ATAN_FRAC_BITS));
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Ângulo do vetor (x, y), no sentido anti-horário a partir da direita.
+ *
+ * Reduz ao primeiro octante (0 a 45°) por simetria e consulta a tabela.
+ */
+uint16_t joystick_angle(int16_t x, int16_t y) {
+    uint32_t ax = (uint32_t)abs(x);
+    uint32_t ay = (uint32_t)abs(y);
+    if (ax == 0 && ay == 0) {
+        return 0;
+    }
+
+    // Ângulo dentro do quadrante (0 a 90°)
+    uint32_t t = ay <= ax ? atan_ratio(ay, ax) : JOYSTICK_ANGLE_TURN / 4 - atan_ratio(ax, ay);
+
+    if (x >= 0) {
+        return (uint16_t)(y >= 0 ? t : JOYSTICK_ANGLE_TURN - t);
+    }
+    return (uint16_t)(y >= 0 ? JOYSTICK_ANGLE_TURN / 2 - t : JOYSTICK_ANGLE_TURN / 2 + t);
+}
+
+/**
+ * @brief Preenche os limiares padrão do detector.
+ *
+ * @param config Limiares a serem preenchidos.
+ */
+void joystick_tracker_config_defaults(joystick_tracker_config_t *config) {
+    config->center_radius = 8192;       // 25% do curso
+    config->edge_radius = 27852;        // 85% do curso
+    config->radial_hysteresis = 1311;   // 4% do curso
+    config->angular_hysteresis = 1024;  // ~5,6°
+}
+
+/**
+ * @brief Inicializa um detector na zona central.
+ *
+ * @param tracker Detector a ser inicializado.
+ * @param config Limiares, ou NULL para os padrões.
+ * @param callback Função chamada a cada evento (pode ser NULL).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_tracker_init(joystick_tracker_t *tracker, const joystick_tracker_config_t *config,
+                           joystick_direction_callback_t callback, void *user_data) {
+    joystick_tracker_config_t defaults;
+    if (!config) {
+        joystick_tracker_config_defaults(&defaults);
+        config = &defaults;
+    }
+
+    uint32_t c = config->center_radius;
+    uint32_t e = config->edge_radius;
+    uint32_t h = config->radial_hysteresis;
+    uint32_t c_low = c > h ? c - h : 0;
+    uint32_t e_low = e > h ? e - h : 0;
+
+    tracker->center_enter_r2 = c_low * c_low;
+    tracker->active_enter_r2 = (c + h) * (c + h);
+    tracker->active_return_r2 = e_low * e_low;
+    tracker->edge_enter_r2 = (e + h) * (e + h);
+    tracker->angular_hysteresis = config->angular_hysteresis;
+    tracker->direction = JOYSTICK_DIR_CENTER;
+    tracker->zone = JOYSTICK_ZONE_CENTER;
+    tracker->angle = 0;
+    tracker->callback = callback;
+    tracker->user_data = user_data;
+}
+
+/**
+ * @brief Próxima zona: só troca ao atravessar a faixa de histerese do raio correspondente.
+ */
+static joystick_zone_t tracker_next_zone(const joystick_tracker_t *tracker, uint32_t r2) {
+    switch (tracker->zone) {
+        case JOYSTICK_ZONE_CENTER:
+            if (r2 > tracker->edge_enter_r2) return JOYSTICK_ZONE_EDGE;
+            if (r2 > tracker->active_enter_r2) return JOYSTICK_ZONE_ACTIVE;
+            return JOYSTICK_ZONE_CENTER;
+        case JOYSTICK_ZONE_ACTIVE:
+            if (r2 < tracker->center_enter_r2) return JOYSTICK_ZONE_CENTER;
+            if (r2 > tracker->edge_enter_r2) return JOYSTICK_ZONE_EDGE;
+            return JOYSTICK_ZONE_ACTIVE;
+        default:
+            if (r2 < tracker->center_enter_r2) return JOYSTICK_ZONE_CENTER;
+            if (r2 < tracker->active_return_r2) return JOYSTICK_ZONE_ACTIVE;
+            return JOYSTICK_ZONE_EDGE;
+    }
+}
+
+/**
+ * @brief Próxima direção: mantém o setor atual enquanto o ângulo não passar da fronteira
+ * por mais de `angular_hysteresis`.
+ */
+static joystick_direction_t tracker_next_direction(const joystick_tracker_t *tracker, joystick_zone_t zone,
+                                                   uint16_t angle) {
+    if (zone == JOYSTICK_ZONE_CENTER) {
+        return JOYSTICK_DIR_CENTER;
+    }
+
+    uint32_t sector = (uint16_t)(angle + JOYSTICK_ANGLE_SECTOR / 2) / JOYSTICK_ANGLE_SECTOR;
+    if (tracker->direction != JOYSTICK_DIR_CENTER) {
+        uint32_t current = tracker->direction - JOYSTICK_DIR_RIGHT;
+        int16_t offset = (int16_t)(angle - current * JOYSTICK_ANGLE_SECTOR);
+        if (abs(offset) <= JOYSTICK_ANGLE_SECTOR / 2 + tracker->angular_hysteresis) {
+            sector = current;
+        }
+    }
+    return (joystick_direction_t)(JOYSTICK_DIR_RIGHT + sector);
+}
+
+/**
+ * @brief Atualiza o detector com uma nova leitura e dispara os eventos de troca.
+ *
+ * @param tracker Detector.
+ * @param x Eixo X centrado (positivo para a direita).
+ * @param y Eixo Y centrado (positivo para cima).
+ * @return Máscara dos eventos disparados (0 se nada mudou).
+ */
+uint32_t joystick_tracker_update(joystick_tracker_t *tracker, int16_t x, int16_t y) {
+    uint32_t r2 = (uint32_t)((int32_t)x * x) + (uint32_t)((int32_t)y * y);
+    uint16_t angle = joystick_angle(x, y);
+    joystick_zone_t zone = tracker_next_zone(tracker, r2);
+    joystick_direction_t direction = tracker_next_direction(tracker, zone, angle);
+
+    joystick_direction_event_t event = {
+        .direction = direction,
+        .previous = tracker->direction,
+        .zone = zone,
+        .previous_zone = tracker->zone,
+        .angle = angle,
+    };
+    tracker->angle = angle;
+    tracker->zone = zone;
+    tracker->direction = direction;
+
+    uint32_t events = 0;
+    if (event.zone != event.previous_zone) {
+        events |= JOYSTICK_EVENT_ZONE_CHANGED;
+    }
+    if (event.direction != event.previous) {
+        events |= JOYSTICK_EVENT_DIRECTION_CHANGED;
+    }
+
+    if (tracker->callback) {
+        // Zona antes da direção: ao sair do centro o consumidor já sabe a zona nova
+        if (events & JOYSTICK_EVENT_ZONE_CHANGED) {
+            event.type = JOYSTICK_EVENT_ZONE_CHANGED;
+            tracker->callback(&event, tracker->user_data);
+        }
+        if (events & JOYSTICK_EVENT_DIRECTION_CHANGED) {
+            event.type = JOYSTICK_EVENT_DIRECTION_CHANGED;
+            tracker->callback(&event, tracker->user_data);
+        }
+    }
+    return events;
+}
@@ -0,0 +1,284 @@
+#include "inc/joystick_gesture.h"
+#include <stdlib.h>
+
+/**
+ * Arquivo: joystick_gesture.c
+ *
+ * Descrição:
+ * Reconhecedor de gestos em fluxo. O flick e o segurar são máquinas de estado sobre o raio²
+ * (com a mesma histerese radial do detector de direção); o giro soma os deltas de ângulo dos
+ * pontos do anel, somando o ponto novo e subtraindo o que sai da janela, então cada amostra
+ * custa o mesmo qualquer que seja o tamanho da janela.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define RING_MASK (JOYSTICK_GESTURE_RING_SIZE - 1)
+
+_Static_assert((JOYSTICK_GESTURE_RING_SIZE & RING_MASK) == 0, "anel do giro deve ter tamanho potência de 2");
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Raiz quadrada inteira (arredondada para baixo), bit a bit.
+ */
+static uint16_t isqrt32(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)root;
+}
+
+/**
+ * @brief Entrega um gesto ao callback e devolve sua máscara.
+ */
+static uint32_t gesture_emit(joystick_gesture_t *gesture, joystick_gesture_type_t type,
+                             joystick_direction_t direction, uint32_t t_us, uint32_t duration_us,
+                             uint16_t radius) {
+    if (gesture->callback) {
+        joystick_gesture_event_t event = {
+            .type = type,
+            .direction = direction,
+            .t_us = t_us,
+            .duration_us = duration_us,
+            .radius = radius,
+        };
+        gesture->callback(&event, gesture->user_data);
+    }
+    return JOYSTICK_GESTURE_MASK(type);
+}
+
+/**
+ * @brief Esvazia a janela do giro.
+ */
+static void circle_reset(joystick_gesture_t *gesture) {
+    gesture->ring_count = 0;
+    gesture->angle_sum = 0;
+    gesture->radius_sum = 0;
+}
+
+/**
+ * @brief Acrescenta um ponto ao anel e verifica se a janela completou uma volta.
+ */
+static uint32_t circle_point(joystick_gesture_t *gesture, uint32_t t_us, uint32_t r2, uint16_t angle) {
+    if (r2 < gesture->circle_r2) {
+        gesture->circle_active = false;
+        circle_reset(gesture);
+        return 0;
+    }
+    if (!gesture->circle_active) {
+        // Primeiro ponto além do raio: só serve de referência para o próximo delta
+        gesture->circle_active = true;
+        gesture->last_point_angle = angle;
+        return 0;
+    }
+
+    // Janela cheia: o ponto mais antigo sai antes de o novo entrar
+    if (gesture->ring_count >= gesture->circle_window) {
+        const joystick_gesture_point_t *oldest =
+            &gesture->ring[(gesture->ring_head - gesture->ring_count) & RING_MASK];
+        gesture->angle_sum -= oldest->delta;
+        gesture->radius_sum -= oldest->radius;
+        gesture->ring_count--;
+    }
+
+    joystick_gesture_point_t *point = &gesture->ring[gesture->ring_head & RING_MASK];
+    point->delta = (int16_t)(angle - gesture->last_point_angle);
+    point->radius = isqrt32(r2);
+    gesture->ring_head++;
+    gesture->ring_count++;
+    gesture->angle_sum += point->delta;
+    gesture->radius_sum += point->radius;
+    gesture->last_point_angle = angle;
+
+    if (abs(gesture->angle_sum) < JOYSTICK_ANGLE_TURN) {
+        return 0;
+    }
+
+    // Ângulo cresce no sentido anti-horário
+    joystick_gesture_type_t type = gesture->angle_sum > 0 ? JOYSTICK_GESTURE_CIRCLE_CCW : JOYSTICK_GESTURE_CIRCLE_CW;
+    uint32_t duration_us = gesture->ring_count * gesture->point_interval_us;
+    uint16_t radius = (uint16_t)(gesture->radius_sum / gesture->ring_count);
+    circle_reset(gesture); // A próxima volta começa deste ponto
+    return gesture_emit(gesture, type, JOYSTICK_DIR_CENTER, t_us, duration_us, radius);
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche os limiares padrão do reconhecedor.
+ *
+ * @param config Limiares a serem preenchidos.
+ */
+void joystick_gesture_config_defaults(joystick_gesture_config_t *config) {
+    config->center_radius = 8192;       // 25% do curso
+    config->edge_radius = 27852;        // 85% do curso
+    config->radial_hysteresis = 1311;   // 4% do curso
+    config->flick_max_us = 250000;
+    config->hold_us = 600000;
+    config->hold_tolerance = 4096;      // 22,5°
+    config->circle_radius = 16384;      // 50% do curso
+    config->circle_max_us = 1500000;
+    config->point_interval_us = 10000;
+}
+
+/**
+ * @brief Inicializa um reconhecedor em repouso.
+ *
+ * O primeiro flick só é aceito depois que o joystick passar pelo centro.
+ *
+ * @param gesture Reconhecedor a ser inicializado.
+ * @param config Limiares, ou NULL para os padrões.
+ * @param callback Função chamada a cada gesto (pode ser NULL).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_gesture_init(joystick_gesture_t *gesture, const joystick_gesture_config_t *config,
+                           joystick_gesture_callback_t callback, void *user_data) {
+    joystick_gesture_config_t defaults;
+    if (!config) {
+        joystick_gesture_config_defaults(&defaults);
+        config = &defaults;
+    }
+
+    uint32_t c = config->center_radius;
+    uint32_t e = config->edge_radius;
+    uint32_t h = config->radial_hysteresis;
+    uint32_t c_low = c > h ? c - h : 0;
+    uint32_t e_low = e > h ? e - h : 0;
+
+    gesture->center_enter_r2 = c_low * c_low;
+    gesture->center_exit_r2 = (c + h) * (c + h);
+    gesture->edge_enter_r2 = (e + h) * (e + h);
+    gesture->edge_exit_r2 = e_low * e_low;
+    gesture->circle_r2 = (uint32_t)config->circle_radius * config->circle_radius;
+    gesture->flick_max_us = config->flick_max_us;
+    gesture->hold_us = config->hold_us;
+    gesture->hold_tolerance = config->hold_tolerance;
+    gesture->point_interval_us = config->point_interval_us ? config->point_interval_us : 1;
+
+    // Janela do giro em pontos, limitada ao tamanho do anel
+    uint32_t window = config->circle_max_us / gesture->point_interval_us;
+    if (window < 1) {
+        window = 1;
+    } else if (window > JOYSTICK_GESTURE_RING_SIZE) {
+        window = JOYSTICK_GESTURE_RING_SIZE;
+    }
+    gesture->circle_window = window;
+
+    gesture->at_center = false;
+    gesture->flick_armed = false;
+    gesture->reached_edge = false;
+    gesture->out_t_us = 0;
+    gesture->peak_r2 = 0;
+    gesture->peak_angle = 0;
+
+    gesture->at_edge = false;
+    gesture->hold_fired = false;
+    gesture->edge_t_us = 0;
+    gesture->edge_angle = 0;
+
+    gesture->ring_head = 0;
+    circle_reset(gesture);
+    gesture->circle_active = false;
+    gesture->last_point_angle = 0;
+    gesture->last_point_t_us = 0;
+    gesture->has_point = false;
+
+    gesture->callback = callback;
+    gesture->user_data = user_data;
+}
+
+/**
+ * @brief Processa uma amostra e dispara os gestos completados por ela.
+ *
+ * @param gesture Reconhecedor.
+ * @param t_us Instante da amostra (pode dar a volta em 32 bits).
+ * @param x Eixo X centrado (positivo para a direita).
+ * @param y Eixo Y centrado (positivo para cima).
+ * @return Máscara (JOYSTICK_GESTURE_MASK) dos gestos reconhecidos, ou 0.
+ */
+uint32_t joystick_gesture_update(joystick_gesture_t *gesture, uint32_t t_us, int16_t x, int16_t y) {
+    uint32_t r2 = (uint32_t)((int32_t)x * x) + (uint32_t)((int32_t)y * y);
+    uint16_t angle = joystick_angle(x, y);
+    uint32_t events = 0;
+
+    // Flick: sair do centro, passar pela borda e voltar dentro do prazo
+    if (gesture->at_center) {
+        if (r2 > gesture->center_exit_r2) {
+            gesture->at_center = false;
+            gesture->flick_armed = true;
+            gesture->reached_edge = false;
+            gesture->out_t_us = t_us;
+            gesture->peak_r2 = 0;
+        }
+    } else if (r2 < gesture->center_enter_r2) {
+        gesture->at_center = true;
+        uint32_t duration_us = t_us - gesture->out_t_us;
+        if (gesture->flick_armed && gesture->reached_edge && duration_us <= gesture->flick_max_us) {
+            events |= gesture_emit(gesture, JOYSTICK_GESTURE_FLICK, joystick_gesture_direction(gesture->peak_angle),
+                                   t_us, duration_us, isqrt32(gesture->peak_r2));
+        }
+        gesture->flick_armed = false;
+    }
+    if (!gesture->at_center && r2 > gesture->peak_r2) {
+        gesture->peak_r2 = r2;
+        gesture->peak_angle = angle;
+    }
+
+    // Segurar: permanência na borda sem girar além da tolerância
+    if (gesture->at_edge ? r2 < gesture->edge_exit_r2 : r2 <= gesture->edge_enter_r2) {
+        gesture->at_edge = false;
+    } else {
+        if (!gesture->at_edge || abs((int16_t)(angle - gesture->edge_angle)) > gesture->hold_tolerance) {
+            // Chegou à borda ou deslizou por ela: a contagem recomeça com a nova direção
+            gesture->at_edge = true;
+            gesture->reached_edge = true;
+            gesture->hold_fired = false;
+            gesture->edge_t_us = t_us;
+            gesture->edge_angle = angle;
+        }
+        uint32_t dwell_us = t_us - gesture->edge_t_us;
+        if (!gesture->hold_fired && dwell_us >= gesture->hold_us) {
+            gesture->hold_fired = true;
+            events |= gesture_emit(gesture, JOYSTICK_GESTURE_HOLD, joystick_gesture_direction(gesture->edge_angle),
+                                   t_us, dwell_us, isqrt32(r2));
+        }
+    }
+
+    // Giro: um ponto por intervalo, qualquer que seja a taxa das amostras
+    if (!gesture->has_point || t_us - gesture->last_point_t_us >= gesture->point_interval_us) {
+        gesture->has_point = true;
+        gesture->last_point_t_us = t_us;
+        events |= circle_point(gesture, t_us, r2, angle);
+    }
+
+    return events;
+}
+
+/**
+ * @brief Direção de 8 setores de um ângulo (sem zona central).
+ *
+ * @param angle Ângulo (JOYSTICK_ANGLE_TURN = 360°).
+ * @return JOYSTICK_DIR_RIGHT a JOYSTICK_DIR_DOWN_RIGHT.
+ */
+joystick_direction_t joystick_gesture_direction(uint16_t angle) {
+    uint32_t sector = (uint16_t)(angle + JOYSTICK_ANGLE_SECTOR / 2) / JOYSTICK_ANGLE_SECTOR;
+    return (joystick_direction_t)(JOYSTICK_DIR_RIGHT + sector);
+}
@@ -0,0 +1,234 @@
+#include "inc/matriz_anim.h"
+
+/**
+ * Arquivo: matriz_anim.c
+ *
+ * Descrição:
+ * Cena retida da matriz de LEDs. Cada trilha guarda o trecho (par de quadros-chave) em que está,
+ * então avançar um quadro custa poucas comparações por sprite; a posição dentro do trecho vira uma
+ * fração em 16.16, passada pela curva e usada para interpolar posição e cor em aritmética inteira.
+ */
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Aplica a curva a uma fração em 16.16 (0 a 65536).
+ */
+static uint32_t ease_fraction(matriz_ease_t ease, uint32_t f) {
+    switch (ease) {
+        case MATRIZ_EASE_STEP:
+            return 0;
+        case MATRIZ_EASE_IN_OUT: {
+            // f² (3 - 2f)
+            uint64_t f2 = ((uint64_t)f * f) >> 16;
+            return (uint32_t)((f2 * (3u * 65536u - 2u * f)) >> 16);
+        }
+        default:
+            return f;
+    }
+}
+
+/**
+ * @brief Valor entre `a` e `b` na fração `f` (16.16), arredondado.
+ */
+static int32_t lerp(int32_t a, int32_t b, uint32_t f) {
+    return a + (int32_t)(((int64_t)(b - a) * f + 32768) >> 16);
+}
+
+/**
+ * @brief Coloca o sprite exatamente num quadro-chave.
+ */
+static void apply_key(matriz_sprite_t *sprite, const matriz_keyframe_t *key) {
+    sprite->x = key->x;
+    sprite->y = key->y;
+    sprite->r = key->r;
+    sprite->g = key->g;
+    sprite->b = key->b;
+}
+
+/**
+ * @brief Avança a trilha de um sprite até `now_ms`.
+ */
+static void update_sprite(matriz_sprite_t *sprite, uint32_t now_ms) {
+    const matriz_keyframe_t *keys = sprite->keys;
+    uint8_t last = sprite->key_count - 1;
+    uint32_t t = now_ms - sprite->start_ms;
+    uint32_t end = keys[last].at_ms;
+
+    if (t >= end) {
+        if (!sprite->loop || end == 0) {
+            apply_key(sprite, &keys[last]);
+            sprite->keys = NULL; // Trilha terminada
+            return;
+        }
+        // Recomeça, contando as voltas inteiras que passaram (quadros atrasados não acumulam)
+        uint32_t laps = t / end;
+        sprite->start_ms += laps * end;
+        t -= laps * end;
+        sprite->key = 0;
+    }
+    if (t < keys[0].at_ms) {
+        apply_key(sprite, &keys[0]);
+        return;
+    }
+
+    // Como t < end, o trecho atual sempre tem um quadro-chave seguinte.
+    if (t < keys[sprite->key].at_ms) {
+        sprite->key = 0; // Instante anterior ao trecho guardado
+    }
+    while (keys[sprite->key + 1].at_ms <= t) {
+        sprite->key++;
+    }
+    const matriz_keyframe_t *a = &keys[sprite->key];
+    const matriz_keyframe_t *b = &keys[sprite->key + 1];
+    uint32_t f = (uint32_t)(((uint64_t)(t - a->at_ms) << 16) / (b->at_ms - a->at_ms));
+    f = ease_fraction(sprite->ease, f);
+
+    sprite->x = (int16_t)lerp(a->x, b->x, f);
+    sprite->y = (int16_t)lerp(a->y, b->y, f);
+    sprite->r = (uint8_t)lerp(a->r, b->r, f);
+    sprite->g = (uint8_t)lerp(a->g, b->g, f);
+    sprite->b = (uint8_t)lerp(a->b, b->b, f);
+}
+
+/**
+ * @brief Desenha um sprite no quadro, cortando o que fica fora da imagem.
+ */
+static void draw_sprite(const matriz_anim_t *anim, const matriz_sprite_t *sprite, uint8_t (*frame)[3]) {
+    for (int row = 0; row < sprite->height; row++) {
+        int y = sprite->y + row;
+        if (y < 0 || y >= anim->height) {
+            continue;
+        }
+        for (int col = 0; col < sprite->width; col++) {
+            int x = sprite->x + col;
+            bool on = sprite->rows == NULL || (sprite->rows[row] & (1u << (sprite->width - 1 - col)));
+            if (!on || x < 0 || x >= anim->width) {
+                continue; // Pixel transparente ou fora da imagem
+            }
+            uint8_t *pixel = frame[y * anim->width + x];
+            pixel[0] = sprite->r;
+            pixel[1] = sprite->g;
+            pixel[2] = sprite->b;
+        }
+    }
+}
+
+/**
+ * @brief Confere o identificador de um sprite.
+ */
+static matriz_sprite_t *get_sprite(matriz_anim_t *anim, int id) {
+    return (id >= 0 && id < anim->count) ? &anim->sprites[id] : NULL;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+void matriz_anim_init(matriz_anim_t *anim, uint16_t width, uint16_t height) {
+    anim->count = 0;
+    anim->width = width;
+    anim->height = height;
+    anim->background[0] = 0;
+    anim->background[1] = 0;
+    anim->background[2] = 0;
+}
+
+int matriz_anim_add(matriz_anim_t *anim, const uint8_t *rows, uint8_t width, uint8_t height, uint8_t layer) {
+    if (anim->count >= MATRIZ_ANIM_MAX_SPRITES || width == 0 || height == 0 ||
+        (rows && (width > MATRIZ_ANIM_MAX_SIZE || height > MATRIZ_ANIM_MAX_SIZE))) {
+        return -1;
+    }
+    matriz_sprite_t *sprite = &anim->sprites[anim->count];
+    *sprite = (matriz_sprite_t){
+        .rows = rows,
+        .width = width,
+        .height = height,
+        .layer = layer,
+        .visible = true,
+    };
+    return anim->count++;
+}
+
+void matriz_anim_set(matriz_anim_t *anim, int id, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b) {
+    matriz_sprite_t *sprite = get_sprite(anim, id);
+    if (sprite) {
+        const matriz_keyframe_t key = {0, x, y, r, g, b};
+        apply_key(sprite, &key);
+        sprite->keys = NULL;
+    }
+}
+
+void matriz_anim_show(matriz_anim_t *anim, int id, bool visible) {
+    matriz_sprite_t *sprite = get_sprite(anim, id);
+    if (sprite) {
+        sprite->visible = visible;
+    }
+}
+
+bool matriz_anim_play(matriz_anim_t *anim, int id, const matriz_keyframe_t *keys, uint8_t count, matriz_ease_t ease,
+                      bool loop, uint32_t now_ms) {
+    matriz_sprite_t *sprite = get_sprite(anim, id);
+    if (sprite == NULL || keys == NULL || count == 0) {
+        return false;
+    }
+    for (uint8_t i = 1; i < count; i++) {
+        if (keys[i].at_ms < keys[i - 1].at_ms) {
+            return false; // Fora de ordem
+        }
+    }
+    sprite->keys = keys;
+    sprite->key_count = count;
+    sprite->key = 0;
+    sprite->ease = ease;
+    sprite->loop = loop;
+    sprite->start_ms = now_ms;
+    apply_key(sprite, &keys[0]);
+    return true;
+}
+
+bool matriz_anim_playing(const matriz_anim_t *anim) {
+    for (uint8_t i = 0; i < anim->count; i++) {
+        if (anim->sprites[i].keys) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void matriz_anim_update(matriz_anim_t *anim, uint32_t now_ms) {
+    for (uint8_t i = 0; i < anim->count; i++) {
+        if (anim->sprites[i].keys) {
+            update_sprite(&anim->sprites[i], now_ms);
+        }
+    }
+}
+
+void matriz_anim_render(const matriz_anim_t *anim, uint8_t (*frame)[3]) {
+    uint32_t pixels = (uint32_t)anim->width * anim->height;
+    for (uint32_t i = 0; i < pixels; i++) {
+        frame[i][0] = anim->background[0];
+        frame[i][1] = anim->background[1];
+        frame[i][2] = anim->background[2];
+    }
+
+    // Ordem de desenho: camada crescente e, na mesma camada, ordem de criação (inserção estável)
+    uint8_t order[MATRIZ_ANIM_MAX_SPRITES];
+    for (uint8_t i = 0; i < anim->count; i++) {
+        uint8_t j = i;
+        while (j > 0 && anim->sprites[order[j - 1]].layer > anim->sprites[i].layer) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    for (uint8_t i = 0; i < anim->count; i++) {
+        const matriz_sprite_t *sprite = &anim->sprites[order[i]];
+        if (sprite->visible) {
+            draw_sprite(anim, sprite, frame);
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include "inc/matriz_marquee.h"
+#include "inc/font5x5.h"
+
+/**
+ * Arquivo: matriz_marquee.c
+ *
+ * Descrição:
+ * Gerador das colunas de um letreiro. Ao carregar uma letra, as linhas do desenho são combinadas
+ * para achar a primeira e a última coluna com pixels; cada coluna é montada na hora, pegando o mesmo
+ * bit de cada linha. Nenhum quadro é montado: quem desenha guarda só as colunas visíveis.
+ */
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Coluna `col` de um desenho da fonte, com a linha 0 no bit 0.
+ */
+static uint8_t glyph_column(const uint8_t *glyph, uint8_t col) {
+    uint8_t column = 0;
+    for (int row = 0; row < FONT5X5_ROWS; row++) {
+        column |= (uint8_t)(((glyph[row] >> (FONT5X5_COLS - 1 - col)) & 1) << row);
+    }
+    return column;
+}
+
+/**
+ * @brief Carrega a próxima letra do texto; devolve false no fim do texto.
+ */
+static bool load_next(matriz_marquee_t *marquee) {
+    while (*marquee->next) {
+        const uint8_t *glyph = font5x5_glyph(*marquee->next++);
+        if (glyph == NULL) {
+            continue; // Sem desenho na fonte
+        }
+
+        uint8_t used = 0;
+        for (int row = 0; row < FONT5X5_ROWS; row++) {
+            used |= glyph[row];
+        }
+        if (used == 0) {
+            marquee->blank += MATRIZ_MARQUEE_SPACE;
+            continue;
+        }
+
+        // A coluna 0 está no bit mais alto: a primeira coluna usada é o bit mais alto ligado.
+        uint8_t first = 0;
+        while (!(used & (1u << (FONT5X5_COLS - 1 - first)))) {
+            first++;
+        }
+        uint8_t last = FONT5X5_COLS - 1;
+        while (!(used & (1u << (FONT5X5_COLS - 1 - last)))) {
+            last--;
+        }
+        marquee->glyph = glyph;
+        marquee->column = first;
+        marquee->last = last;
+        return true;
+    }
+    return false;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+void matriz_marquee_start(matriz_marquee_t *marquee, const char *text, uint16_t tail, bool loop) {
+    marquee->text = text;
+    marquee->next = text;
+    marquee->glyph = NULL;
+    marquee->column = 0;
+    marquee->last = 0;
+    marquee->blank = 0;
+    marquee->tail = tail;
+    marquee->ended = false;
+    marquee->emitted = false;
+    marquee->loop = loop;
+}
+
+bool matriz_marquee_next(matriz_marquee_t *marquee, uint8_t *column) {
+    for (;;) {
+        if (marquee->blank) {
+            marquee->blank--;
+            *column = 0;
+            marquee->emitted = true;
+            return true;
+        }
+
+        if (marquee->glyph) {
+            *column = glyph_column(marquee->glyph, marquee->column);
+            if (marquee->column++ == marquee->last) {
+                marquee->glyph = NULL;
+                marquee->blank = MATRIZ_MARQUEE_GAP;
+            }
+            marquee->emitted = true;
+            return true;
+        }
+
+        if (!marquee->ended) {
+            if (!load_next(marquee)) {
+                // Fim do texto: o espaço depois da última letra já conta para a saída
+                marquee->ended = true;
+                marquee->blank = marquee->tail > MATRIZ_MARQUEE_GAP ? marquee->tail - MATRIZ_MARQUEE_GAP : 0;
+            }
+            continue;
+        }
+
+        // Colunas do fim já enviadas; uma volta sem colunas não é repetida (não geraria nada)
+        if (!marquee->loop || !marquee->emitted) {
+            return false;
+        }
+        marquee->next = marquee->text;
+        marquee->ended = false;
+        marquee->emitted = false;
+    }
+}
@@ -0,0 +1,65 @@
+#include "inc/matriz_parallel.h"
+
+/**
+ * Arquivo: matriz_parallel.c
+ *
+ * Descrição:
+ * Transposição dos pixels das fitas para planos de bits. Os 8 bytes de um canal (um por fita) ficam
+ * em duas palavras de 32 bits, fitas 0-3 em `lo` e 4-7 em `hi`, e a matriz de 8x8 bits é transposta
+ * em três passos que trocam blocos de 1, 2 e 4 bits (Hacker's Delight, transpose8), só com
+ * operações de 32 bits, que o Cortex-M0+ executa direto.
+ */
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Transpõe a matriz de 8x8 bits em `hi:lo` (linha `s` no byte `s`, coluna `j` no bit `j`).
+ */
+static inline void transpose8(uint32_t *hi, uint32_t *lo) {
+    uint32_t x = *lo, y = *hi, t;
+
+    // Blocos de 1 bit dentro de cada par de linhas
+    t = (x ^ (x >> 7)) & 0x00AA00AAu; x ^= t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AAu; y ^= t ^ (t << 7);
+
+    // Blocos de 2 bits dentro de cada grupo de 4 linhas
+    t = (x ^ (x >> 14)) & 0x0000CCCCu; x ^= t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCCu; y ^= t ^ (t << 14);
+
+    // Blocos de 4 bits entre as duas metades
+    t = ((x >> 4) ^ y) & 0x0F0F0F0Fu;
+    y ^= t;
+    x ^= t << 4;
+
+    *lo = x;
+    *hi = y;
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+void matriz_parallel_transpose(const uint32_t *pixels, uint32_t strip_leds, uint8_t strips, uint8_t channels,
+                               uint32_t *planes) {
+    for (uint32_t p = 0; p < strip_leds; p++) {
+        uint32_t words[MATRIZ_PARALLEL_MAX_STRIPS] = {0};
+        for (uint8_t s = 0; s < strips; s++) {
+            words[s] = pixels[s * strip_leds + p];
+        }
+
+        for (uint8_t c = 0; c < channels; c++) {
+            uint8_t shift = 24 - 8 * c; // G, R, B e W, do byte mais significativo ao menos
+            uint32_t lo = ((words[0] >> shift) & 0xFF) | ((words[1] >> shift) & 0xFF) << 8 |
+                          ((words[2] >> shift) & 0xFF) << 16 | ((words[3] >> shift) & 0xFF) << 24;
+            uint32_t hi = ((words[4] >> shift) & 0xFF) | ((words[5] >> shift) & 0xFF) << 8 |
+                          ((words[6] >> shift) & 0xFF) << 16 | ((words[7] >> shift) & 0xFF) << 24;
+            transpose8(&hi, &lo);
+
+            // Byte j = bit j do canal: o plano do bit 7 (byte 3 de hi) sai primeiro.
+            *planes++ = hi;
+            *planes++ = lo;
+        }
+    }
+}
@@ -0,0 +1,206 @@
+#include <stdio.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#include "inc/JoystickPi.h"
+
+// Taxa de amostragem por eixo usada pelo motor durante o teste
+#define TEST_RATE_HZ 10000
+
+// Quantidade de leituras usadas para medir o custo de joystickPi_read
+#define TIMING_READS 1000
+
+// Amostras usadas em cada medição de ruído
+#define NOISE_SAMPLES 32
+
+// Taxa e duração da comparação de jitter entre o laço com sleep_ms e o fluxo de amostras
+#define STREAM_RATE_HZ 1000
+#define STREAM_SAMPLES 2000
+
+// Calcula o desvio padrão de um vetor, em LSB de 12 bits (escala = divisor para chegar a 12 bits)
+float std_dev_lsb(const uint16_t *values, uint count, float scale) {
+    double sum = 0, sum_sq = 0;
+    for (uint i = 0; i < count; i++) {
+        double v = values[i] / scale;
+        sum += v;
+        sum_sq += v * v;
+    }
+    double mean = sum / count;
+    return (float)sqrt(sum_sq / count - mean * mean);
+}
+
+// Coleta saídas decimadas consecutivas e devolve o ruído de cada eixo
+void measure_decimated_noise(float *noise_x, float *noise_y) {
+    uint16_t x[NOISE_SAMPLES], y[NOISE_SAMPLES];
+    joystick_engine_stats_t stats;
+    uint32_t last = 0;
+
+    for (uint i = 0; i < NOISE_SAMPLES; i++) {
+        do {
+            joystickPi_engine_get_stats(&stats);
+        } while (stats.decimated == last);
+        last = stats.decimated;
+
+        joystick_state_t state = joystickPi_read();
+        x[i] = state.x_hires;
+        y[i] = state.y_hires;
+    }
+    *noise_x = std_dev_lsb(x, NOISE_SAMPLES, 16.0f);
+    *noise_y = std_dev_lsb(y, NOISE_SAMPLES, 16.0f);
+}
+
+// Exibe o desvio padrão em repouso antes e depois da sobreamostragem
+void report_noise() {
+    uint16_t x[NOISE_SAMPLES], y[NOISE_SAMPLES];
+    joystickPi_engine_set_decimation(1, 1);
+    uint count = joystickPi_engine_snapshot(x, y, NOISE_SAMPLES);
+    float raw_x = std_dev_lsb(x, count, 1.0f);
+    float raw_y = std_dev_lsb(y, count, 1.0f);
+
+    printf("Ruído em repouso (desvio padrão, LSB de 12 bits) - não toque no joystick\n");
+    printf("Bruto        : X %.3f  Y %.3f\n", raw_x, raw_y);
+
+    for (uint order = 1; order <= 2; order++) {
+        for (uint factor = 4; factor <= JOYSTICK_DECIMATION_MAX_FACTOR; factor *= 4) {
+            float dec_x, dec_y;
+            joystickPi_engine_set_decimation(factor, order);
+            measure_decimated_noise(&dec_x, &dec_y);
+
+            // Cada redução do ruído pela metade equivale a um bit efetivo a mais
+            printf("%3ux ordem %u : X %.3f  Y %.3f  (+%.1f / +%.1f bits)\n", factor, order, dec_x, dec_y,
+                   dec_x > 0 ? log2f(raw_x / dec_x) : 0.0f, dec_y > 0 ? log2f(raw_y / dec_y) : 0.0f);
+        }
+    }
+}
+
+// Rotina guiada de calibração: centro em repouso e faixa girando o joystick
+void run_calibration() {
+    joystick_calibration_t cal;
+
+    printf("Calibração: deixe o joystick em repouso...\n");
+    sleep_ms(1000);
+    joystickPi_calibrate_center(200);
+
+    printf("Gire o joystick até os batentes em todas as direções por 5 segundos...\n");
+    joystickPi_calibration_begin_range();
+    uint64_t end = time_us_64() + 5000000;
+    while (time_us_64() < end) {
+        joystickPi_read(); // Cada leitura amplia os limites aprendidos
+        sleep_ms(1);
+    }
+    joystickPi_calibration_end_range();
+    joystickPi_calibration_save();
+
+    joystickPi_calibration_get(&cal);
+    printf("Centro: X %u  Y %u | X: %u a %u | Y: %u a %u | zona morta: %u (escala de 16 bits)\n",
+           cal.center_x, cal.center_y, cal.min_x, cal.max_x, cal.min_y, cal.max_y, cal.deadzone);
+}
+
+// Mede o tempo médio (em µs) de uma chamada a joystickPi_read
+// Compara a regularidade de um laço com sleep_ms com a do fluxo de taxa fixa
+void report_stream_jitter() {
+    const int64_t period_us = 1000000 / STREAM_RATE_HZ;
+
+    // Laço tradicional: o instante da leitura é o de quando a CPU acordou
+    uint32_t sleep_jitter = 0;
+    uint64_t last = time_us_64();
+    for (uint i = 0; i < STREAM_SAMPLES; i++) {
+        sleep_us(period_us);
+        volatile joystick_state_t state = joystickPi_read();
+        (void)state;
+        uint64_t now = time_us_64();
+        int64_t error = (int64_t)(now - last) - period_us;
+        sleep_jitter = MAX(sleep_jitter, (uint32_t)(error < 0 ? -error : error));
+        last = now;
+    }
+
+    // Fluxo: o instante vem da cadência do ADC, então o intervalo entre amostras é o período por
+    // construção; o que se mede é a diferença entre o relógio e esse instante a cada processamento
+    joystickPi_stream_start(STREAM_RATE_HZ);
+    joystick_sample_t sample;
+    joystickPi_stream_wait(&sample);
+    joystickPi_stream_reset_stats(); // Descarta a partida do motor
+    for (uint i = 0; i < STREAM_SAMPLES; i++) {
+        joystickPi_stream_wait(&sample);
+    }
+    joystick_stream_stats_t stats;
+    joystickPi_stream_get_stats(&stats);
+    joystickPi_stream_stop();
+
+    printf("Regularidade a %u Hz (%u amostras, medida com time_us_64)\n", STREAM_RATE_HZ, STREAM_SAMPLES);
+    printf("sleep_us + joystickPi_read : maior desvio do período %lu us\n", (unsigned long)sleep_jitter);
+    printf("Fluxo de amostras          : relógio - instante da amostra de %ld a %ld us (variação %ld us)\n",
+           (long)stats.clock_error_min_us, (long)stats.clock_error_max_us,
+           (long)(stats.clock_error_max_us - stats.clock_error_min_us));
+    printf("                             %.2f Hz, %lu passadas por amostra, temporizador %lu us, perdidas %lu\n",
+           stats.rate_hz, (unsigned long)stats.groups_per_sample, (unsigned long)stats.tick_jitter_us,
+           (unsigned long)stats.dropped);
+}
+
+float measure_read_cost_us() {
+    uint64_t start = time_us_64();
+    for (int i = 0; i < TIMING_READS; i++) {
+        volatile joystick_state_t state = joystickPi_read();
+        (void)state;
+    }
+    return (float)(time_us_64() - start) / TIMING_READS;
+}
+
+int main() {
+    stdio_init_all();
+    sleep_ms(2000); // Tempo para o terminal USB conectar
+
+    joystickPi_init();
+    if (joystickPi_calibration_load()) {
+        printf("Calibração carregada da flash\n");
+    }
+
+    // Custo da leitura bloqueante (duas conversões do ADC por chamada)
+    float blocking_us = measure_read_cost_us();
+
+    if (!joystickPi_engine_start(TEST_RATE_HZ)) {
+        printf("Falha ao iniciar o motor de amostragem\n");
+        while (true) {
+            tight_loop_contents();
+        }
+    }
+
+    // Custo da leitura servida pelo buffer do DMA
+    float engine_us = measure_read_cost_us();
+    printf("joystickPi_read: bloqueante %.2f us, motor DMA %.2f us\n", blocking_us, engine_us);
+
+    report_noise();
+    report_stream_jitter();
+    joystickPi_engine_set_decimation(16, 2);
+
+    // Temperatura no round-robin; a calibração abaixo fixa as condições de referência
+    joystickPi_compensation_enable(JOYSTICK_COMP_NO_REF);
+    run_calibration();
+    joystickPi_calibration_set_auto(true); // Pontos de repouso para o ajuste da deriva
+
+    while (true) {
+        sleep_ms(1000);
+
+        joystick_engine_stats_t stats;
+        joystickPi_engine_get_stats(&stats);
+        joystick_state_t state = joystickPi_read();
+
+        printf("Taxa pedida: %lu Hz | obtida: %.1f Hz | medida: %.1f Hz | amostras: %llu | overruns: %lu\n",
+               (unsigned long)stats.requested_rate_hz, stats.achieved_rate_hz, stats.measured_rate_hz,
+               (unsigned long long)stats.samples, (unsigned long)stats.overruns);
+        printf("Decimação: %ux ordem %u | saída: %.1f Hz\n",
+               stats.decimation_factor, stats.decimation_order, stats.output_rate_hz);
+        printf("X: %4u (%5u) norm %6d  Y: %4u (%5u) norm %6d  Botão: %d\n",
+               state.x, state.x_hires, state.x_norm, state.y, state.y_hires, state.y_norm, state.button);
+
+        uint16_t temp, ref;
+        joystick_comp_t comp;
+        joystickPi_compensation_get(&comp);
+        if (joystickPi_compensation_sensors(&temp, &ref)) {
+            printf("Temperatura: %.1f °C (referência %.1f °C) | deriva X %.3f Y %.3f LSB/LSB\n",
+                   joystickPi_temperature_c(temp), joystickPi_temperature_c(comp.temp_ref),
+                   comp.temp_slope_x / 65536.0f, comp.temp_slope_y / 65536.0f);
+        }
+    }
+
+    return 0;
+}
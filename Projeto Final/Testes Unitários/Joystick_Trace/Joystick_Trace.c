@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "inc/JoystickPi.h"
+#include "inc/joystick_trace.h"
+
+// Taxa e duração de cada gravação
+#define TRACE_RATE_HZ 1000
+#define TRACE_SECONDS 30
+
+// Fila entre o temporizador e o envio pela USB (1 s na taxa padrão; potência de 2)
+#define TRACE_QUEUE_SIZE 1024
+
+// Fila de registros: o temporizador escreve em head, o laço principal lê em tail
+static joystick_trace_record_t queue[TRACE_QUEUE_SIZE];
+static volatile uint32_t queue_head;
+static volatile uint32_t queue_tail;
+static volatile uint32_t ticks;      // Amostras tomadas pelo temporizador (gravadas ou perdidas)
+static volatile uint32_t dropped;    // Amostras perdidas com a fila cheia
+static bool gap;                     // A próxima amostra gravada vem depois de uma perda
+
+// Envia bytes crus pela USB, sem a tradução de '\n' para "\r\n"
+void write_raw(const void *data, size_t size) {
+    const uint8_t *bytes = data;
+    for (size_t i = 0; i < size; i++) {
+        putchar_raw(bytes[i]);
+    }
+}
+
+// Lê os eixos direto do ADC (sem calibração nem filtro) e enfileira o registro
+bool sample_callback(repeating_timer_t *timer) {
+    adc_select_input(JOYSTICK_X_ADC_CHANNEL);
+    uint16_t x = adc_read();
+    adc_select_input(JOYSTICK_Y_ADC_CHANNEL);
+    uint16_t y = adc_read();
+    bool button = joystickPi_read_button();
+    ticks++;
+
+    uint32_t head = queue_head;
+    if (head - queue_tail >= TRACE_QUEUE_SIZE) {
+        dropped++;
+        gap = true;
+        return true;
+    }
+    queue[head & (TRACE_QUEUE_SIZE - 1)] = joystick_trace_record(x, y, button, gap);
+    gap = false;
+    __dmb(); // Publica o registro antes do índice
+    queue_head = head + 1;
+    return true;
+}
+
+// Grava um trace: cabeçalho, TRACE_SECONDS de registros e rodapé
+void record_trace() {
+    joystick_trace_header_t header = {
+        .magic = JOYSTICK_TRACE_MAGIC,
+        .version = JOYSTICK_TRACE_VERSION,
+        .header_size = sizeof(joystick_trace_header_t),
+        .rate_hz = TRACE_RATE_HZ,
+        .x_channel = JOYSTICK_X_ADC_CHANNEL,
+        .y_channel = JOYSTICK_Y_ADC_CHANNEL,
+        .button_pin = JOYSTICK_BUTTON_PIN,
+    };
+    joystickPi_calibration_get(&header.cal);
+
+    queue_head = queue_tail = 0;
+    ticks = dropped = 0;
+    gap = false;
+    write_raw(&header, sizeof(header));
+
+    // Período negativo: cada disparo é agendado a partir do anterior, sem acumular atraso
+    repeating_timer_t timer;
+    add_repeating_timer_us(-1000000ll / TRACE_RATE_HZ, sample_callback, NULL, &timer);
+
+    uint32_t total = TRACE_RATE_HZ * TRACE_SECONDS;
+    uint32_t written = 0;
+    while (ticks < total || queue_tail != queue_head) {
+        if (ticks >= total) {
+            cancel_repeating_timer(&timer);
+        }
+        uint32_t tail = queue_tail;
+        if (tail == queue_head) {
+            tight_loop_contents();
+            continue;
+        }
+        __dmb(); // Lê o registro só depois de ver o índice que o publicou
+        joystick_trace_record_t record = queue[tail & (TRACE_QUEUE_SIZE - 1)];
+        queue_tail = tail + 1;
+        write_raw(&record, sizeof(record));
+        written++;
+    }
+    cancel_repeating_timer(&timer);
+
+    joystick_trace_footer_t footer = {
+        .magic = JOYSTICK_TRACE_END_MAGIC,
+        .samples = written,
+        .dropped = dropped,
+    };
+    write_raw(&footer, sizeof(footer));
+    stdio_flush();
+
+    printf("\nTrace gravado: %lu amostras, %lu perdidas\n", (unsigned long)written, (unsigned long)dropped);
+}
+
+int main() {
+    stdio_init_all();
+    joystickPi_init();
+
+    // Aguarda o terminal abrir a porta para não perder o início do trace
+    while (!stdio_usb_connected()) {
+        sleep_ms(100);
+    }
+    sleep_ms(500);
+
+    // A calibração vai no cabeçalho para o replay normalizar como a placa
+    if (!joystickPi_calibration_load()) {
+        printf("Sem calibração salva: mantenha o joystick em repouso\n");
+        joystickPi_calibrate_center(200);
+    }
+
+    while (true) {
+        printf("Gravando %u s a %u Hz\n", TRACE_SECONDS, TRACE_RATE_HZ);
+        record_trace();
+
+        // Nova gravação a cada toque no botão
+        printf("Pressione o botão para gravar outro trace\n");
+        while (!joystickPi_read_button()) {
+            sleep_ms(10);
+        }
+        while (joystickPi_read_button()) {
+            sleep_ms(10);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,973 @@
+#ifndef JOYSTICK_PI_H
+#define JOYSTICK_PI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/flash.h"
+#include "inc/joystick_curve.h"
+
+/******************************
+ * Documentação do Arquivo
+ ******************************/
+
+/**
+ * @file JoystickPi.h
+ * @brief Biblioteca para leitura de um joystick analógico no Raspberry Pi Pico
+ * 
+ * Esta biblioteca fornece funcionalidades para ler os valores de um joystick analógico conectado
+ * ao Raspberry Pi Pico. O joystick possui dois eixos (X e Y) e um botão. Os eixos são lidos
+ * através de conversores analógico-digitais (ADC), e o botão é lido como uma entrada digital.
+ * 
+ * Funcionalidades:
+ * 1. Inicialização dos pinos ADC e GPIO para leitura do joystick.
+ * 2. Leitura dos valores dos eixos X e Y (valores brutos do ADC).
+ * 3. Leitura do estado do botão (pressionado ou não pressionado).
+ * 4. Mapeamento dos valores do ADC para uma faixa personalizada (útil para normalização).
+ * 5. Motor de amostragem em segundo plano (ADC round-robin + FIFO + DMA), que mantém os
+ *    eixos sempre atualizados sem bloquear quem chama `joystickPi_read`.
+ * 6. Sobreamostragem e decimação (CIC de ordem 1 ou 2) para 13 a 16 bits efetivos.
+ * 7. Calibração de centro, faixa e zona morta por eixo, persistida na flash, com
+ *    normalização em ponto fixo sem divisão por leitura.
+ * 8. Zona morta radial, anti-zona-morta e curva de resposta por tabela de ganho em Q14.
+ * 9. Filtro adaptativo One-Euro em ponto fixo, que suaviza em repouso sem atrasar movimentos rápidos.
+ * 10. Instâncias `JoystickPi_t` com pinos, inversão e troca de eixos próprios; o motor amostra todos
+ *     os joysticks registrados (e canais extras) numa única passada do round-robin.
+ * 11. Fluxo de amostras de taxa fixa com instante de conversão, estatísticas de tempo e de perdas.
+ * 12. Compensação de temperatura (sensor interno) e de alimentação (canal de referência), com a
+ *     deriva térmica ajustada a partir dos centros medidos em repouso.
+ *
+ * As funções `joystickPi_*` sem instância operam sobre um joystick padrão nos pinos da BitDogLab.
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+/**
+ * @brief Pino ADC para leitura do eixo X do joystick padrão.
+ */
+#define JOYSTICK_X_PIN 27 // Pino ADC1 (GP27) na BitDogLab
+
+/**
+ * @brief Pino ADC para leitura do eixo Y do joystick padrão.
+ */
+#define JOYSTICK_Y_PIN 26 // Pino ADC0 (GP26) na BitDogLab
+
+/**
+ * @brief Pino GPIO para leitura do botão do joystick padrão.
+ */
+#define JOYSTICK_BUTTON_PIN 22 // Pino GPIO para o botão
+
+/**
+ * @brief Primeiro pino com entrada analógica: o canal do ADC é `pino - JOYSTICK_ADC_FIRST_PIN`.
+ */
+#define JOYSTICK_ADC_FIRST_PIN 26
+
+/**
+ * @brief Canais do ADC: ADC0 a ADC3 (GP26 a GP29) e ADC4 (sensor de temperatura interno).
+ */
+#define JOYSTICK_ADC_CHANNELS 5
+
+/**
+ * @brief Canais ADC dos eixos do joystick padrão, derivados dos pinos.
+ */
+#define JOYSTICK_X_ADC_CHANNEL (JOYSTICK_X_PIN - JOYSTICK_ADC_FIRST_PIN)
+#define JOYSTICK_Y_ADC_CHANNEL (JOYSTICK_Y_PIN - JOYSTICK_ADC_FIRST_PIN)
+
+/**
+ * @brief Valor de `button_pin` para joysticks sem botão.
+ */
+#define JOYSTICK_NO_BUTTON 0xFFu
+
+/**
+ * @brief Quantidade máxima de joysticks registrados no motor de amostragem.
+ */
+#define JOYSTICK_MAX_INSTANCES 2
+
+/******************************
+ * Motor de Amostragem (DMA)
+ ******************************/
+
+/**
+ * @brief Maior taxa total de conversões do ADC (96 ciclos de clk_adc a 48 MHz), somados todos os canais.
+ */
+#define JOYSTICK_ENGINE_ADC_MAX_SPS 500000
+
+/**
+ * @brief Capacidade do buffer circular preenchido pelo DMA, em amostras de 16 bits.
+ *
+ * Cada passada do DMA usa o maior múltiplo do número de canais que cabe aqui, de modo
+ * que cada posição do buffer pertence sempre ao mesmo canal do round-robin. O tamanho cobre
+ * 2,5 ms na taxa total máxima do ADC (JOYSTICK_ENGINE_ADC_MAX_SPS).
+ */
+#define JOYSTICK_ENGINE_RING_SAMPLES 1280
+
+/**
+ * @brief Faixa aceita para a taxa de amostragem por eixo (Hz).
+ */
+#define JOYSTICK_ENGINE_MIN_RATE_HZ 1000
+#define JOYSTICK_ENGINE_MAX_RATE_HZ 100000
+
+/**
+ * @brief Quantidade de pares mais recentes promediados por `joystickPi_read` com o motor ativo.
+ */
+#define JOYSTICK_ENGINE_READ_AVERAGE 4
+
+/**
+ * @brief IRQ de DMA usada pelo motor (compartilhada com outras bibliotecas).
+ */
+#define JOYSTICK_ENGINE_DMA_IRQ DMA_IRQ_1
+
+/**
+ * @brief Taxa (Hz) do temporizador que consome o buffer e roda a decimação e o filtro.
+ * 
+ * O buffer cobre pelo menos 2,5 ms com qualquer taxa aceita (a taxa total de conversões é limitada a
+ * JOYSTICK_ENGINE_ADC_MAX_SPS), então o temporizador nunca fica uma volta atrás.
+ */
+#define JOYSTICK_ENGINE_PROCESS_HZ 1000
+
+/**
+ * @brief Maior fator de decimação aceito por `joystickPi_engine_set_decimation`.
+ * 
+ * Cada fator de 4 acrescenta cerca de 1 bit efetivo: 4x ≈ 13 bits, 16x ≈ 14, 64x ≈ 15, 256x ≈ 16.
+ */
+#define JOYSTICK_DECIMATION_MAX_FACTOR 256
+
+/******************************
+ * Fluxo de Amostras
+ ******************************/
+
+/**
+ * @brief Capacidade da fila do fluxo de amostras (potência de 2).
+ *
+ * A 1 kHz, o programa pode ficar 64 ms sem ler antes de o fluxo começar a descartar amostras.
+ */
+#define JOYSTICK_STREAM_QUEUE_SIZE 64
+
+/******************************
+ * Filtro Adaptativo (One-Euro)
+ ******************************/
+
+/**
+ * @brief Faixas de velocidade da tabela de coeficientes do filtro.
+ */
+#define JOYSTICK_FILTER_LUT_SIZE 256
+
+/**
+ * @brief Largura de cada faixa de velocidade: 2^SHIFT unidades de 16 bits por passo.
+ * 
+ * Com 256 faixas de 8 unidades a 1 kHz, a tabela cobre até ~31 cursos completos por segundo;
+ * acima disso usa o coeficiente da última faixa.
+ */
+#define JOYSTICK_FILTER_SPEED_SHIFT 3
+
+/**
+ * @brief Parâmetros padrão (ver `joystick_filter_params_t`), ajustados para o joystick da BitDogLab.
+ */
+#define JOYSTICK_FILTER_DEFAULT_MIN_CUTOFF_HZ 1.0f
+#define JOYSTICK_FILTER_DEFAULT_BETA 5.0f
+#define JOYSTICK_FILTER_DEFAULT_D_CUTOFF_HZ 1.0f
+
+/******************************
+ * Calibração
+ ******************************/
+
+/**
+ * @brief Valor máximo (em módulo) dos eixos normalizados `x_norm`/`y_norm`.
+ */
+#define JOYSTICK_NORM_MAX 32767
+
+/**
+ * @brief Setor da flash reservado para a calibração (último setor do chip).
+ * 
+ * Cada joystick grava seu registro numa página do setor, na ordem em que foi inicializado.
+ */
+#define JOYSTICK_CAL_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+
+/**
+ * @brief Assinatura e versão do registro de calibração gravado na flash.
+ */
+#define JOYSTICK_CAL_MAGIC 0x4C41434Au // "JCAL"
+#define JOYSTICK_CAL_VERSION 2
+
+/**
+ * @brief Margem somada à zona morta medida em repouso (escala de 16 bits).
+ */
+#define JOYSTICK_CAL_DEADZONE_MARGIN (8 << 4)
+
+/**
+ * @brief Leituras consecutivas em repouso para a calibração automática atualizar o centro (potência de 2).
+ */
+#define JOYSTICK_CAL_IDLE_READS 256
+
+/**
+ * @brief Maior deslocamento de centro aceito pela calibração automática (escala de 16 bits).
+ * 
+ * Evita que o joystick segurado parado fora do centro seja aprendido como repouso.
+ */
+#define JOYSTICK_CAL_MAX_DRIFT (200 << 4)
+
+/******************************
+ * Compensação de Temperatura e Alimentação
+ ******************************/
+
+/**
+ * @brief Canal do ADC ligado ao sensor de temperatura interno.
+ */
+#define JOYSTICK_COMP_TEMP_CHANNEL 4
+
+/**
+ * @brief Valor de `ref_channel` para compensar só a temperatura.
+ *
+ * É o caso da BitDogLab: os potenciômetros e a referência do ADC vêm do mesmo 3V3, então a
+ * leitura já é ratiométrica e uma variação da alimentação não a desloca.
+ */
+#define JOYSTICK_COMP_NO_REF 0xFFu
+
+/**
+ * @brief Constante de tempo do passa-baixas dos sensores: 2^SHIFT passos do processamento (ou leituras).
+ *
+ * O sensor de temperatura tem ruído de alguns LSB; 128 ms o reduzem sem atrasar uma deriva térmica.
+ */
+#define JOYSTICK_COMP_FILTER_SHIFT 7
+
+/**
+ * @brief Menor faixa de temperatura (escala de 16 bits) entre os pontos de repouso para ajustar a deriva.
+ *
+ * O sensor varia cerca de -34 unidades de 16 bits por °C, então 100 equivalem a ~3 °C.
+ */
+#define JOYSTICK_COMP_MIN_SPAN 100
+
+/**
+ * @brief Pontos de repouso acumulados no ajuste antes de os mais antigos perderem metade do peso.
+ */
+#define JOYSTICK_COMP_MAX_POINTS 1024
+
+/******************************
+ * Curva de Resposta
+ ******************************/
+
+/**
+ * @brief Bits de fração usados na interpolação entre duas entradas da tabela de ganho.
+ */
+#define JOYSTICK_CURVE_INTERP_BITS 8
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Estrutura para armazenar os valores do joystick.
+ * 
+ * Contém os valores dos eixos X e Y (lidos do ADC) e o estado do botão.
+ */
+typedef struct {
+    uint16_t x;      // Valor do eixo X (0-4095)
+    uint16_t y;      // Valor do eixo Y (0-4095)
+    bool button;     // Estado do botão (true = pressionado, false = não pressionado)
+    uint16_t x_hires; // Eixo X em escala de 16 bits (0-65535), com os bits extras da decimação
+    uint16_t y_hires; // Eixo Y em escala de 16 bits (0-65535), com os bits extras da decimação
+    int16_t x_norm;   // Eixo X normalizado pela calibração (-JOYSTICK_NORM_MAX a JOYSTICK_NORM_MAX)
+    int16_t y_norm;   // Eixo Y normalizado pela calibração (-JOYSTICK_NORM_MAX a JOYSTICK_NORM_MAX)
+} joystick_state_t;
+
+/**
+ * @brief Calibração do joystick, na escala de 16 bits de `x_hires`/`y_hires`.
+ */
+typedef struct {
+    uint16_t center_x;  // Posição de repouso do eixo X
+    uint16_t center_y;  // Posição de repouso do eixo Y
+    uint16_t min_x;     // Menor leitura do eixo X
+    uint16_t min_y;     // Menor leitura do eixo Y
+    uint16_t max_x;     // Maior leitura do eixo X
+    uint16_t max_y;     // Maior leitura do eixo Y
+    uint16_t deadzone;  // Distância ao centro tratada como repouso
+} joystick_calibration_t;
+
+/**
+ * @brief Coeficientes da compensação de um joystick, gravados na flash junto com a calibração.
+ *
+ * Cada eixo (escala de 16 bits, já com troca e inversão) é corrigido por
+ * `v * supply_ref / ref - temp_slope * (temp - temp_ref)`, ou seja, levado de volta às
+ * condições de `temp_ref`/`supply_ref`, em que a calibração foi feita.
+ */
+typedef struct {
+    uint16_t temp_ref;      // Leitura do sensor de temperatura na calibração do centro (0 = ainda não capturada)
+    uint16_t supply_ref;    // Leitura do canal de referência no mesmo instante (0 = sem correção ratiométrica)
+    int32_t temp_slope_x;   // Deriva do centro X por unidade do sensor de temperatura (Q16)
+    int32_t temp_slope_y;   // Deriva do centro Y por unidade do sensor de temperatura (Q16)
+} joystick_comp_t;
+
+/**
+ * @brief Parâmetros do filtro adaptativo One-Euro.
+ * 
+ * O corte é `min_cutoff_hz + beta * velocidade`, com a velocidade em cursos completos por
+ * segundo. Para ajustar: com o joystick parado, reduza `min_cutoff_hz` até o tremor sumir;
+ * depois, com movimentos rápidos, aumente `beta` até o atraso deixar de ser perceptível.
+ */
+typedef struct {
+    float min_cutoff_hz;  // Corte em repouso: menor suaviza mais, mas atrasa movimentos lentos
+    float beta;           // Quanto o corte sobe com a velocidade (Hz por curso completo/s)
+    float d_cutoff_hz;    // Corte do passa-baixas da derivada usada para estimar a velocidade
+} joystick_filter_params_t;
+
+/**
+ * @brief Coeficientes do filtro adaptativo pré-calculados para uma taxa de amostragem.
+ */
+typedef struct {
+    uint16_t alpha[JOYSTICK_FILTER_LUT_SIZE];  // Coeficiente (Q16) por faixa de velocidade
+    uint16_t alpha_d;                          // Coeficiente (Q16) do filtro da derivada
+} joystick_euro_t;
+
+/**
+ * @brief Estado do filtro adaptativo de um eixo.
+ */
+typedef struct {
+    int32_t value;  // Valor filtrado em Q8 (escala de 16 bits)
+    int32_t slope;  // Derivada filtrada em Q8 por passo
+    bool primed;    // Já recebeu a primeira amostra
+} joystick_euro_axis_t;
+
+/**
+ * @brief Estágio CIC (integrador-pente) de um eixo, usado na sobreamostragem (uso interno).
+ * 
+ * Os integradores rodam na taxa do ADC e os pentes na taxa de saída. Com ordem 1 o
+ * estágio equivale a um boxcar (soma de M amostras). A aritmética é modular em 32 bits,
+ * o que o CIC tolera porque o ganho máximo (4095 * 256^2) cabe em 32 bits.
+ */
+typedef struct {
+    uint32_t integ[2];
+    uint32_t comb[2];
+} joystick_cic_t;
+
+/**
+ * @brief Calibração de um eixo pré-processada para a normalização sem divisão (uso interno).
+ */
+typedef struct {
+    int32_t center;
+    int32_t dead;
+    int32_t span_pos;   // Curso útil acima do centro, descontada a zona morta
+    int32_t span_neg;   // Curso útil abaixo do centro, descontada a zona morta
+    int32_t scale_pos;  // JOYSTICK_NORM_MAX / span_pos em Q15
+    int32_t scale_neg;  // JOYSTICK_NORM_MAX / span_neg em Q15
+} joystick_axis_cal_t;
+
+/**
+ * @brief Regressão linear do centro em repouso contra a temperatura (uso interno).
+ */
+typedef struct {
+    int32_t t0, x0, y0;     // Primeiro ponto, subtraído dos demais para manter as somas pequenas
+    int64_t st, stt, sx, sy, stx, sty;
+    uint32_t n;
+    int32_t t_min, t_max;   // Faixa de temperatura coberta (relativa a t0)
+} joystick_comp_fit_t;
+
+/**
+ * @brief Pinos e orientação de um joystick.
+ */
+typedef struct {
+    uint x_pin;       // Pino analógico do eixo X (GP26 a GP29)
+    uint y_pin;       // Pino analógico do eixo Y (GP26 a GP29)
+    uint button_pin;  // Pino do botão (pull-up), ou JOYSTICK_NO_BUTTON
+    bool invert_x;    // Inverte o eixo X (aplicado depois da troca)
+    bool invert_y;    // Inverte o eixo Y (aplicado depois da troca)
+    bool swap_xy;     // Troca os eixos, para joysticks montados girados em 90°
+} JoystickPi_config_t;
+
+/**
+ * @brief Instância de um joystick: pinos, canais do ADC, orientação, calibração e estado
+ * do processamento no motor de amostragem.
+ * 
+ * Deve permanecer válida enquanto estiver registrada (a partir de `JoystickPi_init`), pois o
+ * motor guarda um ponteiro para ela.
+ */
+typedef struct {
+    uint x_pin;
+    uint y_pin;
+    uint button_pin;
+    uint x_channel;             // Canal ADC do eixo X (x_pin - JOYSTICK_ADC_FIRST_PIN)
+    uint y_channel;             // Canal ADC do eixo Y
+    bool invert_x;
+    bool invert_y;
+    bool swap_xy;
+
+    // Calibração
+    joystick_calibration_t calibration;
+    joystick_axis_cal_t cal_x;
+    joystick_axis_cal_t cal_y;
+    bool cal_ready;             // Alguma calibração já foi aplicada
+    bool cal_auto;              // Calibração automática ligada
+    bool cal_range_capture;     // Rotina guiada de faixa em andamento
+    uint cal_slot;              // Página do setor de calibração usada por esta instância
+    struct {
+        uint16_t ref_x, ref_y;
+        uint32_t sum_x, sum_y;
+        uint count;
+    } cal_idle;                 // Janela de repouso da calibração automática
+    const joystick_curve_t *shape_curve; // Curva de resposta (NULL = desligada)
+
+    // Compensação
+    joystick_comp_t comp;
+    joystick_comp_fit_t comp_fit;
+
+    // Processamento no motor
+    bool registered;
+    uint x_slot;                // Posição do eixo X dentro de cada grupo do round-robin
+    uint y_slot;                // Posição do eixo Y dentro de cada grupo do round-robin
+    joystick_cic_t cic_x;
+    joystick_cic_t cic_y;
+    uint32_t decim_xy;          // Última saída decimada: X nos 16 bits baixos, Y nos altos
+    joystick_euro_axis_t euro_x;
+    joystick_euro_axis_t euro_y;
+    volatile uint32_t hires_xy; // Saída publicada (decimada e/ou filtrada), no mesmo formato de decim_xy
+    volatile bool hires_valid;  // hires_xy contém uma saída do processamento
+} JoystickPi_t;
+
+/**
+ * @brief Estatísticas do motor de amostragem em segundo plano.
+ */
+typedef struct {
+    uint32_t requested_rate_hz;  // Taxa por eixo pedida em `joystickPi_engine_start`
+    float achieved_rate_hz;      // Taxa por eixo resultante do divisor do ADC
+    float measured_rate_hz;      // Taxa por eixo medida pelas transferências do DMA
+    uint64_t samples;            // Conversões gravadas no buffer desde o início
+    uint32_t overruns;           // Vezes em que a FIFO do ADC transbordou (seguido de ressincronização)
+    uint decimation_factor;      // Fator de decimação em uso (1 = desligado)
+    uint decimation_order;       // Ordem do CIC em uso
+    float output_rate_hz;        // Taxa das saídas decimadas por eixo
+    uint32_t decimated;          // Saídas decimadas produzidas desde a última configuração
+} joystick_engine_stats_t;
+
+/**
+ * @brief Amostra do fluxo de taxa fixa, com o instante da conversão.
+ */
+typedef struct {
+    uint64_t t_us;     // Instante (relógio de `time_us_64`) em que terminou a última conversão da amostra
+    int16_t x;         // Eixo X normalizado e com a curva de resposta (como `x_norm`)
+    int16_t y;         // Eixo Y normalizado e com a curva de resposta (como `y_norm`)
+    uint16_t x_hires;  // Eixo X em 16 bits, com troca e inversão, antes da calibração
+    uint16_t y_hires;  // Eixo Y em 16 bits, com troca e inversão, antes da calibração
+    bool button;       // Botão no passo do processamento que produziu a amostra
+} joystick_sample_t;
+
+/**
+ * @brief Estatísticas do fluxo de amostras desde o início ou o último `joystickPi_stream_reset_stats`.
+ *
+ * Os tempos são medidos com `time_us_64` no temporizador de processamento. O intervalo entre os
+ * instantes de amostras consecutivas vale o período por construção; a variação de
+ * `clock_error_max_us - clock_error_min_us` é o que mostra a regularidade medida.
+ */
+typedef struct {
+    float rate_hz;                 // Taxa efetiva: taxa do ADC por eixo / groups_per_sample
+    uint32_t groups_per_sample;    // Passadas do round-robin promediadas em cada amostra
+    uint32_t delivered;            // Amostras colocadas na fila
+    uint32_t dropped;              // Amostras perdidas: fila cheia ou lacuna após transbordamento do ADC
+    int32_t clock_error_min_us;    // Menor (time_us_64 no processamento - instante da amostra mais nova)
+    int32_t clock_error_max_us;    // Maior (idem); deve ficar entre 0 e cerca de dois períodos do ADC
+    uint32_t tick_jitter_us;       // Maior desvio do período do temporizador de processamento
+} joystick_stream_stats_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Preenche a configuração do joystick da BitDogLab (X em GP27, Y em GP26, botão em GP22).
+ * 
+ * @param config Configuração a ser preenchida.
+ */
+void JoystickPi_config_default(JoystickPi_config_t *config);
+
+/**
+ * @brief Inicializa um joystick e o registra no motor de amostragem.
+ * 
+ * Configura os pinos analógicos e o botão e aplica a calibração nominal. Se o motor já estiver
+ * rodando, ele é reiniciado na mesma taxa para incluir os canais do novo joystick.
+ * 
+ * @param js Instância a ser inicializada.
+ * @param config Pinos e orientação.
+ * @return false se algum pino não é analógico ou se já há JOYSTICK_MAX_INSTANCES registrados.
+ */
+bool JoystickPi_init(JoystickPi_t *js, const JoystickPi_config_t *config);
+
+/**
+ * @brief Lê os valores atuais de um joystick (ver `joystickPi_read`).
+ * 
+ * @param js Instância inicializada.
+ * @return Estado dos eixos, já com troca e inversão aplicadas, e do botão.
+ */
+joystick_state_t JoystickPi_read(JoystickPi_t *js);
+
+/**
+ * @brief Lê o eixo X de um joystick (0-4095), com troca e inversão aplicadas.
+ */
+uint16_t JoystickPi_read_x(JoystickPi_t *js);
+
+/**
+ * @brief Lê o eixo Y de um joystick (0-4095), com troca e inversão aplicadas.
+ */
+uint16_t JoystickPi_read_y(JoystickPi_t *js);
+
+/**
+ * @brief Lê o botão de um joystick.
+ * 
+ * @return true se pressionado; false também para joysticks sem botão.
+ */
+bool JoystickPi_read_button(JoystickPi_t *js);
+
+/**
+ * @brief Normaliza um estado cujos eixos de 16 bits vieram de fora de `JoystickPi_read`.
+ *
+ * Aplica a calibração e a curva de resposta do joystick a `x_hires`/`y_hires` e preenche
+ * `x_norm`/`y_norm`. Útil para filtrar os eixos antes da normalização, como faz o motor.
+ *
+ * @param js Instância inicializada.
+ * @param state Estado com `x_hires`/`y_hires` preenchidos.
+ */
+void JoystickPi_normalize(JoystickPi_t *js, joystick_state_t *state);
+
+/**
+ * @brief Copia os pares brutos mais recentes de um joystick (ver `joystickPi_engine_snapshot`).
+ */
+uint JoystickPi_engine_snapshot(JoystickPi_t *js, uint16_t *x, uint16_t *y, uint count);
+
+/**
+ * @brief Aplica uma calibração a um joystick (ver `joystickPi_calibration_set`).
+ */
+void JoystickPi_calibration_set(JoystickPi_t *js, const joystick_calibration_t *cal);
+
+/**
+ * @brief Obtém a calibração em uso por um joystick.
+ */
+void JoystickPi_calibration_get(JoystickPi_t *js, joystick_calibration_t *cal);
+
+/**
+ * @brief Carrega a calibração de um joystick da sua página na flash.
+ * 
+ * @return true se havia um registro válido.
+ */
+bool JoystickPi_calibration_load(JoystickPi_t *js);
+
+/**
+ * @brief Grava a calibração de um joystick na sua página da flash, preservando as demais.
+ */
+void JoystickPi_calibration_save(JoystickPi_t *js);
+
+/**
+ * @brief Calibra o centro e a zona morta de um joystick em repouso (ver `joystickPi_calibrate_center`).
+ */
+void JoystickPi_calibrate_center(JoystickPi_t *js, uint reads);
+
+/**
+ * @brief Inicia a rotina guiada de faixa de um joystick.
+ */
+void JoystickPi_calibration_begin_range(JoystickPi_t *js);
+
+/**
+ * @brief Encerra a rotina guiada de faixa de um joystick.
+ */
+void JoystickPi_calibration_end_range(JoystickPi_t *js);
+
+/**
+ * @brief Liga ou desliga a calibração automática de um joystick.
+ */
+void JoystickPi_calibration_set_auto(JoystickPi_t *js, bool enabled);
+
+/**
+ * @brief Define a curva de resposta de um joystick, ou NULL para desligar.
+ */
+void JoystickPi_shape_set_curve(JoystickPi_t *js, const joystick_curve_t *curve);
+
+/**
+ * @brief Aplica coeficientes de compensação a um joystick (ex: ajustados numa câmara térmica).
+ */
+void JoystickPi_compensation_set(JoystickPi_t *js, const joystick_comp_t *comp);
+
+/**
+ * @brief Obtém os coeficientes de compensação em uso por um joystick.
+ */
+void JoystickPi_compensation_get(JoystickPi_t *js, joystick_comp_t *comp);
+
+/**
+ * @brief Descarta os pontos de repouso acumulados no ajuste da deriva (os coeficientes são mantidos).
+ */
+void JoystickPi_compensation_reset_fit(JoystickPi_t *js);
+
+/**
+ * @brief Acrescenta um canal do ADC (ex: outro sensor analógico) ao round-robin do motor.
+ * 
+ * O canal passa a ser convertido na mesma passada dos joysticks e é lido com
+ * `joystickPi_engine_read_channel`, sem selecionar entradas. Para o canal 4 (temperatura),
+ * habilite antes o sensor com `adc_set_temp_sensor_enabled`.
+ * 
+ * @param channel Canal do ADC (0 a JOYSTICK_ADC_CHANNELS - 1).
+ * @return false se o canal é inválido.
+ */
+bool joystickPi_engine_add_channel(uint channel);
+
+/**
+ * @brief Lê um canal do ADC.
+ * 
+ * Com o motor ativo, devolve a média das últimas `JOYSTICK_ENGINE_READ_AVERAGE` conversões
+ * do canal no buffer; com o motor parado, faz uma conversão bloqueante.
+ * 
+ * @param channel Canal do ADC.
+ * @return Valor de 12 bits, ou 0 se o motor está ativo e o canal não faz parte do round-robin.
+ */
+uint16_t joystickPi_engine_read_channel(uint channel);
+
+/**
+ * @brief Inicializa o joystick padrão.
+ * 
+ * Configura os pinos ADC para leitura dos eixos X e Y e o pino GPIO para leitura do botão.
+ */
+void joystickPi_init();
+
+/**
+ * @brief Lê os valores atuais do joystick.
+ * 
+ * Com o motor de amostragem ativo, devolve em tempo constante e sem acessar o ADC a última
+ * saída decimada e/ou filtrada ou, com ambos desligados, a média dos últimos
+ * `JOYSTICK_ENGINE_READ_AVERAGE` pares capturados pelo DMA. Caso contrário, faz duas conversões bloqueantes.
+ * 
+ * @return Estrutura `joystick_state_t` contendo os valores dos eixos X e Y e o estado do botão.
+ */
+joystick_state_t joystickPi_read();
+
+/**
+ * @brief Lê o valor do eixo X do joystick.
+ * 
+ * @return Valor do eixo X (0-4095).
+ */
+uint16_t joystickPi_read_x();
+
+/**
+ * @brief Lê o valor do eixo Y do joystick.
+ * 
+ * @return Valor do eixo Y (0-4095).
+ */
+uint16_t joystickPi_read_y();
+
+/**
+ * @brief Lê o estado do botão do joystick.
+ * 
+ * @return true se o botão estiver pressionado, false caso contrário.
+ */
+bool joystickPi_read_button();
+
+/**
+ * @brief Mapeia um valor de uma faixa de entrada para uma faixa de saída.
+ * 
+ * Útil para normalizar os valores do ADC para uma faixa desejada (ex: -100 a 100).
+ * O produto intermediário é calculado em 64 bits, então faixas de saída largas não transbordam.
+ * 
+ * @param value Valor a ser mapeado.
+ * @param min_input Valor mínimo da faixa de entrada.
+ * @param max_input Valor máximo da faixa de entrada.
+ * @param min_output Valor mínimo da faixa de saída.
+ * @param max_output Valor máximo da faixa de saída.
+ * @return Valor mapeado para a faixa de saída.
+ */
+int16_t joystickPi_map_value(uint16_t value, uint16_t min_input, uint16_t max_input, int16_t min_output, int16_t max_output);
+
+/**
+ * @brief Inicia a amostragem contínua dos eixos X e Y em segundo plano.
+ * 
+ * O ADC roda livre em round-robin entre os canais de todos os joysticks registrados e dos
+ * canais extras, a FIFO é drenada por um canal de DMA para um buffer circular e um segundo
+ * canal de DMA rearma o primeiro a cada passada, sem intervenção da CPU. Deve ser chamada
+ * após `joystickPi_init` ou `JoystickPi_init`.
+ * 
+ * @param rate_hz Taxa de amostragem por eixo (JOYSTICK_ENGINE_MIN_RATE_HZ a JOYSTICK_ENGINE_MAX_RATE_HZ);
+ *                `rate_hz` vezes o número de canais do round-robin não pode passar de JOYSTICK_ENGINE_ADC_MAX_SPS.
+ * @return true se o motor foi iniciado, false se a taxa é inválida ou não há canais de DMA livres.
+ */
+bool joystickPi_engine_start(uint32_t rate_hz);
+
+/**
+ * @brief Para o motor de amostragem e devolve o ADC ao modo de conversão avulsa.
+ */
+void joystickPi_engine_stop();
+
+/**
+ * @brief Indica se o motor de amostragem está ativo.
+ * 
+ * @return true se o motor estiver rodando.
+ */
+bool joystickPi_engine_running();
+
+/**
+ * @brief Obtém as estatísticas do motor de amostragem.
+ * 
+ * @param stats Estrutura preenchida com as taxas, o total de amostras e os transbordamentos.
+ */
+void joystickPi_engine_get_stats(joystick_engine_stats_t *stats);
+
+/**
+ * @brief Configura o estágio de sobreamostragem e decimação do motor.
+ * 
+ * A decimação roda no temporizador de processamento (JOYSTICK_ENGINE_PROCESS_HZ) sobre os
+ * pares chegados desde o último passo. Pode ser chamada com o motor parado ou ativo.
+ * 
+ * @param factor Fator de decimação: 1 desliga; potências de 2 de 4 a JOYSTICK_DECIMATION_MAX_FACTOR.
+ * @param order Ordem do CIC: 1 (boxcar) ou 2.
+ * @return true se a configuração foi aceita.
+ */
+bool joystickPi_engine_set_decimation(uint factor, uint order);
+
+/**
+ * @brief Copia os pares brutos mais recentes do buffer do DMA, do mais antigo ao mais novo.
+ * 
+ * Útil para medir o ruído do ADC antes da filtragem.
+ * 
+ * @param x Destino das amostras do eixo X.
+ * @param y Destino das amostras do eixo Y.
+ * @param count Quantidade de pares desejada.
+ * @return Quantidade de pares copiados (no máximo uma metade do buffer).
+ */
+uint joystickPi_engine_snapshot(uint16_t *x, uint16_t *y, uint count);
+
+/**
+ * @brief Preenche uma calibração com os valores nominais (centro 2048, faixa completa do ADC).
+ * 
+ * @param cal Calibração a ser preenchida.
+ */
+void joystickPi_calibration_defaults(joystick_calibration_t *cal);
+
+/**
+ * @brief Aplica uma calibração e pré-calcula os fatores de escala em ponto fixo.
+ * 
+ * @param cal Calibração a ser aplicada.
+ */
+void joystickPi_calibration_set(const joystick_calibration_t *cal);
+
+/**
+ * @brief Obtém a calibração em uso.
+ * 
+ * @param cal Estrutura que recebe a calibração.
+ */
+void joystickPi_calibration_get(joystick_calibration_t *cal);
+
+/**
+ * @brief Carrega e aplica a calibração gravada na flash.
+ * 
+ * @return true se havia um registro válido (assinatura e checksum corretos); false mantém a calibração atual.
+ */
+bool joystickPi_calibration_load();
+
+/**
+ * @brief Grava a calibração em uso no setor reservado da flash.
+ * 
+ * Apaga e programa o setor com as interrupções desativadas; leva algumas dezenas de ms.
+ */
+void joystickPi_calibration_save();
+
+/**
+ * @brief Calibra o centro e a zona morta com o joystick em repouso.
+ * 
+ * Faz `reads` leituras espaçadas de 1 ms; o centro é a média e a zona morta é o dobro do
+ * maior desvio observado mais `JOYSTICK_CAL_DEADZONE_MARGIN`.
+ * 
+ * @param reads Quantidade de leituras (ex: 200); com 0 a calibração não é alterada.
+ */
+void joystickPi_calibrate_center(uint reads);
+
+/**
+ * @brief Inicia a rotina guiada de faixa: a partir daqui cada leitura amplia min/max.
+ * 
+ * O usuário deve girar o joystick até os batentes em todas as direções e depois chamar
+ * `joystickPi_calibration_end_range`.
+ */
+void joystickPi_calibration_begin_range();
+
+/**
+ * @brief Encerra a rotina guiada de faixa e aplica os limites aprendidos.
+ */
+void joystickPi_calibration_end_range();
+
+/**
+ * @brief Liga ou desliga a calibração automática.
+ * 
+ * Ligada, cada leitura amplia min/max quando ultrapassados e, após
+ * `JOYSTICK_CAL_IDLE_READS` leituras em repouso, ajusta o centro.
+ * 
+ * @param enabled true para ligar.
+ */
+void joystickPi_calibration_set_auto(bool enabled);
+
+/**
+ * @brief Define a curva de resposta aplicada a `x_norm`/`y_norm` em `joystickPi_read`.
+ * 
+ * A curva (ex: `&joystick_curve_expo`, gerada por `Joystick/host/gen_curve_lut.py`) contém
+ * a zona morta radial, a anti-zona-morta e a resposta. Com NULL, os eixos saem apenas normalizados.
+ * 
+ * @param curve Curva de resposta, ou NULL para desligar.
+ */
+void joystickPi_shape_set_curve(const joystick_curve_t *curve);
+
+/**
+ * @brief Aplica uma curva de resposta a um par normalizado.
+ * 
+ * Calcula x² + y², zera o par dentro da zona morta radial e, fora dela, interpola o ganho
+ * radial na tabela e multiplica os dois eixos por ele, preservando a direção do vetor.
+ * Usa apenas multiplicações inteiras e deslocamentos.
+ * 
+ * @param curve Curva de resposta.
+ * @param x Eixo X normalizado (entrada e saída).
+ * @param y Eixo Y normalizado (entrada e saída).
+ */
+void joystickPi_shape(const joystick_curve_t *curve, int16_t *x, int16_t *y);
+
+/**
+ * @brief Preenche os parâmetros padrão do filtro adaptativo.
+ * 
+ * @param params Parâmetros a serem preenchidos.
+ */
+void joystickPi_filter_defaults(joystick_filter_params_t *params);
+
+/**
+ * @brief Pré-calcula os coeficientes do filtro adaptativo para uma taxa de amostragem.
+ * 
+ * Única etapa com ponto flutuante; `joystickPi_euro_step` usa só inteiros e a tabela.
+ * 
+ * @param euro Coeficientes a serem calculados.
+ * @param params Parâmetros do filtro.
+ * @param rate_hz Taxa com que `joystickPi_euro_step` será chamado.
+ */
+void joystickPi_euro_init(joystick_euro_t *euro, const joystick_filter_params_t *params, uint32_t rate_hz);
+
+/**
+ * @brief Filtra uma amostra de um eixo.
+ * 
+ * @param euro Coeficientes do filtro.
+ * @param axis Estado do eixo (zerado antes da primeira amostra).
+ * @param value Amostra na escala de 16 bits.
+ * @return Amostra filtrada na escala de 16 bits.
+ */
+uint16_t joystickPi_euro_step(const joystick_euro_t *euro, joystick_euro_axis_t *axis, uint16_t value);
+
+/**
+ * @brief Liga, reconfigura ou desliga o filtro adaptativo do motor de amostragem.
+ * 
+ * O filtro roda a JOYSTICK_ENGINE_PROCESS_HZ sobre a saída decimada ou, sem decimação, sobre
+ * a média dos pares de cada passo, e seu resultado passa a ser devolvido por `joystickPi_read`.
+ * 
+ * @param params Parâmetros do filtro, ou NULL para desligar.
+ */
+void joystickPi_engine_set_filter(const joystick_filter_params_t *params);
+
+/**
+ * @brief Liga a compensação de temperatura e, opcionalmente, de alimentação.
+ *
+ * O sensor de temperatura (canal 4) e o canal de referência entram no round-robin do motor,
+ * na mesma passada dos eixos, e passam por um passa-baixas a cada passo do processamento (com
+ * o motor parado, cada leitura também converte os sensores). A correção é aplicada em ponto
+ * fixo em todas as leituras (`joystickPi_read`, `_read_x`/`_read_y` e o fluxo), antes da
+ * calibração, então os limiares sobre `x_norm`/`y_norm` deixam de andar com a temperatura.
+ *
+ * A deriva térmica é ajustada sozinha por mínimos quadrados a partir dos centros medidos em
+ * repouso (`joystickPi_calibrate_center` e as janelas da calibração automática), assim que
+ * eles cobrem JOYSTICK_COMP_MIN_SPAN de temperatura.
+ *
+ * @param ref_channel Canal (0 a 3) ligado à alimentação dos potenciômetros por um divisor, para
+ *                    a correção ratiométrica, ou JOYSTICK_COMP_NO_REF.
+ * @return false se o canal de referência é inválido.
+ */
+bool joystickPi_compensation_enable(uint ref_channel);
+
+/**
+ * @brief Desliga a compensação (os canais continuam no round-robin até o próximo `engine_start`).
+ */
+void joystickPi_compensation_disable();
+
+/**
+ * @brief Lê os sensores da compensação já filtrados, na escala de 16 bits.
+ *
+ * @param temp Leitura do sensor de temperatura.
+ * @param ref Leitura do canal de referência (0 sem canal de referência).
+ * @return false se a compensação está desligada ou ainda não há leituras.
+ */
+bool joystickPi_compensation_sensors(uint16_t *temp, uint16_t *ref);
+
+/**
+ * @brief Converte uma leitura do sensor de temperatura para °C (27 - (V - 0,706) / 0,001721).
+ *
+ * @param temp Leitura do sensor, na escala de 16 bits.
+ * @return Temperatura em °C.
+ */
+float joystickPi_temperature_c(uint16_t temp);
+
+/**
+ * @brief Aplica coeficientes de compensação ao joystick padrão.
+ */
+void joystickPi_compensation_set(const joystick_comp_t *comp);
+
+/**
+ * @brief Obtém os coeficientes de compensação do joystick padrão.
+ */
+void joystickPi_compensation_get(joystick_comp_t *comp);
+
+/**
+ * @brief Inicia o fluxo de amostras de taxa fixa do joystick padrão (ver `JoystickPi_stream_start`).
+ */
+bool joystickPi_stream_start(uint32_t rate_hz);
+
+/**
+ * @brief Inicia o fluxo de amostras de taxa fixa de um joystick.
+ *
+ * Cada amostra é a média de um bloco de passadas consecutivas do round-robin (um número
+ * inteiro delas, escolhido para chegar mais perto de `rate_hz`), passada pelo filtro adaptativo
+ * quando ele está ligado. Como o ADC é cadenciado pelo próprio divisor de clock, o instante de
+ * cada amostra é calculado pela posição do bloco desde o início da conversão, sem depender de
+ * quando a CPU a processou. O fluxo é único: iniciá-lo de novo troca o joystick ou a taxa.
+ * Deve ser chamada com o motor ativo; é reconfigurado sozinho se o motor for reiniciado.
+ *
+ * @param js Joystick registrado.
+ * @param rate_hz Taxa desejada, de 1 Hz até a taxa do motor por eixo.
+ * @return false se o motor está parado, o joystick não está registrado ou a taxa é inválida.
+ */
+bool JoystickPi_stream_start(JoystickPi_t *js, uint32_t rate_hz);
+
+/**
+ * @brief Encerra o fluxo de amostras e descarta as que estão na fila.
+ */
+void joystickPi_stream_stop();
+
+/**
+ * @brief Retira a amostra mais antiga da fila do fluxo, sem bloquear.
+ *
+ * A calibração e a curva de resposta são aplicadas aqui, fora da interrupção.
+ *
+ * @param sample Amostra retirada.
+ * @return false se a fila está vazia.
+ */
+bool joystickPi_stream_read(joystick_sample_t *sample);
+
+/**
+ * @brief Aguarda a próxima amostra do fluxo.
+ *
+ * Substitui o laço com `sleep_ms`: o programa passa a rodar na cadência do ADC.
+ *
+ * @param sample Amostra retirada.
+ * @return false se o fluxo ou o motor foram encerrados.
+ */
+bool joystickPi_stream_wait(joystick_sample_t *sample);
+
+/**
+ * @brief Obtém as estatísticas de tempo e de perdas do fluxo.
+ *
+ * @param stats Estrutura preenchida.
+ */
+void joystickPi_stream_get_stats(joystick_stream_stats_t *stats);
+
+/**
+ * @brief Zera os contadores e os extremos das estatísticas do fluxo.
+ */
+void joystickPi_stream_reset_stats();
+
+#endif // JOYSTICK_PI_H
@@ -0,0 +1,42 @@
+#ifndef JOYSTICK_CURVE_H
+#define JOYSTICK_CURVE_H
+
+#include <stdint.h>
+
+/**
+ * @file joystick_curve.h
+ * @brief Tabelas de curva de resposta da JoystickPi (gerado por Joystick/host/gen_curve_lut.py).
+ * 
+ * Cada curva tem o limiar da zona morta radial (raio ao quadrado em Q30) e
+ * JOYSTICK_CURVE_LUT_SIZE + 1 ganhos radiais em Q14, indexados pelo raio ao quadrado do
+ * vetor normalizado (0 a 2). Não edite à mão: rode o gerador novamente.
+ */
+
+#define JOYSTICK_CURVE_LUT_BITS 8
+#define JOYSTICK_CURVE_LUT_SIZE (1 << JOYSTICK_CURVE_LUT_BITS)
+#define JOYSTICK_CURVE_GAIN_FRAC_BITS 14
+
+/**
+ * @brief Curva de resposta radial.
+ */
+typedef struct {
+    uint32_t deadzone_r2;                        // Raio ao quadrado (Q30) abaixo do qual a saída é zero
+    uint16_t gain[JOYSTICK_CURVE_LUT_SIZE + 1];  // Ganho radial em Q14
+} joystick_curve_t;
+
+/**
+ * @brief Curva linear: zona morta 0.10, anti-zona-morta 0.00, curva linear.
+ */
+extern const joystick_curve_t joystick_curve_linear;
+
+/**
+ * @brief Curva expo: zona morta 0.10, anti-zona-morta 0.00, curva exponencial (expo = 3).
+ */
+extern const joystick_curve_t joystick_curve_expo;
+
+/**
+ * @brief Curva precise: zona morta 0.06, anti-zona-morta 0.12, curva exponencial (expo = 1.5).
+ */
+extern const joystick_curve_t joystick_curve_precise;
+
+#endif // JOYSTICK_CURVE_H
@@ -2,6 +2,179 @@
 #include "pico/stdlib.h"        // Biblioteca específica do Raspberry Pi Pico
 #include "inc/MatrizRGBPI.h"    // Biblioteca personalizada para controle da matriz RGB
 
+// Quadros enviados em cada medição de tempo
+#define TIMING_FRAMES 200
+
+// Pontilhado temporal: taxa pedida e brilho baixo da rampa de teste
+#define DITHER_HZ 1000
+#define DITHER_BRIGHTNESS 16
+
+// Letreiro: tempo de cada coluna
+#define MARQUEE_COLUMN_MS 80
+
+// Cena animada: quadros por segundo e duração da demonstração
+#define ANIM_FPS 50
+#define ANIM_DEMO_MS 4000
+
+// Instante em que o último quadro terminou o RESET (preenchido pelo callback)
+static volatile uint64_t frame_done_us;
+
+// Callback de fim de quadro da matriz
+static void on_frame_done(void *user_data) {
+    (void)user_data;
+    frame_done_us = time_us_64();
+}
+
+// Mede o tempo de CPU por quadro do envio bloqueante e do envio por DMA
+void report_write_timing() {
+    for (uint i = 0; i < LED_COUNT; i++) {
+        MatrizRGBPI_SetLED(i, i, 2 * i, 3 * i); // Quadro qualquer, com todos os bytes diferentes
+    }
+
+    uint64_t blocking_us = 0, dma_us = 0, frame_us = 0, skip_us = 0;
+    for (uint i = 0; i < TIMING_FRAMES; i++) {
+        uint64_t start = time_us_64();
+        MatrizRGBPI_WriteBlocking();
+        blocking_us += time_us_64() - start;
+    }
+
+    MatrizRGBPI_SetWriteCallback(on_frame_done, NULL);
+    for (uint i = 0; i < TIMING_FRAMES; i++) {
+        MatrizRGBPI_WaitIdle(); // Fora da medição: só conta o tempo da chamada
+        MatrizRGBPI_SetLED(0, i & 1, 0, 0); // Quadros alternados, para nenhum ser ignorado
+        uint64_t start = time_us_64();
+        MatrizRGBPI_Write();
+        dma_us += time_us_64() - start;
+        MatrizRGBPI_WaitIdle();
+        frame_us += frame_done_us - start;
+    }
+    MatrizRGBPI_SetWriteCallback(NULL, NULL);
+
+    // Quadro igual ao que está nos LEDs: Present só compara e conta
+    for (uint i = 0; i < TIMING_FRAMES; i++) {
+        uint64_t start = time_us_64();
+        MatrizRGBPI_Present();
+        skip_us += time_us_64() - start;
+    }
+
+    printf("Tempo de CPU por quadro (%u quadros)\n", TIMING_FRAMES);
+    printf("Bloqueante : %.1f us\n", (double)blocking_us / TIMING_FRAMES);
+    printf("DMA        : %.1f us (quadro completo em %.1f us, com o RESET)\n", (double)dma_us / TIMING_FRAMES,
+           (double)frame_us / TIMING_FRAMES);
+    printf("Ignorado   : %.1f us (quadro igual ao anterior)\n", (double)skip_us / TIMING_FRAMES);
+
+    MatrizRGBPI_stats_t stats;
+    MatrizRGBPI_GetStats(&stats);
+    printf("Quadros enviados: %lu, ignorados: %lu\n", (unsigned long)stats.presented, (unsigned long)stats.skipped);
+    MatrizRGBPI_Clear();
+    MatrizRGBPI_Write();
+}
+
+// Rampa em brilho baixo com pontilhado temporal e custo de CPU de cada atualização
+void report_dither_timing() {
+    MatrizRGBPI_SetGamma(2.2f);
+    MatrizRGBPI_SetBrightness(DITHER_BRIGHTNESS); // Sem o pontilhado, só 17 níveis na saída
+    if (!MatrizRGBPI_SetDithering(true, DITHER_HZ)) {
+        printf("Pontilhado indisponível (sem DMA ou temporizador)\n");
+        return;
+    }
+
+    MatrizRGBPI_stats_t before, after;
+    MatrizRGBPI_GetStats(&before);
+    uint64_t start = time_us_64();
+    for (int step = 0; step < 512; step++) {
+        uint8_t v = step < 256 ? step : 511 - step;
+        for (uint i = 0; i < LED_COUNT; i++) {
+            MatrizRGBPI_SetLED(i, v, v, v);
+        }
+        MatrizRGBPI_Present();
+        sleep_ms(4);
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    MatrizRGBPI_GetStats(&after);
+    MatrizRGBPI_SetDithering(false, 0);
+
+    uint32_t refreshes = after.refreshes - before.refreshes;
+    double refresh_us = refreshes ? (double)(after.refresh_us - before.refresh_us) / refreshes : 0.0;
+    double line_us = (double)LED_COUNT * MATRIZ_PIXEL_BITS * 1e6 / MATRIZ_BIT_FREQ_HZ + MATRIZ_RESET_US;
+    printf("Pontilhado : %lu atualizações em %.2f s (%.0f Hz)\n", (unsigned long)refreshes, elapsed_us / 1e6,
+           refreshes * 1e6 / elapsed_us);
+    printf("CPU por atualização: %.1f us (%.1f%% da CPU); limite da linha: %.0f Hz\n", refresh_us,
+           refresh_us * refreshes * 100.0 / elapsed_us, 1e6 / line_us);
+
+    MatrizRGBPI_SetGamma(1.0f);
+    MatrizRGBPI_SetBrightness(255);
+    MatrizRGBPI_Clear();
+    MatrizRGBPI_Write();
+}
+
+// Passa um letreiro e conta as voltas que o laço principal dá enquanto ele roda
+void report_marquee() {
+    MatrizRGBPI_stats_t before, after;
+    MatrizRGBPI_GetStats(&before);
+    uint64_t start = time_us_64();
+    if (!MatrizRGBPI_MarqueeStart("Letreiro sem bloquear: 0123456789!", MARQUEE_COLUMN_MS, false, 20, 0, 20)) {
+        printf("Letreiro: sem temporizador livre\n");
+        return;
+    }
+    uint64_t start_us = time_us_64() - start;
+
+    uint32_t iterations = 0;
+    while (MatrizRGBPI_MarqueeRunning()) {
+        iterations++; // O laço segue livre enquanto o temporizador anda as colunas
+        tight_loop_contents();
+    }
+    uint64_t elapsed_us = time_us_64() - start;
+    MatrizRGBPI_GetStats(&after);
+
+    printf("Letreiro: %.1f s passando, MarqueeStart retornou em %llu us, %lu voltas do laço principal, "
+           "%lu quadros enviados\n", elapsed_us / 1e6, (unsigned long long)start_us, (unsigned long)iterations,
+           (unsigned long)(after.presented - before.presented));
+}
+
+// Anima uma cena em camadas pelo relógio de quadros e mostra o tempo de cada quadro
+void report_anim() {
+    static const uint8_t cross[3] = {0x2, 0x7, 0x2};
+    static const matriz_keyframe_t background[] = {
+        {0, 0, 0, 0, 0, 4}, {1000, 0, 0, 0, 4, 8}, {2000, 0, 0, 0, 0, 4},
+    };
+    static const matriz_keyframe_t ball[] = {
+        {0, 0, 0, 20, 0, 0}, {500, 3, 0, 20, 10, 0}, {1000, 3, 3, 0, 20, 0}, {1500, 0, 3, 0, 0, 20},
+        {2000, 0, 0, 20, 0, 0},
+    };
+    static const matriz_keyframe_t blink[] = {{0, 1, 1, 20, 20, 20}, {250, 1, 1, 0, 0, 0}, {500, 1, 1, 20, 20, 20}};
+
+    matriz_anim_t *anim = MatrizRGBPI_AnimLock();
+    matriz_anim_init(anim, MATRIZ_WIDTH, MATRIZ_HEIGHT);
+    uint32_t now = MatrizRGBPI_AnimNow();
+    matriz_anim_play(anim, matriz_anim_add(anim, NULL, MATRIZ_WIDTH, MATRIZ_HEIGHT, 0), background, 3,
+                     MATRIZ_EASE_LINEAR, true, now);
+    matriz_anim_play(anim, matriz_anim_add(anim, NULL, 2, 2, 1), ball, 5, MATRIZ_EASE_IN_OUT, true, now);
+    matriz_anim_play(anim, matriz_anim_add(anim, cross, 3, 3, 2), blink, 3, MATRIZ_EASE_STEP, true, now);
+    MatrizRGBPI_AnimUnlock();
+
+    MatrizRGBPI_stats_t stats;
+    if (!MatrizRGBPI_AnimStart(ANIM_FPS)) {
+        printf("Cena: sem temporizador livre\n");
+        return;
+    }
+    uint32_t iterations = 0;
+    uint64_t end = time_us_64() + ANIM_DEMO_MS * 1000ull;
+    while (time_us_64() < end) {
+        iterations++; // O laço segue livre: as trilhas andam no relógio de quadros
+        tight_loop_contents();
+    }
+    MatrizRGBPI_AnimStop();
+    MatrizRGBPI_GetStats(&stats);
+
+    printf("Cena: %lu quadros a %d Hz, %.1f us por quadro (máximo %lu us), %lu perdidos, %lu voltas do laço "
+           "principal\n", (unsigned long)stats.anim_frames, ANIM_FPS,
+           stats.anim_frames ? (double)stats.anim_frame_us / stats.anim_frames : 0.0,
+           (unsigned long)stats.anim_frame_max_us, (unsigned long)stats.anim_missed, (unsigned long)iterations);
+    MatrizRGBPI_Clear();
+    MatrizRGBPI_Write();
+}
+
 int main()
 {
     // Inicializa a comunicação serial (para possível debug)
@@ -10,6 +183,13 @@ int main()
     // Inicializa a matriz de LEDs RGB no pino definido por LED_PIN
     MatrizRGBPI_Init(LED_PIN);
 
+    // Dá tempo de abrir o monitor serial e mede o envio dos quadros
+    sleep_ms(2000);
+    report_write_timing();
+    report_dither_timing();
+    report_marquee();
+    report_anim();
+
     // Loop principal infinito
     while (true) {
         // Exibe a palavra "Led" com scroll:
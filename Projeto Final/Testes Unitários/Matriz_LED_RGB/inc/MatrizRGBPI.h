@@ -5,54 +5,412 @@
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
-
+#include "hardware/dma.h"
+#include "hardware/sync.h"
 
 // Biblioteca gerada pelo arquivo .pio durante compilação.
 #include "ws2818b.pio.h"
+#include "ws2812_parallel.pio.h"
+
+#include "inc/matriz_layout.h"
+#include "inc/font5x5.h"
+#include "inc/matriz_marquee.h"
+#include "inc/matriz_anim.h"
+#include "inc/matriz_parallel.h"
+
+/**
+ * @file MatrizRGBPI.h
+ * @brief Cabeçalho para controle de uma matriz de LEDs RGB 5x5 usando Raspberry Pi Pico.
+ * 
+ * Este arquivo define estruturas, constantes e funções para manipular uma matriz de LEDs WS2812B (NeoPixel).
+ * Inclui suporte para exibição de letras, strings, frames personalizados e efeitos de scroll.
+ *
+ * O tamanho da imagem (MATRIZ_WIDTH x MATRIZ_HEIGHT) e a montagem dos LEDs (MATRIZ_LAYOUT, ver
+ * `matriz_layout.h`) podem ser redefinidos na compilação. A posição de cada pixel na fita vem de
+ * uma tabela gerada na inicialização, usada por `getIndex` e `MatrizRGBPI_SetPixel`.
+ *
+ * Os textos usam a fonte 5x5 em bits de `font5x5.h`, indexada pelo código ASCII.
+ *
+ * Os pixels são desenhados em `leds`, em cores lineares. `MatrizRGBPI_Present` aplica numa passada
+ * a correção de cor (gama, balanço de branco e brilho, por tabelas de 256 entradas por canal) e
+ * gera o quadro no formato da linha (uma palavra GRB por LED); quando o envio anterior termina,
+ * troca esse quadro com o da frente, dispara o DMA para a FIFO do PIO e retorna. Um alarme marca
+ * o fim do quadro depois do sinal de RESET. Quadros iguais ao que já está nos LEDs não são
+ * reenviados.
+ *
+ * Com o pontilhado temporal (`MatrizRGBPI_SetDithering`), o quadro corrigido é guardado com 16 bits
+ * por canal e reenviado por DMA numa taxa alta; a fração de cada canal é acumulada entre os
+ * quadros, o que suaviza as transições em brilho baixo.
+ *
+ * O letreiro (`MatrizRGBPI_MarqueeStart`) roda sem bloquear: um temporizador anda uma coluna por
+ * período numa janela circular com as colunas visíveis (uma por pixel de largura, em bits) e envia
+ * o quadro por DMA. Enquanto ele roda, a imagem é dele: não desenhe nem chame Present/Write.
+ *
+ * Para animações, a biblioteca mantém uma cena (`matriz_anim.h`) com sprites em camadas e trilhas de
+ * quadros-chave. `MatrizRGBPI_AnimStart` liga o relógio de quadros, um temporizador que avança as
+ * trilhas, compõe a cena e envia o quadro; o jogo só agenda as trilhas (entre `MatrizRGBPI_AnimLock`
+ * e `MatrizRGBPI_AnimUnlock`) e segue tratando as entradas. Com o relógio ligado, a imagem também
+ * é da cena.
+ *
+ * A cadeia de LEDs pode ser dividida em MATRIZ_STRIPS fitas (até 8) ligadas em pinos consecutivos.
+ * Nesse caso, antes de cada envio o quadro é transposto em planos de bits (`matriz_parallel.h`) e
+ * uma única máquina PIO (`ws2812_parallel.pio.h`) envia todas as fitas ao mesmo tempo, então o
+ * quadro leva o tempo de uma fita, qualquer que seja o número de fitas.
+ */
+
+// --- DEFINIÇÕES DE HARDWARE ---
+#ifndef MATRIZ_WIDTH
+#define MATRIZ_WIDTH 5    // Pixels por linha da imagem
+#endif
+#ifndef MATRIZ_HEIGHT
+#define MATRIZ_HEIGHT 5   // Linhas da imagem
+#endif
+#ifndef MATRIZ_LAYOUT
+#define MATRIZ_LAYOUT MATRIZ_LAYOUT_BITDOGLAB  // Montagem carregada por MatrizRGBPI_Init (matriz_layout.h)
+#endif
+
+#define LED_COUNT (MATRIZ_WIDTH * MATRIZ_HEIGHT)  // Número total de LEDs
+#define LED_PIN 7      // Pino GPIO conectado à matriz
+
+// --- TEMPORIZAÇÃO DO WS2812B ---
+#define MATRIZ_BIT_FREQ_HZ 800000  // Taxa de bits do protocolo (1,25 us por bit)
+#define MATRIZ_RESET_US 100        // Linha em nível baixo que trava as cores (mínimo de 50 us no datasheet)
 
-// Definição do número de LEDs e pino.
-#define LED_COUNT 25
-#define LED_PIN 7
+// --- FORMATO DOS PIXELS ---
+#ifndef MATRIZ_LED_RGBW
+#define MATRIZ_LED_RGBW 0          // 1 para LEDs RGBW (32 bits por pixel)
+#endif
 
-// Definição de pixel GRB
-struct pixel_t {
-  uint8_t G, R, B; // Três valores de 8-bits compõem um pixel.
-};
-typedef struct pixel_t pixel_t;
-typedef pixel_t MatrizRGBPI_t; // Mudança de nome de "struct pixel_t" para "MatrizRGBPI_t" por clareza.
+#if MATRIZ_LED_RGBW
+#define MATRIZ_PIXEL_BITS 32
+#else
+#define MATRIZ_PIXEL_BITS 24
+#endif
 
-// Dictionary of letters (A-Z)
+// --- SAÍDA EM PARALELO ---
+#ifndef MATRIZ_STRIPS
+#define MATRIZ_STRIPS 1  // Fitas em pinos consecutivos a partir do pino de MatrizRGBPI_Init (1 a 8)
+#endif
+
+#define MATRIZ_STRIP_LEDS (LED_COUNT / MATRIZ_STRIPS)  // LEDs por fita: a fita s leva os LEDs s * MATRIZ_STRIP_LEDS em diante
+
+#if MATRIZ_STRIPS < 1 || MATRIZ_STRIPS > MATRIZ_PARALLEL_MAX_STRIPS || (LED_COUNT % MATRIZ_STRIPS) != 0
+#error "MATRIZ_STRIPS deve estar entre 1 e 8 e dividir LED_COUNT"
+#endif
+
+// Canais das tabelas de correção de cor.
+#define MATRIZ_CHANNEL_R 0
+#define MATRIZ_CHANNEL_G 1
+#define MATRIZ_CHANNEL_B 2
+#define MATRIZ_CHANNEL_W 3
+#define MATRIZ_CHANNELS (MATRIZ_LED_RGBW ? 4 : 3)
+
+/**
+ * @brief Empacota uma cor no formato enviado ao WS2812B: G nos bits 31-24, R em 23-16, B em 15-8
+ * e W (só nos LEDs RGBW) em 7-0. O PIO envia os MATRIZ_PIXEL_BITS bits de cima, do mais
+ * significativo ao menos.
+ */
+#define MATRIZ_PIXEL(r, g, b) (((uint32_t)(g) << 24) | ((uint32_t)(r) << 16) | ((uint32_t)(b) << 8))
+#define MATRIZ_PIXEL_RGBW(r, g, b, w) (MATRIZ_PIXEL(r, g, b) | (uint8_t)(w))
+
+// --- ESTRUTURAS DE DADOS ---
+/**
+ * @brief Estrutura de um pixel RGB (formato GRB para WS2812B).
+ */
 typedef struct {
-  char character;
-  int matrix[5][5][3];
-} Letter;
+    uint8_t G;  // Componente verde (0-255)
+    uint8_t R;  // Componente vermelho (0-255)
+    uint8_t B;  // Componente azul (0-255)
+} pixel_t;
 
+/**
+ * @brief Pixel no buffer da matriz, empacotado por MATRIZ_PIXEL (uma palavra por LED).
+ */
+typedef uint32_t MatrizRGBPI_t;
 
+/**
+ * @brief Callback chamado quando um quadro termina de ser enviado e travado nos LEDs.
+ * @param user_data Ponteiro registrado com o callback.
+ */
+typedef void (*MatrizRGBPI_callback_t)(void *user_data);
 
-// Declaração do buffer de pixels que formam a matriz.
-extern MatrizRGBPI_t leds[LED_COUNT];
+/**
+ * @brief Contadores de MatrizRGBPI_Present desde a inicialização.
+ */
+typedef struct {
+    uint32_t presented;  // Quadros enviados aos LEDs
+    uint32_t skipped;    // Quadros iguais ao anterior, não reenviados
+    uint32_t refreshes;  // Atualizações do pontilhado temporal
+    uint32_t refresh_us; // Tempo de CPU somado dessas atualizações, em microssegundos
+    uint32_t anim_frames;       // Quadros compostos pelo relógio da cena
+    uint32_t anim_frame_us;     // Tempo de CPU somado desses quadros, em microssegundos
+    uint32_t anim_frame_max_us; // Maior tempo de CPU de um quadro da cena
+    uint32_t anim_missed;       // Quadros da cena perdidos (relógio atrasado ou linha ocupada)
+} MatrizRGBPI_stats_t;
 
-// Variáveis para uso da máquina PIO.
-extern PIO matriz_pio;
-extern uint sm;
+// --- VARIÁVEIS GLOBAIS ---
+extern MatrizRGBPI_t leds[LED_COUNT];  // Buffer de pixels da matriz, em cores lineares
+extern PIO matriz_pio;                // Instância do PIO (PIO0 ou PIO1)
+extern uint sm;                       // Máquina de estado (state machine) do PIO
 
-//extern const Letter alphabet[];
+// --- PROTÓTIPOS DE FUNÇÕES ---
 
-// Protótipos das funções
+/**
+ * @brief Inicializa a matriz de LEDs.
+ * @param pin Pino GPIO conectado aos LEDs.
+ */
 void MatrizRGBPI_Init(uint pin);
+
+/**
+ * @brief Define a cor de um LED específico.
+ * @param index Índice do LED (0 a LED_COUNT-1).
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
 void MatrizRGBPI_SetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b);
+
+/**
+ * @brief Define a cor de um pixel da imagem, pela tabela da montagem (fora da imagem, ignora).
+ * @param x Coluna (0 à esquerda).
+ * @param y Linha (0 em cima).
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
+void MatrizRGBPI_SetPixel(const uint x, const uint y, const uint8_t r, const uint8_t g, const uint8_t b);
+
+/**
+ * @brief Lê a cor de um LED do buffer.
+ * @param index Índice do LED (0 a LED_COUNT-1).
+ * @return Componentes G, R e B do pixel.
+ */
+pixel_t MatrizRGBPI_GetLED(const uint index);
+
+/**
+ * @brief Limpa todos os LEDs (define cores como 0).
+ */
 void MatrizRGBPI_Clear();
+
+/**
+ * @brief Apresenta o buffer sem bloquear.
+ *
+ * Empacota os pixels com a correção de cor; se o quadro for igual ao que está nos LEDs, só conta
+ * um quadro ignorado. Senão espera o fim do quadro anterior, troca os quadros e dispara o DMA; o
+ * buffer pode ser alterado assim que a função retorna. Sem canal de DMA livre, envia pela CPU.
+ * @return true se o quadro foi enviado.
+ */
+bool MatrizRGBPI_Present();
+
+/**
+ * @brief Envia os dados do buffer para a matriz de LEDs sem bloquear (mesmo que `MatrizRGBPI_Present`).
+ */
 void MatrizRGBPI_Write();
-int  MatrizRGBPI_getIndex(int x, int y);
-//void MatrizRGBPI_displayLetter(const int letter[5][5][3]);
+
+/**
+ * @brief Envia os dados do buffer pela CPU, um pixel por vez, e espera o RESET; envia mesmo
+ * quadros iguais ao anterior.
+ */
+void MatrizRGBPI_WriteBlocking();
+
+/**
+ * @brief Indica se um quadro ainda está sendo enviado ou travado nos LEDs.
+ * @return true até o fim do RESET do último quadro enviado.
+ */
+bool MatrizRGBPI_Busy();
+
+/**
+ * @brief Espera o fim do quadro em andamento (não deve ser chamada em interrupções).
+ */
+void MatrizRGBPI_WaitIdle();
+
+/**
+ * @brief Registra o callback de fim de quadro, chamado no contexto do alarme.
+ * @param callback Função chamada (NULL para remover).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void MatrizRGBPI_SetWriteCallback(MatrizRGBPI_callback_t callback, void *user_data);
+
+/**
+ * @brief Define o brilho global, aplicado a todos os canais no envio (padrão 255).
+ * @param brightness Brilho de 0 (apagado) a 255 (cores sem atenuação).
+ */
+void MatrizRGBPI_SetBrightness(uint8_t brightness);
+
+/**
+ * @brief Define o expoente da curva de gama aplicada no envio (padrão 1.0, sem correção).
+ * @param gamma Expoente (2.2 a 2.8 aproximam a percepção do olho).
+ */
+void MatrizRGBPI_SetGamma(float gamma);
+
+/**
+ * @brief Define o ganho de cada canal no envio, para o branco sair neutro (padrão 255, 255, 255).
+ * @param r Ganho do vermelho (0-255).
+ * @param g Ganho do verde (0-255).
+ * @param b Ganho do azul (0-255).
+ */
+void MatrizRGBPI_SetWhiteBalance(uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Liga ou desliga o pontilhado temporal.
+ *
+ * Ligado, um temporizador reenvia o quadro por DMA a cada período, somando a fração (8 bits abaixo
+ * do valor enviado) de cada canal a um acumulador; a média no tempo reproduz a cor com 16 bits.
+ * `MatrizRGBPI_Present` passa a só trocar o quadro de 16 bits lido pelo temporizador, e o callback
+ * de fim de quadro é chamado a cada atualização.
+ * @param enable true para ligar.
+ * @param refresh_hz Taxa de atualização (limitada pela duração do quadro na linha, ~1,1 kHz).
+ * @return false se não há canal de DMA ou temporizador livre.
+ */
+bool MatrizRGBPI_SetDithering(bool enable, uint32_t refresh_hz);
+
+/**
+ * @brief Lê os contadores de quadros enviados e ignorados e das atualizações do pontilhado.
+ * @param stats Destino dos contadores.
+ */
+void MatrizRGBPI_GetStats(MatrizRGBPI_stats_t *stats);
+
+/**
+ * @brief Troca a montagem dos LEDs e regenera a tabela de coordenadas.
+ * @param layout Montagem; a imagem precisa ter MATRIZ_WIDTH x MATRIZ_HEIGHT pixels.
+ * @return false se a montagem é inválida ou de outro tamanho (a tabela anterior é mantida).
+ */
+bool MatrizRGBPI_SetLayout(const matriz_layout_t *layout);
+
+/**
+ * @brief Converte coordenadas (x, y) para índice linear, pela tabela da montagem.
+ * @param x Coordenada horizontal (0 a MATRIZ_WIDTH-1).
+ * @param y Coordenada vertical (0 a MATRIZ_HEIGHT-1).
+ * @return Índice linear correspondente (0 a LED_COUNT-1), ou -1 fora da imagem.
+ */
+int getIndex(int x, int y);
+
+/**
+ * @brief Exibe uma letra na matriz com cor personalizada.
+ *
+ * API bloqueante legada: espera 1 s com `sleep_ms`. Para não travar o laço principal, desenhe com
+ * `MatrizRGBPI_drawGlyph` e `MatrizRGBPI_Present`, ou use um sprite da cena animada.
+ * @param letter Matriz 5x5x3 representando a letra.
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
 void MatrizRGBPI_displayLetter(const int letter[5][5][3], uint8_t r, uint8_t g, uint8_t b);
-//void MatrizRGBPI_displayString(const char *str);
+
+/**
+ * @brief Desenha um caractere da fonte 5x5 no buffer, sem enviar; as partes fora da imagem são cortadas.
+ * @param glyph Linhas do desenho (ver `font5x5_glyph`), com a coluna 0 no bit 4.
+ * @param x Coluna do canto superior esquerdo (pode ser negativa).
+ * @param y Linha do canto superior esquerdo (pode ser negativa).
+ * @param r Componente vermelho dos pixels acesos (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
+void MatrizRGBPI_drawGlyph(const uint8_t *glyph, int x, int y, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Exibe uma string na matriz, caractere por caractere.
+ *
+ * API bloqueante legada: espera 1 s por caractere com `sleep_ms`. Use `MatrizRGBPI_MarqueeStart`
+ * para textos sem travar o laço principal.
+ * @param str String a ser exibida.
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
 void MatrizRGBPI_displayString(const char *str, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Exibe um frame personalizado (5x5) na matriz.
+ * @param frame Matriz 5x5x3 contendo as cores dos pixels.
+ */
 void MatrizRGBPI_displayFrame(const int frame[5][5][3]);
-//void MatrizRGBPI_scrollLetters(const Letter *currentLetter, const Letter *nextLetter, int delay_ms);
-void scrollLetters(const Letter *currentLetter, const Letter *nextLetter, int delay_ms, uint8_t r, uint8_t g, uint8_t b);
-//void MatrizRGBPI_displayStringWithScroll(const char *str, int delay_ms);
+
+/**
+ * @brief Gera animação de scroll entre duas letras.
+ *
+ * API bloqueante legada: espera `delay_ms` por coluna com `sleep_ms`. Use `MatrizRGBPI_MarqueeStart`.
+ * @param current Desenho da letra atual (fonte 5x5).
+ * @param next Desenho da próxima letra.
+ * @param delay_ms Tempo entre frames (ms).
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
+void scrollLetters(const uint8_t *current, const uint8_t *next, int delay_ms, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Exibe uma string com efeito de scroll.
+ *
+ * API bloqueante legada: só retorna depois do texto inteiro. `MatrizRGBPI_MarqueeStart` faz o mesmo
+ * efeito num temporizador, sem travar o laço principal.
+ * @param str String a ser exibida.
+ * @param delay_ms Tempo entre frames (ms).
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ */
 void MatrizRGBPI_displayStringWithScroll(const char *str, int delay_ms, uint8_t r, uint8_t g, uint8_t b);
 
-#endif // MATRIZ_RGB_PI_H
+/**
+ * @brief Inicia um letreiro que passa o texto da direita para a esquerda, sem bloquear.
+ *
+ * A cada `column_ms` um temporizador desloca a imagem uma coluna e envia o quadro por DMA. As letras
+ * têm largura variável e o texto entra e sai inteiro da matriz. Um letreiro em andamento é trocado.
+ * @param text Texto de qualquer tamanho; não é copiado, então precisa continuar válido até o fim.
+ * @param column_ms Tempo de cada coluna (ms).
+ * @param loop true para repetir o texto até `MatrizRGBPI_MarqueeStop`.
+ * @param r Componente vermelho (0-255).
+ * @param g Componente verde (0-255).
+ * @param b Componente azul (0-255).
+ * @return false se não há temporizador livre.
+ */
+bool MatrizRGBPI_MarqueeStart(const char *text, uint32_t column_ms, bool loop, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Para o letreiro; a imagem fica como estava no último quadro.
+ */
+void MatrizRGBPI_MarqueeStop();
+
+/**
+ * @brief Indica se o letreiro ainda está passando.
+ */
+bool MatrizRGBPI_MarqueeRunning();
+
+/**
+ * @brief Dá acesso exclusivo à cena: o relógio de quadros não roda até `MatrizRGBPI_AnimUnlock`.
+ *
+ * As interrupções ficam desligadas nesse intervalo, então use-o só para chamar as funções de
+ * `matriz_anim.h` (com `MatrizRGBPI_AnimNow` como instante atual).
+ * @return A cena, com MATRIZ_WIDTH x MATRIZ_HEIGHT pixels.
+ */
+matriz_anim_t *MatrizRGBPI_AnimLock();
+
+/**
+ * @brief Libera a cena travada por `MatrizRGBPI_AnimLock`.
+ */
+void MatrizRGBPI_AnimUnlock();
 
+/**
+ * @brief Instante atual no relógio das trilhas (ms desde o boot).
+ */
+uint32_t MatrizRGBPI_AnimNow();
+
+/**
+ * @brief Liga o relógio de quadros da cena. Um letreiro em andamento é parado.
+ * @param fps Quadros por segundo (limitado pela duração do quadro na linha).
+ * @return false se não há temporizador livre.
+ */
+bool MatrizRGBPI_AnimStart(uint32_t fps);
+
+/**
+ * @brief Desliga o relógio de quadros; a imagem fica como estava no último quadro.
+ */
+void MatrizRGBPI_AnimStop();
+
+/**
+ * @brief Indica se alguma trilha da cena ainda está em andamento.
+ */
+bool MatrizRGBPI_AnimPlaying();
+
+#endif // MATRIZ_RGB_PI_H
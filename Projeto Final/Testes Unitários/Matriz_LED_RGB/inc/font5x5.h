@@ -0,0 +1,45 @@
+#ifndef FONT5X5_H
+#define FONT5X5_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file font5x5.h
+ * @brief Fonte 5x5 da matriz de LEDs em bits (gerado por Matriz/host/gen_font.py a partir de src/alphabet.c).
+ * 
+ * Cada caractere ocupa FONT5X5_ROWS bytes, um por linha (de cima para baixo), com a coluna 0 no
+ * bit 4. A tabela é indexada pelo código ASCII, então achar o desenho de um caractere custa uma
+ * subtração e um teste de bit. Não edite à mão: altere src/alphabet.c e rode o gerador novamente.
+ */
+
+#define FONT5X5_FIRST 32  // Primeiro código ASCII da tabela
+#define FONT5X5_LAST 126  // Último código ASCII da tabela
+#define FONT5X5_COUNT (FONT5X5_LAST - FONT5X5_FIRST + 1)
+#define FONT5X5_ROWS 5
+#define FONT5X5_COLS 5
+
+/**
+ * @brief Desenho de cada caractere, a partir de FONT5X5_FIRST.
+ */
+extern const uint8_t font5x5[FONT5X5_COUNT][FONT5X5_ROWS];
+
+/**
+ * @brief Um bit por caractere da tabela: 1 se ele tem desenho.
+ */
+extern const uint32_t font5x5_defined[(FONT5X5_COUNT + 31) / 32];
+
+/**
+ * @brief Desenho de um caractere.
+ * @param c Caractere.
+ * @return As FONT5X5_ROWS linhas do desenho, ou NULL se o caractere não tem desenho.
+ */
+static inline const uint8_t *font5x5_glyph(char c) {
+    unsigned code = (unsigned)(uint8_t)c - FONT5X5_FIRST;
+    if (code >= FONT5X5_COUNT || !(font5x5_defined[code / 32] & (1u << (code % 32)))) {
+        return NULL;
+    }
+    return font5x5[code];
+}
+
+#endif // FONT5X5_H
@@ -0,0 +1,167 @@
+#ifndef MATRIZ_ANIM_H
+#define MATRIZ_ANIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * @file matriz_anim.h
+ * @brief Cena retida de uma matriz de LEDs: sprites em camadas com trilhas de quadros-chave.
+ *
+ * Um sprite é um desenho de até 8x8 pixels (um byte por linha, com a coluna 0 no bit `width - 1`,
+ * como na fonte 5x5) ou, sem desenho, um retângulo cheio de qualquer tamanho. Ele tem posição, cor e camada; as camadas
+ * mais altas são desenhadas por cima e, dentro da mesma camada, vale a ordem de criação. Os pixels
+ * apagados do desenho são transparentes.
+ *
+ * Uma trilha é uma lista de quadros-chave com instante, posição e cor. `matriz_anim_update` coloca
+ * cada sprite no ponto da trilha correspondente ao instante pedido, interpolando entre os quadros-chave
+ * com a curva escolhida. Sem repetição, o sprite fica no último quadro-chave quando a trilha termina.
+ *
+ * O módulo só calcula: quem chama decide o relógio e para onde vai o quadro (`matriz_anim_render`).
+ */
+
+/******************************
+ * Definições e Constantes
+ ******************************/
+
+#define MATRIZ_ANIM_MAX_SPRITES 16  // Sprites numa cena
+#define MATRIZ_ANIM_MAX_SIZE 8      // Maior largura e altura de um desenho (retângulos cheios não têm limite)
+
+/******************************
+ * Estruturas
+ ******************************/
+
+/**
+ * @brief Curva de interpolação entre dois quadros-chave.
+ */
+typedef enum {
+    MATRIZ_EASE_LINEAR,  // Velocidade constante
+    MATRIZ_EASE_STEP,    // Salta no quadro-chave seguinte
+    MATRIZ_EASE_IN_OUT,  // Acelera no início e freia no fim (smoothstep)
+} matriz_ease_t;
+
+/**
+ * @brief Estado de um sprite num instante da trilha.
+ */
+typedef struct {
+    uint32_t at_ms;  // Instante, contado do início da trilha (o primeiro costuma ser 0)
+    int16_t x;       // Coluna do canto superior esquerdo
+    int16_t y;       // Linha do canto superior esquerdo
+    uint8_t r;       // Cor
+    uint8_t g;
+    uint8_t b;
+} matriz_keyframe_t;
+
+/**
+ * @brief Sprite da cena.
+ */
+typedef struct {
+    const uint8_t *rows;            // Desenho, uma linha por byte (NULL: retângulo cheio)
+    uint8_t width;                  // Largura (com desenho, até MATRIZ_ANIM_MAX_SIZE)
+    uint8_t height;                 // Altura (com desenho, até MATRIZ_ANIM_MAX_SIZE)
+    uint8_t layer;                  // Camada (maior: por cima)
+    bool visible;                   // Desenhado em matriz_anim_render
+    int16_t x;                      // Posição atual
+    int16_t y;
+    uint8_t r;                      // Cor atual
+    uint8_t g;
+    uint8_t b;
+    const matriz_keyframe_t *keys;  // Trilha em andamento (NULL: parado)
+    uint8_t key_count;              // Quadros-chave da trilha
+    uint8_t key;                    // Quadro-chave do trecho atual
+    matriz_ease_t ease;             // Curva da trilha
+    bool loop;                      // Recomeça a trilha no fim
+    uint32_t start_ms;              // Instante em que a trilha começou
+} matriz_sprite_t;
+
+/**
+ * @brief Cena: os sprites e a cor de fundo de uma imagem de `width` x `height` pixels.
+ */
+typedef struct {
+    matriz_sprite_t sprites[MATRIZ_ANIM_MAX_SPRITES];
+    uint8_t count;          // Sprites criados
+    uint16_t width;         // Tamanho da imagem
+    uint16_t height;
+    uint8_t background[3];  // Cor do fundo (R, G, B)
+} matriz_anim_t;
+
+/******************************
+ * Funções
+ ******************************/
+
+/**
+ * @brief Esvazia a cena, com fundo apagado.
+ * @param anim Cena.
+ * @param width Largura da imagem.
+ * @param height Altura da imagem.
+ */
+void matriz_anim_init(matriz_anim_t *anim, uint16_t width, uint16_t height);
+
+/**
+ * @brief Cria um sprite visível, parado em (0, 0) e apagado.
+ * @param anim Cena.
+ * @param rows Desenho, uma linha por byte com a coluna 0 no bit `width - 1` (NULL: retângulo cheio).
+ *             Não é copiado.
+ * @param width Largura (com desenho, de 1 a MATRIZ_ANIM_MAX_SIZE).
+ * @param height Altura (com desenho, de 1 a MATRIZ_ANIM_MAX_SIZE).
+ * @param layer Camada.
+ * @return Identificador do sprite, ou -1 se a cena está cheia ou o tamanho é inválido.
+ */
+int matriz_anim_add(matriz_anim_t *anim, const uint8_t *rows, uint8_t width, uint8_t height, uint8_t layer);
+
+/**
+ * @brief Coloca um sprite numa posição e cor, parando a trilha dele.
+ * @param anim Cena.
+ * @param id Sprite.
+ * @param x Coluna do canto superior esquerdo (pode ficar fora da imagem).
+ * @param y Linha do canto superior esquerdo.
+ * @param r Componente vermelho.
+ * @param g Componente verde.
+ * @param b Componente azul.
+ */
+void matriz_anim_set(matriz_anim_t *anim, int id, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * @brief Mostra ou esconde um sprite.
+ * @param anim Cena.
+ * @param id Sprite.
+ * @param visible true para desenhar.
+ */
+void matriz_anim_show(matriz_anim_t *anim, int id, bool visible);
+
+/**
+ * @brief Começa uma trilha num sprite, a partir de `now_ms`.
+ * @param anim Cena.
+ * @param id Sprite.
+ * @param keys Quadros-chave em ordem crescente de instante. Não são copiados.
+ * @param count Número de quadros-chave (pelo menos 1).
+ * @param ease Curva entre os quadros-chave.
+ * @param loop true para recomeçar a trilha no fim.
+ * @param now_ms Instante atual, no relógio usado em `matriz_anim_update`.
+ * @return false se o sprite ou a trilha são inválidos.
+ */
+bool matriz_anim_play(matriz_anim_t *anim, int id, const matriz_keyframe_t *keys, uint8_t count, matriz_ease_t ease,
+                      bool loop, uint32_t now_ms);
+
+/**
+ * @brief Indica se algum sprite ainda tem trilha em andamento (trilhas repetidas nunca terminam).
+ * @param anim Cena.
+ */
+bool matriz_anim_playing(const matriz_anim_t *anim);
+
+/**
+ * @brief Avança as trilhas até `now_ms`, atualizando a posição e a cor dos sprites.
+ * @param anim Cena.
+ * @param now_ms Instante atual.
+ */
+void matriz_anim_update(matriz_anim_t *anim, uint32_t now_ms);
+
+/**
+ * @brief Compõe a cena: fundo e sprites visíveis, da camada mais baixa para a mais alta.
+ * @param anim Cena.
+ * @param frame Destino, `width * height` pixels linha a linha, cada um com R, G e B.
+ */
+void matriz_anim_render(const matriz_anim_t *anim, uint8_t (*frame)[3]);
+
+#endif // MATRIZ_ANIM_H
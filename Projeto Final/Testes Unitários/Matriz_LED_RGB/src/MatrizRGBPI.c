@@ -1,296 +1,886 @@
 #include "inc/MatrizRGBPI.h"
-#include <ctype.h>
+#include <math.h>
 #include <string.h>
-#include "inc/alphabet.h"
 
-// Definição do buffer de pixels que formam a matriz.
+// Buffer de pixels que formam a matriz de LEDs, em cores lineares (antes da correção).
 MatrizRGBPI_t leds[LED_COUNT];
 
-// Variáveis para uso da máquina PIO.
-PIO matriz_pio;
-uint sm;
+// Posição na fita de cada pixel da imagem (linha a linha), gerada a partir da montagem.
+static uint16_t matriz_index_lut[LED_COUNT];
 
+// Quadros corrigidos, no formato da linha: um está com o DMA e o outro recebe o próximo quadro.
+static MatrizRGBPI_t matriz_frames[2][LED_COUNT];
+static MatrizRGBPI_t *matriz_front = matriz_frames[0];  // O que está nos LEDs (ou sendo enviado)
+static MatrizRGBPI_t *matriz_next = matriz_frames[1];   // Empacotado por Present
+
+// O quadro da frente só vale depois do primeiro envio; até lá o estado dos LEDs é desconhecido.
+static bool matriz_front_valid = false;
+
+// Algum pixel ou a correção de cor mudou desde o último envio.
+static bool matriz_dirty = false;
+
+// Contadores de MatrizRGBPI_Present.
+static uint32_t matriz_presented = 0;
+static uint32_t matriz_skipped = 0;
+
+// Correção de cor: tabela por canal (R, G, B e W) com gama, balanço de branco e brilho, em 8.8
+// (a parte fracionária é usada pelo pontilhado temporal; sem ele, o valor é arredondado).
+static uint16_t matriz_lut[MATRIZ_CHANNELS][256];
+static float matriz_gamma = 1.0f;
+static uint8_t matriz_white_balance[MATRIZ_CHANNELS];
+static uint8_t matriz_brightness = 255;
+
+// Pontilhado temporal: quadro corrigido em 16 bits por canal, duplicado para que Present prepare um
+// enquanto a atualização periódica lê o outro, e o erro acumulado de cada canal de cada LED.
+static bool matriz_dither = false;
+static uint16_t matriz_frames16[2][LED_COUNT][MATRIZ_CHANNELS];
+static uint16_t (*volatile matriz_dither_src)[MATRIZ_CHANNELS] = matriz_frames16[0];
+static uint8_t matriz_dither_error[LED_COUNT][MATRIZ_CHANNELS];
+static repeating_timer_t matriz_dither_timer;
+
+// Atualizações do pontilhado e tempo de CPU gasto nelas.
+static volatile uint32_t matriz_refreshes = 0;
+static volatile uint32_t matriz_refresh_us = 0;
+
+// Folga do período do pontilhado sobre a duração do quadro, em microssegundos.
+#define MATRIZ_DITHER_SLACK_US 50
+
+// Letreiro: gerador de colunas, janela circular com as colunas visíveis (em bits, linha 0 no bit 0)
+// e a coluna mais à esquerda, cor e temporizador.
+static matriz_marquee_t matriz_marquee;
+static uint8_t matriz_marquee_window[MATRIZ_WIDTH];
+static uint matriz_marquee_head = 0;
+static uint8_t matriz_marquee_color[3];
+static repeating_timer_t matriz_marquee_timer;
+static volatile bool matriz_marquee_running = false;
+
+// Cena animada, quadro composto, relógio de quadros e prazo do próximo quadro.
+static matriz_anim_t matriz_anim;
+static uint8_t matriz_anim_frame[LED_COUNT][3];
+static repeating_timer_t matriz_anim_timer;
+static volatile bool matriz_anim_running = false;
+static uint32_t matriz_anim_lock_state;
+static uint64_t matriz_anim_deadline_us;
+static int64_t matriz_anim_period_us;
+
+// Contadores do relógio da cena.
+static volatile uint32_t matriz_anim_frames = 0;
+static volatile uint32_t matriz_anim_frame_us = 0;
+static volatile uint32_t matriz_anim_frame_max_us = 0;
+static volatile uint32_t matriz_anim_missed = 0;
+
+// Variáveis para controle da máquina PIO (Programmable I/O) do Raspberry Pi Pico.
+PIO matriz_pio;  // Instância do PIO (PIO0 ou PIO1)
+uint sm;         // Máquina de estado (state machine) do PIO
+
+#if MATRIZ_STRIPS > 1
+// Planos de bits das fitas em paralelo, transpostos do quadro da frente antes de cada envio.
+static uint32_t matriz_planes[MATRIZ_STRIP_LEDS * MATRIZ_PARALLEL_WORDS(MATRIZ_PIXEL_BITS / 8)];
+#endif
+
+// Canal de DMA que alimenta a FIFO do PIO (-1: sem canal livre, envio bloqueante).
+static int matriz_dma = -1;
+
+// Duração de um quadro na linha (bits a 800 kHz) mais o RESET, em microssegundos.
+static uint32_t matriz_frame_us;
+
+// Verdadeiro do disparo do DMA até o fim do RESET.
+static volatile bool matriz_busy = false;
+
+// Callback de fim de quadro.
+static MatrizRGBPI_callback_t write_callback = NULL;
+static void *write_user_data = NULL;
+
+/**
+ * Alarme de fim de quadro: os bits já saíram e o RESET já travou as cores.
+ */
+static int64_t matriz_latch_alarm(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    matriz_busy = false;
+    if (write_callback) {
+        write_callback(write_user_data);
+    }
+    return 0; // Não repete
+}
+
+/**
+ * Recalcula as tabelas de correção: a curva de gama (em 16 bits) escalada pelo balanço de branco
+ * do canal e pelo brilho global. Com os valores padrão a tabela é a identidade.
+ */
+static void matriz_build_lut() {
+    for (uint v = 0; v < 256; v++) {
+        uint64_t level = (uint64_t)(powf(v / 255.0f, matriz_gamma) * 65535.0f + 0.5f);
+        for (uint c = 0; c < MATRIZ_CHANNELS; c++) {
+            uint64_t scale = (uint64_t)matriz_white_balance[c] * matriz_brightness;
+            matriz_lut[c][v] = (uint16_t)((level * scale * 255 * 256 + 65535ull * 255 * 255 / 2) / (65535ull * 255 * 255));
+        }
+    }
+    matriz_dirty = true;
+}
+
+/**
+ * Aplica a correção de cor ao buffer `leds`, numa passada, gerando o quadro enviado aos LEDs.
+ * @param frame Quadro de destino.
+ */
+static void matriz_pack(MatrizRGBPI_t *frame) {
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        uint32_t p = leds[i];
+        uint32_t word = ((uint32_t)(matriz_lut[MATRIZ_CHANNEL_G][p >> 24] + 128) >> 8 << 24) |
+                        ((uint32_t)(matriz_lut[MATRIZ_CHANNEL_R][(p >> 16) & 0xFF] + 128) >> 8 << 16) |
+                        ((uint32_t)(matriz_lut[MATRIZ_CHANNEL_B][(p >> 8) & 0xFF] + 128) >> 8 << 8);
+#if MATRIZ_LED_RGBW
+        word |= (uint32_t)(matriz_lut[MATRIZ_CHANNEL_W][p & 0xFF] + 128) >> 8;
+#endif
+        frame[i] = word;
+    }
+}
+
+/**
+ * Aplica a correção de cor ao buffer `leds` guardando a parte fracionária (8.8 por canal).
+ * @param frame Quadro de 16 bits de destino.
+ */
+static void matriz_pack16(uint16_t (*frame)[MATRIZ_CHANNELS]) {
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        uint32_t p = leds[i];
+        frame[i][MATRIZ_CHANNEL_R] = matriz_lut[MATRIZ_CHANNEL_R][(p >> 16) & 0xFF];
+        frame[i][MATRIZ_CHANNEL_G] = matriz_lut[MATRIZ_CHANNEL_G][p >> 24];
+        frame[i][MATRIZ_CHANNEL_B] = matriz_lut[MATRIZ_CHANNEL_B][(p >> 8) & 0xFF];
+#if MATRIZ_LED_RGBW
+        frame[i][MATRIZ_CHANNEL_W] = matriz_lut[MATRIZ_CHANNEL_W][p & 0xFF];
+#endif
+    }
+}
+
+/**
+ * Troca os quadros: o recém-empacotado passa a ser o da frente.
+ */
+static void matriz_swap() {
+    MatrizRGBPI_t *frame = matriz_front;
+    matriz_front = matriz_next;
+    matriz_next = frame;
+    matriz_front_valid = true;
+}
+
+/**
+ * Palavras da FIFO para o quadro da frente: o próprio quadro com uma fita ou, com várias, os planos
+ * de bits transpostos.
+ * @param words Destino do número de palavras.
+ * @return Início das palavras.
+ */
+static const uint32_t *matriz_tx_front(uint *words) {
+#if MATRIZ_STRIPS > 1
+    matriz_parallel_transpose(matriz_front, MATRIZ_STRIP_LEDS, MATRIZ_STRIPS, MATRIZ_PIXEL_BITS / 8, matriz_planes);
+    *words = sizeof(matriz_planes) / sizeof(matriz_planes[0]);
+    return matriz_planes;
+#else
+    *words = LED_COUNT;
+    return matriz_front;
+#endif
+}
+
+/**
+ * Envia o quadro da frente pela CPU, uma palavra por vez, e espera o RESET.
+ */
+static void matriz_put_front() {
+    // Envia cada pixel empacotado (G, R, B), ou cada grupo de planos, para a máquina PIO.
+    uint words;
+    const uint32_t *tx = matriz_tx_front(&words);
+    for (uint i = 0; i < words; ++i) {
+        pio_sm_put_blocking(matriz_pio, sm, tx[i]);
+    }
+    sleep_us(MATRIZ_RESET_US); // Sinal de RESET conforme o datasheet do WS2812B.
+}
+
+/**
+ * Dispara o DMA do quadro da frente e agenda o fim do quadro (bits na linha mais o RESET).
+ */
+static void matriz_start_front() {
+    uint words;
+    const uint32_t *tx = matriz_tx_front(&words);
+    matriz_busy = true;
+    dma_channel_transfer_from_buffer_now(matriz_dma, tx, words);
+    if (add_alarm_in_us(matriz_frame_us, matriz_latch_alarm, NULL, true) < 0) {
+        // Sem alarmes livres: espera o quadro aqui mesmo.
+        busy_wait_us(matriz_frame_us);
+        matriz_latch_alarm(0, NULL);
+    }
+}
+
+/**
+ * Atualização periódica do pontilhado: cada canal soma o erro que sobrou do quadro anterior ao
+ * valor em 8.8 e envia a parte inteira; a fração volta para o acumulador. Ao longo dos quadros,
+ * a média do que sai nos LEDs é o valor de 16 bits.
+ */
+static bool matriz_dither_refresh(repeating_timer_t *timer) {
+    (void)timer;
+    if (matriz_busy) {
+        return true; // Quadro anterior ainda na linha: fica para a próxima atualização
+    }
+
+    uint32_t start = time_us_32();
+    uint16_t (*src)[MATRIZ_CHANNELS] = matriz_dither_src;
+    for (uint i = 0; i < LED_COUNT; ++i) {
+        uint32_t out[MATRIZ_CHANNELS];
+        for (uint c = 0; c < MATRIZ_CHANNELS; c++) {
+            uint32_t acc = src[i][c] + matriz_dither_error[i][c];
+            matriz_dither_error[i][c] = (uint8_t)acc;
+            out[c] = acc >> 8;
+        }
+        uint32_t word = (out[MATRIZ_CHANNEL_G] << 24) | (out[MATRIZ_CHANNEL_R] << 16) | (out[MATRIZ_CHANNEL_B] << 8);
+#if MATRIZ_LED_RGBW
+        word |= out[MATRIZ_CHANNEL_W];
+#endif
+        matriz_next[i] = word;
+    }
+    matriz_swap();
+    matriz_start_front();
+
+    matriz_refreshes++;
+    matriz_refresh_us += time_us_32() - start;
+    return true;
+}
 
 /**
  * Inicializa a máquina PIO para controle da matriz de LEDs.
+ * @param pin Pino GPIO conectado à matriz de LEDs.
  */
 void MatrizRGBPI_Init(uint pin) {
-  // Cria programa PIO.
-  uint offset = pio_add_program(pio0, &ws2818b_program);
-  matriz_pio = pio0;
+    // Adiciona o programa PIO para controle dos LEDs WS2812B (NeoPixel) ao PIO0: com várias fitas,
+    // o programa paralelo, que envia um bit de todas elas por vez.
+#if MATRIZ_STRIPS > 1
+    uint offset = pio_add_program(pio0, &ws2812_parallel_program);
+#else
+    uint offset = pio_add_program(pio0, &ws2818b_program);
+#endif
+    matriz_pio = pio0;
+
+    // Tenta obter uma máquina de estado livre no PIO0.
+    sm = pio_claim_unused_sm(matriz_pio, false);
+    if (sm < 0) {
+        // Se não houver máquinas livres no PIO0, tenta no PIO1.
+        matriz_pio = pio1;
+        sm = pio_claim_unused_sm(matriz_pio, true); // Força a obtenção de uma máquina.
+    }
 
-  // Toma posse de uma máquina PIO.
-  sm = pio_claim_unused_sm(matriz_pio, false);
-  if (sm < 0) {
-    matriz_pio = pio1;
-    sm = pio_claim_unused_sm(matriz_pio, true); // Se nenhuma máquina estiver livre, panic!
-  }
+#if MATRIZ_STRIPS > 1
+    // Fitas nos pinos pin a pin + MATRIZ_STRIPS - 1, com quatro planos de bits por palavra da FIFO.
+    ws2812_parallel_program_init(matriz_pio, sm, offset, pin, MATRIZ_STRIPS, (float)MATRIZ_BIT_FREQ_HZ);
+#else
+    // Inicializa o programa WS2812B na máquina de estado obtida, com um pixel por palavra da FIFO.
+    ws2818b_packed_program_init(matriz_pio, sm, offset, pin, (float)MATRIZ_BIT_FREQ_HZ, MATRIZ_LED_RGBW);
+#endif
 
-  // Inicia programa na máquina PIO obtida.
-  ws2818b_program_init(matriz_pio, sm, offset, pin, 800000.f);
+    // DMA de uma palavra (um pixel) por pedido da FIFO do PIO.
+    matriz_dma = dma_claim_unused_channel(false);
+    if (matriz_dma >= 0) {
+        dma_channel_config c = dma_channel_get_default_config(matriz_dma);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_read_increment(&c, true);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(matriz_pio, sm, true));
+        dma_channel_configure(matriz_dma, &c, &matriz_pio->txf[sm], matriz_front, LED_COUNT, false);
+    }
+
+    // O programa fica parado esperando dados, então o quadro leva exatamente MATRIZ_PIXEL_BITS por LED
+    // de uma fita (as fitas em paralelo saem juntas).
+    matriz_frame_us = (MATRIZ_STRIP_LEDS * MATRIZ_PIXEL_BITS * 1000000ull + MATRIZ_BIT_FREQ_HZ - 1) /
+                      MATRIZ_BIT_FREQ_HZ + MATRIZ_RESET_US;
+
+    // Tabela de coordenadas da montagem configurada; se ela não bater com o tamanho da imagem,
+    // os pixels seguem a ordem da fita.
+    static const matriz_layout_t layout = MATRIZ_LAYOUT;
+    if (!MatrizRGBPI_SetLayout(&layout)) {
+        for (uint i = 0; i < LED_COUNT; ++i) {
+            matriz_index_lut[i] = (uint16_t)i;
+        }
+    }
 
-  // Limpa buffer de pixels.
-  for (uint i = 0; i < LED_COUNT; ++i) {
-    leds[i].R = 0;
-    leds[i].G = 0;
-    leds[i].B = 0;
-  }
+    // Correção de cor neutra: cada caller escolhe gama e brilho.
+    for (uint c = 0; c < MATRIZ_CHANNELS; c++) {
+        matriz_white_balance[c] = 255;
+    }
+    matriz_build_lut();
+
+    // Cena vazia do tamanho da imagem.
+    matriz_anim_init(&matriz_anim, MATRIZ_WIDTH, MATRIZ_HEIGHT);
+
+    // Limpa o buffer de pixels, definindo todas as cores como 0 (apagado).
+    MatrizRGBPI_Clear();
+}
+
+/**
+ * Troca a montagem dos LEDs e regenera a tabela de coordenadas.
+ * @param layout Montagem com MATRIZ_WIDTH x MATRIZ_HEIGHT pixels.
+ * @return false se a montagem não serve (a tabela anterior é mantida).
+ */
+bool MatrizRGBPI_SetLayout(const matriz_layout_t *layout) {
+    if (matriz_layout_width(layout) != MATRIZ_WIDTH || matriz_layout_height(layout) != MATRIZ_HEIGHT) {
+        return false;
+    }
+    return matriz_layout_build(layout, matriz_index_lut, LED_COUNT);
 }
 
-// Mapeamento de coordenadas para a matriz de LEDs
+/**
+ * Mapeia coordenadas (x, y) para o índice linear do buffer de LEDs.
+ * @param x Coordenada horizontal (0 a MATRIZ_WIDTH-1).
+ * @param y Coordenada vertical (0 a MATRIZ_HEIGHT-1).
+ * @return Índice linear correspondente no buffer, ou -1 fora da imagem.
+ */
 int getIndex(int x, int y) {
-  if (y % 2 == 0) {
-      return 24 - (y * 5 + x); // Linha par (esquerda para direita)
-  } else {
-      return 24 - (y * 5 + (4 - x)); // Linha ímpar (direita para esquerda)
-  }
+    if ((uint)x >= MATRIZ_WIDTH || (uint)y >= MATRIZ_HEIGHT) {
+        return -1;
+    }
+    return matriz_index_lut[y * MATRIZ_WIDTH + x];
 }
 
 /**
- * Atribui uma cor RGB a um LED.
+ * Define a cor de um LED específico no buffer.
+ * @param index Índice do LED no buffer.
+ * @param r Componente vermelho (0 a 255).
+ * @param g Componente verde (0 a 255).
+ * @param b Componente azul (0 a 255).
  */
 void MatrizRGBPI_SetLED(const uint index, const uint8_t r, const uint8_t g, const uint8_t b) {
-  leds[index].R = r;
-  leds[index].G = g;
-  leds[index].B = b;
+    if (index >= LED_COUNT) {
+        return; // Índice fora da fita (por exemplo, getIndex fora da imagem)
+    }
+    leds[index] = MATRIZ_PIXEL(r, g, b);
+    matriz_dirty = true;
 }
 
 /**
- * Limpa o buffer de pixels.
+ * Define a cor de um pixel da imagem, pela tabela da montagem.
+ * @param x Coluna (0 à esquerda).
+ * @param y Linha (0 em cima).
+ * @param r Componente vermelho (0 a 255).
+ * @param g Componente verde (0 a 255).
+ * @param b Componente azul (0 a 255).
+ */
+void MatrizRGBPI_SetPixel(const uint x, const uint y, const uint8_t r, const uint8_t g, const uint8_t b) {
+    if (x < MATRIZ_WIDTH && y < MATRIZ_HEIGHT) {
+        MatrizRGBPI_SetLED(matriz_index_lut[y * MATRIZ_WIDTH + x], r, g, b);
+    }
+}
+
+/**
+ * Lê a cor de um LED do buffer.
+ * @param index Índice do LED no buffer.
+ * @return Componentes G, R e B do pixel.
+ */
+pixel_t MatrizRGBPI_GetLED(const uint index) {
+    uint32_t word = leds[index];
+    pixel_t pixel = {.G = (uint8_t)(word >> 24), .R = (uint8_t)(word >> 16), .B = (uint8_t)(word >> 8)};
+    return pixel;
+}
+
+/**
+ * Limpa o buffer de pixels, apagando todos os LEDs.
  */
 void MatrizRGBPI_Clear() {
-  for (uint i = 0; i < LED_COUNT; ++i)
-    MatrizRGBPI_SetLED(i, 0, 0, 0);
+    for (uint i = 0; i < LED_COUNT; ++i)
+        MatrizRGBPI_SetLED(i, 0, 0, 0);
+}
+
+/**
+ * Apresenta o buffer sem bloquear. Empacota os pixels com a correção de cor no quadro livre
+ * (enquanto o anterior ainda pode estar com o DMA); se o resultado for igual ao que está nos LEDs,
+ * não reenvia. Senão, depois do fim do quadro anterior, troca os quadros, dispara o DMA e agenda
+ * o fim do quadro (bits na linha mais o RESET) num alarme.
+ * @return true se o quadro foi enviado, false se era igual ao anterior.
+ */
+bool MatrizRGBPI_Present() {
+    // O flag evita o empacotamento quando nada mudou; a comparação pega quadros redesenhados iguais.
+    if ((matriz_front_valid || matriz_dither) && !matriz_dirty) {
+        matriz_skipped++;
+        return false;
+    }
+    matriz_dirty = false;
+
+    if (matriz_dither) {
+        // A atualização periódica só lê o quadro de 16 bits apontado; o outro é preparado aqui.
+        uint16_t (*frame)[MATRIZ_CHANNELS] =
+            matriz_dither_src == matriz_frames16[0] ? matriz_frames16[1] : matriz_frames16[0];
+        matriz_pack16(frame);
+        if (memcmp(frame, matriz_dither_src, sizeof(matriz_frames16[0])) == 0) {
+            matriz_skipped++;
+            return false;
+        }
+        matriz_dither_src = frame;
+        matriz_presented++;
+        return true;
+    }
+
+    matriz_pack(matriz_next);
+    if (matriz_front_valid && memcmp(matriz_next, matriz_front, sizeof(matriz_frames[0])) == 0) {
+        matriz_skipped++;
+        return false;
+    }
+
+    matriz_presented++;
+    if (matriz_dma < 0) {
+        matriz_swap();
+        matriz_put_front();
+        if (write_callback) {
+            write_callback(write_user_data);
+        }
+        return true;
+    }
+
+    // O DMA ainda lê o quadro da frente até o fim do anterior; o alarme só mexe em matriz_busy,
+    // então a troca dos ponteiros acontece aqui, com o DMA parado.
+    MatrizRGBPI_WaitIdle();
+    matriz_swap();
+    matriz_start_front();
+    return true;
 }
 
 /**
- * Escreve os dados do buffer nos LEDs.
+ * Envia os dados do buffer para a matriz de LEDs sem bloquear (equivale a MatrizRGBPI_Present).
  */
 void MatrizRGBPI_Write() {
-  // Escreve cada dado de 8-bits dos pixels em sequência no buffer da máquina PIO.
-  for (uint i = 0; i < LED_COUNT; ++i) {
-    pio_sm_put_blocking(matriz_pio, sm, leds[i].G);
-    pio_sm_put_blocking(matriz_pio, sm, leds[i].R);
-    pio_sm_put_blocking(matriz_pio, sm, leds[i].B);
-  }
-  sleep_us(100); // Espera 100us, sinal de RESET do datasheet.
-}
-
-/**
- * Exibe uma letra na matriz de LEDs.
- * @param letra Matriz de bits representando a letra.
- * @param corR Componente vermelho da cor.
- * @param corG Componente verde da cor.
- * @param corB Componente azul da cor.
- */
-
-
-/*
- void MatrizRGBPI_displayLetter(const int letter[5][5][3]) {
-      for (int row = 0; row < 5; row++) {
-          for (int col = 0; col < 5; col++) {
-              int position = getIndex(row, col);
-              MatrizRGBPI_SetLED(position, letter[col][row][0],  // Red
-                                letter[col][row][1],  // Green
-                                letter[col][row][2]); // Blue
-          }
-      }
-      MatrizRGBPI_Write();
-      sleep_ms(1000); // Display time for each letter (1 second)
-    }
-*/
+    MatrizRGBPI_Present();
+}
+
+/**
+ * Envia os dados do buffer para a matriz de LEDs pela CPU, um pixel por vez, mesmo que o quadro
+ * seja igual ao anterior. Com o pontilhado ativo, a linha é da atualização periódica e o quadro
+ * só é apresentado.
+ */
+void MatrizRGBPI_WriteBlocking() {
+    if (matriz_dither) {
+        MatrizRGBPI_Present();
+        return;
+    }
+    MatrizRGBPI_WaitIdle();
+    matriz_pack(matriz_next);
+    matriz_swap();
+    matriz_dirty = false;
+    matriz_presented++;
+    matriz_put_front();
+}
+
+/**
+ * Indica se um quadro ainda está sendo enviado ou travado nos LEDs.
+ */
+bool MatrizRGBPI_Busy() {
+    return matriz_busy;
+}
+
+/**
+ * Espera o fim do quadro em andamento.
+ */
+void MatrizRGBPI_WaitIdle() {
+    while (matriz_busy) {
+        tight_loop_contents();
+    }
+}
+
+/**
+ * Registra o callback de fim de quadro.
+ * @param callback Função chamada no contexto do alarme (NULL para remover).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void MatrizRGBPI_SetWriteCallback(MatrizRGBPI_callback_t callback, void *user_data) {
+    write_callback = callback;
+    write_user_data = user_data;
+}
+
+/**
+ * Define o brilho global, aplicado a todos os canais no envio.
+ * @param brightness Brilho de 0 (apagado) a 255 (cores sem atenuação).
+ */
+void MatrizRGBPI_SetBrightness(uint8_t brightness) {
+    matriz_brightness = brightness;
+    matriz_build_lut();
+}
+
+/**
+ * Define o expoente da curva de gama aplicada no envio.
+ * @param gamma Expoente (1.0 desliga a correção; 2.2 a 2.8 aproximam a percepção do olho).
+ */
+void MatrizRGBPI_SetGamma(float gamma) {
+    matriz_gamma = gamma > 0.0f ? gamma : 1.0f;
+    matriz_build_lut();
+}
+
+/**
+ * Define o balanço de branco: o ganho de cada canal no envio.
+ * @param r Ganho do vermelho (255: sem atenuação).
+ * @param g Ganho do verde.
+ * @param b Ganho do azul.
+ */
+void MatrizRGBPI_SetWhiteBalance(uint8_t r, uint8_t g, uint8_t b) {
+    matriz_white_balance[MATRIZ_CHANNEL_R] = r;
+    matriz_white_balance[MATRIZ_CHANNEL_G] = g;
+    matriz_white_balance[MATRIZ_CHANNEL_B] = b;
+    matriz_build_lut();
+}
+
+/**
+ * Liga ou desliga o pontilhado temporal. Ligado, um temporizador reenvia o quadro por DMA na taxa
+ * pedida, distribuindo entre os quadros a fração que a correção de cor deixa em cada canal.
+ * @param enable true para ligar.
+ * @param refresh_hz Taxa de atualização (limitada pela duração do quadro na linha).
+ * @return false se não há canal de DMA ou temporizador livre (o pontilhado fica desligado).
+ */
+bool MatrizRGBPI_SetDithering(bool enable, uint32_t refresh_hz) {
+    if (matriz_dither) {
+        cancel_repeating_timer(&matriz_dither_timer);
+        matriz_dither = false;
+        MatrizRGBPI_WaitIdle();
+        matriz_dirty = true; // O próximo Present envia o quadro arredondado
+    }
+    if (!enable) {
+        return true;
+    }
+    if (matriz_dma < 0 || refresh_hz == 0) {
+        return false;
+    }
+
+    MatrizRGBPI_WaitIdle();
+    memset(matriz_dither_error, 0, sizeof(matriz_dither_error));
+    matriz_pack16(matriz_frames16[0]);
+    matriz_dither_src = matriz_frames16[0];
+    matriz_dirty = false;
+
+    // O alarme de fim de quadro é agendado depois do empacotamento: sem a folga, a atualização
+    // seguinte encontraria o quadro ainda ocupado e seria perdida.
+    int64_t period_us = 1000000 / refresh_hz;
+    if (period_us < matriz_frame_us + MATRIZ_DITHER_SLACK_US) {
+        period_us = matriz_frame_us + MATRIZ_DITHER_SLACK_US;
+    }
+    // Período negativo: conta do início de uma atualização ao da próxima
+    matriz_dither = add_repeating_timer_us(-period_us, matriz_dither_refresh, NULL, &matriz_dither_timer);
+    return matriz_dither;
+}
+
+/**
+ * Lê os contadores de quadros enviados e ignorados e das atualizações do pontilhado.
+ * @param stats Destino dos contadores.
+ */
+void MatrizRGBPI_GetStats(MatrizRGBPI_stats_t *stats) {
+    stats->presented = matriz_presented;
+    stats->skipped = matriz_skipped;
+    stats->refreshes = matriz_refreshes;
+    stats->refresh_us = matriz_refresh_us;
+    stats->anim_frames = matriz_anim_frames;
+    stats->anim_frame_us = matriz_anim_frame_us;
+    stats->anim_frame_max_us = matriz_anim_frame_max_us;
+    stats->anim_missed = matriz_anim_missed;
+}
+
+/**
+ * Exibe uma letra na matriz de LEDs com a cor especificada (API bloqueante legada).
+ * @param letter Matriz 5x5x3 representando a letra (cada pixel pode estar ligado ou desligado).
+ * @param r Componente vermelho da cor.
+ * @param g Componente verde da cor.
+ * @param b Componente azul da cor.
+ */
 void MatrizRGBPI_displayLetter(const int letter[5][5][3], uint8_t r, uint8_t g, uint8_t b) {
-      for (int row = 0; row < 5; row++) {
-          for (int col = 0; col < 5; col++) {
-              int position = getIndex(row, col);
-              // Use the letter matrix as a mask (0 = off, non-zero = use provided color)
-              if (letter[col][row][0] || letter[col][row][1] || letter[col][row][2]) {
-                  MatrizRGBPI_SetLED(position, r, g, b);
-              } else {
-                  MatrizRGBPI_SetLED(position, 0, 0, 0);
-              }
-          }
-      }
-      MatrizRGBPI_Write();
-      sleep_ms(1000); // Display time for each letter (1 second)
-  }
-
-/*
-// Função para escrever uma string na matriz (com suporte a minúsculas)
-void MatrizRGBPI_displayString(const char *str) {
-  for (int i = 0; i < strlen(str); i++) {
-      char c = toupper(str[i]); // Usa a função toupper() do <ctype.h>
-      // Busca a letra no dicionário
-      for (int j = 0; j < ALPHABET_COUNT; j++) {
-          if (alphabet[j].character == c) {
-              MatrizRGBPI_displayLetter(alphabet[j].matrix);
-              break;
-          }
-      }
-  }
-}
-*/
+    for (int row = 0; row < 5; row++) {
+        for (int col = 0; col < 5; col++) {
+            // Se o pixel na matriz da letra estiver "ligado", usa a cor especificada.
+            if (letter[col][row][0] || letter[col][row][1] || letter[col][row][2]) {
+                MatrizRGBPI_SetPixel(row, col, r, g, b);
+            } else {
+                MatrizRGBPI_SetPixel(row, col, 0, 0, 0);
+            }
+        }
+    }
+    MatrizRGBPI_Write();
+    sleep_ms(1000); // Exibe a letra por 1 segundo.
+}
+
+/**
+ * Desenha um caractere da fonte 5x5 no buffer, cortando o que fica fora da imagem.
+ * @param glyph Linhas do desenho, com a coluna 0 no bit 4.
+ * @param x Coluna do canto superior esquerdo (pode ser negativa).
+ * @param y Linha do canto superior esquerdo (pode ser negativa).
+ * @param r Componente vermelho dos pixels acesos.
+ * @param g Componente verde dos pixels acesos.
+ * @param b Componente azul dos pixels acesos.
+ */
+void MatrizRGBPI_drawGlyph(const uint8_t *glyph, int x, int y, uint8_t r, uint8_t g, uint8_t b) {
+    for (int row = 0; row < FONT5X5_ROWS; row++) {
+        uint8_t bits = glyph[row];
+        for (int col = 0; col < FONT5X5_COLS; col++) {
+            // SetPixel ignora as coordenadas fora da imagem (negativas viram valores grandes)
+            if (bits & (1u << (FONT5X5_COLS - 1 - col))) {
+                MatrizRGBPI_SetPixel(x + col, y + row, r, g, b);
+            } else {
+                MatrizRGBPI_SetPixel(x + col, y + row, 0, 0, 0);
+            }
+        }
+    }
+}
 
+/**
+ * Exibe uma string na matriz de LEDs, caractere por caractere, com a cor especificada (API
+ * bloqueante legada; o letreiro de `MatrizRGBPI_MarqueeStart` não bloqueia).
+ * Caracteres sem desenho na fonte são ignorados.
+ * @param str String a ser exibida.
+ * @param r Componente vermelho da cor.
+ * @param g Componente verde da cor.
+ * @param b Componente azul da cor.
+ */
 void MatrizRGBPI_displayString(const char *str, uint8_t r, uint8_t g, uint8_t b) {
-      for (int i = 0; i < strlen(str); i++) {
-          char c = toupper(str[i]);
-          // Busca a letra no dicionário
-          for (int j = 0; j < ALPHABET_COUNT; j++) {
-              if (alphabet[j].character == c) {
-                  MatrizRGBPI_displayLetter(alphabet[j].matrix, r, g, b);
-                  break;
-              }
-          }
-      }
-  }
-
-// Função para exibir um frame específico (5x5) na matriz
+    for (; *str; str++) {
+        const uint8_t *glyph = font5x5_glyph(*str); // Minúsculas já têm o desenho das maiúsculas.
+        if (glyph) {
+            MatrizRGBPI_drawGlyph(glyph, 0, 0, r, g, b);
+            MatrizRGBPI_Write();
+            sleep_ms(1000); // Exibe a letra por 1 segundo.
+        }
+    }
+}
+
+/**
+ * Exibe um frame (imagem 5x5) na matriz de LEDs.
+ * @param frame Matriz 5x5x3 contendo as cores de cada pixel.
+ */
 void MatrizRGBPI_displayFrame(const int frame[5][5][3]) {
-      for (int y = 0; y < 5; y++) {
-          for (int x = 0; x < 5; x++) {
-              int posicao = getIndex(x, y);
-              MatrizRGBPI_SetLED(posicao, frame[y][x][0], frame[y][x][1], frame[y][x][2]);
-          }
-      }
-      MatrizRGBPI_Write();
-  }
-/*
-// Function to generate scroll between two letters
-void scrollLetters(const Letter *currentLetter, const Letter *nextLetter, int delay_ms) {
-      int frame[5][5][3]; // Buffer for the current frame
-    
-      for (int offset = 0; offset <= 5; offset++) {
-          // Fill the frame with columns from current and next letter
-          for (int y = 0; y < 5; y++) {
-              for (int x = 0; x < 5; x++) {
-                  if (x < 5 - offset) {
-                      // Get from current letter
-                      frame[y][x][0] = currentLetter->matrix[y][x + offset][0];
-                      frame[y][x][1] = currentLetter->matrix[y][x + offset][1];
-                      frame[y][x][2] = currentLetter->matrix[y][x + offset][2];
-                  } else {
-                      // Get from next letter
-                      frame[y][x][0] = nextLetter->matrix[y][x - (5 - offset)][0];
-                      frame[y][x][1] = nextLetter->matrix[y][x - (5 - offset)][1];
-                      frame[y][x][2] = nextLetter->matrix[y][x - (5 - offset)][2];
-                  }
-              }
-          }
-          MatrizRGBPI_displayFrame(frame);
-          sleep_ms(delay_ms);
-      }
-  }
-
-*/
-void scrollLetters(const Letter *currentLetter, const Letter *nextLetter, int delay_ms, uint8_t r, uint8_t g, uint8_t b) {
-      int frame[5][5][3]; // Buffer for the current frame
-      
-      for (int offset = 0; offset <= 5; offset++) {
-          // Fill the frame with columns from current and next letter
-          for (int y = 0; y < 5; y++) {
-              for (int x = 0; x < 5; x++) {
-                  if (x < 5 - offset) {
-                      // Get from current letter - use specified color if pixel is "on"
-                      if (currentLetter->matrix[y][x + offset][0] || 
-                          currentLetter->matrix[y][x + offset][1] || 
-                          currentLetter->matrix[y][x + offset][2]) {
-                          frame[y][x][0] = r;
-                          frame[y][x][1] = g;
-                          frame[y][x][2] = b;
-                      } else {
-                          frame[y][x][0] = 0;
-                          frame[y][x][1] = 0;
-                          frame[y][x][2] = 0;
-                      }
-                  } else {
-                      // Get from next letter - use specified color if pixel is "on"
-                      if (nextLetter->matrix[y][x - (5 - offset)][0] || 
-                          nextLetter->matrix[y][x - (5 - offset)][1] || 
-                          nextLetter->matrix[y][x - (5 - offset)][2]) {
-                          frame[y][x][0] = r;
-                          frame[y][x][1] = g;
-                          frame[y][x][2] = b;
-                      } else {
-                          frame[y][x][0] = 0;
-                          frame[y][x][1] = 0;
-                          frame[y][x][2] = 0;
-                      }
-                  }
-              }
-          }
-          MatrizRGBPI_displayFrame(frame);
-          sleep_ms(delay_ms);
-      }
-  }
-  
-/*
-// Function to write a string with scroll effect
-void MatrizRGBPI_displayStringWithScroll(const char *str, int delay_ms) {
-      const Letter *currentLetter = NULL;
-      const Letter *nextLetter = NULL;
-  
-      for (int i = 0; i < strlen(str); i++) {
-          char c = toupper(str[i]);
-          
-          // Find the next letter in the dictionary
-          for (int j = 0; j < ALPHABET_COUNT; j++) {
-              if (alphabet[j].character == c) {
-                  nextLetter = &alphabet[j];
-                  break;
-              }
-          }
-  
-          if (currentLetter != NULL && nextLetter != NULL) {
-              scrollLetters(currentLetter, nextLetter, delay_ms);
-          } else if (nextLetter != NULL) {
-              // Display the first letter without scrolling
-              MatrizRGBPI_displayFrame(nextLetter->matrix);
-              sleep_ms(delay_ms * 3);
-          }
-  
-          currentLetter = nextLetter;
-      }
-  }
-      */
-// Function to write a string with scroll effect and custom color
+    for (int y = 0; y < 5; y++) {
+        for (int x = 0; x < 5; x++) {
+            MatrizRGBPI_SetPixel(x, y, frame[y][x][0], frame[y][x][1], frame[y][x][2]);
+        }
+    }
+    MatrizRGBPI_Write();
+}
+
+/**
+ * Gera uma animação de scroll entre duas letras com a cor especificada: a cada passo as duas
+ * letras andam uma coluna para a esquerda (API bloqueante legada).
+ * @param current Desenho da letra atual.
+ * @param next Desenho da próxima letra.
+ * @param delay_ms Tempo de delay entre os frames da animação.
+ * @param r Componente vermelho da cor.
+ * @param g Componente verde da cor.
+ * @param b Componente azul da cor.
+ */
+void scrollLetters(const uint8_t *current, const uint8_t *next, int delay_ms, uint8_t r, uint8_t g, uint8_t b) {
+    for (int offset = 0; offset <= FONT5X5_COLS; offset++) {
+        MatrizRGBPI_drawGlyph(current, -offset, 0, r, g, b);
+        MatrizRGBPI_drawGlyph(next, FONT5X5_COLS - offset, 0, r, g, b);
+        MatrizRGBPI_Write();
+        sleep_ms(delay_ms);
+    }
+}
+
+/**
+ * Exibe uma string com efeito de scroll e cor personalizada. Caracteres sem desenho na fonte
+ * são ignorados (API bloqueante legada; o letreiro de `MatrizRGBPI_MarqueeStart` não bloqueia).
+ * @param str String a ser exibida.
+ * @param delay_ms Tempo de delay entre os frames da animação.
+ * @param r Componente vermelho da cor.
+ * @param g Componente verde da cor.
+ * @param b Componente azul da cor.
+ */
 void MatrizRGBPI_displayStringWithScroll(const char *str, int delay_ms, uint8_t r, uint8_t g, uint8_t b) {
-      const Letter *currentLetter = NULL;
-      const Letter *nextLetter = NULL;
-  
-      for (int i = 0; i < strlen(str); i++) {
-          char c = toupper(str[i]);
-          
-          // Find the next letter in the dictionary
-          for (int j = 0; j < ALPHABET_COUNT; j++) {
-              if (alphabet[j].character == c) {
-                  nextLetter = &alphabet[j];
-                  break;
-              }
-          }
-  
-          if (currentLetter != NULL && nextLetter != NULL) {
-              scrollLetters(currentLetter, nextLetter, delay_ms, r, g, b);
-          } else if (nextLetter != NULL) {
-              // Display the first letter without scrolling (with specified color)
-              int frame[5][5][3];
-              for (int y = 0; y < 5; y++) {
-                  for (int x = 0; x < 5; x++) {
-                      // If the pixel is "on" in the letter matrix (any non-zero value), use the specified color
-                      if (nextLetter->matrix[y][x][0] || nextLetter->matrix[y][x][1] || nextLetter->matrix[y][x][2]) {
-                          frame[y][x][0] = r;
-                          frame[y][x][1] = g;
-                          frame[y][x][2] = b;
-                      } else {
-                          frame[y][x][0] = 0;
-                          frame[y][x][1] = 0;
-                          frame[y][x][2] = 0;
-                      }
-                  }
-              }
-              MatrizRGBPI_displayFrame(frame);
-              sleep_ms(delay_ms * 3);
-          }
-  
-          currentLetter = nextLetter;
-      }
-  }
\ No newline at end of file
+    const uint8_t *current = NULL;
+    for (; *str; str++) {
+        const uint8_t *next = font5x5_glyph(*str);
+        if (next == NULL) {
+            continue;
+        }
+        if (current != NULL) {
+            scrollLetters(current, next, delay_ms, r, g, b);
+        } else {
+            // Exibe a primeira letra sem scroll, por um tempo maior.
+            MatrizRGBPI_drawGlyph(next, 0, 0, r, g, b);
+            MatrizRGBPI_Write();
+            sleep_ms(delay_ms * 3);
+        }
+        current = next;
+    }
+}
+
+/**
+ * Passo do letreiro, no contexto do temporizador: a coluna mais antiga da janela dá lugar à
+ * próxima, as linhas do texto são redesenhadas e o quadro vai para o DMA.
+ */
+static bool matriz_marquee_tick(repeating_timer_t *timer) {
+    (void)timer;
+    if (matriz_busy) {
+        return true; // Quadro anterior ainda na linha: o passo fica para o próximo período
+    }
+
+    uint8_t column;
+    if (!matriz_marquee_next(&matriz_marquee, &column)) {
+        matriz_marquee_running = false;
+        return false; // Fim do texto: o temporizador para
+    }
+    matriz_marquee_window[matriz_marquee_head] = column;
+    matriz_marquee_head = (matriz_marquee_head + 1) % MATRIZ_WIDTH;
+
+    // Texto centralizado na vertical; as outras linhas ficam apagadas desde o início.
+    uint top = (MATRIZ_HEIGHT - FONT5X5_ROWS) / 2;
+    uint x = 0;
+    for (uint i = matriz_marquee_head; x < MATRIZ_WIDTH; i = (i + 1) % MATRIZ_WIDTH, x++) {
+        uint8_t bits = matriz_marquee_window[i];
+        for (uint row = 0; row < FONT5X5_ROWS; row++) {
+            if (bits & (1u << row)) {
+                MatrizRGBPI_SetPixel(x, top + row, matriz_marquee_color[0], matriz_marquee_color[1],
+                                     matriz_marquee_color[2]);
+            } else {
+                MatrizRGBPI_SetPixel(x, top + row, 0, 0, 0);
+            }
+        }
+    }
+    MatrizRGBPI_Present();
+    return true;
+}
+
+/**
+ * Inicia um letreiro que passa o texto da direita para a esquerda, sem bloquear.
+ * @param text Texto (precisa continuar válido enquanto o letreiro roda).
+ * @param column_ms Tempo de cada coluna, em milissegundos.
+ * @param loop true para repetir o texto até MatrizRGBPI_MarqueeStop.
+ * @param r Componente vermelho da cor.
+ * @param g Componente verde da cor.
+ * @param b Componente azul da cor.
+ * @return false se não há temporizador livre.
+ */
+bool MatrizRGBPI_MarqueeStart(const char *text, uint32_t column_ms, bool loop, uint8_t r, uint8_t g, uint8_t b) {
+    MatrizRGBPI_MarqueeStop();
+    MatrizRGBPI_AnimStop(); // A imagem passa a ser do letreiro
+
+    // O texto entra pela direita numa matriz apagada e, no fim, sai inteiro pela esquerda.
+    matriz_marquee_start(&matriz_marquee, text, MATRIZ_WIDTH, loop);
+    memset(matriz_marquee_window, 0, sizeof(matriz_marquee_window));
+    matriz_marquee_head = 0;
+    matriz_marquee_color[0] = r;
+    matriz_marquee_color[1] = g;
+    matriz_marquee_color[2] = b;
+    MatrizRGBPI_Clear();
+    MatrizRGBPI_Present();
+
+    // Um período menor que o quadro faria os passos esperarem o fim do envio anterior.
+    int64_t period_us = (int64_t)column_ms * 1000;
+    if (period_us < matriz_frame_us + MATRIZ_DITHER_SLACK_US) {
+        period_us = matriz_frame_us + MATRIZ_DITHER_SLACK_US;
+    }
+    matriz_marquee_running = true;
+    if (!add_repeating_timer_us(-period_us, matriz_marquee_tick, NULL, &matriz_marquee_timer)) {
+        matriz_marquee_running = false;
+    }
+    return matriz_marquee_running;
+}
+
+/**
+ * Para o letreiro, deixando a imagem como estava no último quadro.
+ */
+void MatrizRGBPI_MarqueeStop() {
+    cancel_repeating_timer(&matriz_marquee_timer); // Sem efeito se o letreiro já terminou
+    matriz_marquee_running = false;
+}
+
+/**
+ * Indica se o letreiro ainda está passando.
+ */
+bool MatrizRGBPI_MarqueeRunning() {
+    return matriz_marquee_running;
+}
+
+/**
+ * Relógio de quadros da cena, no contexto do temporizador: conta os prazos perdidos, avança as
+ * trilhas, compõe a cena e envia o quadro.
+ */
+static bool matriz_anim_tick(repeating_timer_t *timer) {
+    (void)timer;
+    uint64_t now = time_us_64();
+
+    // Um atraso de um período inteiro ou mais significa quadros que não saíram no prazo.
+    if (now >= matriz_anim_deadline_us + matriz_anim_period_us) {
+        uint64_t late = (now - matriz_anim_deadline_us) / matriz_anim_period_us;
+        matriz_anim_missed += late;
+        matriz_anim_deadline_us += late * matriz_anim_period_us;
+    }
+    matriz_anim_deadline_us += matriz_anim_period_us;
+    if (matriz_busy) {
+        matriz_anim_missed++; // Quadro anterior ainda na linha
+        return true;
+    }
+
+    uint32_t start = time_us_32();
+    matriz_anim_update(&matriz_anim, (uint32_t)(now / 1000));
+    matriz_anim_render(&matriz_anim, matriz_anim_frame);
+    for (uint y = 0; y < MATRIZ_HEIGHT; y++) {
+        for (uint x = 0; x < MATRIZ_WIDTH; x++) {
+            const uint8_t *pixel = matriz_anim_frame[y * MATRIZ_WIDTH + x];
+            MatrizRGBPI_SetPixel(x, y, pixel[0], pixel[1], pixel[2]);
+        }
+    }
+    MatrizRGBPI_Present();
+
+    uint32_t elapsed = time_us_32() - start;
+    matriz_anim_frames++;
+    matriz_anim_frame_us += elapsed;
+    if (elapsed > matriz_anim_frame_max_us) {
+        matriz_anim_frame_max_us = elapsed;
+    }
+    return true;
+}
+
+/**
+ * Dá acesso exclusivo à cena, desligando as interrupções até MatrizRGBPI_AnimUnlock.
+ * @return A cena.
+ */
+matriz_anim_t *MatrizRGBPI_AnimLock() {
+    matriz_anim_lock_state = save_and_disable_interrupts();
+    return &matriz_anim;
+}
+
+/**
+ * Libera a cena, religando as interrupções.
+ */
+void MatrizRGBPI_AnimUnlock() {
+    restore_interrupts(matriz_anim_lock_state);
+}
+
+/**
+ * Instante atual no relógio das trilhas.
+ * @return Milissegundos desde o boot.
+ */
+uint32_t MatrizRGBPI_AnimNow() {
+    return (uint32_t)(time_us_64() / 1000);
+}
+
+/**
+ * Liga o relógio de quadros da cena.
+ * @param fps Quadros por segundo.
+ * @return false se não há temporizador livre.
+ */
+bool MatrizRGBPI_AnimStart(uint32_t fps) {
+    MatrizRGBPI_AnimStop();
+    MatrizRGBPI_MarqueeStop(); // A imagem passa a ser da cena
+    if (fps == 0) {
+        return false;
+    }
+
+    // Um período menor que o quadro faria todo quadro encontrar a linha ocupada.
+    matriz_anim_period_us = 1000000 / fps;
+    if (matriz_anim_period_us < matriz_frame_us + MATRIZ_DITHER_SLACK_US) {
+        matriz_anim_period_us = matriz_frame_us + MATRIZ_DITHER_SLACK_US;
+    }
+    matriz_anim_deadline_us = time_us_64() + matriz_anim_period_us;
+    matriz_anim_running = add_repeating_timer_us(-matriz_anim_period_us, matriz_anim_tick, NULL, &matriz_anim_timer);
+    return matriz_anim_running;
+}
+
+/**
+ * Desliga o relógio de quadros, deixando a imagem como estava no último quadro.
+ */
+void MatrizRGBPI_AnimStop() {
+    if (matriz_anim_running) {
+        cancel_repeating_timer(&matriz_anim_timer);
+        matriz_anim_running = false;
+    }
+}
+
+/**
+ * Indica se alguma trilha da cena ainda está em andamento.
+ */
+bool MatrizRGBPI_AnimPlaying() {
+    return matriz_anim_playing(&matriz_anim);
+}
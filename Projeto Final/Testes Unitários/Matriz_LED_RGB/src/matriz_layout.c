@@ -0,0 +1,107 @@
+#include "inc/matriz_layout.h"
+
+/**
+ * Arquivo: matriz_layout.c
+ *
+ * Descrição:
+ * Conversão de coordenadas da imagem para a posição do LED na cadeia. A coordenada é levada da
+ * imagem para a montagem (desfazendo a rotação), separada em painel e posição dentro do painel,
+ * e cada parte é numerada a partir do seu canto de origem, invertendo as linhas ímpares na
+ * serpentina.
+ */
+
+/******************************
+ * Funções Auxiliares
+ ******************************/
+
+/**
+ * @brief Número de painéis numa direção (0 equivale a 1).
+ */
+static uint16_t tiles(uint8_t count) {
+    return count ? count : 1;
+}
+
+/**
+ * @brief Posição numa grade de `width` x `height` percorrida a partir de `origin`, linha a linha.
+ */
+static uint32_t grid_index(uint16_t col, uint16_t row, uint16_t width, uint16_t height,
+                           matriz_wiring_t wiring, matriz_origin_t origin) {
+    if (origin == MATRIZ_ORIGIN_TOP_RIGHT || origin == MATRIZ_ORIGIN_BOTTOM_RIGHT) {
+        col = width - 1 - col;
+    }
+    if (origin == MATRIZ_ORIGIN_BOTTOM_LEFT || origin == MATRIZ_ORIGIN_BOTTOM_RIGHT) {
+        row = height - 1 - row;
+    }
+    if (wiring == MATRIZ_WIRING_SERPENTINE && (row & 1)) {
+        col = width - 1 - col; // Linha de volta
+    }
+    return (uint32_t)row * width + col;
+}
+
+/**
+ * @brief Largura e altura da montagem, antes da rotação.
+ */
+static void assembly_size(const matriz_layout_t *layout, uint16_t *width, uint16_t *height) {
+    *width = (uint16_t)(layout->panel_width * tiles(layout->tiles_x));
+    *height = (uint16_t)(layout->panel_height * tiles(layout->tiles_y));
+}
+
+/******************************
+ * Funções
+ ******************************/
+
+uint16_t matriz_layout_width(const matriz_layout_t *layout) {
+    uint16_t width, height;
+    assembly_size(layout, &width, &height);
+    return (layout->rotation & 1) ? height : width;
+}
+
+uint16_t matriz_layout_height(const matriz_layout_t *layout) {
+    uint16_t width, height;
+    assembly_size(layout, &width, &height);
+    return (layout->rotation & 1) ? width : height;
+}
+
+int32_t matriz_layout_index(const matriz_layout_t *layout, uint16_t x, uint16_t y) {
+    uint16_t width, height;
+    assembly_size(layout, &width, &height);
+    if (x >= matriz_layout_width(layout) || y >= matriz_layout_height(layout)) {
+        return -1;
+    }
+
+    // Imagem girada no sentido horário sobre a montagem: o topo da imagem fica à direita (1),
+    // embaixo (2) ou à esquerda (3)
+    uint16_t px, py;
+    switch (layout->rotation & 3) {
+        case 1:  px = width - 1 - y; py = x; break;
+        case 2:  px = width - 1 - x; py = height - 1 - y; break;
+        case 3:  px = y; py = height - 1 - x; break;
+        default: px = x; py = y; break;
+    }
+
+    uint32_t panel = grid_index(px / layout->panel_width, py / layout->panel_height,
+                                tiles(layout->tiles_x), tiles(layout->tiles_y),
+                                layout->tile_wiring, layout->tile_origin);
+    uint32_t led = grid_index(px % layout->panel_width, py % layout->panel_height,
+                              layout->panel_width, layout->panel_height,
+                              layout->wiring, layout->origin);
+    return (int32_t)(panel * layout->panel_width * layout->panel_height + led);
+}
+
+bool matriz_layout_build(const matriz_layout_t *layout, uint16_t *lut, uint32_t lut_size) {
+    if (layout->panel_width == 0 || layout->panel_height == 0) {
+        return false;
+    }
+    uint16_t width = matriz_layout_width(layout);
+    uint16_t height = matriz_layout_height(layout);
+    if ((uint32_t)width * height != lut_size || lut_size > UINT16_MAX + 1u) {
+        return false;
+    }
+
+    for (uint16_t y = 0; y < height; y++) {
+        for (uint16_t x = 0; x < width; x++) {
+            lut[(uint32_t)y * width + x] = (uint16_t)matriz_layout_index(layout, x, y);
+        }
+    }
+    return true;
+}
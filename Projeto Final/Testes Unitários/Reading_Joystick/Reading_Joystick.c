@@ -28,18 +28,39 @@ void print_vertical_bar(int value, int max_height) {
     printf("--\n");
 }
 
+// Indica que a direção ou a zona mudaram e a tela precisa ser redesenhada
+static volatile bool redraw = true;
+
+// Callback do detector de direção: só marca o redesenho
+void on_direction_event(const joystick_direction_event_t *event, void *user_data) {
+    (void)event;
+    (void)user_data;
+    redraw = true;
+}
+
 int main() {
     stdio_init_all();
     // Inicializa o joystick
     joystick_init();
+    joystick_set_direction_callback(on_direction_event, NULL);
 
     while (true) {
         // Lê o estado atual do joystick
         joystick_state_t state = joystick_read();
 
-        // Obtém a direção do joystick
+        // Obtém a direção do joystick (dispara on_direction_event se mudou)
         Direction dir = joystick_get_direction(state);
 
+        // Só redesenha quando a direção ou a zona mudam
+        if (!redraw) {
+            sleep_ms(20);
+            continue;
+        }
+        redraw = false;
+
+        // Limpa o console para atualizar a exibição
+        printf("\033[H\033[J"); // Código ANSI para limpar o console
+
         // Exibe a direção no console
         switch (dir) {
             case CENTRALIZADO:
@@ -82,11 +103,8 @@ int main() {
         printf("Eixo Y:\n");
         print_vertical_bar(state.y, 10);
 
-        // Aguarda um pouco antes de ler novamente (evita flood no console)
-        sleep_ms(200);
-
-        // Limpa o console para atualizar a exibição
-        printf("\033[H\033[J"); // Código ANSI para limpar o console
+        // Aguarda um pouco antes de ler novamente
+        sleep_ms(20);
     }
 
     return 0;
@@ -5,6 +5,7 @@
 #include<stdbool.h>
 #include"pico/stdlib.h"
 #include "hardware/adc.h"
+#include "inc/joystick_direction.h"
 
 
 /******************************
@@ -99,11 +100,33 @@ bool joystick_read_button();
 /**
  * @brief Identifica a direção do joystick com base nos valores dos eixos X e Y.
  * 
+ * Usa um detector com histerese angular e radial: a direção só muda depois de atravessar
+ * a fronteira do setor com folga, e cada troca dispara o callback registrado em
+ * `joystick_set_direction_callback`.
+ * 
  * @param state Estrutura `joystick_state_t` contendo os valores dos eixos X e Y.
  * @return Direção do joystick (enum Direction).
  */
 Direction joystick_get_direction(joystick_state_t state);
 
+/**
+ * @brief Registra a função chamada quando a direção ou a zona do joystick mudam.
+ * 
+ * Reinicia o detector na posição central.
+ * 
+ * @param callback Função chamada a cada evento (NULL para nenhuma).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_set_direction_callback(joystick_direction_callback_t callback, void *user_data);
+
+/**
+ * @brief Converte a direção do detector para o enum Direction.
+ * 
+ * @param direction Direção informada nos eventos do detector.
+ * @return Direção correspondente (enum Direction).
+ */
+Direction joystick_to_direction(joystick_direction_t direction);
+
 /**
  * @brief Mapeia um valor de uma faixa de entrada para uma faixa de saída.
  * 
@@ -2,6 +2,30 @@
 #include<stdlib.h>
 #include<math.h>
 
+/******************************
+ * Variáveis Internas
+ ******************************/
+
+/**
+ * @brief Detector de direção usado por `joystick_get_direction`.
+ */
+static joystick_tracker_t direction_tracker;
+
+/**
+ * @brief Correspondência entre as direções do detector e o enum Direction.
+ */
+static const Direction direction_map[] = {
+    [JOYSTICK_DIR_CENTER] = CENTRALIZADO,
+    [JOYSTICK_DIR_RIGHT] = DIREITA,
+    [JOYSTICK_DIR_UP_RIGHT] = DIREITA_CIMA,
+    [JOYSTICK_DIR_UP] = CIMA,
+    [JOYSTICK_DIR_UP_LEFT] = ESQUERDA_CIMA,
+    [JOYSTICK_DIR_LEFT] = ESQUERDA,
+    [JOYSTICK_DIR_DOWN_LEFT] = ESQUERDA_BAIXO,
+    [JOYSTICK_DIR_DOWN] = BAIXO,
+    [JOYSTICK_DIR_DOWN_RIGHT] = DIREITA_BAIXO,
+};
+
 
 /******************************
  * Funções
@@ -25,6 +49,9 @@ void joystick_init() {
     gpio_init(JOYSTICK_BUTTON_PIN);
     gpio_set_dir(JOYSTICK_BUTTON_PIN, GPIO_IN);
     gpio_pull_up(JOYSTICK_BUTTON_PIN); // Habilita o resistor de pull-up
+
+    // Detector de direção sem callback até que um seja registrado
+    joystick_tracker_init(&direction_tracker, NULL, NULL, NULL);
 }
 
 /**
@@ -81,44 +108,39 @@ bool joystickPi_read_button() {
 /**
  * @brief Identifica a direção do joystick com base nos valores dos eixos X e Y.
  * 
+ * Centra os eixos na escala de ±32767 e atualiza o detector com histerese, que dispara o
+ * callback registrado quando a direção ou a zona mudam.
+ * 
  * @param state Estrutura `joystick_state_t` contendo os valores dos eixos X e Y.
  * @return Direção do joystick (enum Direction).
  */
 Direction joystick_get_direction(joystick_state_t state) {
-    // Define os limites para considerar o joystick centralizado
-    const uint16_t center_threshold = 2048; // Valor central do ADC (0-4095)
-    const uint16_t deadzone = 500; // Zona morta para evitar flutuações
-
-    // Calcula a diferença em relação ao centro
-    int16_t x_diff = state.x - center_threshold;
-    int16_t y_diff = state.y - center_threshold;
-
-    // Verifica se o joystick está centralizado
-    if (abs(x_diff) < deadzone && abs(y_diff) < deadzone) {
-        return CENTRALIZADO;
-    }
-
-    // Verifica as direções principais e diagonais
-    if (x_diff > deadzone && abs(y_diff) < deadzone) {
-        return DIREITA;
-    } else if (x_diff < -deadzone && abs(y_diff) < deadzone) {
-        return ESQUERDA;
-    } else if (y_diff > deadzone && abs(x_diff) < deadzone) {
-        return CIMA;
-    } else if (y_diff < -deadzone && abs(x_diff) < deadzone) {
-        return BAIXO;
-    } else if (x_diff > deadzone && y_diff > deadzone) {
-        return DIREITA_CIMA;
-    } else if (x_diff > deadzone && y_diff < -deadzone) {
-        return DIREITA_BAIXO;
-    } else if (x_diff < -deadzone && y_diff > deadzone) {
-        return ESQUERDA_CIMA;
-    } else if (x_diff < -deadzone && y_diff < -deadzone) {
-        return ESQUERDA_BAIXO;
-    }
-
-    // Caso padrão (centralizado)
-    return CENTRALIZADO;
+    // Diferença em relação ao centro do ADC (2048), levada para 16 bits
+    int16_t x_diff = (int16_t)((state.x - 2048) * 16);
+    int16_t y_diff = (int16_t)((state.y - 2048) * 16);
+
+    joystick_tracker_update(&direction_tracker, x_diff, y_diff);
+    return direction_map[direction_tracker.direction];
+}
+
+/**
+ * @brief Registra a função chamada quando a direção ou a zona do joystick mudam.
+ * 
+ * @param callback Função chamada a cada evento (NULL para nenhuma).
+ * @param user_data Ponteiro repassado ao callback.
+ */
+void joystick_set_direction_callback(joystick_direction_callback_t callback, void *user_data) {
+    joystick_tracker_init(&direction_tracker, NULL, callback, user_data);
+}
+
+/**
+ * @brief Converte a direção do detector para o enum Direction.
+ * 
+ * @param direction Direção informada nos eventos do detector.
+ * @return Direção correspondente (enum Direction).
+ */
+Direction joystick_to_direction(joystick_direction_t direction) {
+    return direction_map[direction];
 }
 
 /**